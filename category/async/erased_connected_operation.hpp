@@ -292,6 +292,8 @@ protected:
     bool lifetime_managed_internally_{
         false}; // some factory classes may deallocate states on their own
     io_priority io_priority_{io_priority::normal};
+    uint16_t device_index_{0}; // set upon initiation if capture_io_latencies
+                               // enabled
     std::atomic<AsyncIO *> io_{
         nullptr}; // set at construction if associated with an AsyncIO instance,
                   // which isn't mandatory
@@ -574,6 +576,18 @@ public:
         io_priority_ = v;
     }
 
+    //! The storage pool device index the i/o was last initiated against.
+    //! Only valid if capture_io_latencies is enabled.
+    uint16_t device_index() const noexcept
+    {
+        return device_index_;
+    }
+
+    void set_device_index(uint16_t v) noexcept
+    {
+        device_index_ = v;
+    }
+
     //! The executor instance being used, which may be none.
     AsyncIO *executor() noexcept
     {
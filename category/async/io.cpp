@@ -27,6 +27,7 @@
 #include <category/core/tl_tid.h>
 #include <category/core/unordered_map.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cerrno>
@@ -199,6 +200,11 @@ AsyncIO::AsyncIO(class storage_pool &pool, monad::io::Buffers &rwbuf)
         pool.activate_chunk(storage_pool::cnv, 0));
     auto count = pool.chunks(storage_pool::seq);
     seq_chunks_.reserve(count);
+    std::vector<uint32_t> device_write_alignments;
+    device_write_alignments.reserve(pool.devices().size());
+    for (auto const &device : pool.devices()) {
+        device_write_alignments.push_back(device.optimal_io_size());
+    }
     std::vector<int> fds;
     fds.reserve(count * 2 + 2);
     fds.push_back(cnv_chunk_.io_uring_read_fd);
@@ -217,9 +223,14 @@ AsyncIO::AsyncIO(class storage_pool &pool, monad::io::Buffers &rwbuf)
         MONAD_ASSERT(
             (seq_chunks_.back().ptr->capacity() %
              MONAD_IO_BUFFERS_WRITE_SIZE) == 0);
+        seq_chunks_.back().device_index = static_cast<uint16_t>(
+            pool.device_index(seq_chunks_.back().ptr->device()));
+        seq_chunks_.back().write_alignment =
+            device_write_alignments[seq_chunks_.back().device_index];
         fds.push_back(seq_chunks_[n].io_uring_read_fd);
         fds.push_back(seq_chunks_[n].io_uring_write_fd);
     }
+    records_.per_device.resize(pool.devices().size());
 
     /* Annoyingly io_uring refuses duplicate file descriptors in its
     registration, and for efficiency the zoned storage emulation returns the
@@ -474,6 +485,26 @@ void AsyncIO::poll_uring_while_submission_queue_full_()
     }
 }
 
+void AsyncIO::record_device_latency_(erased_connected_operation const *state)
+{
+    if (!capture_io_latencies_) {
+        return;
+    }
+    MONAD_DEBUG_ASSERT(state->device_index() < records_.per_device.size());
+    auto &dev = records_.per_device[state->device_index()];
+    auto const elapsed = state->elapsed;
+    if (state->is_write()) {
+        ++dev.nwrites;
+        dev.total_write_latency += elapsed;
+        dev.max_write_latency = std::max(dev.max_write_latency, elapsed);
+    }
+    else {
+        ++dev.nreads;
+        dev.total_read_latency += elapsed;
+        dev.max_read_latency = std::max(dev.max_read_latency, elapsed);
+    }
+}
+
 // return the number of completions processed
 // if blocking is true, will block until at least one completion is processed
 size_t AsyncIO::poll_uring_(bool blocking, unsigned poll_rings_mask)
@@ -658,12 +689,14 @@ size_t AsyncIO::poll_uring_(bool blocking, unsigned poll_rings_mask)
             if (retry_operation_if_temporary_failure()) {
                 return true;
             }
+            record_device_latency_(state);
             // Speculative read i/o deque
             dequeue_concurrent_read_ios_pending();
         }
         else if (state->is_write()) {
             --records_.inflight_wr;
             is_read_or_write = true;
+            record_device_latency_(state);
         }
         else if (state->is_timeout()) {
             --records_.inflight_tm;
@@ -676,6 +709,7 @@ size_t AsyncIO::poll_uring_(bool blocking, unsigned poll_rings_mask)
             if (retry_operation_if_temporary_failure()) {
                 return true;
             }
+            record_device_latency_(state);
         }
 #ifndef NDEBUG
         else {
@@ -25,8 +25,10 @@
 
 #include <category/core/mem/allocators.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
 #include <filesystem>
@@ -34,6 +36,7 @@
 #include <iostream>
 #include <span>
 #include <tuple>
+#include <vector>
 
 MONAD_ASYNC_NAMESPACE_BEGIN
 
@@ -55,6 +58,38 @@ struct IORecord
     unsigned nreads{0};
     // Reads and scatter reads which got a EAGAIN and were retried
     unsigned reads_retried{0};
+
+    // Write buffer requests which found none free, and the total time spent
+    // reaping write completions until one was freed
+    uint64_t nwrite_stalls{0};
+    std::chrono::steady_clock::duration total_write_stall{0};
+
+    // Per storage pool device, only updated if capture_io_latencies is enabled
+    struct device_latencies_t
+    {
+        uint64_t nreads{0};
+        uint64_t nwrites{0};
+        std::chrono::steady_clock::duration total_read_latency{0};
+        std::chrono::steady_clock::duration max_read_latency{0};
+        std::chrono::steady_clock::duration total_write_latency{0};
+        std::chrono::steady_clock::duration max_write_latency{0};
+
+        std::chrono::steady_clock::duration
+        average_read_latency() const noexcept
+        {
+            return nreads == 0 ? std::chrono::steady_clock::duration{0}
+                               : total_read_latency / nreads;
+        }
+
+        std::chrono::steady_clock::duration
+        average_write_latency() const noexcept
+        {
+            return nwrites == 0 ? std::chrono::steady_clock::duration{0}
+                                : total_write_latency / nwrites;
+        }
+    };
+
+    std::vector<device_latencies_t> per_device;
 };
 
 class AsyncIO final
@@ -73,6 +108,10 @@ private:
     {
         std::shared_ptr<T> ptr;
         int io_uring_read_fd{-1}, io_uring_write_fd{-1}; // NOT POSIX fds!
+        uint16_t device_index{0}; // index into storage_pool::devices()
+        // power of two the device prefers writes to this chunk to be
+        // aligned to, see storage_pool::device::optimal_io_size()
+        uint32_t write_alignment{DISK_PAGE_SIZE};
 
         constexpr chunk_ptr_() = default;
 
@@ -124,6 +163,7 @@ private:
 
     void poll_uring_while_submission_queue_full_();
     size_t poll_uring_(bool blocking, unsigned poll_rings_mask);
+    void record_device_latency_(erased_connected_operation const *state);
 
 public:
     AsyncIO(class storage_pool &pool, monad::io::Buffers &rwbuf);
@@ -167,6 +207,14 @@ public:
         return seq_chunks_[id].ptr->capacity();
     }
 
+    //! The power of two alignment, at least `DISK_PAGE_SIZE`, that writes
+    //! into the sequential chunk are best padded to.
+    uint32_t chunk_write_alignment(size_t id) const noexcept
+    {
+        MONAD_DEBUG_ASSERT(id < seq_chunks_.size());
+        return seq_chunks_[id].write_alignment;
+    }
+
     //! The instance for this thread
     static AsyncIO *thread_instance() noexcept
     {
@@ -212,6 +260,19 @@ public:
         return records_.max_inflight_wr;
     }
 
+    //! The number of times a write buffer was requested when none were
+    //! free, causing the caller to stall until a write completed.
+    uint64_t write_stalls() const noexcept
+    {
+        return records_.nwrite_stalls;
+    }
+
+    //! The total time spent stalled waiting for a write buffer.
+    std::chrono::steady_clock::duration write_stall_duration() const noexcept
+    {
+        return records_.total_write_stall;
+    }
+
     unsigned timers_in_flight() const noexcept
     {
         return records_.inflight_tm;
@@ -249,6 +310,15 @@ public:
         return capture_io_latencies_;
     }
 
+    //! Per storage pool device read and write latencies, indexed the same
+    //! as `storage_pool::devices()`. Only populated if capture_io_latencies
+    //! is enabled.
+    std::span<IORecord::device_latencies_t const>
+    device_latencies() const noexcept
+    {
+        return records_.per_device;
+    }
+
     void set_capture_io_latencies(bool v) noexcept
     {
         capture_io_latencies_ = v;
@@ -327,6 +397,10 @@ public:
         records_.max_inflight_rd_scatter = 0;
         records_.max_inflight_wr = 0;
         records_.nreads = 0;
+        std::fill(
+            records_.per_device.begin(),
+            records_.per_device.end(),
+            IORecord::device_latencies_t{});
     }
 
     size_t submit_read_request(
@@ -360,6 +434,7 @@ public:
         }
 
         if (capture_io_latencies_) {
+            uring_data->set_device_index(seq_chunks_[offset.id].device_index);
             uring_data->initiated = std::chrono::steady_clock::now();
         }
         submit_request_(buffer, offset, uring_data, uring_data->io_priority());
@@ -376,6 +451,7 @@ public:
 
     {
         if (capture_io_latencies_) {
+            uring_data->set_device_index(seq_chunks_[offset.id].device_index);
             uring_data->initiated = std::chrono::steady_clock::now();
         }
         submit_request_(buffers, offset, uring_data, uring_data->io_priority());
@@ -391,6 +467,7 @@ public:
         erased_connected_operation *uring_data)
     {
         if (capture_io_latencies_) {
+            uring_data->set_device_index(seq_chunks_[offset.id].device_index);
             uring_data->initiated = std::chrono::steady_clock::now();
         }
         submit_request_(buffer, offset, uring_data, uring_data->io_priority());
@@ -498,7 +575,11 @@ public:
     {
         unsigned char *mem = wr_pool_.alloc();
         if (mem == nullptr) {
+            auto const begin = std::chrono::steady_clock::now();
             mem = poll_uring_while_no_io_buffers_(true);
+            ++records_.nwrite_stalls;
+            records_.total_write_stall +=
+                std::chrono::steady_clock::now() - begin;
         }
         return write_buffer_ptr(
             (std::byte *)mem, detail::write_buffer_deleter(this));
@@ -668,7 +749,7 @@ private:
 using erased_connected_operation_ptr =
     AsyncIO::erased_connected_operation_unique_ptr_type;
 
-static_assert(sizeof(AsyncIO) == 224);
+static_assert(sizeof(AsyncIO) == 240);
 static_assert(alignof(AsyncIO) == 8);
 
 namespace detail
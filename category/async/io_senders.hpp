@@ -399,6 +399,17 @@ public:
         append_ += bytes;
         return ret;
     }
+
+    //! Removes the last `bytes` appended so they won't be written, returning
+    //! where they begin or null if fewer bytes than that have been appended.
+    constexpr std::byte *rewind_buffer_append(size_t bytes) noexcept
+    {
+        if (bytes > written_buffer_bytes()) {
+            return nullptr;
+        }
+        append_ -= bytes;
+        return append_;
+    }
 };
 
 static_assert(sizeof(write_single_buffer_sender) == 48);
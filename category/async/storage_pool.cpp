@@ -24,6 +24,7 @@
 
 #include <algorithm>
 #include <atomic>
+#include <bit>
 #include <cassert>
 #include <cerrno>
 #include <cstddef>
@@ -122,6 +123,52 @@ std::pair<file_offset_t, file_offset_t> storage_pool::device::capacity() const
     }
 }
 
+uint32_t storage_pool::device::optimal_io_size() const
+{
+    static constexpr uint32_t max_io_size = 64 * 1024;
+    auto const normalise = [](uint64_t v) -> uint32_t {
+        if (v == 0 || !std::has_single_bit(v)) {
+            return 0;
+        }
+        return static_cast<uint32_t>(
+            std::clamp(v, uint64_t(DISK_PAGE_SIZE), uint64_t(max_io_size)));
+    };
+    switch (type_) {
+    case device::type_t_::file: {
+        struct stat stat;
+        MONAD_ASSERT_PRINTF(
+            -1 != ::fstat(readwritefd_, &stat),
+            "failed due to %s",
+            std::strerror(errno));
+        if (auto const ret = normalise(uint64_t(stat.st_blksize)); ret != 0) {
+            return ret;
+        }
+        return DISK_PAGE_SIZE;
+    }
+    case device::type_t_::block_device: {
+        // Prefer the optimal i/o size, which is frequently not reported, then
+        // the physical sector size
+        unsigned int size = 0;
+        if (!ioctl(readwritefd_, _IO(0x12, 121) /*BLKIOOPT*/, &size)) {
+            if (auto const ret = normalise(size); ret != 0) {
+                return ret;
+            }
+        }
+        size = 0;
+        if (!ioctl(readwritefd_, _IO(0x12, 123) /*BLKPBSZGET*/, &size)) {
+            if (auto const ret = normalise(size); ret != 0) {
+                return ret;
+            }
+        }
+        return DISK_PAGE_SIZE;
+    }
+    case device::type_t_::zoned_device:
+        MONAD_ABORT("zonefs support isn't implemented yet");
+    default:
+        MONAD_ABORT();
+    }
+}
+
 /***************************************************************************/
 
 storage_pool::chunk::chunk::~chunk()
@@ -669,6 +716,7 @@ storage_pool::storage_pool(storage_pool const *src, clone_as_read_only_tag_)
             }
             MONAD_ABORT();
         }());
+        devices_.back().tier_ = src_device.tier_;
     }
     fill_chunks_(flags);
 }
@@ -792,6 +840,20 @@ storage_pool::~storage_pool()
     devices_.clear();
 }
 
+bool storage_pool::is_tiered() const noexcept
+{
+    bool have_low_latency = false, have_other = false;
+    for (auto const &device : devices_) {
+        if (device.tier_ == device_tier::low_latency) {
+            have_low_latency = true;
+        }
+        else {
+            have_other = true;
+        }
+    }
+    return have_low_latency && have_other;
+}
+
 size_t storage_pool::currently_active_chunks(chunk_type which) const noexcept
 {
     std::unique_lock const g(lock_);
@@ -75,6 +75,17 @@ public:
         seq = 1
     };
 
+    /*! \brief Performance tier of a device. This is runtime placement policy
+    only, it is not persisted into the pool metadata, so the same pool can be
+    reopened with a different tiering without affecting its contents.
+    */
+    enum class device_tier : uint8_t
+    {
+        unspecified = 0,
+        low_latency = 1, // e.g. Optane or a small fast NVMe
+        capacity = 2 // e.g. a large slower SSD
+    };
+
     /*! \brief A source of backing storage for the storage pool.
      */
     class device
@@ -90,6 +101,7 @@ public:
         } type_;
         uint64_t const unique_hash_;
         file_offset_t const size_of_file_;
+        device_tier tier_{device_tier::unspecified};
 
         struct metadata_t
         {
@@ -176,11 +188,20 @@ public:
             return type_ == type_t_::zoned_device;
         }
 
+        //! Returns the performance tier of this device
+        device_tier tier() const noexcept
+        {
+            return tier_;
+        }
+
         //! Returns the number of chunks on this device
         size_t chunks() const;
         //! Returns the capacity of the device, and how much of that is
         //! currently filled with data, in that order.
         std::pair<file_offset_t, file_offset_t> capacity() const;
+        //! Returns the i/o size the device prefers writes to be aligned to,
+        //! a power of two between `DISK_PAGE_SIZE` and 64KiB.
+        uint32_t optimal_io_size() const;
     };
 
     /*! \brief A zone chunk from storage, which is always managed by a shared
@@ -452,6 +473,34 @@ public:
         return {devices_};
     }
 
+    //! \brief Returns the index into `devices()` of a device of this pool
+    size_t device_index(device const &d) const noexcept
+    {
+        MONAD_DEBUG_ASSERT(
+            &d >= devices_.data() && &d < devices_.data() + devices_.size());
+        return static_cast<size_t>(&d - devices_.data());
+    }
+
+    //! \brief Sets the performance tier of a device. Must be done before
+    //! the pool is handed to anything which allocates chunks from it.
+    void set_device_tier(size_t device_idx, device_tier tier) noexcept
+    {
+        MONAD_ASSERT(device_idx < devices_.size());
+        devices_[device_idx].tier_ = tier;
+    }
+
+    //! \brief True if the pool has both a low latency device and at least
+    //! one device which is not low latency, i.e. placement by tier matters
+    bool is_tiered() const noexcept;
+
+    //! \brief Returns the performance tier of the device on which the
+    //! specified chunk lives. Does not need to activate the chunk.
+    device_tier chunk_tier(chunk_type which, uint32_t id) const noexcept
+    {
+        MONAD_DEBUG_ASSERT(id < chunks_[which].size());
+        return chunks_[which][id].device.tier_;
+    }
+
     //! \brief Returns the number of chunks for the specified type
     size_t chunks(chunk_type which) const noexcept
     {
@@ -386,6 +386,73 @@ namespace
         EXPECT_GE(stats.first, 8);
     }
 
+    TEST(StoragePool, device_tiers)
+    {
+        auto create_temp_file =
+            [](file_offset_t length) -> std::filesystem::path {
+            std::filesystem::path ret(
+                working_temporary_directory() /
+                "monad_storage_pool_test_XXXXXX");
+            int const fd = ::mkstemp((char *)ret.native().data());
+            MONAD_ASSERT(fd != -1);
+            MONAD_ASSERT(
+                -1 != ::ftruncate(fd, static_cast<off_t>(length + 16384)));
+            ::close(fd);
+            return ret;
+        };
+        static constexpr file_offset_t BLKSIZE = 256 * 1024 * 1024;
+        std::filesystem::path devs[] = {
+            create_temp_file(6 * BLKSIZE), create_temp_file(12 * BLKSIZE)};
+        auto undevs = monad::make_scope_exit([&]() noexcept {
+            for (auto &p : devs) {
+                std::filesystem::remove(p);
+            }
+        });
+        storage_pool::creation_flags flags;
+        flags.interleave_chunks_evenly = true;
+        storage_pool pool(devs, storage_pool::mode::create_if_needed, flags);
+        EXPECT_FALSE(pool.is_tiered());
+        for (size_t n = 0; n < pool.chunks(storage_pool::seq); n++) {
+            EXPECT_EQ(
+                pool.chunk_tier(storage_pool::seq, static_cast<uint32_t>(n)),
+                storage_pool::device_tier::unspecified);
+        }
+
+        pool.set_device_tier(0, storage_pool::device_tier::low_latency);
+        EXPECT_TRUE(pool.is_tiered());
+        pool.set_device_tier(1, storage_pool::device_tier::capacity);
+        EXPECT_TRUE(pool.is_tiered());
+        size_t low_latency_chunks = 0;
+        for (size_t n = 0; n < pool.chunks(storage_pool::seq); n++) {
+            auto const id = static_cast<uint32_t>(n);
+            auto p = pool.activate_chunk(storage_pool::seq, id);
+            auto const device_idx = pool.device_index(p->device());
+            EXPECT_EQ(
+                pool.chunk_tier(storage_pool::seq, id),
+                pool.devices()[device_idx].tier());
+            if (pool.chunk_tier(storage_pool::seq, id) ==
+                storage_pool::device_tier::low_latency) {
+                EXPECT_EQ(device_idx, 0);
+                low_latency_chunks++;
+            }
+        }
+        // every device holds the same number of cnv chunks
+        auto const cnv_chunks_per_device =
+            pool.chunks(storage_pool::cnv) / pool.devices().size();
+        EXPECT_EQ(
+            low_latency_chunks,
+            pool.devices()[0].chunks() - cnv_chunks_per_device);
+
+        // Tiers are runtime policy, but survive cloning as read only
+        auto pool2 = pool.clone_as_read_only();
+        EXPECT_TRUE(pool2.is_tiered());
+        EXPECT_EQ(
+            pool2.devices()[0].tier(), storage_pool::device_tier::low_latency);
+
+        pool.set_device_tier(1, storage_pool::device_tier::low_latency);
+        EXPECT_FALSE(pool.is_tiered());
+    }
+
     TEST(StoragePool, config_hash_differs)
     {
         auto create_temp_file =
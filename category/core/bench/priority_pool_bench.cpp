@@ -0,0 +1,91 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/fiber/priority_pool.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+int main(int argc, char *const argv[])
+{
+    std::vector<unsigned> thread_counts{8, 32, 96};
+    unsigned seconds = 2;
+    unsigned task_us = 2;
+
+    CLI::App cli(
+        "Benchmark PriorityPool throughput by number of worker threads",
+        "priority_pool_bench");
+    try {
+        cli.add_option(
+            "--threads", thread_counts, "Worker thread counts to run with");
+        cli.add_option("--seconds", seconds, "Duration of each run");
+        cli.add_option(
+            "--task_us", task_us, "Microseconds each task spins for");
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+
+    // Transactions are submitted in index order, each taking a few
+    // microseconds, which is where contention on a shared ready queue shows
+    // on many core hosts.
+    for (unsigned const n_threads : thread_counts) {
+        std::atomic<uint64_t> done{0};
+        uint64_t submitted = 0;
+        auto const task_duration = std::chrono::microseconds(task_us);
+        auto const begin = std::chrono::steady_clock::now();
+        {
+            monad::fiber::PriorityPool ppool(n_threads, n_threads * 4);
+            while (std::chrono::steady_clock::now() - begin <
+                   std::chrono::seconds(seconds)) {
+                for (unsigned n = 0; n < 10000; ++n) {
+                    ppool.submit(submitted++, [&done, task_duration] {
+                        auto const start = std::chrono::steady_clock::now();
+                        while (std::chrono::steady_clock::now() - start <
+                               task_duration) {
+                        }
+                        done.fetch_add(1, std::memory_order_relaxed);
+                    });
+                }
+            }
+        }
+        auto const end = std::chrono::steady_clock::now();
+        if (done.load() != submitted) {
+            std::cerr << "FATAL: " << submitted - done.load()
+                      << " tasks did not run" << std::endl;
+            return 1;
+        }
+        std::cout << "PriorityPool with " << n_threads << " threads executed "
+                  << submitted << " tasks which is "
+                  << 1000000000.0 * double(submitted) /
+                         double(std::chrono::duration_cast<
+                                    std::chrono::nanoseconds>(end - begin)
+                                    .count())
+                  << " tasks/sec." << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,96 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/fiber/config.hpp>
+
+#include <boost/fiber/condition_variable.hpp>
+#include <boost/fiber/mutex.hpp>
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <utility>
+
+MONAD_FIBER_NAMESPACE_BEGIN
+
+/// One shot completion signal between fibers. Unlike
+/// `boost::fibers::promise` it has no heap allocated shared state, so it
+/// can live in an array allocated once and reused by calling `reset` once
+/// nobody waits on it any more. The setter is done with the completion by
+/// the time any waiter returns, so the last waiter may destroy it.
+class Completion final
+{
+    std::atomic<bool> ready_{false};
+    boost::fibers::mutex mutex_{};
+    boost::fibers::condition_variable cv_{};
+    std::exception_ptr exception_{};
+
+    void set(std::exception_ptr e)
+    {
+        std::unique_lock<boost::fibers::mutex> const lock{mutex_};
+        exception_ = std::move(e);
+        ready_.store(true, std::memory_order_release);
+        // notify under the lock, waiters cannot return before it is dropped
+        cv_.notify_all();
+    }
+
+public:
+    Completion() = default;
+
+    Completion(Completion const &) = delete;
+    Completion &operator=(Completion const &) = delete;
+
+    bool is_ready() const noexcept
+    {
+        return ready_.load(std::memory_order_acquire);
+    }
+
+    void set_value()
+    {
+        set(nullptr);
+    }
+
+    void set_exception(std::exception_ptr e)
+    {
+        set(std::move(e));
+    }
+
+    /// Block the calling fiber until set, without rethrowing.
+    void wait()
+    {
+        std::unique_lock<boost::fibers::mutex> lock{mutex_};
+        cv_.wait(lock, [this] { return is_ready(); });
+    }
+
+    /// Wait, then rethrow the exception if one was set.
+    void get()
+    {
+        wait();
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+    /// Only valid once every waiter has returned.
+    void reset() noexcept
+    {
+        ready_.store(false, std::memory_order_relaxed);
+        exception_ = nullptr;
+    }
+};
+
+MONAD_FIBER_NAMESPACE_END
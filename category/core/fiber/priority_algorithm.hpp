@@ -38,12 +38,16 @@ class PriorityAlgorithm final
 
     PriorityQueue &rqueue_;
 
+    // shard of `rqueue_` owned by this thread
+    unsigned shard_;
+
     using lqueue_type = boost::fibers::scheduler::ready_queue_type;
 
     lqueue_type lqueue_{};
 
 public:
-    explicit PriorityAlgorithm(PriorityQueue &, bool prevent_spin = false);
+    PriorityAlgorithm(
+        PriorityQueue &, unsigned shard, bool prevent_spin = false);
 
     PriorityAlgorithm(PriorityAlgorithm const &) = delete;
     PriorityAlgorithm(PriorityAlgorithm &&) = delete;
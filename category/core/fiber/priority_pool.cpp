@@ -31,27 +31,58 @@
 #include <cstdio>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <utility>
 
 #include <pthread.h>
+#include <sched.h>
 
 MONAD_FIBER_NAMESPACE_BEGIN
 
+namespace
+{
+    void pin_worker(cpu_set_t const &cpus, unsigned const worker)
+    {
+        int const n_cpus = CPU_COUNT(&cpus);
+        MONAD_ASSERT(n_cpus > 0);
+        int nth = static_cast<int>(worker % static_cast<unsigned>(n_cpus));
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpus) && nth-- == 0) {
+                cpu_set_t set;
+                CPU_ZERO(&set);
+                CPU_SET(cpu, &set);
+                MONAD_ASSERT(
+                    pthread_setaffinity_np(pthread_self(), sizeof(set), &set) ==
+                    0);
+                return;
+            }
+        }
+    }
+}
+
 PriorityPool::PriorityPool(
-    unsigned const n_threads, unsigned const n_fibers, bool const prevent_spin)
+    unsigned const n_threads, unsigned const n_fibers, bool const prevent_spin,
+    cpu_set_t const *const cpus)
+    : queue_{n_threads}
 {
     MONAD_ASSERT(n_threads);
     MONAD_ASSERT(n_fibers);
 
+    std::optional<cpu_set_t> const pinned_cpus =
+        cpus ? std::make_optional(*cpus) : std::nullopt;
+
     threads_.reserve(n_threads);
     for (unsigned i = n_threads - 1; i > 0; --i) {
-        auto thread = std::thread([this, i, prevent_spin] {
+        auto thread = std::thread([this, i, prevent_spin, pinned_cpus] {
             char name[16];
             std::snprintf(name, 16, "worker %u", i);
             pthread_setname_np(pthread_self(), name);
+            if (pinned_cpus) {
+                pin_worker(*pinned_cpus, i);
+            }
             boost::fibers::use_scheduling_algorithm<PriorityAlgorithm>(
-                queue_, prevent_spin);
+                queue_, i, prevent_spin);
             std::unique_lock<boost::fibers::mutex> lock{mutex_};
             cv_.wait(lock, [this] { return done_; });
         });
@@ -59,10 +90,13 @@ PriorityPool::PriorityPool(
     }
 
     fibers_.reserve(n_fibers);
-    auto thread = std::thread([this, n_fibers, prevent_spin] {
+    auto thread = std::thread([this, n_fibers, prevent_spin, pinned_cpus] {
         pthread_setname_np(pthread_self(), "worker 0");
+        if (pinned_cpus) {
+            pin_worker(*pinned_cpus, 0);
+        }
         boost::fibers::use_scheduling_algorithm<PriorityAlgorithm>(
-            queue_, prevent_spin);
+            queue_, 0u, prevent_spin);
         for (unsigned i = 0; i < n_fibers; ++i) {
             auto *const properties = new PriorityProperties{nullptr};
             boost::fibers::fiber fiber{
@@ -77,6 +111,7 @@ PriorityPool::PriorityPool(
                         properties->set_priority(task.priority);
                         boost::this_fiber::yield();
                         task.task();
+                        properties->set_local(nullptr);
                         properties->set_priority(0);
                     }
                 }};
@@ -27,11 +27,13 @@
 #include <thread>
 #include <utility>
 
+#include <sched.h>
+
 MONAD_FIBER_NAMESPACE_BEGIN
 
 class PriorityPool final
 {
-    PriorityQueue queue_{};
+    PriorityQueue queue_;
 
     bool done_{false};
 
@@ -47,8 +49,13 @@ class PriorityPool final
     std::promise<void> start_{};
 
 public:
+    /// If `cpus` is set, worker thread `i` is pinned to the `i`-th lowest
+    /// numbered cpu in the set, wrapping around. Neighbouring workers, which
+    /// steal from each other first, share a NUMA node when that node's cpus
+    /// are numbered contiguously.
     PriorityPool(
-        unsigned n_threads, unsigned n_fibers, bool prevent_spin = false);
+        unsigned n_threads, unsigned n_fibers, bool prevent_spin = false,
+        cpu_set_t const *cpus = nullptr);
 
     PriorityPool(PriorityPool const &) = delete;
     PriorityPool &operator=(PriorityPool const &) = delete;
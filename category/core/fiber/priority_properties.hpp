@@ -30,6 +30,7 @@ using boost::fibers::fiber_properties;
 class PriorityProperties final : public fiber_properties
 {
     uint64_t priority_ = 0;
+    void *local_ = nullptr;
 
 public:
     explicit PriorityProperties(context *const ctx) noexcept
@@ -48,6 +49,17 @@ public:
 
         notify();
     }
+
+    // Opaque per task pointer, follows the fiber across worker threads
+    [[gnu::always_inline]] void *get_local() const noexcept
+    {
+        return local_;
+    }
+
+    [[gnu::always_inline]] void set_local(void *const local) noexcept
+    {
+        local_ = local;
+    }
 };
 
 MONAD_FIBER_NAMESPACE_END
@@ -15,25 +15,131 @@
 
 #include <category/core/fiber/priority_queue.hpp>
 
+#include <category/core/assert.h>
 #include <category/core/fiber/config.hpp>
+#include <category/core/fiber/priority_properties.hpp>
+#include <category/core/likely.h>
+
+#include <boost/fiber/context.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
 
 MONAD_FIBER_NAMESPACE_BEGIN
 
+namespace
+{
+    // min heap on priority, lower values run first
+    constexpr auto heap_compare = [](auto const &a, auto const &b) {
+        return a.first > b.first;
+    };
+
+    uint64_t get_priority(context const *const ctx)
+    {
+        auto const *const properties =
+            static_cast<PriorityProperties const *>(ctx->get_properties());
+        MONAD_DEBUG_ASSERT(properties);
+        return properties->get_priority();
+    }
+
+    unsigned next_victim(unsigned const n)
+    {
+        // xorshift, only used to spread steal attempts
+        thread_local uint32_t state =
+            static_cast<uint32_t>(std::hash<std::thread::id>{}(
+                std::this_thread::get_id())) |
+            1;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state % n;
+    }
+}
+
+PriorityQueue::PriorityQueue(unsigned const n_shards)
+    : shards_{std::make_unique<Shard[]>(n_shards)}
+    , n_shards_{n_shards}
+{
+    MONAD_ASSERT(n_shards);
+}
+
 bool PriorityQueue::empty() const
 {
-    return queue_.empty();
+    for (unsigned i = 0; i < n_shards_; ++i) {
+        if (shards_[i].top.load(std::memory_order_acquire) != empty_priority) {
+            return false;
+        }
+    }
+    return true;
 }
 
-context *PriorityQueue::pop()
+context *PriorityQueue::try_pop(Shard &shard)
 {
-    context *ctx = nullptr;
-    queue_.try_pop(ctx);
+    if (shard.top.load(std::memory_order_acquire) == empty_priority) {
+        return nullptr;
+    }
+    std::unique_lock const lock{shard.lock};
+    auto &heap = shard.heap;
+    if (heap.empty()) {
+        return nullptr;
+    }
+    std::pop_heap(heap.begin(), heap.end(), heap_compare);
+    context *const ctx = heap.back().second;
+    heap.pop_back();
+    shard.top.store(
+        heap.empty() ? empty_priority : heap.front().first,
+        std::memory_order_release);
     return ctx;
 }
 
-void PriorityQueue::push(context *const ctx)
+context *PriorityQueue::pop(unsigned const shard)
+{
+    MONAD_DEBUG_ASSERT(shard < n_shards_);
+    Shard &home = shards_[shard];
+    if (n_shards_ > 1) {
+        // Sample one other shard and take its front if it should run
+        // before ours, which keeps transactions roughly in index order
+        // across threads without every thread reading every shard.
+        unsigned const victim =
+            (shard + 1 + next_victim(n_shards_ - 1)) % n_shards_;
+        Shard &other = shards_[victim];
+        if (other.top.load(std::memory_order_acquire) <
+            home.top.load(std::memory_order_acquire)) {
+            if (context *const ctx = try_pop(other)) {
+                return ctx;
+            }
+        }
+    }
+    if (context *const ctx = try_pop(home)) {
+        return ctx;
+    }
+    // nearest shards first: +1, -1, +2, -2, ...
+    for (unsigned d = 1; d < n_shards_; ++d) {
+        unsigned const i =
+            d % 2 ? shard + (d + 1) / 2 : shard + n_shards_ - d / 2;
+        if (context *const ctx = try_pop(shards_[i % n_shards_])) {
+            return ctx;
+        }
+    }
+    return nullptr;
+}
+
+void PriorityQueue::push(unsigned const shard, context *const ctx)
 {
-    queue_.push(ctx);
+    MONAD_DEBUG_ASSERT(shard < n_shards_);
+    Shard &home = shards_[shard];
+    uint64_t const priority = get_priority(ctx);
+    std::unique_lock const lock{home.lock};
+    auto &heap = home.heap;
+    heap.emplace_back(priority, ctx);
+    std::push_heap(heap.begin(), heap.end(), heap_compare);
+    home.top.store(heap.front().first, std::memory_order_release);
 }
 
 MONAD_FIBER_NAMESPACE_END
@@ -15,46 +15,62 @@
 
 #pragma once
 
-#include <category/core/assert.h>
 #include <category/core/fiber/config.hpp>
-#include <category/core/fiber/priority_properties.hpp>
-#include <category/core/likely.h>
+#include <category/core/synchronization/spin_lock.hpp>
 
 #include <boost/fiber/context.hpp>
 
-#include <oneapi/tbb/concurrent_priority_queue.h>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
 
 MONAD_FIBER_NAMESPACE_BEGIN
 
 using boost::fibers::context;
 
+/// Ready queue shared by the threads of a `PriorityPool`, sharded into one
+/// priority heap per thread. A thread pushes the fibers it wakes onto its
+/// own shard and pops from it, stealing from the other shards when its own
+/// holds a lower priority than a sampled victim or is empty. Victims are
+/// scanned nearest index first, so with threads pinned to consecutive cpus
+/// a thread steals from its own socket before crossing to the other.
 class PriorityQueue final
 {
-    struct Compare
+    static constexpr uint64_t empty_priority =
+        std::numeric_limits<uint64_t>::max();
+
+    struct alignas(64) Shard
     {
-        static constexpr uint64_t get_priority(context const *const ctx)
-        {
-            auto const *const properties =
-                static_cast<PriorityProperties const *>(ctx->get_properties());
-            MONAD_ASSERT(properties); // TODO debug assert
-            return properties->get_priority();
-        }
-
-        constexpr bool
-        operator()(context const *const ctx1, context const *const ctx2)
-        {
-            return get_priority(ctx1) > get_priority(ctx2);
-        }
+        SpinLock lock{};
+        // priority of the front of the heap, readable without the lock
+        std::atomic<uint64_t> top{empty_priority};
+        std::vector<std::pair<uint64_t, context *>> heap{};
     };
 
-    oneapi::tbb::concurrent_priority_queue<context *, Compare> queue_;
+    std::unique_ptr<Shard[]> shards_;
+    unsigned n_shards_;
+
+    context *try_pop(Shard &);
 
 public:
+    explicit PriorityQueue(unsigned n_shards);
+
+    unsigned shards() const
+    {
+        return n_shards_;
+    }
+
     bool empty() const;
 
-    context *pop();
+    /// Pop the highest priority fiber for the thread owning `shard`,
+    /// stealing from other shards as needed. Returns nullptr if no fiber
+    /// is ready.
+    context *pop(unsigned shard);
 
-    void push(context *);
+    void push(unsigned shard, context *);
 };
 
 MONAD_FIBER_NAMESPACE_END
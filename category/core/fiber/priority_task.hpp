@@ -19,6 +19,8 @@
 
 #include <cstdint>
 #include <functional>
+#include <type_traits>
+#include <utility>
 
 MONAD_FIBER_NAMESPACE_BEGIN
 
@@ -31,4 +33,21 @@ struct PriorityTask
 static_assert(sizeof(PriorityTask) == 40);
 static_assert(alignof(PriorityTask) == 8);
 
+/// Closures up to two pointers in size that are trivially copyable, such as
+/// one capturing a pointer to a preallocated descriptor and an index, are
+/// stored inline by std::function, so submitting them does not allocate.
+template <class F>
+inline constexpr bool is_inline_task_v =
+    sizeof(F) <= 2 * sizeof(void *) && alignof(F) <= alignof(void *) &&
+    std::is_trivially_copyable_v<F>;
+
+template <class F>
+std::function<void()> make_inline_task(F &&f)
+{
+    static_assert(
+        is_inline_task_v<std::decay_t<F>>,
+        "task closure would be heap allocated by std::function");
+    return std::function<void()>{std::forward<F>(f)};
+}
+
 MONAD_FIBER_NAMESPACE_END
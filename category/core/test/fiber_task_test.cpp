@@ -0,0 +1,152 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <gtest/gtest.h>
+
+#include <category/core/fiber/completion.hpp>
+#include <category/core/fiber/priority_pool.hpp>
+#include <category/core/fiber/priority_task.hpp>
+
+#include <category/core/test_util/gtest_signal_stacktrace_printer.hpp> // NOLINT
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+namespace
+{
+    // Allocations made by the calling thread, to measure submission
+    thread_local size_t thread_allocations = 0;
+}
+
+void *operator new(size_t const size)
+{
+    ++thread_allocations;
+    if (void *const p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void *const p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *const p, size_t) noexcept
+{
+    std::free(p);
+}
+
+using namespace monad::fiber;
+
+TEST(Completion, set_before_and_after_wait)
+{
+    struct Chain
+    {
+        std::array<Completion, 65> merged;
+        std::array<unsigned, 64> order{};
+        std::atomic<unsigned> next{0};
+    } chain;
+
+    chain.merged[0].set_value();
+    {
+        PriorityPool pool{4, 64};
+        // submitted in reverse, so most tasks wait on their predecessor
+        for (unsigned i = 64; i-- > 0;) {
+            pool.submit(i, make_inline_task([c = &chain, i] {
+                            c->merged[i].wait();
+                            c->order[i] = c->next.fetch_add(1);
+                            c->merged[i + 1].set_value();
+                        }));
+        }
+        chain.merged[64].wait();
+    }
+    for (unsigned i = 0; i < 64; ++i) {
+        EXPECT_EQ(chain.order[i], i);
+    }
+
+    for (auto &c : chain.merged) {
+        c.reset();
+        EXPECT_FALSE(c.is_ready());
+    }
+}
+
+TEST(Completion, exception)
+{
+    Completion c;
+    c.set_exception(std::make_exception_ptr(std::runtime_error{"failed"}));
+    c.wait();
+    EXPECT_THROW(c.get(), std::runtime_error);
+    c.reset();
+    c.set_value();
+    EXPECT_NO_THROW(c.get());
+}
+
+TEST(PriorityPool, inline_task_submission_allocations)
+{
+    constexpr size_t n_tasks = 10'000;
+
+    struct Descriptor
+    {
+        std::atomic<size_t> done{0};
+        Completion finished;
+    } descriptor;
+
+    std::array<void *, 3> wide{};
+
+    auto const narrow_task = [d = &descriptor, i = uint32_t{0}] {
+        if (d->done.fetch_add(1) + 1 == 2 * n_tasks) {
+            d->finished.set_value();
+        }
+        (void)i;
+    };
+    auto const wide_task = [d = &descriptor, wide] {
+        (void)wide;
+        if (d->done.fetch_add(1) + 1 == 2 * n_tasks) {
+            d->finished.set_value();
+        }
+    };
+    static_assert(is_inline_task_v<decltype(narrow_task)>);
+    static_assert(!is_inline_task_v<decltype(wide_task)>);
+
+    PriorityPool pool{2, 16};
+
+    size_t const before_narrow = thread_allocations;
+    for (size_t i = 0; i < n_tasks; ++i) {
+        pool.submit(i, make_inline_task(narrow_task));
+    }
+    size_t const narrow = thread_allocations - before_narrow;
+
+    size_t const before_wide = thread_allocations;
+    for (size_t i = 0; i < n_tasks; ++i) {
+        pool.submit(i, wide_task);
+    }
+    size_t const wide_allocs = thread_allocations - before_wide;
+
+    descriptor.finished.wait();
+
+    std::cout << "allocations per submitted task: inline closure "
+              << double(narrow) / n_tasks << ", three pointer closure "
+              << double(wide_allocs) / n_tasks << std::endl;
+    EXPECT_EQ(narrow, 0);
+    EXPECT_GE(wide_allocs, n_tasks);
+}
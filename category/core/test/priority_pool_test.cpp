@@ -22,11 +22,14 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iostream>
 #include <thread>
 #include <vector>
 
+#include <sched.h>
+
 /* On Niall's machine, for reference:
 
 PriorityPool executed 700000 ops which is 126020 ops/sec.
@@ -125,3 +128,21 @@ TEST(PriorityPool, benchmark)
         << " times faster than a single CPU core. Hardware concurrency is "
         << std::thread::hardware_concurrency() << std::endl;
 }
+
+TEST(PriorityPool, pinned_workers)
+{
+    cpu_set_t cpus;
+    ASSERT_EQ(sched_getaffinity(0, sizeof(cpus), &cpus), 0);
+
+    std::atomic<unsigned> done{0};
+    {
+        monad::fiber::PriorityPool ppool(4, 16, false, &cpus);
+        for (uint64_t i = 0; i < 1000; ++i) {
+            ppool.submit(i, [&done, &cpus] {
+                EXPECT_TRUE(CPU_ISSET(sched_getcpu(), &cpus));
+                done.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+    }
+    EXPECT_EQ(done.load(), 1000);
+}
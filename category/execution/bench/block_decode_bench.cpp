@@ -0,0 +1,114 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/core/block_view.hpp>
+#include <category/execution/ethereum/core/rlp/block_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/block_view_rlp.hpp>
+#include <category/execution/ethereum/db/block_db.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+    template <class F>
+    std::chrono::nanoseconds time_per_block(
+        std::vector<byte_string> const &encoded, unsigned const iterations,
+        F &&f)
+    {
+        auto const begin = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < iterations; ++i) {
+            for (auto const &block : encoded) {
+                f(byte_string_view{block});
+            }
+        }
+        return (std::chrono::steady_clock::now() - begin) /
+               (iterations * encoded.size());
+    }
+}
+
+int main(int argc, char *const argv[])
+{
+    std::filesystem::path block_dir;
+    unsigned iterations = 100;
+
+    CLI::App cli(
+        "Benchmark owning vs view rlp decoding of blocks",
+        "block_decode_bench");
+    try {
+        cli.add_option(
+               "--block_db",
+               block_dir,
+               "block_db directory, e.g. test/data/blocks/compressed_blocks")
+            ->required();
+        cli.add_option(
+            "--iterations", iterations, "Number of passes over the blocks");
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+
+    // Decompress every block up front, so that only decoding is timed
+    BlockDb const block_db{block_dir};
+    std::vector<byte_string> encoded;
+    for (auto const &entry : std::filesystem::directory_iterator{block_dir}) {
+        if (!entry.is_regular_file()) {
+            continue;
+        }
+        auto const num = std::stoull(entry.path().filename().string());
+        MONAD_ASSERT(block_db.get_encoded(num, encoded.emplace_back()));
+    }
+    MONAD_ASSERT(!encoded.empty());
+
+    auto const owning = time_per_block(encoded, iterations, [](auto enc) {
+        auto const block = rlp::decode_block(enc);
+        MONAD_ASSERT(!block.has_error());
+    });
+    std::vector<std::byte> storage(1 << 20);
+    std::pmr::monotonic_buffer_resource arena{storage.data(), storage.size()};
+    auto const view = time_per_block(encoded, iterations, [&](auto enc) {
+        {
+            auto const block = rlp::decode_block_view(enc, &arena);
+            MONAD_ASSERT(!block.has_error());
+        }
+        arena.release();
+    });
+
+    auto const to_ns = [](auto const d) { return d.count(); };
+    std::cout << "Decoded " << encoded.size() << " blocks x " << iterations
+              << " iterations, time per block:" << std::endl;
+    std::cout << "  owning decode: " << to_ns(owning) << " ns" << std::endl;
+    std::cout << "  view decode:   " << to_ns(view) << " ns" << std::endl;
+    return 0;
+}
@@ -0,0 +1,197 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/core/transaction.hpp>
+#include <category/execution/ethereum/trace/call_frame.hpp>
+#include <category/execution/ethereum/trace/call_tracer.hpp>
+#include <category/execution/ethereum/trace/rlp/call_frame_rlp.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <evmc/evmc.h>
+#include <evmc/evmc.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+    struct Workload
+    {
+        size_t frames_per_transaction;
+        byte_string input;
+        byte_string output;
+    };
+
+    // Replays the tracer callbacks of a transaction which makes a chain of
+    // nested calls, as the evm host would issue them
+    void trace_transaction(CallTracerBase &call_tracer, Workload const &w)
+    {
+        evmc_message msg{
+            .kind = EVMC_CALL,
+            .gas = 1'000'000,
+            .input_data = w.input.data(),
+            .input_size = w.input.size()};
+        evmc::Result res{};
+        res.gas_left = 1'000;
+        res.output_data = w.output.data();
+        res.output_size = w.output.size();
+        for (size_t i = 0; i < w.frames_per_transaction; ++i) {
+            msg.depth = static_cast<int32_t>(i);
+            call_tracer.on_enter(msg);
+        }
+        for (size_t i = 0; i < w.frames_per_transaction; ++i) {
+            call_tracer.on_exit(res);
+        }
+        call_tracer.on_finish(21'000);
+    }
+}
+
+int main(int argc, char *const argv[])
+{
+    size_t num_transactions = 1000;
+    size_t frames_per_transaction = 8;
+    size_t input_size = 100;
+    size_t output_size = 32;
+    unsigned iterations = 20;
+
+    CLI::App cli(
+        "Benchmark the cost of call tracing a block, with tracing off, with "
+        "CallTracer and commit time encoding, and with ArenaCallTracer",
+        "call_trace_bench");
+    try {
+        cli.add_option(
+            "--transactions", num_transactions, "Transactions per block");
+        cli.add_option(
+            "--frames-per-transaction",
+            frames_per_transaction,
+            "Call frames recorded per transaction");
+        cli.add_option(
+            "--input-size", input_size, "Call data size of each frame");
+        cli.add_option(
+            "--output-size", output_size, "Return data size of each frame");
+        cli.add_option("--iterations", iterations, "Number of blocks traced");
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(num_transactions > 0 && frames_per_transaction > 0);
+    MONAD_ASSERT(iterations > 0);
+
+    Workload const w{
+        .frames_per_transaction = frames_per_transaction,
+        .input = byte_string(input_size, 0xab),
+        .output = byte_string(output_size, 0xcd)};
+    std::vector<Transaction> const transactions(
+        num_transactions, Transaction{.gas_limit = 1'000'000});
+
+    using clock = std::chrono::steady_clock;
+    clock::duration noop_elapsed{};
+    clock::duration call_tracer_elapsed{};
+    clock::duration call_tracer_commit_elapsed{};
+    clock::duration arena_elapsed{};
+    clock::duration arena_commit_elapsed{};
+    size_t encoded_size = 0;
+
+    for (unsigned iteration = 0; iteration < iterations; ++iteration) {
+        {
+            auto const begin = clock::now();
+            std::vector<std::unique_ptr<CallTracerBase>> call_tracers;
+            for (size_t i = 0; i < num_transactions; ++i) {
+                call_tracers.emplace_back(std::make_unique<NoopCallTracer>());
+                trace_transaction(*call_tracers.back(), w);
+            }
+            noop_elapsed += clock::now() - begin;
+        }
+        byte_string expected;
+        {
+            auto begin = clock::now();
+            std::vector<std::vector<CallFrame>> call_frames(num_transactions);
+            std::vector<std::unique_ptr<CallTracerBase>> call_tracers;
+            for (size_t i = 0; i < num_transactions; ++i) {
+                call_tracers.emplace_back(std::make_unique<CallTracer>(
+                    transactions[i], call_frames[i]));
+                trace_transaction(*call_tracers.back(), w);
+            }
+            call_tracer_elapsed += clock::now() - begin;
+
+            // what commit used to do with the recorded frames
+            begin = clock::now();
+            std::vector<byte_string> encoded;
+            for (auto const &frames : call_frames) {
+                encoded.emplace_back(rlp::encode_call_frames(frames));
+            }
+            call_tracer_commit_elapsed += clock::now() - begin;
+            expected = encoded.front();
+        }
+        {
+            auto begin = clock::now();
+            std::vector<byte_string> encoded(num_transactions);
+            std::vector<std::unique_ptr<CallTracerBase>> call_tracers;
+            for (size_t i = 0; i < num_transactions; ++i) {
+                call_tracers.emplace_back(std::make_unique<ArenaCallTracer>(
+                    transactions[i], encoded[i]));
+                trace_transaction(*call_tracers.back(), w);
+            }
+            arena_elapsed += clock::now() - begin;
+
+            // commit only takes views of the encodings
+            begin = clock::now();
+            std::vector<byte_string_view> views;
+            for (auto const &frames : encoded) {
+                views.emplace_back(frames);
+                encoded_size += frames.size();
+            }
+            arena_commit_elapsed += clock::now() - begin;
+            MONAD_ASSERT(encoded.front() == expected);
+        }
+    }
+
+    auto const per_block_us = [iterations](clock::duration const d) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d)
+                   .count() /
+               iterations;
+    };
+    std::cout << "Traced " << iterations << " blocks of " << num_transactions
+              << " transactions, " << frames_per_transaction
+              << " frames each (" << encoded_size / iterations
+              << " encoded bytes per block), time per block:" << std::endl;
+    std::cout << "  tracing off:           " << per_block_us(noop_elapsed)
+              << " us" << std::endl;
+    std::cout << "  CallTracer:            "
+              << per_block_us(call_tracer_elapsed) << " us execution + "
+              << per_block_us(call_tracer_commit_elapsed) << " us commit"
+              << std::endl;
+    std::cout << "  ArenaCallTracer:       " << per_block_us(arena_elapsed)
+              << " us execution + " << per_block_us(arena_commit_elapsed)
+              << " us commit" << std::endl;
+    return 0;
+}
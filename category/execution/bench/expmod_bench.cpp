@@ -0,0 +1,148 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/execution/ethereum/precompiles_expmod.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <evmc/hex.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <silkpre/precompile.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+    struct Vector
+    {
+        std::string name;
+        byte_string input;
+    };
+
+    // Reads the go-ethereum precompile test vector format, e.g.
+    // core/vm/testdata/precompiles/modexp_eip2565.json
+    std::vector<Vector> load_vectors(std::filesystem::path const &path)
+    {
+        std::ifstream in{path};
+        MONAD_ASSERT(in.good());
+        std::vector<Vector> vectors;
+        for (auto const &j : nlohmann::json::parse(in)) {
+            auto input = evmc::from_hex(j.at("Input").get<std::string>());
+            MONAD_ASSERT(input.has_value());
+            vectors.push_back(
+                {.name = j.at("Name").get<std::string>(),
+                 .input = std::move(*input)});
+        }
+        return vectors;
+    }
+}
+
+int main(int argc, char *const argv[])
+{
+    std::filesystem::path vectors_path;
+    unsigned iterations = 1000;
+
+    CLI::App cli(
+        "Benchmark the native MODEXP engine against silkpre",
+        "expmod_bench");
+    try {
+        cli.add_option(
+               "--vectors",
+               vectors_path,
+               "Precompile test vectors, e.g. go-ethereum's "
+               "modexp_eip2565.json")
+            ->required()
+            ->check(CLI::ExistingFile);
+        cli.add_option(
+            "--iterations", iterations, "Evaluations of each vector");
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(iterations > 0);
+
+    using clock = std::chrono::steady_clock;
+    auto const per_call_ns = [iterations](clock::duration const d) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d)
+                   .count() /
+               iterations;
+    };
+
+    std::cout << std::left << std::setw(40) << "vector" << std::right
+              << std::setw(14) << "native ns" << std::setw(14)
+              << "silkpre ns" << std::endl;
+    for (auto const &[name, input] : load_vectors(vectors_path)) {
+        auto const expected = [&input] {
+            auto const [output, size] =
+                silkpre_expmod_run(input.data(), input.size());
+            byte_string result{output, size};
+            std::free(output);
+            return result;
+        }();
+
+        auto begin = clock::now();
+        bool native = true;
+        for (unsigned i = 0; i < iterations; ++i) {
+            auto const output = expmod::execute(input);
+            if (!output.has_value()) {
+                native = false;
+                break;
+            }
+            MONAD_ASSERT(*output == expected);
+        }
+        auto const native_elapsed = clock::now() - begin;
+
+        begin = clock::now();
+        for (unsigned i = 0; i < iterations; ++i) {
+            auto const [output, size] =
+                silkpre_expmod_run(input.data(), input.size());
+            std::free(output);
+        }
+        auto const silkpre_elapsed = clock::now() - begin;
+
+        std::cout << std::left << std::setw(40) << name << std::right
+                  << std::setw(14);
+        if (native) {
+            std::cout << per_call_ns(native_elapsed);
+        }
+        else {
+            std::cout << "even modulus";
+        }
+        std::cout << std::setw(14) << per_call_ns(silkpre_elapsed)
+                  << std::endl;
+    }
+    return 0;
+}
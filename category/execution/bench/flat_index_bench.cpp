@@ -0,0 +1,188 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/async/util.hpp>
+#include <category/core/assert.h>
+#include <category/core/bytes.hpp>
+#include <category/core/int.hpp>
+#include <category/execution/ethereum/core/account.hpp>
+#include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/db/flat_state_index.hpp>
+#include <category/execution/ethereum/db/trie_db.hpp>
+#include <category/execution/ethereum/db/util.hpp>
+#include <category/execution/ethereum/state2/state_deltas.hpp>
+#include <category/execution/ethereum/types/incarnation.hpp>
+#include <category/mpt/db.hpp>
+#include <category/mpt/ondisk_db_config.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <intx/intx.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <utility>
+
+#include <unistd.h>
+
+using namespace monad;
+
+namespace
+{
+    Address to_address(uint64_t const n)
+    {
+        Address address{};
+        for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+            address.bytes[sizeof(address.bytes) - 1 - i] =
+                static_cast<uint8_t>((n + 1) >> (8 * i));
+        }
+        return address;
+    }
+
+    bytes32_t to_key(uint64_t const n)
+    {
+        return intx::be::store<bytes32_t>(uint256_t{n} + 1);
+    }
+
+    std::filesystem::path create_db_file(uint64_t const size_gb)
+    {
+        std::filesystem::path path(
+            MONAD_ASYNC_NAMESPACE::working_temporary_directory() /
+            "monad_flat_index_bench_XXXXXX");
+        int const fd = ::mkstemp((char *)path.native().data());
+        MONAD_ASSERT(fd != -1);
+        MONAD_ASSERT(
+            -1 != ::ftruncate(fd, static_cast<off_t>(size_gb << 30)));
+        ::close(fd);
+        return path;
+    }
+
+    // Random storage reads against a freshly opened db, so the trie node
+    // cache starts cold. Returns the mean latency in nanoseconds.
+    uint64_t time_reads(
+        std::filesystem::path const &path, FlatStateIndex *const index,
+        uint64_t const accounts, uint64_t const slots, uint64_t const reads)
+    {
+        OnDiskMachine machine;
+        mpt::Db db{
+            machine,
+            mpt::OnDiskDbConfig{.append = true, .dbname_paths = {path}}};
+        TrieDb tdb{db, index};
+
+        uint64_t state = 0x9e3779b97f4a7c15;
+        bytes32_t sink{};
+        auto const begin = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < reads; ++i) {
+            state = state * 6364136223846793005 + 1442695040888963407;
+            uint64_t const account = (state >> 33) % accounts;
+            uint64_t const slot = (state >> 11) % slots;
+            sink ^= tdb.read_storage(
+                to_address(account), Incarnation{0, 0}, to_key(slot));
+        }
+        auto const elapsed = std::chrono::steady_clock::now() - begin;
+        MONAD_ASSERT(sink != bytes32_t{1}); // keep the reads
+        return static_cast<uint64_t>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       elapsed)
+                       .count()) /
+               reads;
+    }
+}
+
+int main(int argc, char *const argv[])
+{
+    uint64_t accounts = 10'000;
+    uint64_t slots = 100;
+    uint64_t accounts_per_block = 1'000;
+    uint64_t reads = 100'000;
+    uint64_t size_gb = 8;
+
+    CLI::App cli(
+        "Compare cold storage read latency through the state trie and "
+        "through the flat state index",
+        "flat_index_bench");
+    try {
+        cli.add_option("--accounts", accounts, "Number of contracts");
+        cli.add_option("--slots", slots, "Storage slots per contract");
+        cli.add_option(
+            "--accounts-per-block",
+            accounts_per_block,
+            "Contracts written by each committed block");
+        cli.add_option("--reads", reads, "Number of random storage reads");
+        cli.add_option("--size-gb", size_gb, "Size of the temporary db file");
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(accounts > 0 && slots > 0 && accounts_per_block > 0);
+    MONAD_ASSERT(reads > 0);
+
+    auto const path = create_db_file(size_gb);
+    // the index keeps the writes, so it serves every read below
+    FlatStateIndex index{accounts * slots + accounts};
+    {
+        OnDiskMachine machine;
+        mpt::Db db{
+            machine,
+            mpt::OnDiskDbConfig{.append = false, .dbname_paths = {path}}};
+        TrieDb tdb{db, &index};
+        uint64_t block = 0;
+        for (uint64_t first = 0; first < accounts;
+             first += accounts_per_block, ++block) {
+            StateDeltas deltas;
+            for (uint64_t a = first;
+                 a < std::min(accounts, first + accounts_per_block);
+                 ++a) {
+                StateDelta delta{
+                    .account = {std::nullopt, Account{.nonce = 1}},
+                    .storage = {}};
+                for (uint64_t s = 0; s < slots; ++s) {
+                    delta.storage.emplace(
+                        to_key(s), std::make_pair(bytes32_t{}, to_key(a)));
+                }
+                deltas.emplace(to_address(a), std::move(delta));
+            }
+            bytes32_t const block_id{block + 1};
+            tdb.commit(deltas, Code{}, block_id, BlockHeader{.number = block});
+            tdb.finalize(block, block_id);
+            tdb.set_block_and_prefix(block);
+        }
+    }
+
+    uint64_t const trie_ns =
+        time_reads(path, nullptr, accounts, slots, reads);
+    uint64_t const flat_ns = time_reads(path, &index, accounts, slots, reads);
+    std::filesystem::remove(path);
+
+    std::cout << "Read " << reads << " random slots of " << accounts
+              << " contracts with " << slots << " slots each: trie "
+              << trie_ns << " ns, flat index " << flat_ns << " ns per read"
+              << std::endl;
+    return 0;
+}
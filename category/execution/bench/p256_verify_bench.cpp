@@ -0,0 +1,177 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/execution/ethereum/precompiles_p256.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <cryptopp/eccrypto.h>
+#include <cryptopp/ecp.h>
+#include <cryptopp/integer.h>
+#include <cryptopp/nbtheory.h>
+#include <cryptopp/oids.h>
+#include <cryptopp/osrng.h>
+#include <cryptopp/sha.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using namespace monad;
+
+namespace
+{
+    // The generic CryptoPP implementation p256_verify_execute used before
+    // the dedicated engine, kept as the baseline
+    bool verify_cryptopp(byte_string_view const input)
+    {
+        using namespace CryptoPP;
+
+        if (input.size() != p256::INPUT_SIZE) {
+            return false;
+        }
+
+        Integer h(input.data(), 32);
+        Integer r(input.data() + 32, 32);
+        Integer s(input.data() + 64, 32);
+        Integer qx(input.data() + 96, 32);
+        Integer qy(input.data() + 128, 32);
+
+        DL_GroupParameters_EC<ECP> params(ASN1::secp256r1());
+        auto const &ec = params.GetCurve();
+        auto const &n = params.GetSubgroupOrder();
+        auto const p_mod = ec.FieldSize();
+        auto const &G = params.GetSubgroupGenerator();
+
+        if (!(r > Integer::Zero() && r < n) ||
+            !(s > Integer::Zero() && s < n) || !(qx < p_mod) ||
+            !(qy < p_mod) || !ec.VerifyPoint({qx, qy}) ||
+            (qx.IsZero() && qy.IsZero())) {
+            return false;
+        }
+
+        auto const s1 = s.InverseMod(n);
+        auto const u1 = a_times_b_mod_c(h, s1, n);
+        auto const u2 = a_times_b_mod_c(r, s1, n);
+        auto const r_prime =
+            ec.Add(ec.Multiply(u1, G), ec.Multiply(u2, {qx, qy}));
+        return !r_prime.identity && r_prime.x % n == r;
+    }
+
+    // Signs random messages with random keys, producing EIP-7951 inputs
+    std::vector<byte_string> make_inputs(size_t const num_signatures)
+    {
+        using namespace CryptoPP;
+
+        AutoSeededRandomPool rng;
+        std::vector<byte_string> inputs;
+        for (size_t i = 0; i < num_signatures; ++i) {
+            ECDSA<ECP, SHA256>::PrivateKey key;
+            key.Initialize(rng, ASN1::secp256r1());
+            ECDSA<ECP, SHA256>::PublicKey pub;
+            key.MakePublicKey(pub);
+            ECDSA<ECP, SHA256>::Signer signer(key);
+
+            byte_string message(64, 0);
+            rng.GenerateBlock(message.data(), message.size());
+            byte_string input(p256::INPUT_SIZE, 0);
+            SHA256().CalculateDigest(
+                input.data(), message.data(), message.size());
+            // r || s in IEEE P1363 format
+            size_t const sig_size = signer.SignMessage(
+                rng, message.data(), message.size(), input.data() + 32);
+            MONAD_ASSERT(sig_size == 64);
+            pub.GetPublicElement().x.Encode(input.data() + 96, 32);
+            pub.GetPublicElement().y.Encode(input.data() + 128, 32);
+            inputs.emplace_back(std::move(input));
+        }
+        return inputs;
+    }
+}
+
+int main(int argc, char *const argv[])
+{
+    size_t num_signatures = 1000;
+    unsigned iterations = 10;
+
+    CLI::App cli(
+        "Benchmark EIP-7951 P-256 signature verification against the "
+        "generic CryptoPP implementation",
+        "p256_verify_bench");
+    try {
+        cli.add_option(
+            "--signatures", num_signatures, "Distinct signatures verified");
+        cli.add_option(
+            "--iterations", iterations, "Passes over all signatures");
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(num_signatures > 0 && iterations > 0);
+
+    auto const inputs = make_inputs(num_signatures);
+    std::vector<byte_string_view> const views(inputs.begin(), inputs.end());
+
+    // warm up the precomputed generator table, and check both
+    // implementations accept every signature
+    for (auto const &input : views) {
+        MONAD_ASSERT(p256::verify(input));
+        MONAD_ASSERT(verify_cryptopp(input));
+    }
+
+    using clock = std::chrono::steady_clock;
+    clock::duration cryptopp_elapsed{};
+    clock::duration verify_elapsed{};
+    size_t verified = 0;
+
+    for (unsigned iteration = 0; iteration < iterations; ++iteration) {
+        auto begin = clock::now();
+        for (auto const &input : views) {
+            verified += verify_cryptopp(input);
+        }
+        cryptopp_elapsed += clock::now() - begin;
+
+        begin = clock::now();
+        for (auto const &input : views) {
+            verified += p256::verify(input);
+        }
+        verify_elapsed += clock::now() - begin;
+    }
+    MONAD_ASSERT(verified == 2 * iterations * num_signatures);
+
+    auto const per_signature_ns = [&](clock::duration const d) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d)
+                   .count() /
+               static_cast<int64_t>(iterations * num_signatures);
+    };
+    std::cout << "Verified " << num_signatures << " signatures "
+              << iterations << " times, time per signature:" << std::endl;
+    std::cout << "  CryptoPP:     " << per_signature_ns(cryptopp_elapsed)
+              << " ns" << std::endl;
+    std::cout << "  p256::verify: " << per_signature_ns(verify_elapsed) << " ns"
+              << std::endl;
+    return 0;
+}
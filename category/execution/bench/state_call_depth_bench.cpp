@@ -0,0 +1,155 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/bytes.hpp>
+#include <category/core/int.hpp>
+#include <category/execution/ethereum/core/account.hpp>
+#include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/db/trie_db.hpp>
+#include <category/execution/ethereum/db/util.hpp>
+#include <category/execution/ethereum/state2/block_state.hpp>
+#include <category/execution/ethereum/state2/state_deltas.hpp>
+#include <category/execution/ethereum/state3/state.hpp>
+#include <category/execution/ethereum/types/incarnation.hpp>
+#include <category/mpt/db.hpp>
+#include <category/vm/vm.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <evmc/evmc.hpp>
+
+#include <intx/intx.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <optional>
+
+using namespace monad;
+using namespace evmc::literals;
+
+namespace
+{
+    constexpr auto ROUTER = 0x5353535353535353535353535353535353535353_address;
+    constexpr auto CALLEE = 0xbebebebebebebebebebebebebebebebebebebebe_address;
+
+    bytes32_t to_key(uint64_t const n)
+    {
+        return intx::be::store<bytes32_t>(uint256_t{n} + 1);
+    }
+
+    // A call chain `depth` deep into a contract with `dirty_slots` storage
+    // slots already written by the transaction, where every frame writes a
+    // slot and moves some value before returning
+    void call(
+        State &state, unsigned const depth, uint64_t const dirty_slots,
+        bool const revert)
+    {
+        if (depth == 0) {
+            return;
+        }
+        state.push();
+        (void)state.set_storage(
+            ROUTER, to_key(depth % dirty_slots), to_key(depth));
+        state.subtract_from_balance(ROUTER, 1);
+        state.add_to_balance(CALLEE, 1);
+        call(state, depth - 1, dirty_slots, revert);
+        if (revert && depth % 2) {
+            state.pop_reject();
+        }
+        else {
+            state.pop_accept();
+        }
+    }
+}
+
+int main(int argc, char *const argv[])
+{
+    uint64_t dirty_slots = 1000;
+    unsigned depth = 1024;
+    unsigned iterations = 100;
+    bool revert = false;
+
+    CLI::App cli(
+        "Benchmark entering and leaving nested call frames on an account "
+        "with many dirty storage slots",
+        "state_call_depth_bench");
+    try {
+        cli.add_option(
+            "--dirty-slots",
+            dirty_slots,
+            "Storage slots written before the call chain starts");
+        cli.add_option("--depth", depth, "Depth of the call chain");
+        cli.add_option("--iterations", iterations, "Number of call chains");
+        cli.add_flag("--revert", revert, "Revert every other call frame");
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(dirty_slots > 0 && iterations > 0);
+
+    InMemoryMachine machine;
+    mpt::Db db{machine};
+    TrieDb tdb{db};
+    vm::VM vm;
+    tdb.commit(
+        StateDeltas{
+            {ROUTER,
+             StateDelta{
+                 .account =
+                     {std::nullopt,
+                      Account{
+                          .balance =
+                              std::numeric_limits<uint64_t>::max()}}}}},
+        Code{},
+        NULL_HASH_BLAKE3,
+        BlockHeader{});
+    tdb.finalize(0, NULL_HASH_BLAKE3);
+    tdb.set_block_and_prefix(0);
+
+    std::chrono::steady_clock::duration elapsed{};
+    for (unsigned i = 0; i < iterations; ++i) {
+        BlockState bs{tdb, vm};
+        State state{bs, Incarnation{1, 1}};
+        state.push();
+        for (uint64_t slot = 0; slot < dirty_slots; ++slot) {
+            (void)state.set_storage(ROUTER, to_key(slot), to_key(slot));
+        }
+        auto const begin = std::chrono::steady_clock::now();
+        call(state, depth, dirty_slots, revert);
+        elapsed += std::chrono::steady_clock::now() - begin;
+        state.pop_accept();
+    }
+
+    auto const calls = uint64_t{iterations} * depth;
+    std::cout << "Made " << iterations << " call chains " << depth
+              << " deep over " << dirty_slots << " dirty slots: "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(
+                     elapsed)
+                         .count() /
+                     calls
+              << " ns per call" << std::endl;
+    return 0;
+}
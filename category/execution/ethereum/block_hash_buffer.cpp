@@ -189,13 +189,13 @@ bool init_block_hash_buffer_from_blockdb(
     for (uint64_t b = block_number < 256 ? 1 : block_number - 255;
          b <= block_number;
          ++b) {
-        Block block;
-        auto const ok = block_db.get(b, block);
+        BlockHeader header;
+        auto const ok = block_db.get_header(b, header);
         if (!ok) {
             LOG_WARNING("Could not query block {} from blockdb.", b);
             return false;
         }
-        block_hash_buffer.set(b - 1, block.header.parent_hash);
+        block_hash_buffer.set(b - 1, header.parent_hash);
     }
 
     return true;
@@ -14,6 +14,7 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <category/core/blake3.hpp>
+#include <category/core/byte_string.hpp>
 #include <category/core/bytes.hpp>
 #include <category/core/int.hpp>
 #include <category/execution/ethereum/chain/genesis_state.hpp>
@@ -22,7 +23,6 @@
 #include <category/execution/ethereum/core/receipt.hpp>
 #include <category/execution/ethereum/core/transaction.hpp>
 #include <category/execution/ethereum/db/trie_db.hpp>
-#include <category/execution/ethereum/trace/call_frame.hpp>
 
 #include <evmc/evmc.hpp>
 #include <nlohmann/json.hpp>
@@ -52,7 +52,7 @@ void load_genesis_state(GenesisState const &genesis, TrieDb &db)
         NULL_HASH_BLAKE3,
         genesis.header,
         std::vector<Receipt>{},
-        std::vector<std::vector<CallFrame>>{},
+        std::vector<byte_string>{},
         std::vector<Address>{},
         std::vector<Transaction>{},
         std::vector<BlockHeader>{},
@@ -0,0 +1,64 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/byte_string.hpp>
+#include <category/core/config.hpp>
+#include <category/core/int.hpp>
+#include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/core/signature.hpp>
+#include <category/execution/ethereum/core/transaction.hpp>
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+MONAD_NAMESPACE_BEGIN
+
+// Non-owning counterparts of Transaction and Block, decoded by
+// rlp::decode_transaction_view() and rlp::decode_block_view(). Variable length
+// fields reference the encoded buffer, which must outlive the view. List
+// fields hold their validated RLP encoding and are only materialized by
+// rlp::to_transaction() and rlp::to_block().
+
+struct TransactionView
+{
+    SignatureAndChain sc{};
+    uint64_t nonce{};
+    uint256_t max_fee_per_gas{}; // gas_price
+    uint64_t gas_limit{};
+    uint256_t value{};
+    std::optional<Address> to{};
+    TransactionType type{};
+    byte_string_view data{};
+    byte_string_view access_list{}; // encoded, empty for legacy
+    uint256_t max_priority_fee_per_gas{};
+    uint256_t max_fee_per_blob_gas{};
+    byte_string_view blob_versioned_hashes{}; // encoded, eip4844 only
+    byte_string_view authorization_list{}; // encoded, eip7702 only
+};
+
+struct BlockView
+{
+    BlockHeader header{};
+    std::pmr::vector<TransactionView> transactions{};
+    byte_string_view ommers{}; // encoded
+    std::optional<byte_string_view> withdrawals{std::nullopt}; // encoded
+};
+
+MONAD_NAMESPACE_END
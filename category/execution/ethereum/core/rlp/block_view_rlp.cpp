@@ -0,0 +1,343 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/bytes.hpp>
+#include <category/core/int.hpp>
+#include <category/core/likely.h>
+#include <category/core/result.hpp>
+#include <category/core/rlp/config.hpp>
+#include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/core/block_view.hpp>
+#include <category/execution/ethereum/core/rlp/address_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/block_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/block_view_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/bytes_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/int_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/signature_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/transaction_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/withdrawal_rlp.hpp>
+#include <category/execution/ethereum/core/transaction.hpp>
+#include <category/execution/ethereum/core/withdrawal.hpp>
+#include <category/execution/ethereum/rlp/decode.hpp>
+#include <category/execution/ethereum/rlp/decode_error.hpp>
+
+#include <boost/outcome/try.hpp>
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <utility>
+
+MONAD_RLP_NAMESPACE_BEGIN
+
+namespace
+{
+    // Consume one list from `enc` and return its complete encoding
+    Result<byte_string_view> parse_list_encoding(byte_string_view &enc)
+    {
+        auto const begin = enc;
+        BOOST_OUTCOME_TRYV(parse_list_metadata(enc));
+        return begin.substr(0, begin.size() - enc.size());
+    }
+
+    // The validators below accept the same input as decode_access_list(),
+    // decode_authorization_list() etc. but decode into locals only
+
+    Result<byte_string_view> parse_access_list(byte_string_view &enc)
+    {
+        BOOST_OUTCOME_TRY(auto const encoding, parse_list_encoding(enc));
+        byte_string_view list = encoding;
+        BOOST_OUTCOME_TRY(auto payload, parse_list_metadata(list));
+        while (payload.size() > 0) {
+            BOOST_OUTCOME_TRY(auto entry, parse_list_metadata(payload));
+            BOOST_OUTCOME_TRYV(decode_address(entry));
+            BOOST_OUTCOME_TRY(auto keys, parse_list_metadata(entry));
+            while (keys.size() > 0) {
+                BOOST_OUTCOME_TRYV(decode_bytes32(keys));
+            }
+            if (MONAD_UNLIKELY(!entry.empty())) {
+                return DecodeError::InputTooLong;
+            }
+        }
+        return encoding;
+    }
+
+    Result<byte_string_view> parse_blob_versioned_hashes(byte_string_view &enc)
+    {
+        BOOST_OUTCOME_TRY(auto const encoding, parse_list_encoding(enc));
+        byte_string_view list = encoding;
+        BOOST_OUTCOME_TRY(auto payload, parse_list_metadata(list));
+        while (payload.size() >= sizeof(bytes32_t)) {
+            BOOST_OUTCOME_TRYV(decode_bytes32(payload));
+        }
+        return encoding;
+    }
+
+    Result<byte_string_view> parse_authorization_list(byte_string_view &enc)
+    {
+        BOOST_OUTCOME_TRY(auto const encoding, parse_list_encoding(enc));
+        byte_string_view list = encoding;
+        BOOST_OUTCOME_TRY(auto payload, parse_list_metadata(list));
+        while (payload.size() > 0) {
+            BOOST_OUTCOME_TRYV(decode_authorization_entry(payload));
+        }
+        return encoding;
+    }
+
+    Result<byte_string_view> parse_ommers(byte_string_view &enc)
+    {
+        BOOST_OUTCOME_TRY(auto const encoding, parse_list_encoding(enc));
+        byte_string_view list = encoding;
+        BOOST_OUTCOME_TRY(auto payload, parse_list_metadata(list));
+        while (payload.size() > 0) {
+            BOOST_OUTCOME_TRYV(decode_block_header(payload));
+        }
+        return encoding;
+    }
+
+    Result<byte_string_view> parse_withdrawals(byte_string_view &enc)
+    {
+        BOOST_OUTCOME_TRY(auto const encoding, parse_list_encoding(enc));
+        byte_string_view list = encoding;
+        BOOST_OUTCOME_TRY(auto payload, parse_list_metadata(list));
+        while (payload.size() > 0) {
+            BOOST_OUTCOME_TRYV(decode_withdrawal(payload));
+        }
+        return encoding;
+    }
+
+    Result<TransactionView>
+    decode_transaction_view_legacy(byte_string_view &enc)
+    {
+        TransactionView txn;
+        BOOST_OUTCOME_TRY(auto payload, parse_list_metadata(enc));
+
+        txn.type = TransactionType::legacy;
+        BOOST_OUTCOME_TRY(txn.nonce, decode_unsigned<uint64_t>(payload));
+        BOOST_OUTCOME_TRY(
+            txn.max_fee_per_gas, decode_unsigned<uint256_t>(payload));
+        BOOST_OUTCOME_TRY(txn.gas_limit, decode_unsigned<uint64_t>(payload));
+        BOOST_OUTCOME_TRY(txn.to, decode_optional_address(payload));
+        BOOST_OUTCOME_TRY(txn.value, decode_unsigned<uint256_t>(payload));
+        BOOST_OUTCOME_TRY(txn.data, decode_string(payload));
+        BOOST_OUTCOME_TRY(txn.sc, decode_sc(payload));
+        BOOST_OUTCOME_TRY(txn.sc.r, decode_unsigned<uint256_t>(payload));
+        BOOST_OUTCOME_TRY(txn.sc.s, decode_unsigned<uint256_t>(payload));
+
+        if (MONAD_UNLIKELY(!payload.empty())) {
+            return DecodeError::InputTooLong;
+        }
+
+        return txn;
+    }
+
+    Result<TransactionView>
+    decode_transaction_view_eip2718(byte_string_view &enc)
+    {
+        TransactionView txn;
+        if (MONAD_UNLIKELY(enc.empty())) {
+            return DecodeError::InputTooShort;
+        }
+        if (MONAD_UNLIKELY(
+                enc[0] >= static_cast<unsigned char>(TransactionType::LAST))) {
+            return DecodeError::InvalidTxnType;
+        }
+        txn.type = static_cast<TransactionType>(enc[0]);
+        enc = enc.substr(1);
+        BOOST_OUTCOME_TRY(auto payload, parse_list_metadata(enc));
+
+        txn.sc.chain_id = uint256_t{};
+        BOOST_OUTCOME_TRY(
+            *txn.sc.chain_id, decode_unsigned<uint256_t>(payload));
+        BOOST_OUTCOME_TRY(txn.nonce, decode_unsigned<uint64_t>(payload));
+
+        if (txn.type == TransactionType::eip1559 ||
+            txn.type == TransactionType::eip4844 ||
+            txn.type == TransactionType::eip7702) {
+            BOOST_OUTCOME_TRY(
+                txn.max_priority_fee_per_gas,
+                decode_unsigned<uint256_t>(payload));
+        }
+
+        BOOST_OUTCOME_TRY(
+            txn.max_fee_per_gas, decode_unsigned<uint256_t>(payload));
+        BOOST_OUTCOME_TRY(txn.gas_limit, decode_unsigned<uint64_t>(payload));
+        BOOST_OUTCOME_TRY(txn.to, decode_optional_address(payload));
+        BOOST_OUTCOME_TRY(txn.value, decode_unsigned<uint256_t>(payload));
+        BOOST_OUTCOME_TRY(txn.data, decode_string(payload));
+        BOOST_OUTCOME_TRY(txn.access_list, parse_access_list(payload));
+
+        if (txn.type == TransactionType::eip4844) {
+            if (!txn.to.has_value()) {
+                return DecodeError::InputTooShort;
+            }
+            BOOST_OUTCOME_TRY(
+                txn.max_fee_per_blob_gas, decode_unsigned<uint256_t>(payload));
+            BOOST_OUTCOME_TRY(
+                txn.blob_versioned_hashes,
+                parse_blob_versioned_hashes(payload));
+        }
+
+        if (txn.type == TransactionType::eip7702) {
+            if (!txn.to.has_value()) {
+                return DecodeError::InputTooShort;
+            }
+            BOOST_OUTCOME_TRY(
+                txn.authorization_list, parse_authorization_list(payload));
+        }
+
+        BOOST_OUTCOME_TRY(txn.sc.y_parity, decode_unsigned<uint8_t>(payload));
+        BOOST_OUTCOME_TRY(txn.sc.r, decode_unsigned<uint256_t>(payload));
+        BOOST_OUTCOME_TRY(txn.sc.s, decode_unsigned<uint256_t>(payload));
+
+        if (MONAD_UNLIKELY(!payload.empty())) {
+            return DecodeError::InputTooLong;
+        }
+
+        return txn;
+    }
+
+    // Number of items in a list payload, to size the transaction array
+    // exactly before decoding into it
+    Result<size_t> count_list_items(byte_string_view payload)
+    {
+        size_t count = 0;
+        while (!payload.empty()) {
+            if (payload[0] >= 0xc0) {
+                BOOST_OUTCOME_TRYV(parse_list_metadata(payload));
+            }
+            else {
+                BOOST_OUTCOME_TRYV(parse_string_metadata(payload));
+            }
+            ++count;
+        }
+        return count;
+    }
+}
+
+Result<TransactionView> decode_transaction_view(byte_string_view &enc)
+{
+    if (MONAD_UNLIKELY(enc.empty())) {
+        return DecodeError::InputTooShort;
+    }
+
+    if (enc[0] >= 0xc0) {
+        return decode_transaction_view_legacy(enc);
+    }
+    else {
+        return decode_transaction_view_eip2718(enc);
+    }
+}
+
+Result<BlockView> decode_block_view(
+    byte_string_view &enc, std::pmr::memory_resource *const resource)
+{
+    BlockView block{
+        .transactions = std::pmr::vector<TransactionView>{resource}};
+    BOOST_OUTCOME_TRY(auto payload, parse_list_metadata(enc));
+
+    BOOST_OUTCOME_TRY(block.header, decode_block_header(payload));
+
+    BOOST_OUTCOME_TRY(auto ls, parse_list_metadata(payload));
+    BOOST_OUTCOME_TRY(auto const num_transactions, count_list_items(ls));
+    block.transactions.reserve(num_transactions);
+    while (!ls.empty()) {
+        if (ls[0] >= 0xc0) {
+            BOOST_OUTCOME_TRY(auto tx, decode_transaction_view_legacy(ls));
+            block.transactions.emplace_back(std::move(tx));
+        }
+        else {
+            BOOST_OUTCOME_TRY(auto str, parse_string_metadata(ls));
+            BOOST_OUTCOME_TRY(auto tx, decode_transaction_view_eip2718(str));
+            block.transactions.emplace_back(std::move(tx));
+        }
+    }
+
+    BOOST_OUTCOME_TRY(block.ommers, parse_ommers(payload));
+
+    if (payload.size() > 0) {
+        BOOST_OUTCOME_TRY(auto withdrawals, parse_withdrawals(payload));
+        block.withdrawals.emplace(withdrawals);
+    }
+
+    if (MONAD_UNLIKELY(!payload.empty())) {
+        return DecodeError::InputTooLong;
+    }
+
+    return block;
+}
+
+Transaction to_transaction(TransactionView const &view)
+{
+    Transaction txn{
+        .sc = view.sc,
+        .nonce = view.nonce,
+        .max_fee_per_gas = view.max_fee_per_gas,
+        .gas_limit = view.gas_limit,
+        .value = view.value,
+        .to = view.to,
+        .type = view.type,
+        .data = byte_string{view.data},
+        .max_priority_fee_per_gas = view.max_priority_fee_per_gas,
+        .max_fee_per_blob_gas = view.max_fee_per_blob_gas};
+    // the encoded lists were validated when the view was decoded
+    if (!view.access_list.empty()) {
+        auto enc = view.access_list;
+        auto access_list = decode_access_list(enc);
+        MONAD_ASSERT(!access_list.has_error());
+        txn.access_list = std::move(access_list.value());
+    }
+    if (!view.blob_versioned_hashes.empty()) {
+        auto enc = view.blob_versioned_hashes;
+        auto payload = parse_list_metadata(enc);
+        MONAD_ASSERT(!payload.has_error());
+        while (payload.value().size() >= sizeof(bytes32_t)) {
+            auto const hash = decode_bytes32(payload.value());
+            MONAD_ASSERT(!hash.has_error());
+            txn.blob_versioned_hashes.emplace_back(hash.value());
+        }
+    }
+    if (!view.authorization_list.empty()) {
+        auto enc = view.authorization_list;
+        auto authorization_list = decode_authorization_list(enc);
+        MONAD_ASSERT(!authorization_list.has_error());
+        txn.authorization_list = std::move(authorization_list.value());
+    }
+    return txn;
+}
+
+Block to_block(BlockView const &view)
+{
+    Block block{.header = view.header};
+    block.transactions.reserve(view.transactions.size());
+    for (auto const &txn : view.transactions) {
+        block.transactions.emplace_back(to_transaction(txn));
+    }
+    auto enc = view.ommers;
+    auto ommers = decode_block_header_vector(enc);
+    MONAD_ASSERT(!ommers.has_error());
+    block.ommers = std::move(ommers.value());
+    if (view.withdrawals.has_value()) {
+        auto enc = view.withdrawals.value();
+        auto withdrawals = decode_withdrawal_list(enc);
+        MONAD_ASSERT(!withdrawals.has_error());
+        block.withdrawals.emplace(std::move(withdrawals.value()));
+    }
+    return block;
+}
+
+MONAD_RLP_NAMESPACE_END
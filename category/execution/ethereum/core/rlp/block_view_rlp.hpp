@@ -0,0 +1,41 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/byte_string.hpp>
+#include <category/core/result.hpp>
+#include <category/core/rlp/config.hpp>
+#include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/core/block_view.hpp>
+#include <category/execution/ethereum/core/transaction.hpp>
+
+#include <memory_resource>
+
+MONAD_RLP_NAMESPACE_BEGIN
+
+// Accepts exactly the encodings decode_transaction() and decode_block()
+// accept, without copying any variable length field. The only storage a
+// block view needs is its transaction array, allocated from `resource` so
+// that callers decoding many blocks can back it with a reusable arena.
+Result<TransactionView> decode_transaction_view(byte_string_view &);
+Result<BlockView> decode_block_view(
+    byte_string_view &,
+    std::pmr::memory_resource * = std::pmr::get_default_resource());
+
+Transaction to_transaction(TransactionView const &);
+Block to_block(BlockView const &);
+
+MONAD_RLP_NAMESPACE_END
@@ -0,0 +1,127 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/byte_string.hpp>
+#include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/core/block_view.hpp>
+#include <category/execution/ethereum/core/rlp/block_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/block_view_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/transaction_rlp.hpp>
+#include <category/execution/ethereum/db/block_db.hpp>
+
+#include <gtest/gtest.h>
+
+#include <test_resource_data.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory_resource>
+#include <string>
+
+using namespace monad;
+
+TEST(Rlp_BlockView, MatchesOwningDecoder)
+{
+    BlockDb const block_db(test_resource::correct_block_data_dir);
+    byte_string encoded;
+    size_t num_blocks = 0;
+    for (auto const &entry : std::filesystem::directory_iterator{
+             test_resource::correct_block_data_dir}) {
+        auto const num = std::stoull(entry.path().filename().string());
+        ASSERT_TRUE(block_db.get_encoded(num, encoded));
+
+        byte_string_view enc{encoded};
+        auto const block = rlp::decode_block(enc);
+        ASSERT_FALSE(block.has_error());
+
+        byte_string_view view_enc{encoded};
+        auto const view = rlp::decode_block_view(view_enc);
+        ASSERT_FALSE(view.has_error());
+        EXPECT_TRUE(view_enc.empty());
+        EXPECT_EQ(rlp::to_block(view.value()), block.value());
+
+        // variable length fields alias the encoded buffer
+        for (auto const &txn : view.value().transactions) {
+            if (!txn.data.empty()) {
+                EXPECT_GE(txn.data.data(), encoded.data());
+                EXPECT_LE(
+                    txn.data.data() + txn.data.size(),
+                    encoded.data() + encoded.size());
+            }
+        }
+        ++num_blocks;
+    }
+    EXPECT_GT(num_blocks, 0);
+}
+
+TEST(Rlp_BlockView, DecodesIntoArena)
+{
+    BlockDb const block_db(test_resource::correct_block_data_dir);
+    byte_string encoded;
+    ASSERT_TRUE(block_db.get_encoded(46'402, encoded));
+
+    // the only allocation a block view makes is its transaction array, so a
+    // fixed arena with no upstream is enough
+    std::array<std::byte, 1 << 16> storage;
+    std::pmr::monotonic_buffer_resource arena{
+        storage.data(), storage.size(), std::pmr::null_memory_resource()};
+    byte_string_view enc{encoded};
+    auto const view = rlp::decode_block_view(enc, &arena);
+    ASSERT_FALSE(view.has_error());
+    EXPECT_EQ(view.value().transactions.get_allocator().resource(), &arena);
+
+    Block block;
+    ASSERT_TRUE(block_db.get(46'402, block));
+    ASSERT_EQ(view.value().transactions.size(), block.transactions.size());
+    for (size_t i = 0; i < block.transactions.size(); ++i) {
+        EXPECT_EQ(
+            rlp::to_transaction(view.value().transactions[i]),
+            block.transactions[i]);
+    }
+}
+
+TEST(Rlp_BlockView, RejectsWhatOwningDecoderRejects)
+{
+    BlockDb const block_db(test_resource::correct_block_data_dir);
+    byte_string encoded;
+    ASSERT_TRUE(block_db.get_encoded(2'730'000, encoded));
+
+    for (size_t const trim : {1ul, 2ul, 33ul, encoded.size() / 2}) {
+        byte_string_view const truncated{
+            encoded.data(), encoded.size() - trim};
+        byte_string_view enc{truncated};
+        byte_string_view view_enc{truncated};
+        EXPECT_EQ(
+            rlp::decode_block(enc).has_error(),
+            rlp::decode_block_view(view_enc).has_error());
+    }
+}
+
+TEST(Rlp_BlockView, Transaction)
+{
+    BlockDb const block_db(test_resource::correct_block_data_dir);
+    Block block;
+    ASSERT_TRUE(block_db.get(2'730'000, block));
+    for (auto const &txn : block.transactions) {
+        auto const encoded = rlp::encode_transaction(txn);
+        byte_string_view enc{encoded};
+        auto const view = rlp::decode_transaction_view(enc);
+        ASSERT_FALSE(view.has_error());
+        EXPECT_TRUE(enc.empty());
+        EXPECT_EQ(rlp::to_transaction(view.value()), txn);
+    }
+}
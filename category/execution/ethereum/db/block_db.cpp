@@ -17,7 +17,9 @@
 #include <category/core/byte_string.hpp>
 #include <category/core/config.hpp>
 #include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/core/block_view.hpp>
 #include <category/execution/ethereum/core/rlp/block_rlp.hpp>
+#include <category/execution/ethereum/core/rlp/block_view_rlp.hpp>
 #include <category/execution/ethereum/db/block_db.hpp>
 
 #include <brotli/decode.h>
@@ -28,17 +30,78 @@
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 
 MONAD_NAMESPACE_BEGIN
 
+namespace
+{
+    // A reused decompression buffer grown past this is released after use,
+    // so one outlier block does not pin its size for the thread's lifetime
+    constexpr size_t MAX_RETAINED_BUFFER_SIZE = 16ul << 20;
+
+    // Stream decompress `in` into the front of `buffer`, doubling it whenever
+    // the decoder runs out of output space. Returns the decompressed size.
+    std::optional<size_t>
+    brotli_decompress(byte_string_view const in, byte_string &buffer)
+    {
+        std::unique_ptr<
+            BrotliDecoderState,
+            decltype(&BrotliDecoderDestroyInstance)> const
+            state{
+                BrotliDecoderCreateInstance(nullptr, nullptr, nullptr),
+                &BrotliDecoderDestroyInstance};
+        MONAD_ASSERT(state);
+        if (buffer.size() < in.size() * 4) {
+            buffer.resize(std::max(in.size() * 4, 1ul << 16));
+        }
+        size_t avail_in = in.size();
+        uint8_t const *next_in = in.data();
+        size_t total_out = 0;
+        while (true) {
+            size_t avail_out = buffer.size() - total_out;
+            uint8_t *next_out = buffer.data() + total_out;
+            auto const result = BrotliDecoderDecompressStream(
+                state.get(),
+                &avail_in,
+                &next_in,
+                &avail_out,
+                &next_out,
+                nullptr);
+            total_out = static_cast<size_t>(next_out - buffer.data());
+            if (result == BROTLI_DECODER_RESULT_SUCCESS) {
+                return total_out;
+            }
+            if (result != BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) {
+                // corrupt, or truncated if more input is needed
+                return std::nullopt;
+            }
+            buffer.resize(buffer.size() * 2);
+        }
+    }
+
+    // Blocks get() and get_header() decode are decompressed into this
+    thread_local byte_string decode_buffer;
+
+    void trim_decode_buffer()
+    {
+        if (decode_buffer.size() > MAX_RETAINED_BUFFER_SIZE) {
+            byte_string{}.swap(decode_buffer);
+        }
+    }
+}
+
 BlockDb::BlockDb(std::filesystem::path const &dir)
     : db_{dir.c_str()}
 {
 }
 
-bool BlockDb::get(uint64_t const num, Block &block) const
+std::optional<std::string> BlockDb::get_compressed(uint64_t const num) const
 {
     auto const key = std::to_string(num);
     auto result = db_.get(key.c_str());
@@ -47,23 +110,59 @@ bool BlockDb::get(uint64_t const num, Block &block) const
         auto const key = folder + '/' + std::to_string(num);
         result = db_.get(key.c_str());
     }
-    if (!result.has_value()) {
+    return result;
+}
+
+std::optional<byte_string_view>
+BlockDb::decompress(uint64_t const num, byte_string &buffer) const
+{
+    auto const compressed = get_compressed(num);
+    if (!compressed.has_value()) {
+        return std::nullopt;
+    }
+    auto const size =
+        brotli_decompress(to_byte_string_view(compressed.value()), buffer);
+    MONAD_ASSERT(size.has_value());
+    return byte_string_view{buffer.data(), size.value()};
+}
+
+bool BlockDb::get(uint64_t const num, Block &block) const
+{
+    auto view = decompress(num, decode_buffer);
+    if (!view.has_value()) {
         return false;
     }
-    auto const view = to_byte_string_view(result.value());
-    size_t brotli_size = std::max(result->size() * 100, 1ul << 20); // TODO
-    byte_string brotli_buffer;
-    brotli_buffer.resize(brotli_size);
-    auto const brotli_result = BrotliDecoderDecompress(
-        view.size(), view.data(), &brotli_size, brotli_buffer.data());
-    brotli_buffer.resize(brotli_size);
-    MONAD_ASSERT(brotli_result == BROTLI_DECODER_RESULT_SUCCESS);
-    byte_string_view view2{brotli_buffer};
+    auto decoded_block = rlp::decode_block(view.value());
+    MONAD_ASSERT(!decoded_block.has_error());
+    MONAD_ASSERT(view.value().size() == 0);
+    block = std::move(decoded_block.value());
+    trim_decode_buffer();
+    return true;
+}
 
-    auto const decoded_block = rlp::decode_block(view2);
+bool BlockDb::get_header(uint64_t const num, BlockHeader &header) const
+{
+    auto view = decompress(num, decode_buffer);
+    if (!view.has_value()) {
+        return false;
+    }
+    // the transaction array is the only allocation of a block view
+    std::pmr::monotonic_buffer_resource arena;
+    auto const decoded_block = rlp::decode_block_view(view.value(), &arena);
     MONAD_ASSERT(!decoded_block.has_error());
-    MONAD_ASSERT(view2.size() == 0);
-    block = decoded_block.value();
+    MONAD_ASSERT(view.value().size() == 0);
+    header = decoded_block.value().header;
+    trim_decode_buffer();
+    return true;
+}
+
+bool BlockDb::get_encoded(uint64_t const num, byte_string &encoded) const
+{
+    auto const view = decompress(num, encoded);
+    if (!view.has_value()) {
+        return false;
+    }
+    encoded.resize(view.value().size());
     return true;
 }
 
@@ -15,20 +15,28 @@
 
 #pragma once
 
+#include <category/core/byte_string.hpp>
 #include <category/core/config.hpp>
 #include <category/execution/ethereum/db/file_db.hpp>
 
 #include <cstdint>
 #include <filesystem>
+#include <optional>
+#include <string>
 
 MONAD_NAMESPACE_BEGIN
 
 struct Block;
+struct BlockHeader;
 
 class BlockDb
 {
     FileDb db_;
 
+    std::optional<std::string> get_compressed(uint64_t) const;
+    std::optional<byte_string_view>
+    decompress(uint64_t, byte_string &buffer) const;
+
 public:
     BlockDb() = delete;
     BlockDb(Block const &) = delete;
@@ -37,6 +45,12 @@ public:
     ~BlockDb() = default;
 
     bool get(uint64_t, Block &) const;
+    // As get(), but only the header is materialized. The rest of the block
+    // is validated by rlp::decode_block_view() without copying it.
+    bool get_header(uint64_t, BlockHeader &) const;
+    // Decompress the RLP encoding of a block into `encoded`, reusing its
+    // storage, e.g. for rlp::decode_block_view()
+    bool get_encoded(uint64_t, byte_string &encoded) const;
 
     void upsert(uint64_t, Block const &) const;
     bool remove(uint64_t) const;
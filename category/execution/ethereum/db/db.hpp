@@ -60,7 +60,7 @@ struct Db
     virtual void commit(
         StateDeltas const &, Code const &, bytes32_t const &block_id,
         BlockHeader const &, std::vector<Receipt> const & = {},
-        std::vector<std::vector<CallFrame>> const & = {},
+        std::vector<byte_string> const & = {},
         std::vector<Address> const & = {},
         std::vector<Transaction> const & = {},
         std::vector<BlockHeader> const &ommers = {},
@@ -70,7 +70,7 @@ struct Db
         std::unique_ptr<StateDeltas> state_deltas, Code const &code,
         bytes32_t const &block_id, BlockHeader const &header,
         std::vector<Receipt> const &receipts = {},
-        std::vector<std::vector<CallFrame>> const &call_frames = {},
+        std::vector<byte_string> const &call_frames = {},
         std::vector<Address> const &senders = {},
         std::vector<Transaction> const &transactions = {},
         std::vector<BlockHeader> const &ommers = {},
@@ -154,9 +154,8 @@ public:
     virtual void commit(
         StateDeltas const &, Code const &, bytes32_t const &,
         BlockHeader const &, std::vector<Receipt> const &,
-        std::vector<std::vector<CallFrame>> const &,
-        std::vector<Address> const &, std::vector<Transaction> const &,
-        std::vector<BlockHeader> const &,
+        std::vector<byte_string> const &, std::vector<Address> const &,
+        std::vector<Transaction> const &, std::vector<BlockHeader> const &,
         std::optional<std::vector<Withdrawal>> const &) override
     {
         MONAD_ABORT("Use DbCache commit with unique_ptr arg.");
@@ -166,7 +165,7 @@ public:
         std::unique_ptr<StateDeltas> state_deltas, Code const &code,
         bytes32_t const &block_id, BlockHeader const &header,
         std::vector<Receipt> const &receipts = {},
-        std::vector<std::vector<CallFrame>> const &call_frames = {},
+        std::vector<byte_string> const &call_frames = {},
         std::vector<Address> const &senders = {},
         std::vector<Transaction> const &transactions = {},
         std::vector<BlockHeader> const &ommers = {},
@@ -0,0 +1,255 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/bytes.hpp>
+#include <category/core/config.hpp>
+#include <category/core/keccak.hpp>
+#include <category/core/unordered_map.hpp>
+#include <category/execution/ethereum/core/account.hpp>
+#include <category/execution/ethereum/db/flat_state_index.hpp>
+#include <category/execution/ethereum/state2/state_deltas.hpp>
+#include <category/execution/ethereum/types/incarnation.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <string>
+#include <vector>
+
+MONAD_NAMESPACE_BEGIN
+
+FlatStateIndex::StorageKey::StorageKey(
+    bytes32_t const &account_hash, bytes32_t const &slot_hash,
+    Incarnation const incarnation)
+{
+    uint64_t const inc = incarnation.to_int();
+    memcpy(bytes, account_hash.bytes, sizeof(bytes32_t));
+    memcpy(&bytes[sizeof(bytes32_t)], slot_hash.bytes, sizeof(bytes32_t));
+    memcpy(&bytes[2 * sizeof(bytes32_t)], &inc, sizeof(inc));
+}
+
+bool operator==(
+    FlatStateIndex::StorageKey const &a, FlatStateIndex::StorageKey const &b)
+{
+    return memcmp(a.bytes, b.bytes, sizeof(a.bytes)) == 0;
+}
+
+uint64_t FlatStateIndex::StorageKeyHash::operator()(
+    StorageKey const &key) const noexcept
+{
+    return hash_bytes(key.bytes, sizeof(key.bytes));
+}
+
+FlatStateIndex::FlatStateIndex(size_t const max_entries)
+    : accounts_{max_entries}
+    , storage_{max_entries}
+{
+    MONAD_ASSERT(max_entries > 0);
+}
+
+bool FlatStateIndex::reads_finalized(ReadVersion const rv) const
+{
+    // The ethereum runloop executes block N on top of the proposal of block
+    // N - 1, which by then has been finalized and holds the same state
+    return rv.finalized ||
+           (rv.block_number == version_ && version_block_id_ != bytes32_t{} &&
+            rv.block_id == version_block_id_);
+}
+
+bool FlatStateIndex::covers(ReadVersion const rv) const
+{
+    if (version_ == INVALID_VERSION) {
+        return false;
+    }
+    if (reads_finalized(rv)) {
+        return rv.block_number == version_;
+    }
+    return rv.block_number > version_ && version_ + 1 >= first_known_proposal_;
+}
+
+void FlatStateIndex::clear_entries()
+{
+    accounts_.clear();
+    storage_.clear();
+}
+
+void FlatStateIndex::reset(
+    uint64_t const version, uint64_t const latest_version)
+{
+    clear_entries();
+    pending_.clear();
+    pending_accounts_.clear();
+    pending_storage_.clear();
+    version_ = version;
+    version_block_id_ = bytes32_t{};
+    first_known_proposal_ =
+        latest_version == INVALID_VERSION ? 0 : latest_version + 1;
+}
+
+bool FlatStateIndex::find_account(
+    ReadVersion const rv, bytes32_t const &account_hash,
+    std::optional<Account> &account)
+{
+    if (!covers(rv) ||
+        (!reads_finalized(rv) && pending_accounts_.contains(account_hash))) {
+        return false;
+    }
+    AccountIndex::ConstAccessor acc{};
+    if (!accounts_.find(acc, account_hash)) {
+        n_miss_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    n_hit_.fetch_add(1, std::memory_order_relaxed);
+    account = acc->second.value_;
+    return true;
+}
+
+void FlatStateIndex::insert_account(
+    ReadVersion const rv, bytes32_t const &account_hash,
+    std::optional<Account> const &account)
+{
+    if (!covers(rv) ||
+        (!reads_finalized(rv) && pending_accounts_.contains(account_hash))) {
+        return;
+    }
+    accounts_.insert(account_hash, account);
+}
+
+bool FlatStateIndex::find_storage(
+    ReadVersion const rv, StorageKey const &key, bytes32_t &value)
+{
+    if (!covers(rv) ||
+        (!reads_finalized(rv) && pending_storage_.contains(key))) {
+        return false;
+    }
+    StorageIndex::ConstAccessor acc{};
+    if (!storage_.find(acc, key)) {
+        n_miss_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    n_hit_.fetch_add(1, std::memory_order_relaxed);
+    value = acc->second.value_;
+    return true;
+}
+
+void FlatStateIndex::insert_storage(
+    ReadVersion const rv, StorageKey const &key, bytes32_t const &value)
+{
+    if (!covers(rv) ||
+        (!reads_finalized(rv) && pending_storage_.contains(key))) {
+        return;
+    }
+    storage_.insert(key, value);
+}
+
+void FlatStateIndex::commit(
+    uint64_t const block_number, bytes32_t const &block_id,
+    StateDeltas const &state_deltas)
+{
+    // a proposal may be committed again after re-execution
+    std::erase_if(pending_, [&](PendingBlock const &pending) {
+        return pending.block_id == block_id;
+    });
+
+    PendingBlock &pending = pending_.emplace_back(PendingBlock{
+        .block_number = block_number,
+        .block_id = block_id,
+        .accounts = {},
+        .storage = {}});
+    for (auto const &[addr, delta] : state_deltas) {
+        auto const &account = delta.account.second;
+        bytes32_t const account_hash =
+            to_bytes(keccak256({addr.bytes, sizeof(addr.bytes)}));
+        bool storage_written = false;
+        if (account.has_value()) {
+            for (auto const &[key, storage_delta] : delta.storage) {
+                if (storage_delta.first == storage_delta.second) {
+                    continue;
+                }
+                storage_written = true;
+                pending.storage.emplace_back(
+                    StorageKey{
+                        account_hash,
+                        to_bytes(keccak256({key.bytes, sizeof(key.bytes)})),
+                        account->incarnation},
+                    storage_delta.second);
+            }
+        }
+        if (storage_written || delta.account.first != account) {
+            pending.accounts.emplace_back(account_hash, account);
+        }
+    }
+    rebuild_pending_keys();
+}
+
+void FlatStateIndex::finalize(
+    uint64_t const block_number, bytes32_t const &block_id)
+{
+    auto const it =
+        std::ranges::find_if(pending_, [&](PendingBlock const &pending) {
+            return pending.block_number == block_number &&
+                   pending.block_id == block_id;
+        });
+    // Entries are stale if the writes of this block are unknown, or if blocks
+    // were finalized without the index. The writes of this block are valid
+    // in an empty index.
+    if (it == pending_.end() || version_ == INVALID_VERSION ||
+        block_number != version_ + 1) {
+        clear_entries();
+    }
+    if (it != pending_.end()) {
+        for (auto const &[account_hash, account] : it->accounts) {
+            accounts_.insert(account_hash, account);
+        }
+        for (auto const &[key, value] : it->storage) {
+            storage_.insert(key, value);
+        }
+    }
+    version_ = block_number;
+    version_block_id_ = block_id;
+    std::erase_if(pending_, [&](PendingBlock const &pending) {
+        return pending.block_number <= block_number;
+    });
+    rebuild_pending_keys();
+}
+
+void FlatStateIndex::rebuild_pending_keys()
+{
+    pending_accounts_.clear();
+    pending_storage_.clear();
+    for (auto const &pending : pending_) {
+        for (auto const &[account_hash, account] : pending.accounts) {
+            pending_accounts_.insert(account_hash);
+        }
+        for (auto const &[key, value] : pending.storage) {
+            pending_storage_.insert(key);
+        }
+    }
+}
+
+std::string FlatStateIndex::print_stats()
+{
+    std::string const ret = std::format(
+        ",fi={}/{}",
+        n_hit_.exchange(0, std::memory_order_relaxed),
+        n_miss_.exchange(0, std::memory_order_relaxed));
+    return ret;
+}
+
+MONAD_NAMESPACE_END
@@ -0,0 +1,163 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/bytes.hpp>
+#include <category/core/bytes_hash_compare.hpp>
+#include <category/core/config.hpp>
+#include <category/core/lru/lru_cache.hpp>
+#include <category/execution/ethereum/core/account.hpp>
+#include <category/execution/ethereum/state2/state_deltas.hpp>
+#include <category/execution/ethereum/types/incarnation.hpp>
+
+#include <ankerl/unordered_dense.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+MONAD_NAMESPACE_BEGIN
+
+// Flat index of the latest finalized state, keyed like the state trie:
+// keccak(address) maps to the account and keccak(address) || keccak(slot)
+// maps to the storage value. TrieDb looks keys up here before walking the
+// trie, which stays the source of truth for roots and history.
+//
+// The index is maintained from the state deltas of committed proposals,
+// which are applied when their block is finalized, and filled on read
+// misses. It is bounded, so a miss does not mean the key is absent.
+//
+// An entry is valid for reads of the finalized head, including reads of the
+// proposal that was finalized as the head, and for reads of any proposal
+// above it unless a proposal that has not been finalized yet wrote the key.
+// Proposals the index has not seen committed, such as those left in the db
+// by a previous run, disable the latter until they are finalized. Lookups
+// and inserts are thread safe; the remaining methods must not run
+// concurrently with them.
+class FlatStateIndex
+{
+public:
+    struct StorageKey
+    {
+        static constexpr size_t k_bytes =
+            sizeof(bytes32_t) + sizeof(bytes32_t) + sizeof(Incarnation);
+
+        uint8_t bytes[k_bytes];
+
+        StorageKey() = default;
+
+        StorageKey(
+            bytes32_t const &account_hash, bytes32_t const &slot_hash,
+            Incarnation);
+
+        friend bool operator==(StorageKey const &, StorageKey const &);
+    };
+
+    // Version a TrieDb is reading: a block number and whether it reads the
+    // finalized trie or a proposal, and if so which one
+    struct ReadVersion
+    {
+        uint64_t block_number;
+        bool finalized;
+        bytes32_t block_id;
+    };
+
+    static constexpr uint64_t INVALID_VERSION =
+        std::numeric_limits<uint64_t>::max();
+
+private:
+    struct StorageKeyHash
+    {
+        using is_avalanching = void;
+
+        uint64_t operator()(StorageKey const &) const noexcept;
+    };
+
+    struct PendingBlock
+    {
+        uint64_t block_number;
+        bytes32_t block_id;
+        std::vector<std::pair<bytes32_t, std::optional<Account>>> accounts;
+        std::vector<std::pair<StorageKey, bytes32_t>> storage;
+    };
+
+    using AccountIndex = LruCache<
+        bytes32_t, std::optional<Account>, BytesHashCompare<bytes32_t>>;
+    using StorageIndex =
+        LruCache<StorageKey, bytes32_t, BytesHashCompare<StorageKey>>;
+
+    AccountIndex accounts_;
+    StorageIndex storage_;
+    uint64_t version_{INVALID_VERSION};
+    // id of the proposal finalized as version_, if finalized through this
+    // index
+    bytes32_t version_block_id_{};
+    // proposals below this block number may not have been seen
+    uint64_t first_known_proposal_{0};
+    std::vector<PendingBlock> pending_{};
+    ankerl::unordered_dense::set<bytes32_t> pending_accounts_{};
+    ankerl::unordered_dense::set<StorageKey, StorageKeyHash> pending_storage_{};
+
+    std::atomic<uint64_t> n_hit_{0};
+    std::atomic<uint64_t> n_miss_{0};
+
+    bool reads_finalized(ReadVersion) const;
+    bool covers(ReadVersion) const;
+    void clear_entries();
+    void rebuild_pending_keys();
+
+public:
+    explicit FlatStateIndex(size_t max_entries);
+
+    FlatStateIndex(FlatStateIndex const &) = delete;
+    FlatStateIndex &operator=(FlatStateIndex const &) = delete;
+
+    uint64_t version() const
+    {
+        return version_;
+    }
+
+    // Drop every entry and pending proposal, the index then describes the
+    // finalized state at `version` of a db whose latest version, finalized
+    // or not, is `latest_version`
+    void reset(uint64_t version, uint64_t latest_version);
+
+    bool find_account(
+        ReadVersion, bytes32_t const &account_hash, std::optional<Account> &);
+    void insert_account(
+        ReadVersion, bytes32_t const &account_hash,
+        std::optional<Account> const &);
+
+    bool find_storage(ReadVersion, StorageKey const &, bytes32_t &);
+    void insert_storage(ReadVersion, StorageKey const &, bytes32_t const &);
+
+    // Record the writes of a committed proposal
+    void commit(
+        uint64_t block_number, bytes32_t const &block_id, StateDeltas const &);
+
+    // Apply the writes of the finalized proposal and forget the proposals it
+    // supersedes. If its writes were never committed here the index is reset.
+    void finalize(uint64_t block_number, bytes32_t const &block_id);
+
+    std::string print_stats();
+};
+
+MONAD_NAMESPACE_END
@@ -0,0 +1,289 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/bytes.hpp>
+#include <category/core/config.hpp>
+#include <category/core/keccak.hpp>
+#include <category/execution/ethereum/db/storage_filter_index.hpp>
+#include <category/execution/ethereum/state2/state_deltas.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+MONAD_NAMESPACE_BEGIN
+
+StorageFilterIndex::Filter::Filter(size_t const capacity)
+    : words_(
+          std::max<size_t>(
+              1, (capacity * BITS_PER_SLOT + BLOCK_BITS - 1) / BLOCK_BITS) *
+              BLOCK_WORDS,
+          0)
+    , capacity_{capacity}
+{
+}
+
+size_t StorageFilterIndex::Filter::block(bytes32_t const &slot_hash) const
+{
+    uint64_t h;
+    std::memcpy(&h, slot_hash.bytes, sizeof(h));
+    return (h % (words_.size() / BLOCK_WORDS)) * BLOCK_WORDS;
+}
+
+void StorageFilterIndex::Filter::insert(bytes32_t const &slot_hash)
+{
+    uint64_t probes;
+    std::memcpy(&probes, &slot_hash.bytes[8], sizeof(probes));
+    uint64_t *const words = &words_[block(slot_hash)];
+    for (unsigned i = 0; i < PROBES; ++i, probes >>= 9) {
+        words[(probes & 511) / 64] |= uint64_t{1} << (probes % 64);
+    }
+    ++size_;
+}
+
+bool StorageFilterIndex::Filter::may_contain(bytes32_t const &slot_hash) const
+{
+    uint64_t probes;
+    std::memcpy(&probes, &slot_hash.bytes[8], sizeof(probes));
+    uint64_t const *const words = &words_[block(slot_hash)];
+    for (unsigned i = 0; i < PROBES; ++i, probes >>= 9) {
+        if (!(words[(probes & 511) / 64] & (uint64_t{1} << (probes % 64)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+StorageFilterIndex::StorageFilterIndex(
+    size_t const max_accounts, size_t const max_slots,
+    uint32_t const build_threshold)
+    : max_accounts_{max_accounts}
+    , max_slots_{max_slots}
+    , build_threshold_{build_threshold}
+{
+    MONAD_ASSERT(max_accounts > 0);
+    MONAD_ASSERT(max_slots > 0);
+    MONAD_ASSERT(build_threshold > 0);
+}
+
+StorageFilterIndex::Entry const *StorageFilterIndex::find(
+    ReadVersion const rv, bytes32_t const &account_hash) const
+{
+    auto const it = filters_.find(account_hash);
+    if (it == filters_.end()) {
+        return nullptr;
+    }
+    Entry const &entry = it->second;
+    if (rv.finalized ? rv.block_number < entry.version
+                     : rv.block_number <= entry.version) {
+        return nullptr;
+    }
+    return &entry;
+}
+
+void StorageFilterIndex::reset(
+    uint64_t const version, uint64_t const latest_version)
+{
+    filters_.clear();
+    unfilterable_.clear();
+    build_.reset();
+    pending_.clear();
+    {
+        std::lock_guard const lock{candidates_mutex_};
+        candidates_.clear();
+    }
+    version_ = version;
+    first_known_proposal_ =
+        latest_version == INVALID_VERSION ? 0 : latest_version + 1;
+}
+
+bool StorageFilterIndex::may_contain(
+    ReadVersion const rv, bytes32_t const &account_hash,
+    bytes32_t const &slot_hash)
+{
+    Entry const *const entry = find(rv, account_hash);
+    if (entry && !entry->filter.may_contain(slot_hash)) {
+        n_skipped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void StorageFilterIndex::record_miss(
+    ReadVersion const rv, bytes32_t const &account_hash)
+{
+    if (find(rv, account_hash)) {
+        n_false_positive_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (filters_.contains(account_hash) ||
+        unfilterable_.contains(account_hash)) {
+        return;
+    }
+    uint64_t bucket;
+    std::memcpy(&bucket, account_hash.bytes, sizeof(bucket));
+    auto const misses = misses_[bucket % MISS_COUNTERS].fetch_add(
+        1, std::memory_order_relaxed);
+    if (misses + 1 == build_threshold_) {
+        std::lock_guard const lock{candidates_mutex_};
+        candidates_.insert(account_hash);
+    }
+}
+
+void StorageFilterIndex::commit(
+    uint64_t const block_number, bytes32_t const &block_id,
+    StateDeltas const &state_deltas)
+{
+    // a proposal may be committed again after re-execution
+    if (std::ranges::none_of(pending_, [&](Proposal const &pending) {
+            return pending.block_id == block_id;
+        })) {
+        pending_.push_back(
+            Proposal{.block_number = block_number, .block_id = block_id});
+    }
+    if (filters_.empty() && !build_.has_value()) {
+        return;
+    }
+    for (auto const &[addr, delta] : state_deltas) {
+        if (!delta.account.second.has_value() || delta.storage.empty()) {
+            continue;
+        }
+        auto const account_hash =
+            to_bytes(keccak256({addr.bytes, sizeof(addr.bytes)}));
+        auto const for_each_written = [&](auto const &f) {
+            for (auto const &[key, storage_delta] : delta.storage) {
+                if (storage_delta.first != storage_delta.second &&
+                    storage_delta.second != bytes32_t{}) {
+                    f(to_bytes(keccak256({key.bytes, sizeof(key.bytes)})));
+                }
+            }
+        };
+        if (build_.has_value() && build_->account_hash == account_hash) {
+            // ranges already read do not see this write
+            for_each_written([this](bytes32_t const &slot_hash) {
+                build_->slots.push_back(slot_hash);
+            });
+            continue;
+        }
+        auto const it = filters_.find(account_hash);
+        if (it == filters_.end()) {
+            continue;
+        }
+        Filter &filter = it->second.filter;
+        for_each_written([&filter](bytes32_t const &slot_hash) {
+            filter.insert(slot_hash);
+        });
+        // rebuilt with a larger capacity once it misses again
+        if (filter.size() > filter.capacity()) {
+            filters_.erase(it);
+        }
+    }
+}
+
+void StorageFilterIndex::finalize(
+    uint64_t const block_number, bytes32_t const &block_id)
+{
+    bool const known =
+        std::ranges::any_of(pending_, [&](Proposal const &pending) {
+            return pending.block_number == block_number &&
+                   pending.block_id == block_id;
+        });
+    if (!known || version_ == INVALID_VERSION ||
+        block_number != version_ + 1) {
+        filters_.clear();
+        build_.reset();
+    }
+    version_ = block_number;
+    std::erase_if(pending_, [&](Proposal const &pending) {
+        return pending.block_number <= block_number;
+    });
+    // older misses count for less
+    for (auto &misses : misses_) {
+        misses.store(
+            misses.load(std::memory_order_relaxed) / 2,
+            std::memory_order_relaxed);
+    }
+}
+
+StorageFilterIndex::Build *StorageFilterIndex::current_build()
+{
+    if (version_ == INVALID_VERSION || version_ + 1 < first_known_proposal_) {
+        return nullptr;
+    }
+    if (build_.has_value()) {
+        return &*build_;
+    }
+    if (filters_.size() >= max_accounts_) {
+        return nullptr;
+    }
+    std::lock_guard const lock{candidates_mutex_};
+    while (!candidates_.empty()) {
+        bytes32_t const account_hash = *candidates_.begin();
+        candidates_.erase(account_hash);
+        if (!filters_.contains(account_hash) &&
+            !unfilterable_.contains(account_hash)) {
+            build_.emplace(Build{
+                .account_hash = account_hash, .next_range = 0, .slots = {}});
+            return &*build_;
+        }
+    }
+    return nullptr;
+}
+
+void StorageFilterIndex::finish_build()
+{
+    MONAD_ASSERT(build_.has_value());
+    install(build_->account_hash, std::move(build_->slots));
+    build_.reset();
+}
+
+void StorageFilterIndex::install(
+    bytes32_t const &account_hash, std::vector<bytes32_t> slots)
+{
+    std::ranges::sort(slots);
+    auto const [first, last] = std::ranges::unique(slots);
+    slots.erase(first, last);
+    if (slots.size() > max_slots_) {
+        unfilterable_.insert(account_hash);
+        return;
+    }
+    Filter filter{std::max<size_t>(2 * slots.size(), 1024)};
+    for (auto const &slot_hash : slots) {
+        filter.insert(slot_hash);
+    }
+    filters_.insert_or_assign(
+        account_hash, Entry{.filter = std::move(filter), .version = version_});
+    ++n_built_;
+}
+
+std::string StorageFilterIndex::print_stats()
+{
+    std::string const ret = std::format(
+        ",sf={}/{}/{}",
+        n_skipped_.exchange(0, std::memory_order_relaxed),
+        n_false_positive_.exchange(0, std::memory_order_relaxed),
+        std::exchange(n_built_, 0));
+    return ret;
+}
+
+MONAD_NAMESPACE_END
@@ -0,0 +1,212 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/bytes.hpp>
+#include <category/core/config.hpp>
+#include <category/execution/ethereum/db/flat_state_index.hpp>
+#include <category/execution/ethereum/state2/state_deltas.hpp>
+
+#include <ankerl/unordered_dense.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+MONAD_NAMESPACE_BEGIN
+
+// Membership filters over the slot hashes in the storage trie of accounts
+// whose empty slots are read often, such as the `mapping[x] == 0` checks of
+// token contracts. TrieDb answers a read of a slot the filter rules out with
+// zero instead of walking the storage trie down to where the path diverges.
+//
+// A filter is built by traversing the storage trie of an account once reads
+// of absent slots have missed it `build_threshold` times, and then extended
+// with the slots written by every committed proposal. The traversal is spread
+// over finalizations, one range of slot hashes at a time, and the slots
+// written meanwhile are added to the build. Cleared slots are never
+// removed, so a filter only over-approximates the storage of the account.
+//
+// A filter built at finalized version V is valid for reads of any finalized
+// version from V on and of any proposal above V. Filters are only built while
+// every proposal above the finalized head was committed here, and are dropped
+// when a block is finalized whose writes were not. may_contain() and
+// record_miss() are thread safe; the remaining methods must not run
+// concurrently with them.
+class StorageFilterIndex
+{
+public:
+    using ReadVersion = FlatStateIndex::ReadVersion;
+
+    static constexpr uint64_t INVALID_VERSION =
+        FlatStateIndex::INVALID_VERSION;
+    // Each finalization reads ranges of the storage tries being built until
+    // either bound is reached. A range holds the slots whose hash starts with
+    // one byte.
+    static constexpr size_t MAX_BUILD_SLOTS_PER_FINALIZE = 1 << 16;
+    static constexpr unsigned MAX_BUILD_RANGES_PER_FINALIZE = 1024;
+    static constexpr unsigned BUILD_RANGES = 256;
+    static constexpr uint32_t DEFAULT_BUILD_THRESHOLD = 64;
+
+    // Blocked bloom filter: each slot sets bits within one cache line. Slot
+    // hashes are keccak outputs, their bits are used directly as probes.
+    class Filter
+    {
+        static constexpr size_t BLOCK_WORDS = 8;
+        static constexpr size_t BLOCK_BITS = BLOCK_WORDS * 64;
+        static constexpr size_t BITS_PER_SLOT = 10;
+        static constexpr unsigned PROBES = 7;
+
+        std::vector<uint64_t> words_;
+        size_t capacity_;
+        size_t size_{0};
+
+        // offset of the first word of the block of a slot
+        size_t block(bytes32_t const &slot_hash) const;
+
+    public:
+        explicit Filter(size_t capacity);
+
+        size_t capacity() const
+        {
+            return capacity_;
+        }
+
+        size_t size() const
+        {
+            return size_;
+        }
+
+        void insert(bytes32_t const &slot_hash);
+        bool may_contain(bytes32_t const &slot_hash) const;
+    };
+
+    struct Proposal
+    {
+        uint64_t block_number;
+        bytes32_t block_id;
+    };
+
+    // A filter being built over several finalizations
+    struct Build
+    {
+        bytes32_t account_hash;
+        // ranges below this one have been read
+        unsigned next_range;
+        std::vector<bytes32_t> slots;
+    };
+
+private:
+    struct Entry
+    {
+        Filter filter;
+        uint64_t version;
+    };
+
+    static constexpr size_t MISS_COUNTERS = 4096;
+
+    size_t const max_accounts_;
+    size_t const max_slots_;
+    uint32_t const build_threshold_;
+    uint64_t version_{INVALID_VERSION};
+    // proposals below this block number may not have been seen
+    uint64_t first_known_proposal_{0};
+    std::vector<Proposal> pending_{};
+    ankerl::unordered_dense::map<bytes32_t, Entry> filters_{};
+    // accounts with more than max_slots_ slots
+    ankerl::unordered_dense::set<bytes32_t> unfilterable_{};
+    std::optional<Build> build_{};
+
+    // misses of accounts without a filter, bucketed by account hash
+    std::array<std::atomic<uint32_t>, MISS_COUNTERS> misses_{};
+    std::mutex candidates_mutex_{};
+    ankerl::unordered_dense::set<bytes32_t> candidates_{};
+
+    std::atomic<uint64_t> n_skipped_{0};
+    std::atomic<uint64_t> n_false_positive_{0};
+    uint64_t n_built_{0};
+
+    Entry const *find(ReadVersion, bytes32_t const &account_hash) const;
+
+    // Install the filter of an account from the slots of its storage trie.
+    // An account with more than max_slots() slots is not filtered.
+    void install(bytes32_t const &account_hash, std::vector<bytes32_t> slots);
+
+public:
+    StorageFilterIndex(
+        size_t max_accounts, size_t max_slots,
+        uint32_t build_threshold = DEFAULT_BUILD_THRESHOLD);
+
+    StorageFilterIndex(StorageFilterIndex const &) = delete;
+    StorageFilterIndex &operator=(StorageFilterIndex const &) = delete;
+
+    uint64_t version() const
+    {
+        return version_;
+    }
+
+    size_t max_slots() const
+    {
+        return max_slots_;
+    }
+
+    // Proposals above the finalized head, the storage trie of a candidate is
+    // read at each of them and at the finalized head
+    std::vector<Proposal> const &pending() const
+    {
+        return pending_;
+    }
+
+    // Drop every filter and pending proposal, the index then describes the
+    // finalized state at `version` of a db whose latest version, finalized
+    // or not, is `latest_version`
+    void reset(uint64_t version, uint64_t latest_version);
+
+    // False if the slot is definitely absent from the storage of the account
+    bool may_contain(
+        ReadVersion, bytes32_t const &account_hash,
+        bytes32_t const &slot_hash);
+
+    // A read of the trie found no value for a slot of the account
+    void record_miss(ReadVersion, bytes32_t const &account_hash);
+
+    // Record the writes of a committed proposal
+    void commit(
+        uint64_t block_number, bytes32_t const &block_id, StateDeltas const &);
+
+    // Forget the proposals the finalized block supersedes. If its writes were
+    // never committed here every filter is dropped.
+    void finalize(uint64_t block_number, bytes32_t const &block_id);
+
+    // The build in progress, else one started for a candidate account.
+    // Null while a proposal above the finalized head may not have been
+    // committed here. The caller adds the slots of the next range at the
+    // finalized head and at every pending proposal.
+    Build *current_build();
+
+    // Install the filter of the current build, once every range was read or
+    // it has more than max_slots() slots
+    void finish_build();
+
+    std::string print_stats();
+};
+
+MONAD_NAMESPACE_END
@@ -184,3 +184,28 @@ TEST(BlockDb, DecompressBlock2397315)
     BlockDb const block_db_read(test_resource::correct_block_data_dir);
     EXPECT_TRUE(block_db_read.get(block_number, block));
 }
+
+TEST(BlockDb, ReadHeader)
+{
+    BlockDb const block_db(test_resource::correct_block_data_dir);
+    for (uint64_t const block_number :
+         {46'402ul, 2'730'000ul, 2'730'009ul, 14'000'000ul}) {
+        Block block;
+        ASSERT_TRUE(block_db.get(block_number, block));
+        BlockHeader header;
+        ASSERT_TRUE(block_db.get_header(block_number, header));
+        EXPECT_EQ(header, block.header);
+    }
+    BlockHeader header;
+    EXPECT_FALSE(block_db.get_header(3u, header));
+}
+
+TEST(BlockDb, ReadHeaderOfNonDecodeableBlock)
+{
+    BlockHeader header;
+    BlockDb const block_db(test_resource::bad_decode_block_data_dir);
+    EXPECT_EXIT(
+        block_db.get_header(46'402u, header),
+        testing::KilledBySignal(SIGABRT),
+        "");
+}
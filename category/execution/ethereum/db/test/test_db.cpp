@@ -27,6 +27,8 @@
 #include <category/execution/ethereum/core/rlp/int_rlp.hpp>
 #include <category/execution/ethereum/core/rlp/transaction_rlp.hpp>
 #include <category/execution/ethereum/core/transaction.hpp>
+#include <category/execution/ethereum/db/flat_state_index.hpp>
+#include <category/execution/ethereum/db/storage_filter_index.hpp>
 #include <category/execution/ethereum/db/trie_db.hpp>
 #include <category/execution/ethereum/db/util.hpp>
 #include <category/execution/ethereum/execute_block.hpp>
@@ -66,6 +68,7 @@
 #include <memory>
 #include <optional>
 #include <set>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -389,6 +392,323 @@ TEST_F(OnDiskTrieDbFixture, get_proposal_block_ids)
     }
 }
 
+TEST_F(OnDiskTrieDbFixture, flat_index)
+{
+    FlatStateIndex index{1000};
+    TrieDb tdb{db, &index};
+    TrieDb plain{db};
+    Account const acct{.balance = 1, .nonce = 1};
+    Incarnation const inc{0, 0};
+    auto const hash_a = to_bytes(keccak256(ADDR_A.bytes));
+
+    commit_sequential(
+        tdb,
+        StateDeltas{
+            {ADDR_A,
+             StateDelta{
+                 .account = {std::nullopt, acct},
+                 .storage = {{key1, {bytes32_t{}, value1}}}}}},
+        Code{},
+        BlockHeader{.number = 0});
+    EXPECT_EQ(index.version(), 0);
+
+    // finalized writes are served from the index
+    std::optional<Account> indexed;
+    EXPECT_TRUE(index.find_account({0, true, {}}, hash_a, indexed));
+    EXPECT_EQ(indexed, acct);
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key1), value1);
+
+    // reads fill the index, including absent keys
+    FlatStateIndex::StorageKey const slot2{
+        hash_a, to_bytes(keccak256(key2.bytes)), inc};
+    bytes32_t slot_value;
+    EXPECT_FALSE(index.find_storage({0, true, {}}, slot2, slot_value));
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key2), bytes32_t{});
+    EXPECT_TRUE(index.find_storage({0, true, {}}, slot2, slot_value));
+    EXPECT_EQ(slot_value, bytes32_t{});
+
+    // a proposal above the finalized head reads its own writes from the trie
+    bytes32_t const block_id{1};
+    tdb.commit(
+        StateDeltas{
+            {ADDR_A,
+             StateDelta{
+                 .account = {acct, acct},
+                 .storage = {{key1, {value1, value2}}}}}},
+        Code{},
+        block_id,
+        BlockHeader{.number = 1});
+    tdb.set_block_and_prefix(1, block_id);
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key1), value2);
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key2), bytes32_t{});
+    EXPECT_EQ(tdb.read_account(ADDR_A), acct);
+
+    // the finalized head is unaffected by the proposal
+    tdb.set_block_and_prefix(0);
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key1), value1);
+
+    tdb.finalize(1, block_id);
+    tdb.set_block_and_prefix(1);
+    plain.set_block_and_prefix(1);
+    EXPECT_EQ(index.version(), 1);
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key1), value2);
+    EXPECT_EQ(
+        tdb.read_storage(ADDR_A, inc, key1),
+        plain.read_storage(ADDR_A, inc, key1));
+    EXPECT_EQ(tdb.read_account(ADDR_B), std::nullopt);
+    EXPECT_EQ(tdb.state_root(), plain.state_root());
+
+    // a new incarnation does not see storage of the previous one
+    Account const recreated{.nonce = 1, .incarnation = Incarnation{2, 1}};
+    commit_sequential(
+        tdb,
+        StateDeltas{
+            {ADDR_A,
+             StateDelta{
+                 .account = {acct, recreated},
+                 .storage = {{key2, {bytes32_t{}, value1}}}}}},
+        Code{},
+        BlockHeader{.number = 2});
+    EXPECT_EQ(
+        tdb.read_storage(ADDR_A, recreated.incarnation, key1), bytes32_t{});
+    EXPECT_EQ(tdb.read_storage(ADDR_A, recreated.incarnation, key2), value1);
+}
+
+TEST_F(OnDiskTrieDbFixture, flat_index_runloop_reads)
+{
+    // The ethereum runloop executes block n on top of the proposal of block
+    // n - 1, which it has already finalized
+    FlatStateIndex index{1000};
+    TrieDb tdb{db, &index};
+    Account const acct{.balance = 1, .nonce = 1};
+    Incarnation const inc{0, 0};
+    auto const hash_a = to_bytes(keccak256(ADDR_A.bytes));
+    FlatStateIndex::StorageKey const slot1{
+        hash_a, to_bytes(keccak256(key1.bytes)), inc};
+
+    bytes32_t parent_id = commit_sequential(
+        tdb,
+        StateDeltas{
+            {ADDR_A,
+             StateDelta{
+                 .account = {std::nullopt, acct},
+                 .storage = {{key1, {bytes32_t{}, value1}}}}}},
+        Code{},
+        BlockHeader{.number = 0});
+    bytes32_t value = value1;
+    for (uint64_t n = 1; n < 4; ++n) {
+        tdb.set_block_and_prefix(n - 1, parent_id);
+        bytes32_t indexed;
+        EXPECT_TRUE(
+            index.find_storage({n - 1, false, parent_id}, slot1, indexed));
+        EXPECT_EQ(indexed, value);
+        EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key1), value);
+
+        bytes32_t const next = value == value1 ? value2 : value1;
+        bytes32_t const block_id{n};
+        tdb.commit(
+            StateDeltas{
+                {ADDR_A,
+                 StateDelta{
+                     .account = {acct, acct},
+                     .storage = {{key1, {value, next}}}}}},
+            Code{},
+            block_id,
+            BlockHeader{.number = n});
+        tdb.finalize(n, block_id);
+        EXPECT_EQ(index.version(), n);
+        value = next;
+        parent_id = block_id;
+    }
+
+    // a sibling of the finalized head is not served from the index
+    tdb.set_block_and_prefix(2, bytes32_t{2});
+    bytes32_t const sibling_id{33};
+    bytes32_t const sibling_value{0x51b1};
+    tdb.commit(
+        StateDeltas{
+            {ADDR_A,
+             StateDelta{
+                 .account = {acct, acct},
+                 .storage = {{key1, {value1, sibling_value}}}}}},
+        Code{},
+        sibling_id,
+        BlockHeader{.number = 3});
+    tdb.set_block_and_prefix(3, sibling_id);
+    bytes32_t indexed;
+    EXPECT_FALSE(index.find_storage({3, false, sibling_id}, slot1, indexed));
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key1), sibling_value);
+    EXPECT_TRUE(index.find_storage({3, false, parent_id}, slot1, indexed));
+    EXPECT_EQ(indexed, value);
+}
+
+TEST_F(OnDiskTrieDbFixture, storage_filters)
+{
+    StorageFilterIndex index{10, 1000, 1};
+    TrieDb tdb{db, nullptr, &index};
+    Account const acct{.balance = 1, .nonce = 1};
+    Incarnation const inc{0, 0};
+    auto const hash_a = to_bytes(keccak256(ADDR_A.bytes));
+    auto const slot1 = to_bytes(keccak256(key1.bytes));
+    auto const slot2 = to_bytes(keccak256(key2.bytes));
+    bytes32_t const key3{3};
+    auto const slot3 = to_bytes(keccak256(key3.bytes));
+
+    commit_sequential(
+        tdb,
+        StateDeltas{
+            {ADDR_A,
+             StateDelta{
+                 .account = {std::nullopt, acct},
+                 .storage = {{key1, {bytes32_t{}, value1}}}}}},
+        Code{},
+        BlockHeader{.number = 0});
+
+    // a miss makes the account a candidate, built when a block is finalized
+    EXPECT_TRUE(index.may_contain({0, true, {}}, hash_a, slot2));
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key2), bytes32_t{});
+    commit_sequential(
+        tdb,
+        StateDeltas{
+            {ADDR_B,
+             StateDelta{.account = {std::nullopt, Account{.nonce = 1}}}}},
+        Code{},
+        BlockHeader{.number = 1});
+    EXPECT_EQ(index.version(), 1);
+    EXPECT_TRUE(index.may_contain({1, true, {}}, hash_a, slot1));
+    EXPECT_FALSE(index.may_contain({1, true, {}}, hash_a, slot2));
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key1), value1);
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key2), bytes32_t{});
+
+    // the filter does not describe versions before it was built
+    EXPECT_TRUE(index.may_contain({0, true, {}}, hash_a, slot2));
+
+    // slots written by a proposal are added when it is committed
+    bytes32_t const block_id{2};
+    EXPECT_FALSE(index.may_contain({2, false, {}}, hash_a, slot3));
+    tdb.commit(
+        StateDeltas{
+            {ADDR_A,
+             StateDelta{
+                 .account = {acct, acct},
+                 .storage = {{key3, {bytes32_t{}, value2}}}}}},
+        Code{},
+        block_id,
+        BlockHeader{.number = 2});
+    tdb.set_block_and_prefix(2, block_id);
+    EXPECT_TRUE(index.may_contain({2, false, {}}, hash_a, slot3));
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key3), value2);
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key2), bytes32_t{});
+
+    tdb.finalize(2, block_id);
+    tdb.set_block_and_prefix(2);
+    EXPECT_EQ(tdb.read_storage(ADDR_A, inc, key3), value2);
+    EXPECT_NE(tdb.print_stats().find(",sf="), std::string::npos);
+
+    // finalizing a block that was never committed here drops the filters
+    bytes32_t const other_id{3};
+    db.copy_trie(2, finalized_nibbles, 3, proposal_prefix(other_id), false);
+    tdb.finalize(3, other_id);
+    EXPECT_TRUE(index.may_contain({3, true, {}}, hash_a, slot2));
+}
+
+TEST(StorageFilterIndex, build_sees_writes_to_ranges_already_read)
+{
+    StorageFilterIndex index{10, 1000, 1};
+    index.reset(0, 0);
+    auto const hash_a = to_bytes(keccak256(ADDR_A.bytes));
+    auto const slot1 = to_bytes(keccak256(key1.bytes));
+    auto const slot2 = to_bytes(keccak256(key2.bytes));
+
+    index.record_miss({0, true, {}}, hash_a);
+    auto *const build = index.current_build();
+    ASSERT_NE(build, nullptr);
+    EXPECT_EQ(build->account_hash, hash_a);
+
+    // the build continues over finalizations, and the range of slot1 was
+    // read before slot1 was written
+    build->next_range = slot1.bytes[0] + 1u;
+    bytes32_t const block_id{1};
+    Account const acct{.nonce = 1};
+    index.commit(
+        1,
+        block_id,
+        StateDeltas{
+            {ADDR_A,
+             StateDelta{
+                 .account = {acct, acct},
+                 .storage = {{key1, {bytes32_t{}, value1}}}}}});
+    index.finalize(1, block_id);
+    EXPECT_EQ(index.current_build(), build);
+
+    index.finish_build();
+    EXPECT_EQ(index.current_build(), nullptr);
+    EXPECT_TRUE(index.may_contain({1, true, {}}, hash_a, slot1));
+    EXPECT_FALSE(index.may_contain({1, true, {}}, hash_a, slot2));
+}
+
+TEST_F(OnDiskTrieDbFixture, generate_proofs)
+{
+    TrieDb tdb{db};
+    Account const acct{.balance = 1, .nonce = 1};
+    bytes32_t const key3{3};
+    Address const addr_c{0xc};
+
+    commit_sequential(
+        tdb,
+        StateDeltas{
+            {ADDR_A,
+             StateDelta{
+                 .account = {std::nullopt, acct},
+                 .storage =
+                     {{key1, {bytes32_t{}, value1}},
+                      {key2, {bytes32_t{}, value2}}}}},
+            {ADDR_B,
+             StateDelta{.account = {std::nullopt, Account{.nonce = 1}}}}},
+        Code{},
+        BlockHeader{.number = 0});
+
+    auto const hash_of = [](byte_string const &rlp) {
+        return to_bytes(keccak256(rlp));
+    };
+
+    std::vector<Address> const addresses{ADDR_A, ADDR_B, addr_c};
+    auto const accounts =
+        generate_account_proofs(db, 0, finalized_nibbles, addresses);
+    ASSERT_TRUE(accounts.has_value());
+    EXPECT_EQ(accounts.value().root, tdb.state_root());
+    EXPECT_EQ(hash_of(accounts.value().nodes[0]), tdb.state_root());
+    ASSERT_EQ(accounts.value().keys.size(), 3);
+    EXPECT_EQ(accounts.value().keys[0].result, mpt::find_result::success);
+    EXPECT_EQ(accounts.value().keys[1].result, mpt::find_result::success);
+    EXPECT_NE(accounts.value().keys[2].result, mpt::find_result::success);
+
+    std::vector<bytes32_t> const slots{key1, key2, key3};
+    auto const storage =
+        generate_storage_proofs(db, 0, finalized_nibbles, ADDR_A, slots);
+    ASSERT_TRUE(storage.has_value());
+    EXPECT_EQ(storage.value().keys[0].result, mpt::find_result::success);
+    EXPECT_EQ(storage.value().keys[1].result, mpt::find_result::success);
+    EXPECT_NE(storage.value().keys[2].result, mpt::find_result::success);
+    // the account leaf commits to the storage root
+    auto const &account_leaf =
+        accounts.value().nodes[accounts.value().keys[0].nodes.back()];
+    EXPECT_NE(
+        account_leaf.find(byte_string_view{
+            storage.value().root.bytes, sizeof(bytes32_t)}),
+        byte_string::npos);
+
+    auto const empty_storage =
+        generate_storage_proofs(db, 0, finalized_nibbles, ADDR_B, slots);
+    ASSERT_TRUE(empty_storage.has_value());
+    EXPECT_EQ(empty_storage.value().root, NULL_ROOT);
+    EXPECT_TRUE(empty_storage.value().nodes.empty());
+
+    EXPECT_FALSE(
+        generate_storage_proofs(db, 0, finalized_nibbles, addr_c, slots)
+            .has_value());
+}
+
 TYPED_TEST(DBTest, ModifyStorageOfAccount)
 {
     Account acct{.balance = 1'000'000, .code_hash = {}, .nonce = 1337};
@@ -564,7 +884,7 @@ TYPED_TEST(DBTest, commit_receipts_transactions)
         keccak256(rlp::encode_transaction(transactions.emplace_back(t3))));
     ASSERT_EQ(receipts.size(), transactions.size());
 
-    std::vector<std::vector<CallFrame>> call_frames;
+    std::vector<byte_string> call_frames;
     call_frames.resize(receipts.size());
     constexpr uint64_t first_block = 1;
     std::vector<Address> senders = recover_senders(transactions);
@@ -782,6 +1102,149 @@ TYPED_TEST(DBTest, to_json)
     }
 }
 
+TYPED_TEST(DBTest, export_state_ndjson)
+{
+    TrieDb tdb{this->db};
+    load_db(tdb, 0);
+    auto const expected = tdb.to_json();
+    uint64_t expected_storage_slots = 0;
+    for (auto const &account : expected) {
+        expected_storage_slots += account["storage"].size();
+    }
+
+    // small chunks, so the threads' chunks interleave
+    for (unsigned const num_threads : {1u, 4u}) {
+        std::string out;
+        auto const stats = tdb.export_state(
+            StateExportFormat::ndjson,
+            [&](byte_string_view const chunk) {
+                EXPECT_EQ(chunk.back(), '\n');
+                out.append(
+                    reinterpret_cast<char const *>(chunk.data()),
+                    chunk.size());
+            },
+            num_threads,
+            64);
+        EXPECT_EQ(stats.accounts, expected.size());
+        EXPECT_EQ(stats.storage_slots, expected_storage_slots);
+        EXPECT_EQ(stats.bytes, out.size());
+
+        // each account precedes its storage slots
+        auto json = nlohmann::json::object();
+        std::istringstream lines{out};
+        for (std::string line; std::getline(lines, line);) {
+            auto record = nlohmann::json::parse(line);
+            auto const key = record["key"].get<std::string>();
+            if (record.contains("account")) {
+                auto const account = record["account"].get<std::string>();
+                ASSERT_TRUE(json.contains(account));
+                json[account]["storage"][key] = {
+                    {"slot", record["slot"]}, {"value", record["value"]}};
+                continue;
+            }
+            record.erase("key");
+            record["storage"] = nlohmann::json::object();
+            json[key] = std::move(record);
+        }
+        EXPECT_EQ(expected, json) << num_threads;
+    }
+}
+
+TYPED_TEST(DBTest, export_state_binary)
+{
+    std::ifstream accounts(test_resource::checkpoint_dir / "accounts");
+    std::ifstream code(test_resource::checkpoint_dir / "code");
+    load_from_binary(this->db, accounts, code);
+    TrieDb tdb{this->db};
+
+    // what load_from_binary() reads back to the same state
+    byte_string exported_accounts;
+    auto const stats = tdb.export_state(
+        StateExportFormat::binary,
+        [&](byte_string_view const chunk) { exported_accounts += chunk; },
+        4,
+        256);
+    EXPECT_GT(stats.accounts, 0u);
+    EXPECT_EQ(stats.bytes, exported_accounts.size());
+    byte_string exported_code;
+    ASSERT_TRUE(for_each_code(
+        this->db,
+        tdb.get_block_number(),
+        [&](bytes32_t const &code_hash, byte_string_view const icode) {
+            uint64_t const size = icode.size();
+            exported_code += to_byte_string_view(code_hash.bytes);
+            exported_code += byte_string_view{
+                reinterpret_cast<unsigned char const *>(&size), sizeof(size)};
+            exported_code += icode;
+        }));
+
+    std::stringstream accounts_in{std::string{
+        reinterpret_cast<char const *>(exported_accounts.data()),
+        exported_accounts.size()}};
+    std::stringstream code_in{std::string{
+        reinterpret_cast<char const *>(exported_code.data()),
+        exported_code.size()}};
+    InMemoryMachine machine;
+    mpt::Db db{machine};
+    load_from_binary(db, accounts_in, code_in, 0, 1ul << 20);
+    TrieDb loaded{db};
+    EXPECT_EQ(loaded.state_root(), tdb.state_root());
+    auto const a_icode = loaded.read_code(A_CODE_HASH);
+    EXPECT_EQ(
+        byte_string_view(a_icode->code(), a_icode->size()),
+        byte_string_view(A_ICODE->code(), A_ICODE->size()));
+}
+
+TYPED_TEST(DBTest, export_state_binary_splits_large_account)
+{
+    constexpr size_t chunk_size = 256;
+    constexpr uint64_t num_slots = 1000;
+    StateDelta large{.account = {std::nullopt, Account{.nonce = 1}}};
+    for (uint64_t i = 1; i <= num_slots; ++i) {
+        large.storage.emplace(
+            bytes32_t{i}, StorageDelta{bytes32_t{}, bytes32_t{i * 7}});
+    }
+    TrieDb tdb{this->db};
+    commit_sequential(
+        tdb,
+        StateDeltas{
+            {ADDR_A, std::move(large)},
+            {ADDR_B,
+             StateDelta{
+                 .account = {std::nullopt, Account{.nonce = 2}},
+                 .storage = {{key1, {bytes32_t{}, value1}}}}}},
+        Code{},
+        BlockHeader{});
+
+    for (unsigned const num_threads : {1u, 4u}) {
+        byte_string exported_accounts;
+        auto const stats = tdb.export_state(
+            StateExportFormat::binary,
+            [&](byte_string_view const chunk) {
+                // an account header and a slot past the chunk size at most
+                EXPECT_LT(chunk.size(), chunk_size + 112 + 64);
+                exported_accounts += chunk;
+            },
+            num_threads,
+            chunk_size);
+        EXPECT_EQ(stats.accounts, 2u);
+        EXPECT_EQ(stats.storage_slots, num_slots + 1);
+        ASSERT_GT(exported_accounts.size(), 64 * num_slots);
+
+        // the loader's buffer is smaller than the account, so its batches
+        // are written to the db in several updates
+        std::stringstream accounts_in{std::string{
+            reinterpret_cast<char const *>(exported_accounts.data()),
+            exported_accounts.size()}};
+        std::stringstream code_in;
+        InMemoryMachine machine;
+        mpt::Db db{machine};
+        load_from_binary(db, accounts_in, code_in, 0, 1ul << 14);
+        TrieDb loaded{db};
+        EXPECT_EQ(loaded.state_root(), tdb.state_root()) << num_threads;
+    }
+}
+
 TYPED_TEST(DBTest, load_from_binary)
 {
     std::ifstream accounts(test_resource::checkpoint_dir / "accounts");
@@ -853,9 +1316,9 @@ TYPED_TEST(DBTest, commit_call_frames)
 
     static byte_string const encoded_txn = byte_string{0x1a, 0x1b, 0x1c};
     std::vector<CallFrame> const call_frame{call_frame1, call_frame2};
-    std::vector<std::vector<CallFrame>> call_frames;
+    std::vector<byte_string> call_frames;
     for (uint64_t txn = 0; txn < NUM_TXNS; ++txn) {
-        call_frames.emplace_back(call_frame);
+        call_frames.emplace_back(rlp::encode_call_frames(call_frame));
     }
     std::vector<Receipt> const receipts(call_frames.size());
     // need to increment the nonce of transactions
@@ -948,11 +1411,10 @@ TYPED_TEST(DBTest, call_frames_stress_test)
     }
     auto const recovered_authorities =
         recover_authorities(block.value().transactions, pool);
-    std::vector<std::vector<CallFrame>> call_frames(
-        block.value().transactions.size());
+    std::vector<byte_string> call_frames(block.value().transactions.size());
     std::vector<std::unique_ptr<CallTracerBase>> call_tracers;
     for (size_t i = 0; i < block.value().transactions.size(); ++i) {
-        call_tracers.emplace_back(std::make_unique<CallTracer>(
+        call_tracers.emplace_back(std::make_unique<ArenaCallTracer>(
             block.value().transactions[i], call_frames[i]));
     }
 
@@ -1146,11 +1608,10 @@ TYPED_TEST(DBTest, call_frames_refund)
     }
     auto const recovered_authorities =
         recover_authorities(block.value().transactions, pool);
-    std::vector<std::vector<CallFrame>> call_frames(
-        block.value().transactions.size());
+    std::vector<byte_string> call_frames(block.value().transactions.size());
     std::vector<std::unique_ptr<CallTracerBase>> call_tracers;
     for (size_t i = 0; i < block.value().transactions.size(); ++i) {
-        call_tracers.emplace_back(std::make_unique<CallTracer>(
+        call_tracers.emplace_back(std::make_unique<ArenaCallTracer>(
             block.value().transactions[i], call_frames[i]));
     }
 
@@ -47,6 +47,7 @@
 #include <category/mpt/traverse.hpp>
 #include <category/mpt/update.hpp>
 #include <category/mpt/util.hpp>
+#include <category/vm/intercode_cache.hpp>
 
 #include <evmc/evmc.hpp>
 #include <evmc/hex.hpp>
@@ -59,15 +60,20 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <format>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -93,59 +99,139 @@ namespace
     }
 }
 
-TrieDb::TrieDb(mpt::Db &db)
+TrieDb::TrieDb(
+    mpt::Db &db, FlatStateIndex *const flat_index,
+    StorageFilterIndex *const storage_filters)
     : db_{db}
     , block_number_{db.get_latest_finalized_version() == INVALID_BLOCK_NUM ? 0 : db.get_latest_finalized_version()}
     , proposal_block_id_{bytes32_t{}}
     , prefix_{finalized_nibbles}
+    , flat_index_{flat_index}
+    , storage_filters_{storage_filters}
 {
+    if (flat_index_ || storage_filters_) {
+        // in memory tries commit straight into the finalized state
+        MONAD_ASSERT(db_.is_on_disk());
+    }
+    auto const finalized = db_.get_latest_finalized_version();
+    auto const version = finalized == INVALID_BLOCK_NUM
+                             ? FlatStateIndex::INVALID_VERSION
+                             : finalized;
+    auto const latest_version = [&] {
+        auto const latest = db_.get_latest_version();
+        return latest == INVALID_BLOCK_NUM ? FlatStateIndex::INVALID_VERSION
+                                           : latest;
+    };
+    if (flat_index_ && flat_index_->version() != version) {
+        flat_index_->reset(version, latest_version());
+    }
+    if (storage_filters_ && storage_filters_->version() != version) {
+        storage_filters_->reset(version, latest_version());
+    }
 }
 
 TrieDb::~TrieDb() = default;
 
 std::optional<Account> TrieDb::read_account(Address const &addr)
 {
+    auto const account_hash =
+        to_bytes(keccak256({addr.bytes, sizeof(addr.bytes)}));
+    std::optional<Account> account;
+    if (flat_index_ &&
+        flat_index_->find_account(read_version(), account_hash, account)) {
+        if (account.has_value()) {
+            stats_account_value();
+        }
+        else {
+            stats_account_no_value();
+        }
+        return account;
+    }
     auto const value = db_.get(
         concat(
             prefix_,
             STATE_NIBBLE,
-            NibblesView{keccak256({addr.bytes, sizeof(addr.bytes)})}),
+            NibblesView{to_byte_string_view(account_hash.bytes)}),
         block_number_);
-    if (!value.has_value()) {
+    if (value.has_value()) {
+        stats_account_value();
+        auto encoded_account = value.value();
+        auto const acct = decode_account_db_ignore_address(encoded_account);
+        MONAD_DEBUG_ASSERT(!acct.has_error());
+        account = acct.value();
+    }
+    else {
         stats_account_no_value();
-        return std::nullopt;
     }
-    stats_account_value();
-
-    auto encoded_account = value.value();
-    auto const acct = decode_account_db_ignore_address(encoded_account);
-    MONAD_DEBUG_ASSERT(!acct.has_error());
-    return acct.value();
+    if (flat_index_) {
+        flat_index_->insert_account(read_version(), account_hash, account);
+    }
+    return account;
 }
 
-bytes32_t
-TrieDb::read_storage(Address const &addr, Incarnation, bytes32_t const &key)
+bytes32_t TrieDb::read_storage(
+    Address const &addr, Incarnation const incarnation, bytes32_t const &key)
 {
+    auto const account_hash =
+        to_bytes(keccak256({addr.bytes, sizeof(addr.bytes)}));
+    auto const slot_hash = to_bytes(keccak256({key.bytes, sizeof(key.bytes)}));
+    FlatStateIndex::StorageKey const index_key{
+        account_hash, slot_hash, incarnation};
+    bytes32_t result{};
+    if (flat_index_ &&
+        flat_index_->find_storage(read_version(), index_key, result)) {
+        if (result == bytes32_t{}) {
+            stats_storage_no_value();
+        }
+        else {
+            stats_storage_value();
+        }
+        return result;
+    }
+    if (storage_filters_ &&
+        !storage_filters_->may_contain(
+            read_version(), account_hash, slot_hash)) {
+        stats_storage_no_value();
+        if (flat_index_) {
+            flat_index_->insert_storage(read_version(), index_key, result);
+        }
+        return result;
+    }
     auto const value = db_.get(
         concat(
             prefix_,
             STATE_NIBBLE,
-            NibblesView{keccak256({addr.bytes, sizeof(addr.bytes)})},
-            NibblesView{keccak256({key.bytes, sizeof(key.bytes)})}),
+            NibblesView{to_byte_string_view(account_hash.bytes)},
+            NibblesView{to_byte_string_view(slot_hash.bytes)}),
         block_number_);
-    if (!value.has_value()) {
+    if (value.has_value()) {
+        stats_storage_value();
+        auto encoded_storage = value.value();
+        auto const storage = decode_storage_db_ignore_slot(encoded_storage);
+        MONAD_ASSERT(!storage.has_error());
+        result = to_bytes(storage.value());
+    }
+    else {
         stats_storage_no_value();
-        return {};
+        if (storage_filters_) {
+            storage_filters_->record_miss(read_version(), account_hash);
+        }
+    }
+    if (flat_index_) {
+        flat_index_->insert_storage(read_version(), index_key, result);
     }
-    stats_storage_value();
-    auto encoded_storage = value.value();
-    auto const storage = decode_storage_db_ignore_slot(encoded_storage);
-    MONAD_ASSERT(!storage.has_error());
-    return to_bytes(storage.value());
+    return result;
 };
 
 vm::SharedIntercode TrieDb::read_code(bytes32_t const &code_hash)
 {
+    // code is content addressed, so analysis shared by any version is valid
+    auto *const cache = vm::get_intercode_cache();
+    if (cache) {
+        if (auto icode = cache->find(code_hash)) {
+            return icode;
+        }
+    }
     // TODO read intercode object
     auto const value = db_.get(
         concat(
@@ -156,6 +242,9 @@ vm::SharedIntercode TrieDb::read_code(bytes32_t const &code_hash)
     if (!value.has_value()) {
         return vm::make_shared_intercode({});
     }
+    if (cache) {
+        return cache->analyse(code_hash, value.assume_value());
+    }
     return vm::make_shared_intercode(value.assume_value());
 }
 
@@ -163,7 +252,7 @@ void TrieDb::commit(
     StateDeltas const &state_deltas, Code const &code,
     bytes32_t const &block_id, BlockHeader const &header,
     std::vector<Receipt> const &receipts,
-    std::vector<std::vector<CallFrame>> const &call_frames,
+    std::vector<byte_string> const &call_frames,
     std::vector<Address> const &senders,
     std::vector<Transaction> const &transactions,
     std::vector<BlockHeader> const &ommers,
@@ -189,7 +278,8 @@ void TrieDb::commit(
         auto const dest_prefix = proposal_prefix(block_id);
         if (db_.get_latest_version() != INVALID_BLOCK_NUM) {
             MONAD_ASSERT(header.number != block_number_);
-            db_.copy_trie(
+            // overlaps with building the updates below, upsert() waits for it
+            db_.copy_trie_async(
                 block_number_, prefix_, header.number, dest_prefix, false);
         }
         proposal_block_id_ = block_id;
@@ -197,6 +287,13 @@ void TrieDb::commit(
         prefix_ = dest_prefix;
     }
 
+    if (flat_index_) {
+        flat_index_->commit(header.number, block_id, state_deltas);
+    }
+    if (storage_filters_) {
+        storage_filters_->commit(header.number, block_id, state_deltas);
+    }
+
     UpdateList account_updates;
     for (auto const &[addr, delta] : state_deltas) {
         UpdateList storage_updates;
@@ -239,9 +336,13 @@ void TrieDb::commit(
     }
 
     UpdateList code_updates;
+    auto *const intercode_cache = vm::get_intercode_cache();
     for (auto const &[hash, icode] : code) {
         // TODO write intercode object
         MONAD_ASSERT(icode);
+        if (intercode_cache) {
+            intercode_cache->insert(hash, icode);
+        }
         code_updates.push_front(update_alloc_.emplace_back(Update{
             .key = NibblesView{to_byte_string_view(hash.bytes)},
             .value = {{icode->code(), icode->size()}},
@@ -295,10 +396,11 @@ void TrieDb::commit(
             .next = UpdateList{},
             .version = static_cast<int64_t>(block_number_)}));
 
-        // Call frames
-        std::span<CallFrame const> frames{call_frames[i]};
-        byte_string_view frame_view =
-            bytes_alloc_.emplace_back(rlp::encode_call_frames(frames));
+        // Call frames, already encoded by the tracer as the transaction
+        // finished executing
+        byte_string_view frame_view = call_frames[i].empty()
+                                          ? rlp::EMPTY_CALL_FRAMES
+                                          : call_frames[i];
         uint8_t chunk_index = 0;
         auto const call_frame_prefix =
             serialize_as_big_endian<sizeof(uint32_t)>(i);
@@ -503,6 +605,13 @@ void TrieDb::finalize(uint64_t const block_number, bytes32_t const &block_id)
     db_.copy_trie(
         block_number, src_prefix, block_number, finalized_nibbles, true);
     db_.update_finalized_version(block_number);
+    if (flat_index_) {
+        flat_index_->finalize(block_number, block_id);
+    }
+    if (storage_filters_) {
+        storage_filters_->finalize(block_number, block_id);
+        build_storage_filters();
+    }
 }
 
 void TrieDb::update_verified_block(uint64_t const block_number)
@@ -563,6 +672,118 @@ bytes32_t TrieDb::merkle_root(mpt::Nibbles const &nibbles)
     return to_bytes(value.value());
 }
 
+void TrieDb::build_storage_filters()
+{
+    // collects the slot hashes below an account node whose leading byte is
+    // `range`
+    class SlotTraverseMachine final : public TraverseMachine
+    {
+        std::vector<bytes32_t> &slots_;
+        unsigned char range_;
+        size_t max_slots_;
+        Nibbles path_{};
+
+        bool in_range(NibblesView const path) const
+        {
+            return (path.nibble_size() < 1 || path.get(0) == range_ >> 4) &&
+                   (path.nibble_size() < 2 || path.get(1) == (range_ & 0xf));
+        }
+
+    public:
+        SlotTraverseMachine(
+            std::vector<bytes32_t> &slots, unsigned char const range,
+            size_t const max_slots)
+            : slots_(slots)
+            , range_(range)
+            , max_slots_(max_slots)
+        {
+        }
+
+        SlotTraverseMachine(SlotTraverseMachine const &other) = default;
+
+        virtual bool down(unsigned char const branch, Node const &node) override
+        {
+            if (branch == INVALID_BRANCH) {
+                // the account node, slot paths start below it
+                return true;
+            }
+            if (slots_.size() > max_slots_) {
+                return false;
+            }
+            Nibbles const path =
+                concat(NibblesView{path_}, branch, node.path_nibble_view());
+            if (!in_range(path)) {
+                return false;
+            }
+            if (node.has_value()) {
+                MONAD_ASSERT(path.nibble_size() == KECCAK256_SIZE * 2);
+                slots_.push_back(
+                    to_bytes(byte_string_view{path.data(), KECCAK256_SIZE}));
+                return false;
+            }
+            path_ = path;
+            return true;
+        }
+
+        virtual void up(unsigned char const branch, Node const &node) override
+        {
+            auto const path_view = NibblesView{path_};
+            unsigned const prefix_size =
+                branch == INVALID_BRANCH
+                    ? 0
+                    : path_view.nibble_size() - node.path_nibbles_len() - 1;
+            path_ = path_view.substr(0, prefix_size);
+        }
+
+        virtual std::unique_ptr<TraverseMachine> clone() const override
+        {
+            return std::make_unique<SlotTraverseMachine>(*this);
+        }
+    };
+
+    // Reading a whole storage trie here would stall finalization for as long
+    // as the trie is large, so the read is bounded and resumes at the next
+    // range of slot hashes on the following finalization
+    size_t n_slots = 0;
+    for (unsigned n_ranges = 0;
+         n_slots < StorageFilterIndex::MAX_BUILD_SLOTS_PER_FINALIZE &&
+         n_ranges < StorageFilterIndex::MAX_BUILD_RANGES_PER_FINALIZE;
+         ++n_ranges) {
+        auto *const build = storage_filters_->current_build();
+        if (build == nullptr) {
+            break;
+        }
+        bytes32_t const account_hash = build->account_hash;
+        size_t const slots_before = build->slots.size();
+        SlotTraverseMachine machine{
+            build->slots,
+            static_cast<unsigned char>(build->next_range),
+            storage_filters_->max_slots()};
+        auto const collect = [&](NibblesView const prefix,
+                                 uint64_t const version) {
+            auto const cursor = db_.find(
+                concat(
+                    prefix,
+                    STATE_NIBBLE,
+                    NibblesView{to_byte_string_view(account_hash.bytes)}),
+                version);
+            if (cursor.has_value() && cursor.value().is_valid()) {
+                db_.traverse(cursor.value(), machine, version);
+            }
+        };
+        collect(finalized_nibbles, storage_filters_->version());
+        for (auto const &proposal : storage_filters_->pending()) {
+            collect(
+                proposal_prefix(proposal.block_id), proposal.block_number);
+        }
+        n_slots += build->slots.size() - slots_before;
+        if (++build->next_range == StorageFilterIndex::BUILD_RANGES ||
+            build->slots.size() > storage_filters_->max_slots()) {
+            storage_filters_->finish_build();
+        }
+    }
+}
+
 BlockHeader TrieDb::read_eth_header()
 {
     auto const query_res =
@@ -590,6 +811,12 @@ std::string TrieDb::print_stats()
     n_account_value_.store(0, std::memory_order_release);
     n_storage_no_value_.store(0, std::memory_order_release);
     n_storage_value_.store(0, std::memory_order_release);
+    if (flat_index_) {
+        ret += flat_index_->print_stats();
+    }
+    if (storage_filters_) {
+        ret += storage_filters_->print_stats();
+    }
     return ret;
 }
 
@@ -729,6 +956,278 @@ nlohmann::json TrieDb::to_json(size_t const concurrency_limit)
     return json;
 }
 
+StateExportStats TrieDb::export_state(
+    StateExportFormat const format,
+    std::function<void(byte_string_view)> const &sink,
+    unsigned const num_threads, size_t const chunk_size)
+{
+    MONAD_ASSERT(num_threads > 0 && num_threads <= 16);
+    MONAD_ASSERT(chunk_size > 0);
+
+    // Finds are not safe to run concurrently on every kind of Db, so the
+    // threads take turns at reading code
+    struct Shared
+    {
+        TrieDb &db;
+        StateExportFormat format;
+        size_t chunk_size;
+        std::function<void(byte_string_view)> const &sink;
+        std::mutex sink_lock;
+        std::mutex code_lock;
+    };
+
+    class Export final : public TraverseMachine
+    {
+        Shared &shared_;
+        unsigned partition_;
+        unsigned num_partitions_;
+        Nibbles path_{};
+        byte_string buffer_{};
+        // binary only, where the current storage batch's count goes
+        size_t num_storage_offset_{0};
+        uint64_t num_storage_{0};
+        // binary only, set while the batches of an account larger than a
+        // chunk are written, so no other thread's chunk goes between them
+        bool holds_sink_{false};
+
+    public:
+        StateExportStats stats{};
+
+        Export(
+            Shared &shared, unsigned const partition,
+            unsigned const num_partitions)
+            : shared_(shared)
+            , partition_(partition)
+            , num_partitions_(num_partitions)
+        {
+        }
+
+        Export(Export const &) = default;
+
+        virtual bool
+        should_visit(Node const &, unsigned char const branch) override
+        {
+            // the children of the state root partition the accounts
+            return path_.nibble_size() != 0 ||
+                   branch % num_partitions_ == partition_;
+        }
+
+        virtual bool down(unsigned char const branch, Node const &node) override
+        {
+            if (branch == INVALID_BRANCH) {
+                MONAD_ASSERT(node.path_nibble_view().nibble_size() == 0);
+                return true;
+            }
+            path_ = concat(NibblesView{path_}, branch, node.path_nibble_view());
+            if (path_.nibble_size() == KECCAK256_SIZE * 2) {
+                handle_account(node);
+            }
+            else if (path_.nibble_size() == KECCAK256_SIZE * 4) {
+                handle_storage(node);
+            }
+            return true;
+        }
+
+        virtual void up(unsigned char const branch, Node const &node) override
+        {
+            auto const path_view = NibblesView{path_};
+            if (branch == INVALID_BRANCH) {
+                MONAD_ASSERT(path_view.nibble_size() == 0);
+                return;
+            }
+            if (path_view.nibble_size() == KECCAK256_SIZE * 2) {
+                end_account();
+            }
+            unsigned const prefix_size = path_view.nibble_size() - 1 -
+                                         node.path_nibble_view().nibble_size();
+            path_ = path_view.substr(0, prefix_size);
+        }
+
+        virtual std::unique_ptr<TraverseMachine> clone() const override
+        {
+            return std::make_unique<Export>(*this);
+        }
+
+        void flush()
+        {
+            MONAD_ASSERT(!holds_sink_);
+            if (buffer_.empty()) {
+                return;
+            }
+            std::lock_guard const g(shared_.sink_lock);
+            write();
+        }
+
+    private:
+        // the caller holds the sink lock
+        void write()
+        {
+            shared_.sink(buffer_);
+            stats.bytes += buffer_.size();
+            buffer_.clear();
+        }
+
+        void set_num_storage(uint64_t const num_storage)
+        {
+            std::memcpy(
+                buffer_.data() + num_storage_offset_,
+                &num_storage,
+                sizeof(num_storage));
+        }
+
+        void append(void const *const data, size_t const size)
+        {
+            buffer_.append(static_cast<unsigned char const *>(data), size);
+        }
+
+        void append(std::string const &str)
+        {
+            append(str.data(), str.size());
+        }
+
+        void handle_account(Node const &node)
+        {
+            MONAD_ASSERT(node.has_value());
+            auto encoded_account = node.value();
+            auto const acct = decode_account_db(encoded_account);
+            MONAD_ASSERT(!acct.has_error());
+            auto const &[address, account] = acct.value();
+            ++stats.accounts;
+
+            if (shared_.format == StateExportFormat::binary) {
+                append(path_.data(), KECCAK256_SIZE);
+                append(&account.balance, sizeof(account.balance));
+                append(&account.nonce, sizeof(account.nonce));
+                append(account.code_hash.bytes, sizeof(account.code_hash));
+                num_storage_offset_ = buffer_.size();
+                num_storage_ = 0;
+                append(&num_storage_, sizeof(num_storage_));
+                return;
+            }
+            vm::SharedIntercode icode;
+            {
+                std::lock_guard const g(shared_.code_lock);
+                icode = shared_.db.read_code(account.code_hash);
+            }
+            MONAD_ASSERT(icode);
+            append(fmt::format(
+                "{{\"key\":\"{}\",\"address\":\"{}\",\"balance\":\"{}\","
+                "\"nonce\":\"0x{:x}\",\"code\":\"0x{}\"}}\n",
+                NibblesView{path_},
+                address,
+                account.balance,
+                account.nonce,
+                evmc::hex({icode->code(), icode->size()})));
+            maybe_flush();
+        }
+
+        void handle_storage(Node const &node)
+        {
+            MONAD_ASSERT(node.has_value());
+            auto encoded_storage = node.value();
+            auto const storage = decode_storage_db(encoded_storage);
+            MONAD_ASSERT(!storage.has_error());
+            auto const &[slot, value] = storage.value();
+            ++stats.storage_slots;
+
+            if (shared_.format == StateExportFormat::binary) {
+                append(path_.data() + KECCAK256_SIZE, KECCAK256_SIZE);
+                append(value.bytes, sizeof(value));
+                ++num_storage_;
+                if (buffer_.size() >= shared_.chunk_size) {
+                    set_num_storage(num_storage_ | BINARY_STORAGE_CONTINUES);
+                    if (!holds_sink_) {
+                        shared_.sink_lock.lock();
+                        holds_sink_ = true;
+                    }
+                    write();
+                    num_storage_offset_ = 0;
+                    num_storage_ = 0;
+                    append(&num_storage_, sizeof(num_storage_));
+                }
+                return;
+            }
+            auto const path_view = NibblesView{path_};
+            append(fmt::format(
+                "{{\"account\":\"{}\",\"key\":\"{}\",\"slot\":\"0x{:02x}\","
+                "\"value\":\"0x{:02x}\"}}\n",
+                path_view.substr(0, KECCAK256_SIZE * 2),
+                path_view.substr(KECCAK256_SIZE * 2, KECCAK256_SIZE * 2),
+                fmt::join(std::as_bytes(std::span(slot.bytes)), ""),
+                fmt::join(std::as_bytes(std::span(value.bytes)), "")));
+            maybe_flush();
+        }
+
+        void end_account()
+        {
+            if (shared_.format != StateExportFormat::binary) {
+                return;
+            }
+            set_num_storage(num_storage_);
+            if (holds_sink_) {
+                write();
+                holds_sink_ = false;
+                shared_.sink_lock.unlock();
+                return;
+            }
+            maybe_flush();
+        }
+
+        void maybe_flush()
+        {
+            if (buffer_.size() >= shared_.chunk_size) {
+                flush();
+            }
+        }
+    };
+
+    auto const begin = std::chrono::steady_clock::now();
+    auto const res_cursor =
+        db_.find(concat(prefix_, STATE_NIBBLE), block_number_);
+    MONAD_ASSERT(res_cursor.has_value());
+    MONAD_ASSERT(res_cursor.value().is_valid());
+
+    // Every thread does its own blocking traversal, which does not cache
+    // what it reads in the shared trie, so they can run alongside each other
+    // on every kind of Db, RWOnDisk included
+    Shared shared{
+        .db = *this,
+        .format = format,
+        .chunk_size = chunk_size,
+        .sink = sink,
+        .sink_lock = {},
+        .code_lock = {}};
+    std::vector<Export> machines;
+    machines.reserve(num_threads);
+    for (unsigned i = 0; i < num_threads; ++i) {
+        machines.emplace_back(shared, i, num_threads);
+    }
+    auto const traverse = [&](Export &machine) {
+        MONAD_ASSERT(db_.traverse_blocking(
+            res_cursor.value(), machine, block_number_));
+        machine.flush();
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads - 1);
+    for (unsigned i = 1; i < num_threads; ++i) {
+        threads.emplace_back(traverse, std::ref(machines[i]));
+    }
+    traverse(machines[0]);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    StateExportStats stats{};
+    for (auto const &machine : machines) {
+        stats.accounts += machine.stats.accounts;
+        stats.storage_slots += machine.stats.storage_slots;
+        stats.bytes += machine.stats.bytes;
+    }
+    stats.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - begin);
+    return stats;
+}
+
 size_t TrieDb::prefetch_current_root()
 {
     return db_.prefetch();
@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <category/core/byte_string.hpp>
 #include <category/core/bytes.hpp>
 #include <category/core/config.hpp>
 #include <category/core/keccak.hpp>
@@ -22,6 +23,8 @@
 #include <category/execution/ethereum/core/receipt.hpp>
 #include <category/execution/ethereum/core/transaction.hpp>
 #include <category/execution/ethereum/db/db.hpp>
+#include <category/execution/ethereum/db/flat_state_index.hpp>
+#include <category/execution/ethereum/db/storage_filter_index.hpp>
 #include <category/execution/ethereum/db/util.hpp>
 #include <category/execution/ethereum/trace/call_frame.hpp>
 #include <category/mpt/compute.hpp>
@@ -32,7 +35,11 @@
 
 #include <nlohmann/json.hpp>
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <functional>
 #include <istream>
 #include <memory>
 #include <optional>
@@ -41,6 +48,23 @@
 
 MONAD_NAMESPACE_BEGIN
 
+enum class StateExportFormat
+{
+    // One JSON object per line with the fields of TrieDb::to_json(), each
+    // account before its storage slots, which name their account's key
+    ndjson,
+    // The accounts stream read by load_from_binary()
+    binary,
+};
+
+struct StateExportStats
+{
+    uint64_t accounts{0};
+    uint64_t storage_slots{0};
+    uint64_t bytes{0};
+    std::chrono::nanoseconds elapsed{0};
+};
+
 class TrieDb final : public ::monad::Db
 {
     ::monad::mpt::Db &db_;
@@ -51,9 +75,13 @@ class TrieDb final : public ::monad::Db
     // bytes32_t{} represent finalized
     bytes32_t proposal_block_id_;
     ::monad::mpt::Nibbles prefix_;
+    FlatStateIndex *flat_index_;
+    StorageFilterIndex *storage_filters_;
 
 public:
-    TrieDb(mpt::Db &);
+    TrieDb(
+        mpt::Db &, FlatStateIndex * = nullptr,
+        StorageFilterIndex * = nullptr);
     ~TrieDb();
 
     virtual std::optional<Account> read_account(Address const &) override;
@@ -66,7 +94,7 @@ public:
     virtual void commit(
         StateDeltas const &, Code const &, bytes32_t const &block_id,
         BlockHeader const &, std::vector<Receipt> const & = {},
-        std::vector<std::vector<CallFrame>> const & = {},
+        std::vector<byte_string> const & = {},
         std::vector<Address> const & = {},
         std::vector<Transaction> const & = {},
         std::vector<BlockHeader> const &ommers = {},
@@ -85,6 +113,16 @@ public:
     virtual std::string print_stats() override;
 
     nlohmann::json to_json(size_t concurrency_limit = 4096);
+    // Stream the state at the current block to `sink` in chunks of about
+    // `chunk_size` bytes, so memory use does not grow with the state. Each
+    // of `num_threads` threads traverses the accounts whose key starts with
+    // its share of the 16 nibbles. Chunks of different threads interleave,
+    // and `sink` is never called concurrently. In binary, the storage of an
+    // account larger than a chunk is split into batches, as described at
+    // load_from_binary(), whose chunks no other thread's chunk goes between.
+    StateExportStats export_state(
+        StateExportFormat, std::function<void(byte_string_view)> const &sink,
+        unsigned num_threads = 1, size_t chunk_size = 1ul << 20);
     size_t prefetch_current_root();
     uint64_t get_block_number() const;
     uint64_t get_history_length() const;
@@ -117,6 +155,17 @@ private:
     }
 
     bytes32_t merkle_root(mpt::Nibbles const &);
+    // Continue building storage filters, within the per finalization bounds
+    // of StorageFilterIndex
+    void build_storage_filters();
+
+    FlatStateIndex::ReadVersion read_version() const
+    {
+        return {
+            .block_number = block_number_,
+            .finalized = proposal_block_id_ == bytes32_t{},
+            .block_id = proposal_block_id_};
+    }
 };
 
 MONAD_NAMESPACE_END
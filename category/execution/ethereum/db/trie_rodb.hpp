@@ -21,6 +21,7 @@
 #include <category/execution/ethereum/db/util.hpp>
 #include <category/mpt/db.hpp>
 #include <category/mpt/db_error.hpp>
+#include <category/vm/intercode_cache.hpp>
 #include <category/vm/vm.hpp>
 
 #include <evmc/hex.hpp>
@@ -115,6 +116,12 @@ public:
 
     virtual vm::SharedIntercode read_code(bytes32_t const &code_hash) override
     {
+        auto *const cache = vm::get_intercode_cache();
+        if (cache) {
+            if (auto icode = cache->find(code_hash)) {
+                return icode;
+            }
+        }
         // TODO read intercode object
         auto code_leaf_res = db_.find(
             prefix_cursor_,
@@ -129,13 +136,17 @@ public:
                 "Block was invalidated in db while execution was in progress");
             return vm::make_shared_intercode({});
         }
-        return vm::make_shared_intercode(code_leaf_res.value().node->value());
+        auto const code = code_leaf_res.value().node->value();
+        if (cache) {
+            return cache->analyse(code_hash, code);
+        }
+        return vm::make_shared_intercode(code);
     }
 
     virtual void commit(
         StateDeltas const &, Code const &, bytes32_t const &,
         BlockHeader const &, std::vector<Receipt> const & = {},
-        std::vector<std::vector<CallFrame>> const & = {},
+        std::vector<byte_string> const & = {},
         std::vector<Address> const & = {},
         std::vector<Transaction> const & = {},
         std::vector<BlockHeader> const & = {},
@@ -18,6 +18,7 @@
 #include <category/core/bytes.hpp>
 #include <category/core/config.hpp>
 #include <category/core/int.hpp>
+#include <category/core/keccak.hpp>
 #include <category/core/likely.h>
 #include <category/core/result.hpp>
 #include <category/core/unaligned.hpp>
@@ -101,6 +102,12 @@ namespace
         size_t buf_size_;
         std::unique_ptr<unsigned char[]> buf_;
         uint64_t block_id_;
+        // the account whose next storage batch is read next, and its update
+        // in the current list of updates if it has one
+        bool storage_continues_{false};
+        byte_string continued_key_{};
+        byte_string continued_value_{};
+        Update *continued_account_{nullptr};
 
     public:
         BinaryDbLoader(
@@ -143,9 +150,11 @@ namespace
                         std::move(finalized_updates), block_id_, false, false);
                     db_.update_finalized_version(block_id_);
 
+                    continued_account_ = nullptr;
                     update_alloc_.clear();
                     bytes_alloc_.clear();
                 });
+            MONAD_ASSERT(!storage_continues_);
             load(
                 code,
                 [&](byte_string_view in, UpdateList &updates) {
@@ -231,27 +240,55 @@ namespace
                 sizeof(bytes32_t) + sizeof(uint64_t);
             static_assert(account_fixed_size == 112);
             size_t total_processed = 0;
-            while (in.size() >= account_fixed_size) {
-                constexpr auto num_storage_offset =
-                    account_fixed_size - sizeof(uint64_t);
-                auto const num_storage = unaligned_load<uint64_t>(
-                    in.substr(num_storage_offset, sizeof(uint64_t)).data());
+            while (true) {
+                auto const header_size = storage_continues_
+                                             ? sizeof(uint64_t)
+                                             : account_fixed_size;
+                if (in.size() < header_size) {
+                    return total_processed;
+                }
+                auto const num_storage_word = unaligned_load<uint64_t>(
+                    in.substr(header_size - sizeof(uint64_t), sizeof(uint64_t))
+                        .data());
+                auto const num_storage =
+                    num_storage_word & ~BINARY_STORAGE_CONTINUES;
                 auto const storage_size = num_storage * storage_entry_size;
-                auto const entry_size = account_fixed_size + storage_size;
+                auto const entry_size = header_size + storage_size;
                 MONAD_ASSERT(entry_size <= buf_size_);
                 if (in.size() < entry_size) {
                     return total_processed;
                 }
-                auto &update = update_alloc_.emplace_back(handle_account(in));
-                if (num_storage) {
-                    update.next = handle_storage(
-                        in.substr(account_fixed_size, storage_size));
+                bool const new_account = !storage_continues_;
+                if (new_account) {
+                    continued_account_ =
+                        &update_alloc_.emplace_back(handle_account(in));
+                    account_updates.push_front(*continued_account_);
+                }
+                else if (continued_account_ == nullptr) {
+                    // the earlier batches went out with the previous updates
+                    continued_account_ = &update_alloc_.emplace_back(Update{
+                        .key = bytes_alloc_.emplace_back(continued_key_),
+                        .value = bytes_alloc_.emplace_back(continued_value_),
+                        .incarnation = false,
+                        .next = UpdateList{},
+                        .version = static_cast<int64_t>(block_id_)});
+                    account_updates.push_front(*continued_account_);
+                }
+                handle_storage(
+                    in.substr(header_size, storage_size),
+                    continued_account_->next);
+                storage_continues_ =
+                    (num_storage_word & BINARY_STORAGE_CONTINUES) != 0;
+                if (!storage_continues_) {
+                    continued_account_ = nullptr;
+                }
+                else if (new_account) {
+                    continued_key_ = in.substr(0, sizeof(bytes32_t));
+                    continued_value_ = continued_account_->value.value();
                 }
-                account_updates.push_front(update);
                 total_processed += entry_size;
                 in = in.substr(entry_size);
             }
-            return total_processed;
         }
 
         size_t parse_code(byte_string_view in, UpdateList &code_updates)
@@ -307,9 +344,8 @@ namespace
                 .version = static_cast<int64_t>(block_id_)};
         }
 
-        UpdateList handle_storage(byte_string_view in)
+        void handle_storage(byte_string_view in, UpdateList &storage_updates)
         {
-            UpdateList storage_updates;
             while (!in.empty()) {
                 storage_updates.push_front(update_alloc_.emplace_back(Update{
                     .key = in.substr(0, sizeof(bytes32_t)),
@@ -324,7 +360,6 @@ namespace
                     .version = static_cast<int64_t>(block_id_)}));
                 in = in.substr(storage_entry_size);
             }
-            return storage_updates;
         }
     };
 
@@ -960,4 +995,49 @@ bool for_each_code(
     return true;
 }
 
+Result<mpt::merkle_multiproof_t> generate_account_proofs(
+    mpt::Db const &db, uint64_t const block, mpt::NibblesView const prefix,
+    std::span<Address const> const addresses)
+{
+    std::vector<bytes32_t> hashes;
+    hashes.reserve(addresses.size());
+    std::vector<NibblesView> keys;
+    keys.reserve(addresses.size());
+    for (auto const &address : addresses) {
+        auto const &hash = hashes.emplace_back(
+            to_bytes(keccak256({address.bytes, sizeof(address.bytes)})));
+        keys.emplace_back(to_byte_string_view(hash.bytes));
+    }
+    return db.generate_proof(
+        concat(prefix, STATE_NIBBLE),
+        keys,
+        &ComputeAccountLeaf::compute,
+        block);
+}
+
+Result<mpt::merkle_multiproof_t> generate_storage_proofs(
+    mpt::Db const &db, uint64_t const block, mpt::NibblesView const prefix,
+    Address const &address, std::span<bytes32_t const> const slots)
+{
+    std::vector<bytes32_t> hashes;
+    hashes.reserve(slots.size());
+    std::vector<NibblesView> keys;
+    keys.reserve(slots.size());
+    for (auto const &slot : slots) {
+        auto const &hash = hashes.emplace_back(
+            to_bytes(keccak256({slot.bytes, sizeof(slot.bytes)})));
+        keys.emplace_back(to_byte_string_view(hash.bytes));
+    }
+    auto const account_hash =
+        to_bytes(keccak256({address.bytes, sizeof(address.bytes)}));
+    return db.generate_proof(
+        concat(
+            prefix,
+            STATE_NIBBLE,
+            NibblesView{to_byte_string_view(account_hash.bytes)}),
+        keys,
+        &ComputeStorageLeaf::compute,
+        block);
+}
+
 MONAD_NAMESPACE_END
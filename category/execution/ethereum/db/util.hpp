@@ -29,6 +29,7 @@
 #include <filesystem>
 #include <functional>
 #include <istream>
+#include <span>
 
 MONAD_NAMESPACE_BEGIN
 
@@ -156,6 +157,17 @@ void write_to_file(
     nlohmann::json const &, std::filesystem::path const &,
     uint64_t block_number);
 
+// Set in a storage batch's slot count of the binary accounts stream when
+// another batch of the same account follows it
+inline constexpr uint64_t BINARY_STORAGE_CONTINUES = 1ul << 63;
+
+// `accounts` is a sequence of accounts, each its 32 byte key, balance, 8 byte
+// nonce and code hash, followed by one or more storage batches. A batch is
+// an 8 byte slot count followed by that many 32 byte key and value pairs. A
+// count with BINARY_STORAGE_CONTINUES set is followed by the next batch of
+// the same account, so a writer can flush an account before it has read all
+// of its storage. `code` is a sequence of 32 byte code hashes, each followed
+// by the 8 byte length of the code and the code. Integers are little endian.
 void load_from_binary(
     mpt::Db &, std::istream &accounts, std::istream &code,
     uint64_t init_block_number = 0,
@@ -174,4 +186,14 @@ bool for_each_code(
     mpt::Db &, uint64_t block,
     std::function<void(bytes32_t const &, byte_string_view)>);
 
+// Merkle proofs of accounts against the state root, or of the storage slots
+// of one account against its storage root, of the state below `prefix` at
+// `block`. Proof keys are the hashed address and slots, as in eth_getProof.
+Result<mpt::merkle_multiproof_t> generate_account_proofs(
+    mpt::Db const &, uint64_t block, mpt::NibblesView prefix,
+    std::span<Address const>);
+Result<mpt::merkle_multiproof_t> generate_storage_proofs(
+    mpt::Db const &, uint64_t block, mpt::NibblesView prefix, Address const &,
+    std::span<bytes32_t const> slots);
+
 MONAD_NAMESPACE_END
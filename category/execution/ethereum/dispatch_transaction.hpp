@@ -16,14 +16,13 @@
 #pragma once
 
 #include <category/core/config.hpp>
+#include <category/core/fiber/completion.hpp>
 #include <category/core/result.hpp>
 #include <category/execution/ethereum/core/address.hpp>
 #include <category/execution/ethereum/core/receipt.hpp>
 #include <category/execution/ethereum/execute_transaction.hpp>
 #include <category/vm/evm/traits.hpp>
 
-#include <boost/fiber/future/promise.hpp>
-
 #include <cstdint>
 #include <functional>
 #include <optional>
@@ -51,7 +50,7 @@ Result<Receipt> dispatch_transaction(
     std::vector<std::optional<Address>> const &authorities,
     BlockHeader const &header, BlockHashBuffer const &block_hash_buffer,
     BlockState &block_state, BlockMetrics &block_metrics,
-    boost::fibers::promise<void> &prev, CallTracerBase &call_tracer,
+    fiber::Completion &prev, CallTracerBase &call_tracer,
     RevertTransactionFn const &revert_transaction);
 
 MONAD_NAMESPACE_END
@@ -17,7 +17,9 @@
 #include <category/core/config.hpp>
 #include <category/core/cpu_relax.h>
 #include <category/core/event/event_recorder.h>
+#include <category/core/fiber/completion.hpp>
 #include <category/core/fiber/priority_pool.hpp>
+#include <category/core/fiber/priority_task.hpp>
 #include <category/core/int.hpp>
 #include <category/core/likely.h>
 #include <category/core/result.hpp>
@@ -38,6 +40,7 @@
 #include <category/execution/ethereum/execute_block.hpp>
 #include <category/execution/ethereum/execute_transaction.hpp>
 #include <category/execution/ethereum/metrics/block_metrics.hpp>
+#include <category/execution/ethereum/metrics/txn_profile.hpp>
 #include <category/execution/ethereum/state2/block_state.hpp>
 #include <category/execution/ethereum/state3/state.hpp>
 #include <category/execution/ethereum/trace/call_tracer.hpp>
@@ -47,7 +50,6 @@
 #include <category/vm/evm/switch_traits.hpp>
 #include <category/vm/evm/traits.hpp>
 
-#include <boost/fiber/future/promise.hpp>
 #include <boost/outcome/try.hpp>
 #include <evmc/evmc.h>
 #include <intx/intx.hpp>
@@ -115,6 +117,84 @@ void set_beacon_root(BlockState &block_state, BlockHeader const &header)
     }
 }
 
+// Completion of a batch of recovery tasks. Each task captures a pointer to
+// its batch and an index, so submitting it does not allocate.
+struct RecoverBatch
+{
+    std::atomic<size_t> remaining;
+    fiber::Completion done{};
+
+    void finish_one()
+    {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            done.set_value();
+        }
+    }
+
+    void wait()
+    {
+        done.wait();
+    }
+};
+
+// Per transaction merge order signal, result and profile of execute_block.
+// Owned by the thread executing blocks and reused, so once it has seen a
+// block as large as the current one it allocates nothing.
+class BlockTxnTasks
+{
+    std::unique_ptr<fiber::Completion[]> merged_{};
+    std::unique_ptr<std::optional<Result<Receipt>>[]> results_{};
+    std::unique_ptr<TxnProfile[]> profiles_{};
+    size_t capacity_{0};
+    size_t size_{0};
+
+public:
+    void prepare(size_t const txn_count)
+    {
+        if (txn_count > capacity_) {
+            merged_.reset(new fiber::Completion[txn_count + 1]);
+            results_.reset(new std::optional<Result<Receipt>>[txn_count]);
+            profiles_.reset(new TxnProfile[txn_count]);
+            capacity_ = txn_count;
+        }
+        else {
+            for (size_t i = 0; i <= size_; ++i) {
+                merged_[i].reset();
+            }
+            for (size_t i = 0; i < size_; ++i) {
+                results_[i].reset();
+                profiles_[i] = TxnProfile{};
+            }
+        }
+        size_ = txn_count;
+    }
+
+    // Set once transaction `i - 1` has merged, merged(0) is set up front
+    fiber::Completion &merged(size_t const i)
+    {
+        MONAD_DEBUG_ASSERT(i <= size_);
+        return merged_[i];
+    }
+
+    std::optional<Result<Receipt>> &result(size_t const i)
+    {
+        MONAD_DEBUG_ASSERT(i < size_);
+        return results_[i];
+    }
+
+    TxnProfile &profile(size_t const i)
+    {
+        MONAD_DEBUG_ASSERT(i < size_);
+        return profiles_[i];
+    }
+};
+
+BlockTxnTasks &block_txn_tasks()
+{
+    thread_local BlockTxnTasks tasks;
+    return tasks;
+}
+
 MONAD_ANONYMOUS_NAMESPACE_END
 
 MONAD_NAMESPACE_BEGIN
@@ -124,25 +204,24 @@ std::vector<std::optional<Address>> recover_senders(
     fiber::PriorityPool &priority_pool)
 {
     std::vector<std::optional<Address>> senders{transactions.size()};
+    if (transactions.empty()) {
+        return senders;
+    }
 
-    std::shared_ptr<boost::fibers::promise<void>[]> promises{
-        new boost::fibers::promise<void>[transactions.size()]};
+    struct Batch : RecoverBatch
+    {
+        std::vector<Transaction> const &transactions;
+        std::vector<std::optional<Address>> &senders;
+    } batch{{transactions.size()}, transactions, senders};
 
-    for (unsigned i = 0; i < transactions.size(); ++i) {
+    for (uint32_t i = 0; i < transactions.size(); ++i) {
         priority_pool.submit(
-            i,
-            [i = i,
-             promises = promises,
-             &sender = senders[i],
-             &transaction = transactions[i]] {
-                sender = recover_sender(transaction);
-                promises[i].set_value();
-            });
-    }
-
-    for (unsigned i = 0; i < transactions.size(); ++i) {
-        promises[i].get_future().wait();
+            i, fiber::make_inline_task([batch = &batch, i] {
+                batch->senders[i] = recover_sender(batch->transactions[i]);
+                batch->finish_one();
+            }));
     }
+    batch.wait();
 
     return senders;
 }
@@ -153,33 +232,33 @@ std::vector<std::vector<std::optional<Address>>> recover_authorities(
 {
     std::vector<std::vector<std::optional<Address>>> authorities{
         transactions.size()};
-    std::vector<std::shared_ptr<boost::fibers::promise<void>[]>> promises{
-        transactions.size()};
-
+    size_t n_authorities = 0;
     for (auto i = 0u; i < transactions.size(); ++i) {
         authorities[i] = std::vector<std::optional<Address>>{
             transactions[i].authorization_list.size()};
-        promises[i] = std::shared_ptr<boost::fibers::promise<void>[]>{
-            new boost::fibers::promise<void>[authorities[i].size()]};
-
-        for (auto j = 0u; j < authorities[i].size(); ++j) {
-            priority_pool.submit(
-                i,
-                [j = j,
-                 auth_promises = promises[i],
-                 &auth = authorities[i][j],
-                 &auth_entry = transactions[i].authorization_list[j]]() {
-                    auth = recover_authority(auth_entry);
-                    auth_promises[j].set_value();
-                });
-        }
+        n_authorities += authorities[i].size();
+    }
+    if (n_authorities == 0) {
+        return authorities;
     }
 
-    for (auto i = 0u; i < transactions.size(); ++i) {
-        for (auto j = 0u; j < transactions[i].authorization_list.size(); ++j) {
-            promises[i][j].get_future().wait();
+    struct Batch : RecoverBatch
+    {
+        std::vector<Transaction> const &transactions;
+        std::vector<std::vector<std::optional<Address>>> &authorities;
+    } batch{{n_authorities}, transactions, authorities};
+
+    for (uint32_t i = 0; i < transactions.size(); ++i) {
+        for (uint32_t j = 0; j < authorities[i].size(); ++j) {
+            priority_pool.submit(
+                i, fiber::make_inline_task([batch = &batch, i, j] {
+                    batch->authorities[i][j] = recover_authority(
+                        batch->transactions[i].authorization_list[j]);
+                    batch->finish_one();
+                }));
         }
     }
+    batch.wait();
 
     return authorities;
 }
@@ -222,86 +301,109 @@ Result<std::vector<Receipt>> execute_block(
         }
     }
 
-    std::shared_ptr<boost::fibers::promise<void>[]> promises{
-        new boost::fibers::promise<void>[block.transactions.size() + 1]};
-    promises[0].set_value();
-
-    std::shared_ptr<std::optional<Result<Receipt>>[]> const results{
-        new std::optional<Result<Receipt>>[block.transactions.size()]};
-    std::atomic<size_t> txn_exec_finished = 0;
     size_t const txn_count = block.transactions.size();
+    auto &tasks = block_txn_tasks();
+    tasks.prepare(txn_count);
+    tasks.merged(0).set_value();
+
+    struct BlockContext
+    {
+        Chain const &chain;
+        Block const &block;
+        std::vector<Address> const &senders;
+        std::vector<std::vector<std::optional<Address>>> const &authorities;
+        BlockHashBuffer const &block_hash_buffer;
+        BlockState &block_state;
+        BlockMetrics &block_metrics;
+        std::vector<std::unique_ptr<CallTracerBase>> &call_tracers;
+        RevertTransactionFn const &revert_transaction;
+        BlockTxnTasks &tasks;
+        std::atomic<size_t> txn_exec_finished;
+
+        void execute_transaction(uint32_t const i)
+        {
+            auto const &transaction = block.transactions[i];
+            auto &result = tasks.result(i);
+            auto &profile = tasks.profile(i);
+            TxnProfileScope const profile_scope{profile};
+            record_txn_marker_event(MONAD_EXEC_TXN_PERF_EVM_ENTER, i);
+            try {
+                result = dispatch_transaction<traits>(
+                    chain,
+                    i,
+                    transaction,
+                    senders[i],
+                    authorities[i],
+                    block.header,
+                    block_hash_buffer,
+                    block_state,
+                    block_metrics,
+                    tasks.merged(i),
+                    *call_tracers[i],
+                    revert_transaction);
+                tasks.merged(i + 1).set_value();
+                record_txn_marker_event(MONAD_EXEC_TXN_PERF_EVM_EXIT, i);
+                record_txn_events(
+                    i, transaction, senders[i], authorities[i], *result);
+            }
+            catch (...) {
+                tasks.merged(i + 1).set_exception(std::current_exception());
+            }
+            txn_exec_finished.fetch_add(1, std::memory_order::relaxed);
+        }
+    } ctx{
+        chain,
+        block,
+        senders,
+        authorities,
+        block_hash_buffer,
+        block_state,
+        block_metrics,
+        call_tracers,
+        revert_transaction,
+        tasks,
+        0};
 
     auto const tx_exec_begin = std::chrono::steady_clock::now();
-    for (unsigned i = 0; i < txn_count; ++i) {
+    for (uint32_t i = 0; i < txn_count; ++i) {
         priority_pool.submit(
-            i,
-            [&chain = chain,
-             i = i,
-             results = results,
-             promises = promises,
-             &transaction = block.transactions[i],
-             &sender = senders[i],
-             &authorities = authorities[i],
-             &header = block.header,
-             &block_hash_buffer = block_hash_buffer,
-             &block_state,
-             &block_metrics,
-             &call_tracer = *call_tracers[i],
-             &txn_exec_finished,
-             &revert_transaction = revert_transaction] {
-                record_txn_marker_event(MONAD_EXEC_TXN_PERF_EVM_ENTER, i);
-                try {
-                    results[i] = dispatch_transaction<traits>(
-                        chain,
-                        i,
-                        transaction,
-                        sender,
-                        authorities,
-                        header,
-                        block_hash_buffer,
-                        block_state,
-                        block_metrics,
-                        promises[i],
-                        call_tracer,
-                        revert_transaction);
-                    promises[i + 1].set_value();
-                    record_txn_marker_event(MONAD_EXEC_TXN_PERF_EVM_EXIT, i);
-                    record_txn_events(
-                        i, transaction, sender, authorities, *results[i]);
-                }
-                catch (...) {
-                    promises[i + 1].set_exception(std::current_exception());
-                }
-                txn_exec_finished.fetch_add(1, std::memory_order::relaxed);
-            });
+            i, fiber::make_inline_task([ctx = &ctx, i] {
+                ctx->execute_transaction(i);
+            }));
     }
+    block_metrics.set_tx_submit_time(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - tx_exec_begin));
 
-    auto const last = static_cast<std::ptrdiff_t>(block.transactions.size());
-    promises[last].get_future().get();
+    tasks.merged(txn_count).get();
     block_metrics.set_tx_exec_time(
         std::chrono::duration_cast<std::chrono::microseconds>(
             std::chrono::steady_clock::now() - tx_exec_begin));
 
     // All transactions have released their merge-order synchronization
-    // primitive (promises[i + 1]) but some stragglers could still be running
+    // primitive (merged(i + 1)) but some stragglers could still be running
     // post-execution code that occurs immediately after that, e.g.
     // `record_txn_exec_result_events`. This waits for everything to finish
-    // so that it's safe to assume we're the only ones using `results`.
-    while (txn_exec_finished.load() < txn_count) {
+    // so that it's safe to assume we're the only ones using the results.
+    while (ctx.txn_exec_finished.load() < txn_count) {
         cpu_relax();
     }
+    for (size_t i = 0; i < txn_count; ++i) {
+        block_metrics.add_txn_profile(tasks.profile(i));
+    }
 
     std::vector<Receipt> retvals;
     for (unsigned i = 0; i < block.transactions.size(); ++i) {
-        MONAD_ASSERT(results[i].has_value());
-        if (MONAD_UNLIKELY(results[i].value().has_error())) {
+        auto &result = tasks.result(i);
+        MONAD_ASSERT(result.has_value());
+        if (MONAD_UNLIKELY(result.value().has_error())) {
             LOG_ERROR(
                 "tx {} {} validation failed: {}",
                 i,
                 block.transactions[i],
-                results[i].value().assume_error().message().c_str());
+                result.value().assume_error().message().c_str());
         }
-        BOOST_OUTCOME_TRY(auto retval, std::move(results[i].value()));
+        BOOST_OUTCOME_TRY(auto retval, std::move(result.value()));
         retvals.push_back(std::move(retval));
     }
 
@@ -24,6 +24,7 @@
 #include <category/execution/ethereum/evmc_host.hpp>
 #include <category/execution/ethereum/execute_transaction.hpp>
 #include <category/execution/ethereum/metrics/block_metrics.hpp>
+#include <category/execution/ethereum/metrics/txn_profile.hpp>
 #include <category/execution/ethereum/state2/block_state.hpp>
 #include <category/execution/ethereum/state3/state.hpp>
 #include <category/execution/ethereum/trace/call_tracer.hpp>
@@ -36,7 +37,6 @@
 #include <category/vm/evm/switch_traits.hpp>
 #include <category/vm/evm/traits.hpp>
 
-#include <boost/fiber/future/promise.hpp>
 #include <boost/outcome/try.hpp>
 #include <intx/intx.hpp>
 
@@ -298,7 +298,7 @@ ExecuteTransaction<traits>::ExecuteTransaction(
     std::vector<std::optional<Address>> const &authorities,
     BlockHeader const &header, BlockHashBuffer const &block_hash_buffer,
     BlockState &block_state, BlockMetrics &block_metrics,
-    boost::fibers::promise<void> &prev, CallTracerBase &call_tracer,
+    fiber::Completion &prev, CallTracerBase &call_tracer,
     RevertTransactionFn const &revert_transaction)
     : ExecuteTransactionNoValidation<
           traits>{chain, tx, sender, authorities, header, i, revert_transaction}
@@ -433,11 +433,12 @@ Result<Receipt> ExecuteTransaction<traits>::operator()()
 
         call_tracer_.reset();
 
-        auto result = execute_impl2(state);
+        auto result = profiled_evm([&] { return execute_impl2(state); });
 
         {
             TRACE_TXN_EVENT(StartStall);
-            prev_.get_future().wait();
+            TxnProfileTimer const stall_timer{&TxnProfile::stall_nanos};
+            prev_.wait();
         }
 
         if (block_state_.can_merge(state)) {
@@ -453,12 +454,16 @@ Result<Receipt> ExecuteTransaction<traits>::operator()()
     block_metrics_.inc_retries();
     {
         TRACE_TXN_EVENT(StartRetry);
+        TxnProfileTimer const retry_timer{&TxnProfile::retry_nanos};
+        if (auto *const profile = retry_timer.profile()) {
+            ++profile->retry_count;
+        }
 
         State state{block_state_, Incarnation{header_.number, i_ + 1}};
 
         call_tracer_.reset();
 
-        auto result = execute_impl2(state);
+        auto result = profiled_evm([&] { return execute_impl2(state); });
 
         MONAD_ASSERT(block_state_.can_merge(state));
         if (result.has_error()) {
@@ -13,6 +13,7 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <category/core/fiber/completion.hpp>
 #include <category/core/int.hpp>
 #include <category/execution/ethereum/block_hash_buffer.hpp>
 #include <category/execution/ethereum/chain/ethereum_mainnet.hpp>
@@ -33,8 +34,6 @@
 
 #include <intx/intx.hpp>
 
-#include <boost/fiber/future/promise.hpp>
-
 #include <gtest/gtest.h>
 
 #include <memory>
@@ -81,7 +80,7 @@ TEST(TransactionProcessor, irrevocable_gas_and_refund_new_contract)
     BlockHeader const header{.beneficiary = bene};
     BlockHashBufferFinalized const block_hash_buffer;
 
-    boost::fibers::promise<void> prev{};
+    fiber::Completion prev{};
     prev.set_value();
 
     NoopCallTracer noop_call_tracer;
@@ -166,7 +165,7 @@ TEST(TransactionProcessor, monad_four_refunds_delete)
         BlockHeader const header{.beneficiary = bene};
         BlockHashBufferFinalized const block_hash_buffer;
 
-        boost::fibers::promise<void> prev{};
+        fiber::Completion prev{};
         prev.set_value();
 
         NoopCallTracer noop_call_tracer;
@@ -212,7 +211,7 @@ TEST(TransactionProcessor, monad_four_refunds_delete)
         BlockHeader const header{.beneficiary = bene};
         BlockHashBufferFinalized const block_hash_buffer;
 
-        boost::fibers::promise<void> prev{};
+        fiber::Completion prev{};
         prev.set_value();
 
         NoopCallTracer noop_call_tracer;
@@ -298,7 +297,7 @@ TEST(TransactionProcessor, monad_four_refunds_delete_then_set)
         BlockHeader const header{.beneficiary = bene};
         BlockHashBufferFinalized const block_hash_buffer;
 
-        boost::fibers::promise<void> prev{};
+        fiber::Completion prev{};
         prev.set_value();
 
         NoopCallTracer noop_call_tracer;
@@ -16,8 +16,10 @@
 #pragma once
 
 #include <category/core/config.hpp>
+#include <category/execution/ethereum/metrics/txn_profile.hpp>
 
 #include <chrono>
+#include <cstdint>
 
 MONAD_NAMESPACE_BEGIN
 
@@ -25,6 +27,14 @@ class BlockMetrics
 {
     uint32_t n_retries_{0};
     std::chrono::microseconds tx_exec_time_{1};
+    std::chrono::microseconds tx_submit_time_{0};
+    TxnProfile txn_profile_{};
+
+    static std::chrono::microseconds to_micros(uint64_t const nanos)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::nanoseconds{nanos});
+    }
 
 public:
     void inc_retries()
@@ -46,6 +56,43 @@ public:
     {
         return tx_exec_time_;
     }
+
+    // Time spent submitting the block's transactions to the pool
+    void set_tx_submit_time(std::chrono::microseconds const submit_time)
+    {
+        tx_submit_time_ = submit_time;
+    }
+
+    std::chrono::microseconds tx_submit_time() const
+    {
+        return tx_submit_time_;
+    }
+
+    // Sum of the profiles of the block's transactions
+    void add_txn_profile(TxnProfile const &profile)
+    {
+        txn_profile_ += profile;
+    }
+
+    TxnProfile const &txn_profile() const
+    {
+        return txn_profile_;
+    }
+
+    std::chrono::microseconds tx_stall_time() const
+    {
+        return to_micros(txn_profile_.stall_nanos);
+    }
+
+    std::chrono::microseconds db_read_time() const
+    {
+        return to_micros(txn_profile_.db_read_nanos);
+    }
+
+    std::chrono::microseconds precompile_time() const
+    {
+        return to_micros(txn_profile_.precompile_nanos);
+    }
 };
 
 MONAD_NAMESPACE_END
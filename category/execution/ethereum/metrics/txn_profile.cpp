@@ -0,0 +1,99 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/config.hpp>
+#include <category/core/fiber/priority_properties.hpp>
+#include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/metrics/txn_profile.hpp>
+
+#include <boost/fiber/context.hpp>
+
+#include <cstddef>
+
+MONAD_ANONYMOUS_NAMESPACE_BEGIN
+
+fiber::PriorityProperties *active_properties() noexcept
+{
+    auto *const ctx = boost::fibers::context::active();
+    if (ctx == nullptr) {
+        return nullptr;
+    }
+    // PriorityProperties is the only property type installed by the pools
+    return static_cast<fiber::PriorityProperties *>(ctx->get_properties());
+}
+
+MONAD_ANONYMOUS_NAMESPACE_END
+
+MONAD_NAMESPACE_BEGIN
+
+TxnProfile &TxnProfile::operator+=(TxnProfile const &other)
+{
+    evm_cycles += other.evm_cycles;
+    stall_nanos += other.stall_nanos;
+    retry_nanos += other.retry_nanos;
+    db_read_nanos += other.db_read_nanos;
+    precompile_nanos += other.precompile_nanos;
+    for (size_t i = 0; i < PRECOMPILE_SLOTS; ++i) {
+        precompile_addr_nanos[i] += other.precompile_addr_nanos[i];
+    }
+    db_read_count += other.db_read_count;
+    precompile_count += other.precompile_count;
+    retry_count += other.retry_count;
+    return *this;
+}
+
+size_t TxnProfile::precompile_slot(Address const &address)
+{
+    for (size_t i = 0; i < sizeof(address.bytes) - 2; ++i) {
+        if (address.bytes[i] != 0) {
+            return PRECOMPILE_SLOTS;
+        }
+    }
+    uint8_t const hi = address.bytes[sizeof(address.bytes) - 2];
+    uint8_t const lo = address.bytes[sizeof(address.bytes) - 1];
+    if (hi == 0 && lo >= 0x01 && lo <= 0x11) {
+        return lo - 1u;
+    }
+    if (hi == 0x01 && lo == 0x00) {
+        return PRECOMPILE_SLOTS - 1;
+    }
+    return PRECOMPILE_SLOTS;
+}
+
+TxnProfile *active_txn_profile() noexcept
+{
+    auto const *const properties = active_properties();
+    if (properties == nullptr) {
+        return nullptr;
+    }
+    return static_cast<TxnProfile *>(properties->get_local());
+}
+
+TxnProfileScope::TxnProfileScope(TxnProfile &profile)
+    : prev_{active_txn_profile()}
+{
+    if (auto *const properties = active_properties()) {
+        properties->set_local(&profile);
+    }
+}
+
+TxnProfileScope::~TxnProfileScope()
+{
+    if (auto *const properties = active_properties()) {
+        properties->set_local(prev_);
+    }
+}
+
+MONAD_NAMESPACE_END
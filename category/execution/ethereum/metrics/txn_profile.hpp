@@ -0,0 +1,137 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/config.hpp>
+#include <category/execution/ethereum/core/address.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+MONAD_NAMESPACE_BEGIN
+
+// Where a transaction spent its time. It is owned by the block executor,
+// attached to the fiber running the transaction with `TxnProfileScope`, and
+// summed into the block's `BlockMetrics`.
+struct TxnProfile
+{
+    // Precompiles 0x01 - 0x11 and 0x100 (P256VERIFY)
+    static constexpr size_t PRECOMPILE_SLOTS = 18;
+
+    uint64_t evm_cycles{0};
+    uint64_t stall_nanos{0};
+    uint64_t retry_nanos{0};
+    uint64_t db_read_nanos{0};
+    uint64_t precompile_nanos{0};
+    std::array<uint64_t, PRECOMPILE_SLOTS> precompile_addr_nanos{};
+    uint32_t db_read_count{0};
+    uint32_t precompile_count{0};
+    uint32_t retry_count{0};
+
+    TxnProfile &operator+=(TxnProfile const &);
+
+    // Slot of a precompile address in `precompile_addr_nanos`, or
+    // PRECOMPILE_SLOTS if the address has none
+    static size_t precompile_slot(Address const &);
+};
+
+// Profile attached to the current fiber, nullptr if there is none
+TxnProfile *active_txn_profile() noexcept;
+
+class TxnProfileScope
+{
+    TxnProfile *prev_;
+
+public:
+    explicit TxnProfileScope(TxnProfile &);
+    ~TxnProfileScope();
+
+    TxnProfileScope(TxnProfileScope const &) = delete;
+    TxnProfileScope &operator=(TxnProfileScope const &) = delete;
+};
+
+[[gnu::always_inline]] inline uint64_t txn_profile_nanos() noexcept
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+[[gnu::always_inline]] inline uint64_t txn_profile_cycles() noexcept
+{
+#if defined(__x86_64__)
+    return __builtin_ia32_rdtsc();
+#else
+    return txn_profile_nanos();
+#endif
+}
+
+// Adds the duration of a scope to one of the counters of the active profile;
+// does not read the clock when no profile is attached
+class TxnProfileTimer
+{
+    TxnProfile *profile_;
+    uint64_t TxnProfile::*counter_;
+    uint64_t start_;
+
+public:
+    explicit TxnProfileTimer(uint64_t TxnProfile::*const counter) noexcept
+        : profile_{active_txn_profile()}
+        , counter_{counter}
+        , start_{profile_ ? txn_profile_nanos() : 0}
+    {
+    }
+
+    ~TxnProfileTimer()
+    {
+        if (profile_) {
+            profile_->*counter_ += elapsed();
+        }
+    }
+
+    TxnProfileTimer(TxnProfileTimer const &) = delete;
+    TxnProfileTimer &operator=(TxnProfileTimer const &) = delete;
+
+    TxnProfile *profile() const noexcept
+    {
+        return profile_;
+    }
+
+    uint64_t elapsed() const noexcept
+    {
+        return txn_profile_nanos() - start_;
+    }
+};
+
+// Runs an execution attempt, charging its TSC cycles to the active profile.
+// The count includes database reads and precompiles made by the attempt.
+template <typename F>
+auto profiled_evm(F &&execute)
+{
+    TxnProfile *const profile = active_txn_profile();
+    uint64_t const start = profile ? txn_profile_cycles() : 0;
+    auto result = std::forward<F>(execute)();
+    if (profile) {
+        profile->evm_cycles += txn_profile_cycles() - start;
+    }
+    return result;
+}
+
+MONAD_NAMESPACE_END
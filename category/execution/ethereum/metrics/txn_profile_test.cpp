@@ -0,0 +1,114 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/fiber/completion.hpp>
+#include <category/core/fiber/priority_pool.hpp>
+#include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/metrics/block_metrics.hpp>
+#include <category/execution/ethereum/metrics/txn_profile.hpp>
+
+#include <evmc/evmc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <boost/fiber/operations.hpp>
+
+#include <chrono>
+
+using namespace monad;
+using namespace evmc::literals;
+
+TEST(TxnProfile, precompile_slot)
+{
+    EXPECT_EQ(TxnProfile::precompile_slot(0x01_address), 0);
+    EXPECT_EQ(TxnProfile::precompile_slot(0x0a_address), 9);
+    EXPECT_EQ(TxnProfile::precompile_slot(0x11_address), 16);
+    EXPECT_EQ(
+        TxnProfile::precompile_slot(0x0100_address),
+        TxnProfile::PRECOMPILE_SLOTS - 1);
+
+    EXPECT_EQ(
+        TxnProfile::precompile_slot(0x00_address),
+        TxnProfile::PRECOMPILE_SLOTS);
+    EXPECT_EQ(
+        TxnProfile::precompile_slot(0x12_address),
+        TxnProfile::PRECOMPILE_SLOTS);
+    EXPECT_EQ(
+        TxnProfile::precompile_slot(0x1000_address),
+        TxnProfile::PRECOMPILE_SLOTS);
+    EXPECT_EQ(
+        TxnProfile::precompile_slot(0x0101_address),
+        TxnProfile::PRECOMPILE_SLOTS);
+}
+
+TEST(TxnProfile, block_metrics_sum)
+{
+    TxnProfile a{};
+    a.stall_nanos = 3'000;
+    a.db_read_count = 2;
+    a.precompile_addr_nanos[0] = 5;
+    TxnProfile b{};
+    b.stall_nanos = 4'000;
+    b.db_read_count = 1;
+    b.retry_count = 1;
+    b.precompile_addr_nanos[0] = 7;
+
+    BlockMetrics metrics;
+    metrics.add_txn_profile(a);
+    metrics.add_txn_profile(b);
+    EXPECT_EQ(metrics.tx_stall_time(), std::chrono::microseconds{7});
+    EXPECT_EQ(metrics.txn_profile().db_read_count, 3);
+    EXPECT_EQ(metrics.txn_profile().retry_count, 1);
+    EXPECT_EQ(metrics.txn_profile().precompile_addr_nanos[0], 12);
+}
+
+TEST(TxnProfile, follows_fiber)
+{
+    EXPECT_EQ(active_txn_profile(), nullptr);
+    {
+        TxnProfileTimer const timer{&TxnProfile::stall_nanos};
+        EXPECT_EQ(timer.profile(), nullptr);
+    }
+
+    fiber::PriorityPool pool{2, 4};
+    TxnProfile profile{};
+    fiber::Completion done{};
+    pool.submit(0, [&] {
+        TxnProfileScope const scope{profile};
+        EXPECT_EQ(active_txn_profile(), &profile);
+        {
+            TxnProfileTimer const timer{&TxnProfile::db_read_nanos};
+            ASSERT_EQ(timer.profile(), &profile);
+            ++timer.profile()->db_read_count;
+            boost::this_fiber::sleep_for(std::chrono::milliseconds{1});
+        }
+        EXPECT_EQ(active_txn_profile(), &profile);
+        EXPECT_EQ(profiled_evm([] { return 42; }), 42);
+        done.set_value();
+    });
+    done.wait();
+
+    EXPECT_EQ(profile.db_read_count, 1);
+    EXPECT_GE(profile.db_read_nanos, 1'000'000);
+    EXPECT_GT(profile.evm_cycles, 0);
+
+    // The pool detaches the profile once the task is done
+    fiber::Completion detached{};
+    pool.submit(0, [&] {
+        EXPECT_EQ(active_txn_profile(), nullptr);
+        detached.set_value();
+    });
+    detached.wait();
+}
@@ -0,0 +1,163 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/blake3.hpp>
+#include <category/core/byte_string.hpp>
+#include <category/core/bytes.hpp>
+#include <category/core/config.hpp>
+#include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/precompile_cache.hpp>
+#include <category/execution/ethereum/precompiles.hpp>
+
+#include <evmc/evmc.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <format>
+#include <optional>
+#include <string>
+
+MONAD_NAMESPACE_BEGIN
+
+namespace
+{
+    std::atomic<PrecompileCache *> precompile_cache{nullptr};
+}
+
+size_t PrecompileCache::KeyHashCompare::hash(Key const &key) const
+{
+    // the input hash is already uniformly distributed, fold in the rest of
+    // the key so the same input to different precompiles spreads out
+    uint64_t h;
+    std::memcpy(&h, key.input_hash.bytes, sizeof(h));
+    uint64_t a;
+    std::memcpy(&a, key.address.bytes + sizeof(Address) - sizeof(a), sizeof(a));
+    return h ^ (a * 0x9e3779b97f4a7c15ULL) ^
+           static_cast<uint64_t>(key.revision);
+}
+
+bool PrecompileCache::KeyHashCompare::equal(Key const &x, Key const &y) const
+{
+    return x == y;
+}
+
+PrecompileCache::PrecompileCache(uint32_t const max_bytes)
+    : weight_cache_{max_bytes}
+{
+}
+
+bool PrecompileCache::is_cacheable(Address const &address)
+{
+    // MODEXP, SNARKV, point evaluation, BLS12 G1/G2 MSM and pairing check.
+    // The cheap precompiles cost about as much as hashing their input.
+    return address == Address{0x05} || address == Address{0x08} ||
+           address == Address{0x0A} || address == Address{0x0C} ||
+           address == Address{0x0E} || address == Address{0x0F};
+}
+
+PrecompileCache::Key PrecompileCache::make_key(
+    Address const &address, evmc_revision const revision,
+    byte_string_view const input)
+{
+    return Key{
+        .address = address,
+        .revision = revision,
+        .input_hash = to_bytes(blake3(input))};
+}
+
+uint32_t PrecompileCache::output_size_to_cache_weight(size_t const output_size)
+{
+    // Output bytes plus the key, list links and hash map node
+    return static_cast<uint32_t>(output_size) + 128;
+}
+
+std::optional<PrecompileResult> PrecompileCache::find(Key const &key)
+{
+    WeightCache::ConstAccessor acc;
+    if (!weight_cache_.find(acc, key)) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    Value const &value = acc->second.value_;
+    if (value.output.empty()) {
+        return PrecompileResult{
+            .status_code = value.status_code,
+            .obuf = nullptr,
+            .output_size = 0};
+    }
+    auto *const obuf = static_cast<uint8_t *>(std::malloc(value.output.size()));
+    MONAD_ASSERT(obuf != nullptr);
+    std::memcpy(obuf, value.output.data(), value.output.size());
+    return PrecompileResult{
+        .status_code = value.status_code,
+        .obuf = obuf,
+        .output_size = value.output.size()};
+}
+
+void PrecompileCache::insert(Key const &key, PrecompileResult const &result)
+{
+    inserts_.fetch_add(1, std::memory_order_relaxed);
+    weight_cache_.insert(
+        key,
+        Value{
+            .status_code = result.status_code,
+            .output = result.output_size
+                          ? byte_string{result.obuf, result.output_size}
+                          : byte_string{}},
+        output_size_to_cache_weight(result.output_size));
+}
+
+PrecompileCache::Stats PrecompileCache::stats() const
+{
+    return Stats{
+        .hits = hits_.load(std::memory_order_relaxed),
+        .misses = misses_.load(std::memory_order_relaxed),
+        .inserts = inserts_.load(std::memory_order_relaxed),
+        .entries = weight_cache_.size(),
+        .bytes = weight_cache_.approx_weight()};
+}
+
+std::string PrecompileCache::print_stats() const
+{
+    auto const s = stats();
+    auto const lookups = s.hits + s.misses;
+    return std::format(
+        ",precompile_cache_hits={},precompile_cache_misses={},"
+        "precompile_cache_hit_rate={:.2f}%,precompile_cache_entries={},"
+        "precompile_cache_bytes={}",
+        s.hits,
+        s.misses,
+        lookups ? 100.0 * static_cast<double>(s.hits) /
+                      static_cast<double>(lookups)
+                : 0.0,
+        s.entries,
+        s.bytes);
+}
+
+void set_precompile_cache(PrecompileCache *const cache)
+{
+    precompile_cache.store(cache, std::memory_order_release);
+}
+
+PrecompileCache *get_precompile_cache()
+{
+    return precompile_cache.load(std::memory_order_acquire);
+}
+
+MONAD_NAMESPACE_END
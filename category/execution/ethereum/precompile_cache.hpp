@@ -0,0 +1,113 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/byte_string.hpp>
+#include <category/core/bytes.hpp>
+#include <category/core/config.hpp>
+#include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/precompiles.hpp>
+#include <category/vm/utils/lru_weight_cache.hpp>
+
+#include <evmc/evmc.h>
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+MONAD_NAMESPACE_BEGIN
+
+/// Content-addressed cache of precompile results, keyed by (address,
+/// revision, blake3(input)). Only pure precompiles whose execution cost
+/// dwarfs hashing the input are cached; gas is never cached and is always
+/// charged by the caller exactly as without the cache.
+class PrecompileCache
+{
+public:
+    static constexpr uint32_t default_max_bytes = uint32_t{64} << 20;
+
+    struct Key
+    {
+        Address address;
+        evmc_revision revision;
+        bytes32_t input_hash;
+
+        bool operator==(Key const &) const = default;
+    };
+
+    struct KeyHashCompare
+    {
+        size_t hash(Key const &) const;
+        bool equal(Key const &, Key const &) const;
+    };
+
+    struct Value
+    {
+        evmc_status_code status_code;
+        byte_string output;
+    };
+
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t inserts;
+        size_t entries;
+        uint64_t bytes;
+    };
+
+private:
+    using WeightCache = vm::utils::LruWeightCache<Key, Value, KeyHashCompare>;
+
+    WeightCache weight_cache_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> inserts_{0};
+
+public:
+    explicit PrecompileCache(uint32_t max_bytes = default_max_bytes);
+
+    PrecompileCache(PrecompileCache const &) = delete;
+    PrecompileCache &operator=(PrecompileCache const &) = delete;
+
+    /// Whether results of the precompile at `address` are worth caching.
+    static bool is_cacheable(Address const &address);
+
+    static Key make_key(Address const &, evmc_revision, byte_string_view input);
+
+    /// On hit, returns a copy of the cached result with a freshly malloc'd
+    /// output buffer owned by the caller.
+    std::optional<PrecompileResult> find(Key const &);
+
+    void insert(Key const &, PrecompileResult const &);
+
+    Stats stats() const;
+
+    std::string print_stats() const;
+
+    // Cache weight of an entry with the given output size
+    static uint32_t output_size_to_cache_weight(size_t output_size);
+};
+
+/// Install a process-wide precompile cache consulted by
+/// check_call_eth_precompile. Passing nullptr disables caching, which is the
+/// default. The cache must outlive all execution using it.
+void set_precompile_cache(PrecompileCache *);
+
+PrecompileCache *get_precompile_cache();
+
+MONAD_NAMESPACE_END
@@ -18,6 +18,8 @@
 #include <category/core/config.hpp>
 #include <category/core/likely.h>
 #include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/metrics/txn_profile.hpp>
+#include <category/execution/ethereum/precompile_cache.hpp>
 #include <category/execution/ethereum/precompiles.hpp>
 #include <category/execution/ethereum/state3/state.hpp>
 #include <category/vm/evm/explicit_traits.hpp>
@@ -144,7 +146,29 @@ std::optional<evmc::Result> check_call_eth_precompile(evmc_message const &msg)
         return evmc::Result{evmc_status_code::EVMC_OUT_OF_GAS};
     }
 
-    auto const [status_code, output_buffer, output_size] = execute_func(input);
+    TxnProfileTimer const timer{&TxnProfile::precompile_nanos};
+    auto const [status_code, output_buffer, output_size] = [&] {
+        PrecompileCache *const cache = get_precompile_cache();
+        if (MONAD_LIKELY(
+                cache == nullptr || !PrecompileCache::is_cacheable(address))) {
+            return execute_func(input);
+        }
+        auto const key =
+            PrecompileCache::make_key(address, traits::evm_rev(), input);
+        if (auto const cached = cache->find(key)) {
+            return *cached;
+        }
+        auto const result = execute_func(input);
+        cache->insert(key, result);
+        return result;
+    }();
+    if (auto *const profile = timer.profile()) {
+        ++profile->precompile_count;
+        if (auto const slot = TxnProfile::precompile_slot(address);
+            slot < TxnProfile::PRECOMPILE_SLOTS) {
+            profile->precompile_addr_nanos[slot] += timer.elapsed();
+        }
+    }
     return evmc::Result{evmc_result{
         .status_code = status_code,
         .gas_left = (status_code == EVMC_SUCCESS)
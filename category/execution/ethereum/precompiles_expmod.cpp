@@ -0,0 +1,430 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/config.hpp>
+#include <category/execution/ethereum/precompiles_expmod.hpp>
+#include <category/vm/runtime/uint256.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+MONAD_NAMESPACE_BEGIN
+
+namespace expmod
+{
+    namespace
+    {
+        using vm::runtime::addc;
+        using vm::runtime::subb;
+        using vm::runtime::uint128_t;
+
+        // Returns the low word of t + a * b + carry and leaves the high word
+        // in carry
+        [[gnu::always_inline]] inline uint64_t mac(
+            uint64_t const t, uint64_t const a, uint64_t const b,
+            uint64_t &carry)
+        {
+            uint128_t const x = uint128_t{a} * b + t + carry;
+            carry = static_cast<uint64_t>(x >> 64);
+            return static_cast<uint64_t>(x);
+        }
+
+        // A big-endian operand of the precompile input. Bytes past the end of
+        // the input read as zero.
+        struct Operand
+        {
+            byte_string_view input;
+            size_t offset;
+            size_t size;
+
+            uint8_t byte(size_t const i) const
+            {
+                return offset + i < input.size() ? input[offset + i] : 0;
+            }
+
+            size_t bit_width() const
+            {
+                for (size_t i = 0; i < size; ++i) {
+                    if (uint8_t const b = byte(i); b != 0) {
+                        return 8 * (size - i - 1) +
+                               static_cast<size_t>(std::bit_width(b));
+                    }
+                }
+                return 0;
+            }
+
+            bool bit(size_t const i) const
+            {
+                return (byte(size - 1 - i / 8) >> (i % 8)) & 1;
+            }
+
+            // Little-endian limbs of the value, zero extended to `count`
+            std::vector<uint64_t> limbs(size_t const count) const
+            {
+                MONAD_ASSERT(count * 8 >= size);
+                std::vector<uint64_t> r(count, 0);
+                for (size_t i = 0; i < size; ++i) {
+                    r[i / 8] |= uint64_t{byte(size - 1 - i)} << (8 * (i % 8));
+                }
+                return r;
+            }
+        };
+
+        // x mod m, for m with a nonzero top limb, by schoolbook division
+        std::vector<uint64_t>
+        reduce(std::vector<uint64_t> x, std::vector<uint64_t> const &m)
+        {
+            size_t const n = m.size();
+            size_t k = x.size();
+            while (k > 0 && x[k - 1] == 0) {
+                --k;
+            }
+            if (k < n) {
+                // below 2^(64(n - 1)) <= m
+                x.resize(n);
+                return x;
+            }
+
+            std::vector<uint64_t> quot(k - n + 1);
+            if (n == 1) {
+                return {vm::runtime::long_div(k, x.data(), m[0], quot.data())};
+            }
+
+            // normalize so that the top bit of the divisor is set, with an
+            // extra numerator word for the bits shifted out
+            auto const shift = static_cast<uint8_t>(std::countl_zero(m.back()));
+            std::vector<uint64_t> u(k + 1);
+            u[0] = x[0] << shift;
+            for (size_t i = 1; i < k; ++i) {
+                u[i] = vm::runtime::shld(x[i], x[i - 1], shift);
+            }
+            u[k] = x[k - 1] >> 1 >> (63 - shift);
+            std::vector<uint64_t> v(n);
+            v[0] = m[0] << shift;
+            for (size_t i = 1; i < n; ++i) {
+                v[i] = vm::runtime::shld(m[i], m[i - 1], shift);
+            }
+
+            vm::runtime::knuth_div(k, u.data(), n, v.data(), quot.data());
+
+            std::vector<uint64_t> r(n);
+            for (size_t i = 0; i + 1 < n; ++i) {
+                r[i] = vm::runtime::shrd(u[i + 1], u[i], shift);
+            }
+            r[n - 1] = u[n - 1] >> shift;
+            return r;
+        }
+
+        // Montgomery arithmetic modulo an odd m > 1 with R = 2^(64n), where n
+        // is the limb count of m. N is that limb count when it is one of the
+        // common RSA and field sizes, so that the inner loops have constant
+        // trip counts, and 0 otherwise.
+        template <size_t N>
+        class Montgomery
+        {
+            size_t n_;
+            std::vector<uint64_t> m_;
+            uint64_t inv_; // -m^-1 mod 2^64
+            std::vector<uint64_t> t_; // double width product
+
+            // r = t / R mod m, fully reduced, for t < mR
+            void redc(uint64_t *const r)
+            {
+                size_t const n = limbs();
+                uint64_t *const t = t_.data();
+                uint64_t const *const m = m_.data();
+                bool top = false;
+                for (size_t i = 0; i < n; ++i) {
+                    uint64_t const q = t[i] * inv_;
+                    uint64_t c = 0;
+#pragma GCC unroll(4)
+                    for (size_t j = 0; j < n; ++j) {
+                        t[i + j] = mac(t[i + j], q, m[j], c);
+                    }
+                    auto const [s, carry] = addc(t[i + n], c, top);
+                    t[i + n] = s;
+                    top = carry;
+                }
+                // t / R < 2m here
+                std::copy_n(t + n, n, r);
+                if (top || !less_than_m(r)) {
+                    subtract_m(r);
+                }
+            }
+
+            bool less_than_m(uint64_t const *const a) const
+            {
+                bool borrow = false;
+                for (size_t j = 0; j < limbs(); ++j) {
+                    borrow = subb(a[j], m_[j], borrow).carry;
+                }
+                return borrow;
+            }
+
+            void subtract_m(uint64_t *const a) const
+            {
+                bool borrow = false;
+                for (size_t j = 0; j < limbs(); ++j) {
+                    auto const [d, b] = subb(a[j], m_[j], borrow);
+                    a[j] = d;
+                    borrow = b;
+                }
+            }
+
+        public:
+            std::vector<uint64_t> one; // R mod m
+            std::vector<uint64_t> r2; // R^2 mod m
+
+            explicit Montgomery(std::vector<uint64_t> m)
+                : n_{m.size()}
+                , m_{std::move(m)}
+                , t_(2 * n_)
+            {
+                MONAD_ASSERT(N == 0 || N == n_);
+                MONAD_ASSERT(n_ > 0 && (m_[0] & 1) && m_.back() != 0);
+
+                // Newton's iteration doubles the number of correct low bits
+                uint64_t inv = 1;
+                for (size_t i = 0; i < 6; ++i) {
+                    inv *= 2 - m_[0] * inv;
+                }
+                inv_ = 0 - inv;
+
+                std::vector<uint64_t> x(2 * n_ + 1, 0);
+                x[n_] = 1;
+                one = reduce(x, m_);
+                x[n_] = 0;
+                x[2 * n_] = 1;
+                r2 = reduce(std::move(x), m_);
+            }
+
+            size_t limbs() const
+            {
+                if constexpr (N != 0) {
+                    return N;
+                }
+                else {
+                    return n_;
+                }
+            }
+
+            // r = a * b / R mod m, fully reduced, for a, b < m. r may alias a
+            // or b.
+            void mul(uint64_t *const r, uint64_t const *const a,
+                     uint64_t const *const b)
+            {
+                size_t const n = limbs();
+                uint64_t *const t = t_.data();
+                std::fill_n(t, n, 0);
+                for (size_t i = 0; i < n; ++i) {
+                    uint64_t const bi = b[i];
+                    uint64_t c = 0;
+#pragma GCC unroll(4)
+                    for (size_t j = 0; j < n; ++j) {
+                        t[i + j] = mac(t[i + j], a[j], bi, c);
+                    }
+                    t[i + n] = c;
+                }
+                redc(r);
+            }
+
+            // r = a^2 / R mod m, computing each cross product once. r may
+            // alias a.
+            void sqr(uint64_t *const r, uint64_t const *const a)
+            {
+                size_t const n = limbs();
+                uint64_t *const t = t_.data();
+                std::fill_n(t, 2 * n, 0);
+                for (size_t i = 0; i < n; ++i) {
+                    uint64_t const ai = a[i];
+                    uint64_t c = 0;
+#pragma GCC unroll(4)
+                    for (size_t j = i + 1; j < n; ++j) {
+                        t[i + j] = mac(t[i + j], a[j], ai, c);
+                    }
+                    t[i + n] = c;
+                }
+
+                // double the cross products and add the squares
+                bool carry = false;
+                uint64_t shifted_out = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    uint128_t const d = uint128_t{a[i]} * a[i];
+                    uint64_t const lo = t[2 * i];
+                    uint64_t const hi = t[2 * i + 1];
+                    auto const [s0, c0] = addc(
+                        (lo << 1) | shifted_out, static_cast<uint64_t>(d),
+                        carry);
+                    auto const [s1, c1] = addc(
+                        (hi << 1) | (lo >> 63),
+                        static_cast<uint64_t>(d >> 64),
+                        c0);
+                    t[2 * i] = s0;
+                    t[2 * i + 1] = s1;
+                    carry = c1;
+                    shifted_out = hi >> 63;
+                }
+                redc(r);
+            }
+        };
+
+        // Left-to-right sliding window exponentiation. Inputs are public, so
+        // windows and the squarings before the first one are skipped freely.
+        template <size_t N>
+        byte_string powmod(
+            std::vector<uint64_t> m, Operand const &base, Operand const &exp,
+            size_t const mod_size)
+        {
+            size_t const bits = exp.bit_width();
+            std::vector<uint64_t> x =
+                reduce(base.limbs((base.size + 7) / 8), m);
+            bool const zero_base = std::ranges::all_of(
+                x, [](uint64_t const limb) { return limb == 0; });
+            if (bits > 0 && zero_base) {
+                return byte_string(mod_size, 0);
+            }
+
+            Montgomery<N> mont{std::move(m)};
+            size_t const n = mont.limbs();
+            mont.mul(x.data(), x.data(), mont.r2.data());
+
+            size_t const w = bits > 671  ? 6
+                             : bits > 239 ? 5
+                             : bits > 79  ? 4
+                             : bits > 23  ? 3
+                                          : 1;
+
+            // table holds base^1, base^3, ..., base^(2^w - 1)
+            std::vector<uint64_t> table((size_t{1} << (w - 1)) * n);
+            std::copy_n(x.data(), n, table.data());
+            if (w > 1) {
+                mont.sqr(x.data(), x.data());
+                for (size_t k = 1; k < (size_t{1} << (w - 1)); ++k) {
+                    mont.mul(
+                        table.data() + k * n,
+                        table.data() + (k - 1) * n,
+                        x.data());
+                }
+            }
+
+            std::vector<uint64_t> acc = mont.one;
+            bool started = false;
+            for (size_t i = bits; i > 0;) {
+                if (!exp.bit(i - 1)) {
+                    mont.sqr(acc.data(), acc.data());
+                    --i;
+                    continue;
+                }
+                // the longest window of bits [j, i) that is at most w long and
+                // ends in a set bit
+                size_t j = i > w ? i - w : 0;
+                while (!exp.bit(j)) {
+                    ++j;
+                }
+                size_t value = 0;
+                for (size_t k = i; k-- > j;) {
+                    value = (value << 1) | exp.bit(k);
+                }
+                uint64_t const *const power = table.data() + (value >> 1) * n;
+                if (started) {
+                    for (size_t k = j; k < i; ++k) {
+                        mont.sqr(acc.data(), acc.data());
+                    }
+                    mont.mul(acc.data(), acc.data(), power);
+                }
+                else {
+                    std::copy_n(power, n, acc.data());
+                    started = true;
+                }
+                i = j;
+            }
+
+            // out of the Montgomery domain
+            std::vector<uint64_t> plain_one(n, 0);
+            plain_one[0] = 1;
+            mont.mul(acc.data(), acc.data(), plain_one.data());
+
+            byte_string output(mod_size, 0);
+            for (size_t i = 0; i < std::min(mod_size, 8 * n); ++i) {
+                output[mod_size - 1 - i] =
+                    static_cast<uint8_t>(acc[i / 8] >> (8 * (i % 8)));
+            }
+            return output;
+        }
+    }
+
+    std::optional<byte_string> execute(byte_string_view const input)
+    {
+        Operand const header{input, 0, 96};
+        size_t lengths[3];
+        for (size_t k = 0; k < 3; ++k) {
+            // lengths which do not fit in 32 bits cannot be paid for, leave
+            // them to the generic implementation
+            for (size_t i = 0; i < 28; ++i) {
+                if (header.byte(32 * k + i) != 0) {
+                    return std::nullopt;
+                }
+            }
+            lengths[k] = 0;
+            for (size_t i = 28; i < 32; ++i) {
+                lengths[k] = (lengths[k] << 8) | header.byte(32 * k + i);
+            }
+        }
+        auto const [base_size, exp_size, mod_size] = lengths;
+        if (base_size == 0 && mod_size == 0) {
+            return byte_string{};
+        }
+
+        Operand const base{input, 96, base_size};
+        Operand const exp{input, 96 + base_size, exp_size};
+        Operand const mod{input, 96 + base_size + exp_size, mod_size};
+
+        size_t const mod_bits = mod.bit_width();
+        if (mod_bits <= 1) {
+            // x mod 0 is defined as 0, and x mod 1 is 0
+            return byte_string(mod_size, 0);
+        }
+        if (!mod.bit(0)) {
+            return std::nullopt;
+        }
+
+        size_t const n = (mod_bits + 63) / 64;
+        std::vector<uint64_t> m = mod.limbs((mod_size + 7) / 8);
+        m.resize(n);
+        switch (n) {
+        case 4:
+            return powmod<4>(std::move(m), base, exp, mod_size);
+        case 8:
+            return powmod<8>(std::move(m), base, exp, mod_size);
+        case 16:
+            return powmod<16>(std::move(m), base, exp, mod_size);
+        case 32:
+            return powmod<32>(std::move(m), base, exp, mod_size);
+        case 64:
+            return powmod<64>(std::move(m), base, exp, mod_size);
+        default:
+            return powmod<0>(std::move(m), base, exp, mod_size);
+        }
+    }
+} // namespace expmod
+
+MONAD_NAMESPACE_END
@@ -0,0 +1,34 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/byte_string.hpp>
+#include <category/core/config.hpp>
+
+#include <optional>
+
+MONAD_NAMESPACE_BEGIN
+
+namespace expmod
+{
+    // Evaluates the MODEXP precompile (EIP-198) with Montgomery arithmetic,
+    // returning an output of the modulus length. Montgomery reduction needs
+    // an odd modulus, so this returns std::nullopt for nonzero even moduli;
+    // the caller falls back to the generic big integer implementation.
+    std::optional<byte_string> execute(byte_string_view input);
+} // namespace expmod
+
+MONAD_NAMESPACE_END
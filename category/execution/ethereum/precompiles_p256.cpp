@@ -0,0 +1,549 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/config.hpp>
+#include <category/execution/ethereum/precompiles_p256.hpp>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <vector>
+
+MONAD_NAMESPACE_BEGIN
+
+namespace p256
+{
+    namespace
+    {
+        using uint128_t = unsigned __int128;
+
+        // 256 bit integers as little-endian 64 bit limbs. All the arithmetic
+        // below is written in terms of 64x64->128 bit products, which the
+        // compiler lowers to mulx/adc chains on the targets we build for.
+        using Limbs = std::array<uint64_t, 4>;
+
+        [[gnu::always_inline]] constexpr uint64_t
+        addc(uint64_t const a, uint64_t const b, uint64_t &carry)
+        {
+            uint128_t const t = uint128_t{a} + b + carry;
+            carry = static_cast<uint64_t>(t >> 64);
+            return static_cast<uint64_t>(t);
+        }
+
+        [[gnu::always_inline]] constexpr uint64_t
+        subb(uint64_t const a, uint64_t const b, uint64_t &borrow)
+        {
+            uint128_t const t = uint128_t{a} - b - borrow;
+            borrow = static_cast<uint64_t>(t >> 127);
+            return static_cast<uint64_t>(t);
+        }
+
+        // Returns the low word of t + a * b + carry and leaves the high word
+        // in carry
+        [[gnu::always_inline]] constexpr uint64_t mac(
+            uint64_t const t, uint64_t const a, uint64_t const b,
+            uint64_t &carry)
+        {
+            uint128_t const x = uint128_t{a} * b + t + carry;
+            carry = static_cast<uint64_t>(x >> 64);
+            return static_cast<uint64_t>(x);
+        }
+
+        [[gnu::always_inline]] constexpr Limbs
+        add(Limbs const &a, Limbs const &b, uint64_t &carry)
+        {
+            Limbs r;
+            carry = 0;
+#pragma GCC unroll(4)
+            for (size_t i = 0; i < 4; ++i) {
+                r[i] = addc(a[i], b[i], carry);
+            }
+            return r;
+        }
+
+        [[gnu::always_inline]] constexpr Limbs
+        sub(Limbs const &a, Limbs const &b, uint64_t &borrow)
+        {
+            Limbs r;
+            borrow = 0;
+#pragma GCC unroll(4)
+            for (size_t i = 0; i < 4; ++i) {
+                r[i] = subb(a[i], b[i], borrow);
+            }
+            return r;
+        }
+
+        constexpr bool less(Limbs const &a, Limbs const &b)
+        {
+            uint64_t borrow;
+            (void)sub(a, b, borrow);
+            return borrow;
+        }
+
+        constexpr bool is_zero(Limbs const &a)
+        {
+            return (a[0] | a[1] | a[2] | a[3]) == 0;
+        }
+
+        Limbs load(uint8_t const *const bytes)
+        {
+            Limbs r;
+#pragma GCC unroll(4)
+            for (size_t i = 0; i < 4; ++i) {
+                uint64_t w;
+                std::memcpy(&w, bytes + 8 * (3 - i), sizeof(w));
+                r[i] = std::byteswap(w);
+            }
+            return r;
+        }
+
+        // Constants for Montgomery arithmetic modulo an odd m > 2^255
+        struct Modulus
+        {
+            Limbs m;
+            uint64_t inv; // -m^-1 mod 2^64
+            Limbs one; // 2^256 mod m, i.e. 1 in Montgomery form
+            Limbs r2; // 2^512 mod m, for converting into Montgomery form
+        };
+
+        constexpr Limbs double_mod(Limbs const &a, Limbs const &m)
+        {
+            uint64_t carry;
+            Limbs const r = add(a, a, carry);
+            uint64_t borrow;
+            Limbs const s = sub(r, m, borrow);
+            return (carry || !borrow) ? s : r;
+        }
+
+        constexpr Modulus make_modulus(Limbs const &m)
+        {
+            // Newton's iteration doubles the number of correct low bits
+            uint64_t inv = 1;
+            for (size_t i = 0; i < 6; ++i) {
+                inv *= 2 - m[0] * inv;
+            }
+            Limbs one{1, 0, 0, 0};
+            for (size_t i = 0; i < 256; ++i) {
+                one = double_mod(one, m);
+            }
+            Limbs r2 = one;
+            for (size_t i = 0; i < 256; ++i) {
+                r2 = double_mod(r2, m);
+            }
+            return {.m = m, .inv = 0 - inv, .one = one, .r2 = r2};
+        }
+
+        // Computes a * b / 2^256 mod m for a < 2^256 and b < m, fully reduced
+        [[gnu::always_inline]] constexpr Limbs
+        mont_mul(Limbs const &a, Limbs const &b, Modulus const &mod)
+        {
+            uint64_t t[6] = {};
+#pragma GCC unroll(4)
+            for (size_t i = 0; i < 4; ++i) {
+                uint64_t c = 0;
+#pragma GCC unroll(4)
+                for (size_t j = 0; j < 4; ++j) {
+                    t[j] = mac(t[j], a[j], b[i], c);
+                }
+                uint64_t c2 = 0;
+                t[4] = addc(t[4], c, c2);
+                t[5] = c2;
+
+                uint64_t const q = t[0] * mod.inv;
+                c = 0;
+                (void)mac(t[0], q, mod.m[0], c);
+#pragma GCC unroll(4)
+                for (size_t j = 1; j < 4; ++j) {
+                    t[j - 1] = mac(t[j], q, mod.m[j], c);
+                }
+                c2 = 0;
+                t[3] = addc(t[4], c, c2);
+                t[4] = t[5] + c2;
+            }
+            Limbs const r{t[0], t[1], t[2], t[3]};
+            uint64_t borrow;
+            Limbs const s = sub(r, mod.m, borrow);
+            return (t[4] || !borrow) ? s : r;
+        }
+
+        [[gnu::always_inline]] constexpr Limbs
+        add_mod(Limbs const &a, Limbs const &b, Modulus const &mod)
+        {
+            uint64_t carry;
+            Limbs const r = add(a, b, carry);
+            uint64_t borrow;
+            Limbs const s = sub(r, mod.m, borrow);
+            return (carry || !borrow) ? s : r;
+        }
+
+        [[gnu::always_inline]] constexpr Limbs
+        sub_mod(Limbs const &a, Limbs const &b, Modulus const &mod)
+        {
+            uint64_t borrow;
+            Limbs const r = sub(a, b, borrow);
+            if (!borrow) {
+                return r;
+            }
+            uint64_t carry;
+            return add(r, mod.m, carry);
+        }
+
+        constexpr Limbs to_mont(Limbs const &a, Modulus const &mod)
+        {
+            return mont_mul(a, mod.r2, mod);
+        }
+
+        // Fermat inversion a^(m - 2) of a nonzero a in Montgomery form
+        Limbs mont_inv(Limbs const &a, Modulus const &mod)
+        {
+            Limbs e = mod.m;
+            e[0] -= 2;
+            Limbs r = mod.one;
+            for (size_t i = 256; i-- > 0;) {
+                r = mont_mul(r, r, mod);
+                if ((e[i / 64] >> (i % 64)) & 1) {
+                    r = mont_mul(r, a, mod);
+                }
+            }
+            return r;
+        }
+
+        // Inverts every element of xs in place with a single field inversion
+        // (Montgomery's trick). All elements must be nonzero.
+        void batch_inv(std::span<Limbs> const xs, Modulus const &mod)
+        {
+            if (xs.empty()) {
+                return;
+            }
+            std::vector<Limbs> prefix(xs.size());
+            prefix[0] = xs[0];
+            for (size_t i = 1; i < xs.size(); ++i) {
+                prefix[i] = mont_mul(prefix[i - 1], xs[i], mod);
+            }
+            Limbs inv = mont_inv(prefix.back(), mod);
+            for (size_t i = xs.size(); i-- > 1;) {
+                Limbs const x = xs[i];
+                xs[i] = mont_mul(inv, prefix[i - 1], mod);
+                inv = mont_mul(inv, x, mod);
+            }
+            xs[0] = inv;
+        }
+
+        constexpr Modulus P = make_modulus(
+            {0xffffffffffffffff,
+             0x00000000ffffffff,
+             0x0000000000000000,
+             0xffffffff00000001});
+
+        constexpr Modulus N = make_modulus(
+            {0xf3b9cac2fc632551,
+             0xbce6faada7179e84,
+             0xffffffffffffffff,
+             0xffffffff00000000});
+
+        constexpr Limbs B = to_mont(
+            {0x3bce3c3e27d2604b,
+             0x651d06b0cc53b0f6,
+             0xb3ebbd55769886bc,
+             0x5ac635d8aa3a93e7},
+            P);
+
+        constexpr Limbs GX = to_mont(
+            {0xf4a13945d898c296,
+             0x77037d812deb33a0,
+             0xf8bce6e563a440f2,
+             0x6b17d1f2e12c4247},
+            P);
+
+        constexpr Limbs GY = to_mont(
+            {0xcbb6406837bf51f5,
+             0x2bce33576b315ece,
+             0x8ee7eb4a7c0f9e16,
+             0x4fe342e2fe1a7f9b},
+            P);
+
+        // Field operations modulo p, on elements in Montgomery form
+        [[gnu::always_inline]] inline Limbs
+        fmul(Limbs const &a, Limbs const &b)
+        {
+            return mont_mul(a, b, P);
+        }
+
+        [[gnu::always_inline]] inline Limbs fsqr(Limbs const &a)
+        {
+            return mont_mul(a, a, P);
+        }
+
+        [[gnu::always_inline]] inline Limbs
+        fadd(Limbs const &a, Limbs const &b)
+        {
+            return add_mod(a, b, P);
+        }
+
+        [[gnu::always_inline]] inline Limbs
+        fsub(Limbs const &a, Limbs const &b)
+        {
+            return sub_mod(a, b, P);
+        }
+
+        struct Affine
+        {
+            Limbs x;
+            Limbs y;
+        };
+
+        // (X, Y, Z) represents (X / Z^2, Y / Z^3); Z = 0 is the point at
+        // infinity
+        struct Jacobian
+        {
+            Limbs x{};
+            Limbs y{};
+            Limbs z{};
+        };
+
+        // dbl-2001-b, which relies on a = -3
+        Jacobian dbl(Jacobian const &p)
+        {
+            if (is_zero(p.z)) {
+                return p;
+            }
+            Limbs const delta = fsqr(p.z);
+            Limbs const gamma = fsqr(p.y);
+            Limbs const beta = fmul(p.x, gamma);
+            Limbs alpha = fmul(fsub(p.x, delta), fadd(p.x, delta));
+            alpha = fadd(alpha, fadd(alpha, alpha));
+            Limbs const beta4 = fadd(fadd(beta, beta), fadd(beta, beta));
+            Jacobian r;
+            r.x = fsub(fsqr(alpha), fadd(beta4, beta4));
+            r.z = fsub(fsub(fsqr(fadd(p.y, p.z)), gamma), delta);
+            Limbs const gamma2 = fsqr(gamma);
+            Limbs const gamma8 =
+                fadd(fadd(fadd(gamma2, gamma2), fadd(gamma2, gamma2)),
+                     fadd(fadd(gamma2, gamma2), fadd(gamma2, gamma2)));
+            r.y = fsub(fmul(alpha, fsub(beta4, r.x)), gamma8);
+            return r;
+        }
+
+        // add-2007-bl
+        Jacobian add(Jacobian const &p, Jacobian const &q)
+        {
+            if (is_zero(p.z)) {
+                return q;
+            }
+            if (is_zero(q.z)) {
+                return p;
+            }
+            Limbs const z1z1 = fsqr(p.z);
+            Limbs const z2z2 = fsqr(q.z);
+            Limbs const u1 = fmul(p.x, z2z2);
+            Limbs const u2 = fmul(q.x, z1z1);
+            Limbs const s1 = fmul(fmul(p.y, q.z), z2z2);
+            Limbs const s2 = fmul(fmul(q.y, p.z), z1z1);
+            Limbs const h = fsub(u2, u1);
+            Limbs r = fsub(s2, s1);
+            if (is_zero(h)) {
+                return is_zero(r) ? dbl(p) : Jacobian{};
+            }
+            r = fadd(r, r);
+            Limbs const i = fsqr(fadd(h, h));
+            Limbs const j = fmul(h, i);
+            Limbs const v = fmul(u1, i);
+            Jacobian t;
+            t.x = fsub(fsub(fsqr(r), j), fadd(v, v));
+            t.y = fsub(fmul(r, fsub(v, t.x)), fmul(fadd(s1, s1), j));
+            t.z = fmul(fsub(fsub(fsqr(fadd(p.z, q.z)), z1z1), z2z2), h);
+            return t;
+        }
+
+        // madd-2007-bl, adding a point with Z = 1
+        Jacobian add(Jacobian const &p, Affine const &q)
+        {
+            if (is_zero(p.z)) {
+                return {q.x, q.y, P.one};
+            }
+            Limbs const z1z1 = fsqr(p.z);
+            Limbs const u2 = fmul(q.x, z1z1);
+            Limbs const s2 = fmul(fmul(q.y, p.z), z1z1);
+            Limbs const h = fsub(u2, p.x);
+            Limbs r = fsub(s2, p.y);
+            if (is_zero(h)) {
+                return is_zero(r) ? dbl(p) : Jacobian{};
+            }
+            r = fadd(r, r);
+            Limbs const hh = fsqr(h);
+            Limbs const i = fadd(fadd(hh, hh), fadd(hh, hh));
+            Limbs const j = fmul(h, i);
+            Limbs const v = fmul(p.x, i);
+            Jacobian t;
+            t.x = fsub(fsub(fsqr(r), j), fadd(v, v));
+            t.y = fsub(fmul(r, fsub(v, t.x)), fmul(fadd(p.y, p.y), j));
+            t.z = fsub(fsub(fsqr(fadd(p.z, h)), z1z1), hh);
+            return t;
+        }
+
+        // The generator is consumed a byte of its scalar at a time, so the
+        // table holds k * G for every k < 256 in affine form. Entry 0 is
+        // unused.
+        using GeneratorTable = std::array<Affine, 256>;
+
+        GeneratorTable const &generator_table()
+        {
+            static GeneratorTable const table = [] {
+                Affine const g{GX, GY};
+                std::vector<Jacobian> multiples(256);
+                multiples[1] = {GX, GY, P.one};
+                for (size_t k = 2; k < 256; ++k) {
+                    multiples[k] = add(multiples[k - 1], g);
+                }
+                std::vector<Limbs> z_inv(255);
+                for (size_t k = 1; k < 256; ++k) {
+                    z_inv[k - 1] = multiples[k].z;
+                }
+                batch_inv(z_inv, P);
+                GeneratorTable t{};
+                for (size_t k = 1; k < 256; ++k) {
+                    Limbs const zi = z_inv[k - 1];
+                    Limbs const zi2 = fsqr(zi);
+                    t[k].x = fmul(multiples[k].x, zi2);
+                    t[k].y = fmul(multiples[k].y, fmul(zi2, zi));
+                }
+                return t;
+            }();
+            return table;
+        }
+
+        struct Signature
+        {
+            Limbs h; // hash reduced mod n
+            Limbs r;
+            Limbs s; // Montgomery form mod n
+            Affine q; // Montgomery form mod p
+        };
+
+        std::optional<Signature> parse(byte_string_view const input)
+        {
+            if (input.size() != INPUT_SIZE) {
+                return std::nullopt;
+            }
+            uint8_t const *const data = input.data();
+            Signature sig;
+
+            // the hash is only used mod n, and n > 2^255
+            sig.h = load(data);
+            if (!less(sig.h, N.m)) {
+                uint64_t borrow;
+                sig.h = sub(sig.h, N.m, borrow);
+            }
+
+            // if not (0 < r < n and 0 < s < n): return
+            sig.r = load(data + 32);
+            Limbs const s = load(data + 64);
+            if (is_zero(sig.r) || !less(sig.r, N.m) || is_zero(s) ||
+                !less(s, N.m)) {
+                return std::nullopt;
+            }
+            sig.s = to_mont(s, N);
+
+            // if not (0 ≤ qx < p and 0 ≤ qy < p): return
+            Limbs const qx = load(data + 96);
+            Limbs const qy = load(data + 128);
+            if (!less(qx, P.m) || !less(qy, P.m)) {
+                return std::nullopt;
+            }
+            sig.q = {to_mont(qx, P), to_mont(qy, P)};
+
+            // if qy^2 ≢ qx^3 + a*qx + b (mod p): return
+            // This also rejects (0, 0), as b != 0. The curve has cofactor 1,
+            // so every point on it is in the subgroup generated by G.
+            Limbs const x3 = fmul(fsqr(sig.q.x), sig.q.x);
+            Limbs const ax = fadd(fadd(sig.q.x, sig.q.x), sig.q.x);
+            if (fsqr(sig.q.y) != fadd(fsub(x3, ax), B)) {
+                return std::nullopt;
+            }
+            return sig;
+        }
+
+        // Checks R' = (h * s1) * G + (r * s1) * Q has R'.x ≡ r (mod n), given
+        // s1 = s^-1 in Montgomery form. Both products are computed together
+        // with Shamir's trick, sharing one chain of doublings: Q four bits at
+        // a time from a small per-call table, G eight bits at a time from the
+        // precomputed generator table.
+        bool verify(Signature const &sig, Limbs const &s_inv)
+        {
+            Limbs const u1 = mont_mul(sig.h, s_inv, N);
+            Limbs const u2 = mont_mul(sig.r, s_inv, N);
+
+            std::array<Jacobian, 16> q_table;
+            q_table[1] = {sig.q.x, sig.q.y, P.one};
+            q_table[2] = dbl(q_table[1]);
+            for (size_t k = 3; k < 16; ++k) {
+                q_table[k] = add(q_table[k - 1], sig.q);
+            }
+            GeneratorTable const &g_table = generator_table();
+
+            Jacobian acc;
+            for (size_t i = 64; i-- > 0;) {
+                for (size_t k = 0; k < 4; ++k) {
+                    acc = dbl(acc);
+                }
+                size_t const qk = (u2[i / 16] >> (4 * (i % 16))) & 0xf;
+                if (qk) {
+                    acc = add(acc, q_table[qk]);
+                }
+                if (i % 2 == 0) {
+                    size_t const byte = i / 2;
+                    size_t const gk = (u1[byte / 8] >> (8 * (byte % 8))) & 0xff;
+                    if (gk) {
+                        acc = add(acc, g_table[gk]);
+                    }
+                }
+            }
+
+            // If R' is at infinity: return
+            if (is_zero(acc.z)) {
+                return false;
+            }
+
+            // if R'.x ≢ r (mod n): return
+            // R'.x = X / Z^2 is below p, so it is either r or r + n, and the
+            // comparison is made without inverting Z
+            Limbs const z2 = fsqr(acc.z);
+            if (fmul(to_mont(sig.r, P), z2) == acc.x) {
+                return true;
+            }
+            uint64_t carry;
+            Limbs const r_plus_n = add(sig.r, N.m, carry);
+            return !carry && less(r_plus_n, P.m) &&
+                   fmul(to_mont(r_plus_n, P), z2) == acc.x;
+        }
+    }
+
+    bool verify(byte_string_view const input)
+    {
+        auto const sig = parse(input);
+        if (!sig.has_value()) {
+            return false;
+        }
+        return verify(*sig, mont_inv(sig->s, N));
+    }
+} // namespace p256
+
+MONAD_NAMESPACE_END
@@ -0,0 +1,35 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/byte_string.hpp>
+#include <category/core/config.hpp>
+
+#include <cstddef>
+
+MONAD_NAMESPACE_BEGIN
+
+namespace p256
+{
+    // hash (32) || r (32) || s (32) || qx (32) || qy (32), all big-endian
+    inline constexpr size_t INPUT_SIZE = 160;
+
+    // Verifies an ECDSA signature over secp256r1 as specified by EIP-7951.
+    // Inputs that are not exactly INPUT_SIZE bytes long do not verify.
+    bool verify(byte_string_view input);
+} // namespace p256
+
+MONAD_NAMESPACE_END
@@ -14,7 +14,9 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <category/execution/ethereum/core/address.hpp>
+#include <category/execution/ethereum/precompile_cache.hpp>
 #include <category/execution/ethereum/precompiles.hpp>
+#include <category/execution/ethereum/precompiles_expmod.hpp>
 #include <category/execution/ethereum/state2/block_state.hpp>
 #include <category/vm/evm/traits.hpp>
 
@@ -26,11 +28,15 @@
 
 #include <nlohmann/json.hpp>
 
+#include <silkpre/precompile.h>
+
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
+#include <random>
 #include <string_view>
 #include <vector>
 
@@ -559,6 +565,60 @@ TEST(Berlin, modular_exponentiation)
         "Modular Exponentiation", "modexp_eip2565.json", 0x05_address);
 }
 
+TEST(Berlin, modular_exponentiation_matches_silkpre)
+{
+    std::mt19937_64 rng{42};
+    auto const random_bytes = [&rng](size_t const size) {
+        byte_string bytes(size, 0);
+        for (auto &b : bytes) {
+            b = static_cast<uint8_t>(rng());
+        }
+        return bytes;
+    };
+    auto const encode_length = [](size_t const length) {
+        byte_string bytes(32, 0);
+        for (size_t i = 0; i < 8; ++i) {
+            bytes[31 - i] = static_cast<uint8_t>(length >> (8 * i));
+        }
+        return bytes;
+    };
+
+    constexpr size_t MOD_SIZES[] = {1, 8, 31, 32, 33, 64, 100, 256, 512};
+    constexpr size_t EXP_SIZES[] = {0, 1, 3, 32};
+    for (size_t const mod_size : MOD_SIZES) {
+        for (size_t const exp_size : EXP_SIZES) {
+            size_t const base_sizes[] = {0, mod_size, 2 * mod_size + 5};
+            for (size_t const base_size : base_sizes) {
+                auto mod = random_bytes(mod_size);
+                mod.back() |= 1;
+                if (mod_size > 1 && rng() % 2) {
+                    // fewer significant limbs than the modulus length
+                    mod[0] = 0;
+                }
+                auto const input = encode_length(base_size) +
+                                   encode_length(exp_size) +
+                                   encode_length(mod_size) +
+                                   random_bytes(base_size) +
+                                   random_bytes(exp_size) + mod;
+
+                auto const native = expmod::execute(input);
+                ASSERT_TRUE(native.has_value());
+                auto const [output, output_size] =
+                    silkpre_expmod_run(input.data(), input.size());
+                EXPECT_EQ(*native, byte_string(output, output_size))
+                    << "base " << base_size << " exp " << exp_size << " mod "
+                    << mod_size;
+                std::free(output);
+            }
+        }
+    }
+
+    // even moduli are left to silkpre
+    auto const even = encode_length(1) + encode_length(1) + encode_length(1) +
+                      byte_string{3, 5, 10};
+    EXPECT_FALSE(expmod::execute(even).has_value());
+}
+
 TEST(Berlin, bn_add)
 {
     do_geth_tests<EvmTraits<EVMC_BERLIN>>(
@@ -577,6 +637,40 @@ TEST(Berlin, bn_pairing)
         "bn_pairing", "bn256Pairing.json", 0x08_address);
 }
 
+TEST(Berlin, precompile_cache_preserves_results_and_gas)
+{
+    auto const pairing_tests =
+        load_test_cases(test_resource::geth_vectors_dir / "bn256Pairing.json");
+    auto const expmod_tests = load_test_cases(
+        test_resource::geth_vectors_dir / "modexp_eip2565.json");
+    // blake2f is cheap and must bypass the cache
+    auto const blake2f_tests =
+        load_test_cases(test_resource::geth_vectors_dir / "blake2F.json");
+
+    PrecompileCache cache;
+    set_precompile_cache(&cache);
+
+    for (int pass = 0; pass < 2; ++pass) {
+        do_geth_tests<EvmTraits<EVMC_BERLIN>>(
+            "cached bn_pairing", pairing_tests, 0x08_address);
+        do_geth_tests<EvmTraits<EVMC_BERLIN>>(
+            "cached modexp", expmod_tests, 0x05_address);
+        do_geth_tests<EvmTraits<EVMC_BERLIN>>(
+            "cached blake2f", blake2f_tests, 0x09_address);
+    }
+
+    set_precompile_cache(nullptr);
+
+    // every vector is run twice per pass, with two different gas limits
+    size_t const cacheable = pairing_tests.size() + expmod_tests.size();
+    auto const stats = cache.stats();
+    EXPECT_EQ(stats.hits + stats.misses, 4 * cacheable);
+    EXPECT_EQ(stats.inserts, stats.misses);
+    EXPECT_LE(stats.misses, cacheable);
+    EXPECT_GE(stats.hits, 3 * cacheable);
+    EXPECT_EQ(stats.entries, stats.misses);
+}
+
 TEST(Berlin, blake2f_valid)
 {
     // the test cases did not change from the previous fork
@@ -24,6 +24,7 @@
 #include <category/execution/ethereum/core/transaction.hpp>
 #include <category/execution/ethereum/core/withdrawal.hpp>
 #include <category/execution/ethereum/db/db.hpp>
+#include <category/execution/ethereum/metrics/txn_profile.hpp>
 #include <category/execution/ethereum/state2/block_state.hpp>
 #include <category/execution/ethereum/state2/fmt/state_deltas_fmt.hpp> // NOLINT
 #include <category/execution/ethereum/state2/state_deltas.hpp>
@@ -43,6 +44,21 @@
 #include <utility>
 #include <vector>
 
+MONAD_ANONYMOUS_NAMESPACE_BEGIN
+
+// Reads that miss the block state, charged to the running transaction
+template <typename F>
+auto profiled_db_read(F &&read)
+{
+    TxnProfileTimer const timer{&TxnProfile::db_read_nanos};
+    if (auto *const profile = timer.profile()) {
+        ++profile->db_read_count;
+    }
+    return read();
+}
+
+MONAD_ANONYMOUS_NAMESPACE_END
+
 MONAD_NAMESPACE_BEGIN
 
 BlockState::BlockState(Db &db, vm::VM &monad_vm)
@@ -64,7 +80,8 @@ std::optional<Account> BlockState::read_account(Address const &address)
     }
     // database
     {
-        auto const result = db_.read_account(address);
+        auto const result =
+            profiled_db_read([&] { return db_.read_account(address); });
         StateDeltas::const_accessor it{};
         state_->emplace(
             it,
@@ -101,9 +118,12 @@ bytes32_t BlockState::read_storage(
     }
     // database
     {
-        auto const result = read_storage
-                                ? db_.read_storage(address, incarnation, key)
-                                : bytes32_t{};
+        auto const result =
+            read_storage
+                ? profiled_db_read([&] {
+                      return db_.read_storage(address, incarnation, key);
+                  })
+                : bytes32_t{};
         StateDeltas::accessor it{};
         MONAD_ASSERT(state_->find(it, address));
         auto const &account = it->second.account.second;
@@ -134,7 +154,8 @@ vm::SharedVarcode BlockState::read_code(bytes32_t const &code_hash)
     }
     // database
     {
-        auto const result = db_.read_code(code_hash);
+        auto const result =
+            profiled_db_read([&] { return db_.read_code(code_hash); });
         MONAD_ASSERT(result);
         MONAD_ASSERT(code_hash == NULL_HASH || result->size() != 0);
         return vm_.try_insert_varcode(code_hash, result);
@@ -184,10 +205,7 @@ void BlockState::merge(State const &state)
     ankerl::unordered_dense::segmented_set<bytes32_t> code_hashes;
 
     auto const &current = state.current();
-    for (auto const &[address, stack] : current) {
-        MONAD_ASSERT(stack.size() == 1);
-        MONAD_ASSERT(stack.version() == 0);
-        auto const &account_state = stack.recent();
+    for (auto const &[address, account_state] : current) {
         auto const &account = account_state.account_;
         if (account.has_value()) {
             code_hashes.insert(account.value().code_hash);
@@ -204,8 +222,7 @@ void BlockState::merge(State const &state)
     }
 
     MONAD_ASSERT(state_);
-    for (auto const &[address, stack] : current) {
-        auto const &account_state = stack.recent();
+    for (auto const &[address, account_state] : current) {
         auto const &account = account_state.account_;
         auto const &storage = account_state.storage_;
         StateDeltas::accessor it{};
@@ -232,7 +249,7 @@ void BlockState::merge(State const &state)
 void BlockState::commit(
     bytes32_t const &block_id, BlockHeader const &header,
     std::vector<Receipt> const &receipts,
-    std::vector<std::vector<CallFrame>> const &call_frames,
+    std::vector<byte_string> const &call_frames,
     std::vector<Address> const &senders,
     std::vector<Transaction> const &transactions,
     std::vector<BlockHeader> const &ommers,
@@ -61,7 +61,7 @@ public:
     void commit(
         bytes32_t const &block_id, BlockHeader const &,
         std::vector<Receipt> const & = {},
-        std::vector<std::vector<CallFrame>> const & = {},
+        std::vector<byte_string> const & = {},
         std::vector<Address> const & = {},
         std::vector<Transaction> const & = {},
         std::vector<BlockHeader> const &ommers = {},
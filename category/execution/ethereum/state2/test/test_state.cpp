@@ -23,6 +23,7 @@
 #include <category/execution/ethereum/core/address.hpp>
 #include <category/execution/ethereum/core/fmt/bytes_fmt.hpp>
 #include <category/execution/ethereum/core/fmt/int_fmt.hpp>
+#include <category/execution/ethereum/core/receipt.hpp>
 #include <category/execution/ethereum/db/db.hpp>
 #include <category/execution/ethereum/db/db_cache.hpp>
 #include <category/execution/ethereum/db/trie_db.hpp>
@@ -965,6 +966,107 @@ TYPED_TEST(StateTest, set_storage_modified_restored)
 }
 
 // Code
+TYPED_TEST(StateTest, pop_reject_reverts_call_frame)
+{
+    BlockState bs{this->tdb, this->vm};
+    commit_sequential(
+        this->tdb,
+        StateDeltas{
+            {a,
+             StateDelta{
+                 .account = {std::nullopt, Account{.balance = 10'000}},
+                 .storage = {{key1, {bytes32_t{}, value1}}}}}},
+        Code{},
+        BlockHeader{});
+
+    State s{bs, Incarnation{1, 1}};
+    s.push();
+    EXPECT_EQ(s.set_storage(a, key1, value2), EVMC_STORAGE_MODIFIED);
+    s.set_transient_storage(a, key1, value1);
+    s.store_log(Receipt::Log{.address = a});
+    {
+        s.push();
+        EXPECT_EQ(s.access_account(b), EVMC_ACCESS_COLD);
+        EXPECT_EQ(s.access_storage(a, key2), EVMC_ACCESS_COLD);
+        s.add_to_balance(b, 1'000);
+        s.subtract_from_balance(a, 1'000);
+        s.set_nonce(a, 5);
+        EXPECT_EQ(s.set_storage(a, key1, value3), EVMC_STORAGE_ASSIGNED);
+        EXPECT_EQ(s.set_storage(a, key2, value3), EVMC_STORAGE_ADDED);
+        s.set_transient_storage(a, key1, value2);
+        s.set_transient_storage(a, key2, value2);
+        s.store_log(Receipt::Log{.address = b});
+        EXPECT_TRUE(s.selfdestruct<EvmTraits<EVMC_SHANGHAI>>(a, c));
+        s.pop_reject();
+    }
+
+    EXPECT_FALSE(s.current().contains(b));
+    EXPECT_FALSE(s.current().contains(c));
+    EXPECT_EQ(s.access_account(b), EVMC_ACCESS_COLD);
+    EXPECT_EQ(s.access_storage(a, key2), EVMC_ACCESS_COLD);
+    EXPECT_EQ(s.get_balance(a), bytes32_t{10'000});
+    EXPECT_EQ(s.get_nonce(a), 0);
+    EXPECT_EQ(s.get_storage(a, key1), value2);
+    EXPECT_EQ(s.get_storage(a, key2), null);
+    EXPECT_EQ(s.get_transient_storage(a, key1), value1);
+    EXPECT_EQ(s.get_transient_storage(a, key2), null);
+    EXPECT_FALSE(s.current().at(a).is_destructed());
+    ASSERT_EQ(s.logs().size(), 1);
+    EXPECT_EQ(s.logs()[0].address, a);
+
+    s.pop_reject();
+    EXPECT_TRUE(s.current().empty());
+    EXPECT_TRUE(s.logs().empty());
+    EXPECT_EQ(s.get_storage(a, key1), value1);
+}
+
+TYPED_TEST(StateTest, pop_accept_merges_into_parent_call_frame)
+{
+    BlockState bs{this->tdb, this->vm};
+    commit_sequential(
+        this->tdb,
+        StateDeltas{
+            {a,
+             StateDelta{
+                 .account = {std::nullopt, Account{.balance = 10'000}},
+                 .storage = {{key1, {bytes32_t{}, value1}}}}}},
+        Code{},
+        BlockHeader{});
+
+    State s{bs, Incarnation{1, 1}};
+    s.push();
+    s.set_nonce(a, 1);
+    {
+        // changes accepted by a nested frame are reverted with its parent
+        s.push();
+        {
+            s.push();
+            EXPECT_EQ(s.set_storage(a, key1, value2), EVMC_STORAGE_MODIFIED);
+            s.add_to_balance(b, 1'000);
+            s.store_log(Receipt::Log{.address = b});
+            s.pop_accept();
+        }
+        EXPECT_EQ(s.get_storage(a, key1), value2);
+        EXPECT_TRUE(s.account_exists(b));
+        s.pop_reject();
+    }
+    EXPECT_EQ(s.get_storage(a, key1), value1);
+    EXPECT_FALSE(s.account_exists(b));
+    EXPECT_TRUE(s.logs().empty());
+    {
+        s.push();
+        EXPECT_EQ(s.set_storage(a, key1, value3), EVMC_STORAGE_MODIFIED);
+        s.add_to_balance(b, 1'000);
+        s.pop_accept();
+    }
+    s.pop_accept();
+
+    EXPECT_EQ(s.get_nonce(a), 1);
+    EXPECT_EQ(s.get_storage(a, key1), value3);
+    EXPECT_EQ(s.get_balance(b), bytes32_t{1'000});
+    EXPECT_TRUE(s.is_touched(b));
+}
+
 TYPED_TEST(StateTest, get_code_size)
 {
     BlockState bs{this->tdb, this->vm};
@@ -94,6 +94,29 @@ public:
         }
         return EVMC_ACCESS_WARM;
     }
+
+    // Inverses of the above, for reverting a call frame. Each must only undo
+    // a call that changed the substate.
+
+    void undo_destruct()
+    {
+        destructed_ = false;
+    }
+
+    void undo_touch()
+    {
+        touched_ = false;
+    }
+
+    void undo_access()
+    {
+        accessed_ = false;
+    }
+
+    void undo_access_storage(bytes32_t const &key)
+    {
+        accessed_storage_.erase(key);
+    }
 };
 
 MONAD_NAMESPACE_END
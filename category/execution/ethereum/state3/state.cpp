@@ -26,9 +26,9 @@
 #include <category/execution/ethereum/core/account.hpp>
 #include <category/execution/ethereum/core/address.hpp>
 #include <category/execution/ethereum/core/receipt.hpp>
+#include <category/execution/ethereum/core/variant.hpp>
 #include <category/execution/ethereum/state2/block_state.hpp>
 #include <category/execution/ethereum/state3/account_state.hpp>
-#include <category/execution/ethereum/state3/version_stack.hpp>
 #include <category/execution/ethereum/types/incarnation.hpp>
 #include <category/vm/code.hpp>
 #include <category/vm/evm/explicit_traits.hpp>
@@ -48,6 +48,7 @@
 #include <memory>
 #include <optional>
 #include <utility>
+#include <variant>
 #include <vector>
 
 MONAD_NAMESPACE_BEGIN
@@ -68,7 +69,7 @@ AccountState const &State::recent_account_state(Address const &address)
     // current
     auto const it = current_.find(address);
     if (it != current_.end()) {
-        return it->second.recent();
+        return it->second;
     }
     // original
     return original_account_state(address);
@@ -81,14 +82,84 @@ AccountState &State::current_account_state(Address const &address)
     if (MONAD_UNLIKELY(it == current_.end())) {
         // original
         auto const &account_state = original_account_state(address);
-        it = current_.try_emplace(address, account_state, version_).first;
+        it = current_.try_emplace(address, account_state).first;
+        record(AccountInserted{.address = address});
     }
-    return it->second.current(version_);
+    return it->second;
 }
 
 std::optional<Account> &State::current_account(Address const &address)
 {
-    return current_account_state(address).account_;
+    auto &account_state = current_account_state(address);
+    record_account(address, account_state);
+    return account_state.account_;
+}
+
+void State::record(JournalEntry &&entry)
+{
+    // changes made outside of any call frame are never reverted
+    if (version_) {
+        journal_.emplace_back(std::move(entry));
+    }
+}
+
+void State::record_account(
+    Address const &address, AccountState const &account_state)
+{
+    record(
+        AccountChanged{.address = address, .account = account_state.account_});
+}
+
+void State::touch(Address const &address, AccountState &account_state)
+{
+    if (!account_state.is_touched()) {
+        record(Touched{.address = address});
+        account_state.touch();
+    }
+}
+
+void State::undo(JournalEntry const &entry)
+{
+    auto const account_state = [this](Address const &address) -> auto & {
+        auto const it = current_.find(address);
+        MONAD_ASSERT(it != current_.end());
+        return it->second;
+    };
+    std::visit(
+        overloaded{
+            [&](AccountInserted const &e) { current_.erase(e.address); },
+            [&](AccountChanged const &e) {
+                account_state(e.address).account_ = e.account;
+            },
+            [&](StorageChanged const &e) {
+                auto &storage = account_state(e.address).storage_;
+                if (e.value.has_value()) {
+                    storage[e.key] = e.value.value();
+                }
+                else {
+                    storage.erase(e.key);
+                }
+            },
+            [&](TransientStorageChanged const &e) {
+                auto &storage = account_state(e.address).transient_storage_;
+                if (e.value.has_value()) {
+                    storage[e.key] = e.value.value();
+                }
+                else {
+                    storage.erase(e.key);
+                }
+            },
+            [&](Touched const &e) { account_state(e.address).undo_touch(); },
+            [&](Accessed const &e) {
+                account_state(e.address).undo_access();
+            },
+            [&](StorageAccessed const &e) {
+                account_state(e.address).undo_access_storage(e.key);
+            },
+            [&](Destructed const &e) {
+                account_state(e.address).undo_destruct();
+            }},
+        entry);
 }
 
 State::State(
@@ -110,7 +181,7 @@ State::Map<Address, OriginalAccountState> &State::original()
     return original_;
 }
 
-State::Map<Address, VersionStack<AccountState>> const &State::current() const
+State::Map<Address, AccountState> const &State::current() const
 {
     return current_;
 }
@@ -122,40 +193,45 @@ State::Map<bytes32_t, vm::SharedVarcode> const &State::code() const
 
 void State::push()
 {
+    checkpoints_.push_back(
+        {.journal_size = journal_.size(), .logs_size = logs_.size()});
     ++version_;
 }
 
 void State::pop_accept()
 {
     MONAD_ASSERT(version_);
+    MONAD_ASSERT(checkpoints_.size() == version_);
 
-    for (auto &it : current_) {
-        it.second.pop_accept(version_);
-    }
-
-    logs_.pop_accept(version_);
+    // the frame's changes now belong to its parent, and are only reverted
+    // along with it
+    checkpoints_.pop_back();
 
     --version_;
+
+    if (!version_) {
+        journal_.clear();
+    }
 }
 
 void State::pop_reject()
 {
     MONAD_ASSERT(version_);
+    MONAD_ASSERT(checkpoints_.size() == version_);
 
-    std::vector<Address> removals;
+    auto const checkpoint = checkpoints_.back();
+    checkpoints_.pop_back();
 
-    for (auto &it : current_) {
-        if (it.second.pop_reject(version_)) {
-            removals.push_back(it.first);
-        }
+    MONAD_ASSERT(journal_.size() >= checkpoint.journal_size);
+    while (journal_.size() > checkpoint.journal_size) {
+        undo(journal_.back());
+        journal_.pop_back();
     }
 
-    logs_.pop_reject(version_);
-
-    while (removals.size()) {
-        current_.erase(removals.back());
-        removals.pop_back();
-    }
+    MONAD_ASSERT(logs_.size() >= checkpoint.logs_size);
+    logs_.erase(
+        logs_.begin() + static_cast<std::ptrdiff_t>(checkpoint.logs_size),
+        logs_.end());
 
     --version_;
 }
@@ -237,7 +313,7 @@ bytes32_t State::get_storage(Address const &address, bytes32_t const &key)
         return it3->second;
     }
     else {
-        auto const &account_state = it->second.recent();
+        auto const &account_state = it->second;
         auto const &account = account_state.account_;
         MONAD_ASSERT(account.has_value());
         auto const &storage = account_state.storage_;
@@ -288,6 +364,7 @@ void State::set_nonce(Address const &address, uint64_t const nonce)
 void State::add_to_balance(Address const &address, uint256_t const &delta)
 {
     auto &account_state = current_account_state(address);
+    record_account(address, account_state);
     auto &account = account_state.account_;
     if (MONAD_UNLIKELY(!account.has_value())) {
         account = Account{.incarnation = incarnation_};
@@ -299,13 +376,14 @@ void State::add_to_balance(Address const &address, uint256_t const &delta)
         "balance overflow");
 
     account.value().balance += delta;
-    account_state.touch();
+    touch(address, account_state);
 }
 
 void State::subtract_from_balance(
     Address const &address, uint256_t const &delta)
 {
     auto &account_state = current_account_state(address);
+    record_account(address, account_state);
     auto &account = account_state.account_;
     if (MONAD_UNLIKELY(!account.has_value())) {
         account = Account{.incarnation = incarnation_};
@@ -314,7 +392,7 @@ void State::subtract_from_balance(
     MONAD_ASSERT(delta <= account.value().balance);
 
     account.value().balance -= delta;
-    account_state.touch();
+    touch(address, account_state);
 }
 
 void State::set_code_hash(Address const &address, bytes32_t const &hash)
@@ -345,6 +423,15 @@ evmc_storage_status State::set_storage(
     }
     // state
     {
+        if (version_) {
+            auto const it = account_state.storage_.find(key);
+            record(StorageChanged{
+                .address = address,
+                .key = key,
+                .value = it == account_state.storage_.end()
+                             ? std::nullopt
+                             : std::make_optional(it->second)});
+        }
         auto const result =
             account_state.set_storage(key, value, original_value);
         return result;
@@ -354,32 +441,50 @@ evmc_storage_status State::set_storage(
 void State::set_transient_storage(
     Address const &address, bytes32_t const &key, bytes32_t const &value)
 {
-    current_account_state(address).set_transient_storage(key, value);
+    auto &account_state = current_account_state(address);
+    if (version_) {
+        auto const &storage = account_state.transient_storage_;
+        auto const it = storage.find(key);
+        record(TransientStorageChanged{
+            .address = address,
+            .key = key,
+            .value = it == storage.end() ? std::nullopt
+                                         : std::make_optional(it->second)});
+    }
+    account_state.set_transient_storage(key, value);
 }
 
 void State::touch(Address const &address)
 {
-    auto &account_state = current_account_state(address);
-    account_state.touch();
+    touch(address, current_account_state(address));
 }
 
 evmc_access_status State::access_account(Address const &address)
 {
     auto &account_state = current_account_state(address);
-    return account_state.access();
+    auto const status = account_state.access();
+    if (status == EVMC_ACCESS_COLD) {
+        record(Accessed{.address = address});
+    }
+    return status;
 }
 
 evmc_access_status
 State::access_storage(Address const &address, bytes32_t const &key)
 {
     auto &account_state = current_account_state(address);
-    return account_state.access_storage(key);
+    auto const status = account_state.access_storage(key);
+    if (status == EVMC_ACCESS_COLD) {
+        record(StorageAccessed{.address = address, .key = key});
+    }
+    return status;
 }
 
 template <Traits traits>
 bool State::selfdestruct(Address const &address, Address const &beneficiary)
 {
     auto &account_state = current_account_state(address);
+    record_account(address, account_state);
     auto &account = account_state.account_;
     MONAD_ASSERT(account.has_value());
 
@@ -396,7 +501,11 @@ bool State::selfdestruct(Address const &address, Address const &beneficiary)
         }
     }
 
-    return account_state.destruct();
+    bool const destructed = account_state.destruct();
+    if (destructed) {
+        record(Destructed{.address = address});
+    }
+    return destructed;
 }
 
 EXPLICIT_TRAITS_MEMBER(State::selfdestruct);
@@ -408,10 +517,7 @@ void State::destruct_suicides()
     MONAD_ASSERT(!version_);
 
     for (auto &it : current_) {
-        auto &stack = it.second;
-        MONAD_ASSERT(stack.size() == 1);
-        MONAD_ASSERT(stack.version() == 0);
-        auto &account_state = stack.current(0);
+        auto &account_state = it.second;
         if (account_state.is_destructed()) {
             auto &account = account_state.account_;
             if constexpr (traits::evm_rev() < EVMC_CANCUN) {
@@ -434,10 +540,7 @@ void State::destruct_touched_dead()
     MONAD_ASSERT(!version_);
 
     for (auto &it : current_) {
-        auto &stack = it.second;
-        MONAD_ASSERT(stack.size() == 1);
-        MONAD_ASSERT(stack.version() == 0);
-        auto &account_state = stack.current(0);
+        auto &account_state = it.second;
         if (MONAD_LIKELY(!account_state.is_touched())) {
             continue;
         }
@@ -571,13 +674,12 @@ void State::create_account_no_rollback(Address const &address)
 
 std::vector<Receipt::Log> const &State::logs()
 {
-    return logs_.recent();
+    return logs_;
 }
 
 void State::store_log(Receipt::Log const &log)
 {
-    auto &logs = logs_.current(version_);
-    logs.push_back(log);
+    logs_.push_back(log);
 }
 
 void State::set_to_state_incarnation(Address const &address)
@@ -628,9 +730,8 @@ bool State::try_fix_account_mismatch(
     // adjust balances
     auto it = current_.find(address);
     if (it != current_.end()) {
-        MONAD_ASSERT(it->second.size() == 1);
-        auto &recent_state = it->second.recent();
-        auto &recent = recent_state.account_;
+        MONAD_ASSERT(!version_);
+        auto &recent = it->second.account_;
         if (!recent) {
             return false;
         }
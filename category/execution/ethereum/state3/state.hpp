@@ -22,7 +22,6 @@
 #include <category/execution/ethereum/core/address.hpp>
 #include <category/execution/ethereum/core/receipt.hpp>
 #include <category/execution/ethereum/state3/account_state.hpp>
-#include <category/execution/ethereum/state3/version_stack.hpp>
 #include <category/execution/ethereum/types/incarnation.hpp>
 #include <category/vm/evm/traits.hpp>
 #include <category/vm/vm.hpp>
@@ -34,6 +33,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <variant>
 #include <vector>
 
 MONAD_NAMESPACE_BEGIN
@@ -45,20 +45,88 @@ class State
     template <typename K, typename V>
     using Map = ankerl::unordered_dense::segmented_map<K, V>;
 
+    // Undo journal entries, each recording what a single change to current_
+    // overwrote
+    struct AccountInserted
+    {
+        Address address;
+    };
+
+    struct AccountChanged
+    {
+        Address address;
+        std::optional<Account> account;
+    };
+
+    struct StorageChanged
+    {
+        Address address;
+        bytes32_t key;
+        std::optional<bytes32_t> value;
+    };
+
+    struct TransientStorageChanged
+    {
+        Address address;
+        bytes32_t key;
+        std::optional<bytes32_t> value;
+    };
+
+    struct Touched
+    {
+        Address address;
+    };
+
+    struct Accessed
+    {
+        Address address;
+    };
+
+    struct StorageAccessed
+    {
+        Address address;
+        bytes32_t key;
+    };
+
+    struct Destructed
+    {
+        Address address;
+    };
+
+    using JournalEntry = std::variant<
+        AccountInserted, AccountChanged, StorageChanged,
+        TransientStorageChanged, Touched, Accessed, StorageAccessed,
+        Destructed>;
+
+    struct Checkpoint
+    {
+        size_t journal_size;
+        size_t logs_size;
+    };
+
     BlockState &block_state_;
 
     Incarnation const incarnation_;
 
     Map<Address, OriginalAccountState> original_{};
 
-    Map<Address, VersionStack<AccountState>> current_{};
+    // Single mutable view of every account changed by the transaction.
+    // Changes made in call frames that may still revert are journaled, so
+    // entering a call is O(1) and reverting one is proportional to the
+    // number of changes it made.
+    Map<Address, AccountState> current_{};
 
-    VersionStack<std::vector<Receipt::Log>> logs_{{}};
+    std::vector<Receipt::Log> logs_{};
 
     Map<bytes32_t, vm::SharedVarcode> code_{};
 
     unsigned version_{0};
 
+    std::vector<JournalEntry> journal_{};
+
+    // journal and logs size on entry to each call frame, indexed by version
+    std::vector<Checkpoint> checkpoints_{};
+
     bool const relaxed_validation_{false};
 
 public:
@@ -71,6 +139,14 @@ private:
 
     std::optional<Account> &current_account(Address const &);
 
+    void record(JournalEntry &&);
+
+    void undo(JournalEntry const &);
+
+    void record_account(Address const &, AccountState const &);
+
+    void touch(Address const &, AccountState &);
+
 public:
     State(BlockState &, Incarnation, bool relaxed_validation = false);
 
@@ -83,7 +159,7 @@ public:
 
     Map<Address, OriginalAccountState> &original();
 
-    Map<Address, VersionStack<AccountState>> const &current() const;
+    Map<Address, AccountState> const &current() const;
 
     Map<bytes32_t, vm::SharedVarcode> const &code() const;
 
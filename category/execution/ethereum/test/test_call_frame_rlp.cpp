@@ -14,7 +14,9 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <category/core/byte_string.hpp>
+#include <category/core/int.hpp>
 #include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/rlp/encode2.hpp>
 #include <category/execution/ethereum/trace/call_frame.hpp>
 #include <category/execution/ethereum/trace/rlp/call_frame_rlp.hpp>
 
@@ -22,6 +24,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
+#include <limits>
+#include <span>
 #include <vector>
 
 using namespace monad;
@@ -95,3 +100,70 @@ TEST(Rlp_CallFrame, encode_decode_call_frames)
     EXPECT_EQ(decoded_call_frames.assume_value()[0], call_frame1);
     EXPECT_EQ(decoded_call_frames.assume_value()[1], call_frame2);
 }
+
+TEST(Rlp_CallFrame, encode_call_frames_matches_per_frame_encoding)
+{
+    CallFrame const call_frame1{
+        .type = CallType::CREATE2,
+        .flags = 0,
+        .from = a,
+        .to = std::nullopt,
+        .value = 0,
+        .gas = 1'000'000u,
+        .gas_used = 999'999u,
+        .input = byte_string(300, 0xab),
+        .output = byte_string{0x7f},
+        .status = EVMC_INTERNAL_ERROR,
+        .depth = 0,
+    };
+
+    CallFrame const call_frame2{
+        .type = CallType::SELFDESTRUCT,
+        .flags = 1,
+        .from = b,
+        .to = a,
+        .value = std::numeric_limits<uint256_t>::max(),
+        .gas = 0,
+        .gas_used = 0,
+        .input = byte_string{0x80},
+        .output = byte_string(56, 0x01),
+        .status = EVMC_SUCCESS,
+        .depth = 1,
+    };
+
+    constexpr size_t NUM_FRAMES[] = {0, 1, 2, 100};
+    for (size_t const num_frames : NUM_FRAMES) {
+        std::vector<CallFrame> call_frames;
+        std::vector<CallFrameView> views;
+        byte_string concatenated;
+        for (size_t i = 0; i < num_frames; ++i) {
+            call_frames.push_back(i % 2 ? call_frame2 : call_frame1);
+        }
+        for (auto const &call_frame : call_frames) {
+            views.push_back(CallFrameView{
+                .type = call_frame.type,
+                .flags = call_frame.flags,
+                .from = call_frame.from,
+                .to = call_frame.to,
+                .value = call_frame.value,
+                .gas = call_frame.gas,
+                .gas_used = call_frame.gas_used,
+                .input = call_frame.input,
+                .output = call_frame.output,
+                .status = call_frame.status,
+                .depth = call_frame.depth,
+            });
+            concatenated += rlp::encode_call_frame(call_frame);
+        }
+        auto const expected = rlp::encode_list2(concatenated);
+        EXPECT_EQ(rlp::encode_call_frames(call_frames), expected);
+        EXPECT_EQ(
+            rlp::encode_call_frames(std::span<CallFrameView const>{views}),
+            expected);
+
+        byte_string_view encoding_view{expected};
+        auto const decoded = rlp::decode_call_frames(encoding_view);
+        ASSERT_FALSE(decoded.has_error());
+        EXPECT_EQ(decoded.assume_value(), call_frames);
+    }
+}
@@ -13,6 +13,7 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <category/core/byte_string.hpp>
 #include <category/core/int.hpp>
 #include <category/execution/ethereum/block_hash_buffer.hpp>
 #include <category/execution/ethereum/chain/ethereum_mainnet.hpp>
@@ -24,6 +25,7 @@
 #include <category/execution/ethereum/state2/block_state.hpp>
 #include <category/execution/ethereum/state3/state.hpp>
 #include <category/execution/ethereum/trace/call_tracer.hpp>
+#include <category/execution/ethereum/trace/rlp/call_frame_rlp.hpp>
 
 #include <evmc/evmc.h>
 #include <evmc/evmc.hpp>
@@ -105,6 +107,52 @@ TEST(CallTrace, enter_and_exit)
     EXPECT_EQ(call_frames[1].depth, 1);
 }
 
+TEST(CallTrace, arena_tracer_matches_call_tracer)
+{
+    evmc_message msg{.gas = 5'000, .input_data = input};
+    msg.input_size = sizeof(input);
+    evmc::Result res{};
+    res.gas_left = 100;
+    res.output_data = output;
+    res.output_size = sizeof(output);
+
+    auto const trace = [&](CallTracerBase &call_tracer) {
+        msg.depth = 0;
+        msg.kind = EVMC_CALL;
+        call_tracer.on_enter(msg);
+        {
+            msg.depth = 1;
+            msg.kind = EVMC_DELEGATECALL;
+            call_tracer.on_enter(msg);
+            call_tracer.on_exit(res);
+            call_tracer.on_self_destruct(a, b);
+        }
+        call_tracer.on_exit(res);
+        call_tracer.on_finish(9'000);
+    };
+
+    std::vector<CallFrame> call_frames;
+    CallTracer call_tracer{tx, call_frames};
+    trace(call_tracer);
+    ASSERT_EQ(call_frames.size(), 3);
+
+    byte_string encoded;
+    ArenaCallTracer arena_call_tracer{tx, encoded};
+    trace(arena_call_tracer);
+    ASSERT_EQ(arena_call_tracer.frames().size(), 3);
+    EXPECT_EQ(encoded, rlp::encode_call_frames(call_frames));
+
+    // input and output are copied into the tracer's arena
+    EXPECT_NE(arena_call_tracer.frames()[0].input.data(), input);
+    EXPECT_NE(arena_call_tracer.frames()[0].output.data(), output);
+
+    arena_call_tracer.reset();
+    EXPECT_TRUE(arena_call_tracer.frames().empty());
+    EXPECT_TRUE(encoded.empty());
+    trace(arena_call_tracer);
+    EXPECT_EQ(encoded, rlp::encode_call_frames(call_frames));
+}
+
 TEST(CallTrace, execute_success)
 {
     InMemoryMachine machine;
@@ -60,6 +60,26 @@ struct CallFrame
 static_assert(sizeof(CallFrame) == 184);
 static_assert(alignof(CallFrame) == 8);
 
+// CallFrame whose input and output are owned elsewhere, e.g. by the arena of
+// the tracer that recorded it
+struct CallFrameView
+{
+    CallType type{};
+    uint32_t flags{};
+    Address from{};
+    std::optional<Address> to{};
+    uint256_t value{};
+    uint64_t gas{};
+    uint64_t gas_used{};
+    byte_string_view input{};
+    byte_string_view output{};
+    evmc_status_code status{};
+    uint64_t depth{};
+};
+
+static_assert(sizeof(CallFrameView) == 152);
+static_assert(alignof(CallFrameView) == 8);
+
 nlohmann::json to_json(CallFrame const &);
 
 MONAD_NAMESPACE_END
@@ -24,13 +24,18 @@
 #include <category/execution/ethereum/core/transaction.hpp>
 #include <category/execution/ethereum/trace/call_frame.hpp>
 #include <category/execution/ethereum/trace/call_tracer.hpp>
+#include <category/execution/ethereum/trace/rlp/call_frame_rlp.hpp>
 
 #include <evmc/evmc.hpp>
 #include <intx/intx.hpp>
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iomanip>
+#include <memory_resource>
 #include <optional>
 #include <span>
 #include <sstream>
@@ -63,6 +68,43 @@ namespace
             }
         }
     }
+
+    CallType to_call_type(evmc_call_kind const kind)
+    {
+        switch (kind) {
+        case EVMC_CALL:
+            return CallType::CALL;
+        case EVMC_DELEGATECALL:
+            return CallType::DELEGATECALL;
+        case EVMC_CALLCODE:
+            return CallType::CALLCODE;
+        case EVMC_CREATE:
+            return CallType::CREATE;
+        case EVMC_CREATE2:
+            return CallType::CREATE2;
+        default:
+            MONAD_ASSERT(false);
+        }
+    }
+
+    Address call_from(evmc_message const &msg)
+    {
+        // This is to conform with quicknode RPC
+        return msg.kind == EVMC_DELEGATECALL || msg.kind == EVMC_CALLCODE
+                   ? msg.recipient
+                   : msg.sender;
+    }
+
+    std::optional<Address> call_to(evmc_message const &msg)
+    {
+        if (msg.kind == EVMC_CALL) {
+            return msg.recipient;
+        }
+        else if (msg.kind == EVMC_DELEGATECALL || msg.kind == EVMC_CALLCODE) {
+            return msg.code_address;
+        }
+        return std::nullopt;
+    }
 }
 
 void NoopCallTracer::on_enter(evmc_message const &) {}
@@ -87,41 +129,11 @@ void CallTracer::on_enter(evmc_message const &msg)
 {
     depth_ = static_cast<uint64_t>(msg.depth);
 
-    // This is to conform with quicknode RPC
-    Address const from =
-        msg.kind == EVMC_DELEGATECALL || msg.kind == EVMC_CALLCODE
-            ? msg.recipient
-            : msg.sender;
-
-    std::optional<Address> to;
-    if (msg.kind == EVMC_CALL) {
-        to = msg.recipient;
-    }
-    else if (msg.kind == EVMC_DELEGATECALL || msg.kind == EVMC_CALLCODE) {
-        to = msg.code_address;
-    }
-
     frames_.emplace_back(CallFrame{
-        .type =
-            [kind = msg.kind] {
-                switch (kind) {
-                case EVMC_CALL:
-                    return CallType::CALL;
-                case EVMC_DELEGATECALL:
-                    return CallType::DELEGATECALL;
-                case EVMC_CALLCODE:
-                    return CallType::CALLCODE;
-                case EVMC_CREATE:
-                    return CallType::CREATE;
-                case EVMC_CREATE2:
-                    return CallType::CREATE2;
-                default:
-                    MONAD_ASSERT(false);
-                }
-            }(),
+        .type = to_call_type(msg.kind),
         .flags = msg.flags,
-        .from = from,
-        .to = to,
+        .from = call_from(msg),
+        .to = call_to(msg),
         .value = intx::be::load<uint256_t>(msg.value),
         .gas = depth_ == 0 ? tx_.gas_limit : static_cast<uint64_t>(msg.gas),
         .gas_used = 0,
@@ -211,4 +223,110 @@ nlohmann::json CallTracer::to_json() const
     return res;
 }
 
+ArenaCallTracer::ArenaCallTracer(Transaction const &tx, byte_string &encoded)
+    : arena_{INITIAL_ARENA_SIZE}
+    , frames_{&arena_}
+    , last_{&arena_}
+    , depth_{0}
+    , tx_(tx)
+    , encoded_(encoded)
+{
+    frames_.reserve(16);
+}
+
+byte_string_view
+ArenaCallTracer::copy_to_arena(uint8_t const *const data, size_t const size)
+{
+    if (data == nullptr || size == 0) {
+        return {};
+    }
+    auto *const copy = static_cast<unsigned char *>(arena_.allocate(size, 1));
+    std::memcpy(copy, data, size);
+    return {copy, size};
+}
+
+void ArenaCallTracer::on_enter(evmc_message const &msg)
+{
+    depth_ = static_cast<uint64_t>(msg.depth);
+
+    frames_.emplace_back(CallFrameView{
+        .type = to_call_type(msg.kind),
+        .flags = msg.flags,
+        .from = call_from(msg),
+        .to = call_to(msg),
+        .value = intx::be::load<uint256_t>(msg.value),
+        .gas = depth_ == 0 ? tx_.gas_limit : static_cast<uint64_t>(msg.gas),
+        .gas_used = 0,
+        .input = copy_to_arena(msg.input_data, msg.input_size),
+        .output = {},
+        .status = EVMC_FAILURE,
+        .depth = depth_,
+    });
+
+    last_.push_back(frames_.size() - 1);
+}
+
+void ArenaCallTracer::on_exit(evmc::Result const &res)
+{
+    MONAD_ASSERT(!frames_.empty());
+    MONAD_ASSERT(!last_.empty());
+
+    auto &frame = frames_[last_.back()];
+
+    MONAD_ASSERT(frame.gas >= static_cast<uint64_t>(res.gas_left));
+    frame.gas_used = frame.gas - static_cast<uint64_t>(res.gas_left);
+
+    if (res.status_code == EVMC_SUCCESS || res.status_code == EVMC_REVERT) {
+        frame.output = copy_to_arena(res.output_data, res.output_size);
+    }
+    frame.status = res.status_code;
+
+    if (frame.type == CallType::CREATE || frame.type == CallType::CREATE2) {
+        frame.to = res.create_address;
+    }
+
+    last_.pop_back();
+}
+
+void ArenaCallTracer::on_self_destruct(Address const &from, Address const &to)
+{
+    frames_.emplace_back(CallFrameView{
+        .type = CallType::SELFDESTRUCT,
+        .flags = 0,
+        .from = from,
+        .to = to,
+        .value = 0,
+        .gas = 0,
+        .gas_used = 0,
+        .input = {},
+        .output = {},
+        .status = EVMC_SUCCESS,
+        .depth = depth_ + 1,
+    });
+}
+
+void ArenaCallTracer::on_finish(uint64_t const gas_used)
+{
+    MONAD_ASSERT(!frames_.empty());
+    MONAD_ASSERT(last_.empty());
+    frames_.front().gas_used = gas_used;
+    encoded_ = rlp::encode_call_frames(frames());
+}
+
+void ArenaCallTracer::reset()
+{
+    // the containers must give up their storage before the arena is released
+    frames_ = std::pmr::vector<CallFrameView>{&arena_};
+    last_ = std::pmr::vector<size_t>{&arena_};
+    arena_.release();
+    frames_.reserve(16);
+    depth_ = 0;
+    encoded_.clear();
+}
+
+std::span<CallFrameView const> ArenaCallTracer::frames() const
+{
+    return frames_;
+}
+
 MONAD_NAMESPACE_END
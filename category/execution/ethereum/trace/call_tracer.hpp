@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <category/core/byte_string.hpp>
 #include <category/core/config.hpp>
 #include <category/execution/ethereum/core/address.hpp>
 #include <category/execution/ethereum/trace/call_frame.hpp>
@@ -22,6 +23,9 @@
 #include <evmc/evmc.hpp>
 #include <nlohmann/json.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
 #include <optional>
 #include <span>
 #include <stack>
@@ -75,4 +79,38 @@ public:
     nlohmann::json to_json() const;
 };
 
+// Records call frames into a per-transaction arena, so tracing does no heap
+// allocation per frame, and encodes them once the transaction has finished.
+// This takes the rlp encoding of call frames off the block commit path: the
+// encoding is produced on the fiber that executed the transaction, in
+// parallel with the rest of the block, and committed as is.
+class ArenaCallTracer final : public CallTracerBase
+{
+    static constexpr size_t INITIAL_ARENA_SIZE = 4096;
+
+    std::pmr::monotonic_buffer_resource arena_;
+    std::pmr::vector<CallFrameView> frames_;
+    std::pmr::vector<size_t> last_;
+    uint64_t depth_;
+    Transaction const &tx_;
+    byte_string &encoded_;
+
+    byte_string_view copy_to_arena(uint8_t const *, size_t);
+
+public:
+    ArenaCallTracer() = delete;
+    ArenaCallTracer(ArenaCallTracer const &) = delete;
+    ArenaCallTracer(ArenaCallTracer &&) = delete;
+    ArenaCallTracer(Transaction const &, byte_string &encoded);
+
+    virtual void on_enter(evmc_message const &) override;
+    virtual void on_exit(evmc::Result const &) override;
+    virtual void
+    on_self_destruct(Address const &from, Address const &to) override;
+    virtual void on_finish(uint64_t const) override;
+    virtual void reset() override;
+
+    std::span<CallFrameView const> frames() const;
+};
+
 MONAD_NAMESPACE_END
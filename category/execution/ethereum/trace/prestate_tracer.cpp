@@ -75,12 +75,11 @@ namespace trace
         auto const &current = state.current();
         auto const &original = state.original();
 
-        for (auto const &[address, current_stack] : current) {
+        for (auto const &[address, current_account_state] : current) {
             auto const it = original.find(address);
             MONAD_ASSERT(it != original.end());
 
             // Possible diff.
-            auto const &current_account_state = current_stack.recent();
             auto const &current_account = current_account_state.account_;
             auto const &current_storage = current_account_state.storage_;
             auto const &original_account_state = it->second;
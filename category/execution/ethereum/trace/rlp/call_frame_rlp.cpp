@@ -13,10 +13,13 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <category/core/assert.h>
 #include <category/core/byte_string.hpp>
+#include <category/core/int.hpp>
 #include <category/core/likely.h>
 #include <category/core/result.hpp>
 #include <category/core/rlp/config.hpp>
+#include <category/core/rlp/encode.hpp>
 #include <category/execution/ethereum/core/rlp/address_rlp.hpp>
 #include <category/execution/ethereum/core/rlp/int_rlp.hpp>
 #include <category/execution/ethereum/rlp/decode.hpp>
@@ -26,6 +29,9 @@
 
 #include <boost/outcome/try.hpp>
 
+#include <intx/intx.hpp>
+
+#include <cstddef>
 #include <span>
 #include <vector>
 
@@ -47,14 +53,88 @@ byte_string encode_call_frame(CallFrame const &call_frame)
         encode_unsigned(call_frame.depth));
 }
 
-byte_string encode_call_frames(std::span<CallFrame const> const call_frames)
+namespace
 {
-    byte_string res{};
-    for (auto const &call_frame : call_frames) {
-        res += encode_call_frame(call_frame);
+    // Calls f with the rlp string payload of each field of a call frame, in
+    // the order encode_call_frame() writes them
+    template <typename Frame, typename F>
+    void for_each_field(Frame const &call_frame, F &&f)
+    {
+        unsigned char buf[sizeof(uint256_t)];
+        auto const to_compact = [&buf](uint256_t const &n) {
+            intx::be::store(buf, n);
+            return zeroless_view({buf, sizeof(buf)});
+        };
+        f(to_compact(static_cast<unsigned char>(call_frame.type)));
+        f(to_compact(call_frame.flags));
+        f(to_byte_string_view(call_frame.from.bytes));
+        f(call_frame.to.has_value() ? to_byte_string_view(call_frame.to->bytes)
+                                    : byte_string_view{});
+        f(to_compact(call_frame.value));
+        f(to_compact(call_frame.gas));
+        f(to_compact(call_frame.gas_used));
+        f(byte_string_view{call_frame.input});
+        f(byte_string_view{call_frame.output});
+        f(to_compact(static_cast<unsigned char>(call_frame.status)));
+        f(to_compact(call_frame.depth));
+    }
+
+    template <typename Frame>
+    size_t payload_length(Frame const &call_frame)
+    {
+        size_t length = 0;
+        for_each_field(call_frame, [&length](byte_string_view const s) {
+            length += string_length(s);
+        });
+        return length;
+    }
+
+    std::span<unsigned char>
+    encode_list_header(std::span<unsigned char> d, size_t const length)
+    {
+        if (length <= 55) {
+            d[0] = 0xC0 + static_cast<unsigned char>(length);
+            return d.subspan(1);
+        }
+        d[0] = 0xF7 + static_cast<unsigned char>(impl::length_length(length));
+        return impl::encode_length(d.subspan(1), length);
+    }
+
+    // Encodes straight into a single buffer sized up front, rather than
+    // building and concatenating an intermediate string per field and frame
+    template <typename Frame>
+    byte_string encode_frames(std::span<Frame const> const call_frames)
+    {
+        size_t length = 0;
+        for (auto const &call_frame : call_frames) {
+            length += list_length(payload_length(call_frame));
+        }
+        byte_string res;
+        // encode_length() always stores sizeof(size_t) bytes
+        res.resize(list_length(length) + sizeof(size_t));
+        std::span<unsigned char> d{res.data(), res.size()};
+        d = encode_list_header(d, length);
+        for (auto const &call_frame : call_frames) {
+            d = encode_list_header(d, payload_length(call_frame));
+            for_each_field(call_frame, [&d](byte_string_view const s) {
+                d = encode_string(d, s);
+            });
+        }
+        MONAD_ASSERT(d.size() == sizeof(size_t));
+        res.resize(res.size() - d.size());
+        return res;
     }
+}
 
-    return encode_list2(res);
+byte_string encode_call_frames(std::span<CallFrame const> const call_frames)
+{
+    return encode_frames(call_frames);
+}
+
+byte_string
+encode_call_frames(std::span<CallFrameView const> const call_frames)
+{
+    return encode_frames(call_frames);
 }
 
 Result<CallFrame> decode_call_frame(byte_string_view &enc)
@@ -25,10 +25,16 @@
 
 MONAD_RLP_NAMESPACE_BEGIN
 
+// Encoding of a transaction with no call frames, which is what transactions
+// executed without tracing are committed with
+inline byte_string const EMPTY_CALL_FRAMES = {0xc0};
+
 byte_string encode_call_frame(CallFrame const &);
 
 byte_string encode_call_frames(std::span<CallFrame const>);
 
+byte_string encode_call_frames(std::span<CallFrameView const>);
+
 Result<CallFrame> decode_call_frame(byte_string_view &);
 
 Result<std::vector<CallFrame>> decode_call_frames(byte_string_view &);
@@ -49,7 +49,7 @@ bool dipped_into_reserve(
     uint256_t const gas_fees =
         uint256_t{tx.gas_limit} * gas_price(rev, tx, base_fee_per_gas);
     auto const &orig = state.original();
-    for (auto const &[addr, stack] : state.current()) {
+    for (auto const &[addr, account_state] : state.current()) {
         MONAD_ASSERT(orig.contains(addr));
         std::optional<Account> const &orig_account = orig.at(addr).account_;
         bytes32_t const orig_code_hash = orig_account.has_value()
@@ -81,7 +81,7 @@ bool dipped_into_reserve(
             }
             return reserve;
         }();
-        std::optional<Account> const &curr_account = stack.recent().account_;
+        std::optional<Account> const &curr_account = account_state.account_;
         uint256_t const curr_balance =
             curr_account.has_value() ? curr_account.value().balance : 0;
         if (!violation_threshold.has_value() ||
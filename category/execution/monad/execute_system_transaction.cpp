@@ -13,13 +13,14 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
-#include <boost/fiber/future/promise.hpp>
 #include <boost/outcome/try.hpp>
 #include <category/core/assert.h>
+#include <category/core/fiber/completion.hpp>
 #include <category/execution/ethereum/chain/chain.hpp>
 #include <category/execution/ethereum/core/contract/abi_signatures.hpp>
 #include <category/execution/ethereum/core/transaction.hpp>
 #include <category/execution/ethereum/metrics/block_metrics.hpp>
+#include <category/execution/ethereum/metrics/txn_profile.hpp>
 #include <category/execution/ethereum/state2/block_state.hpp>
 #include <category/execution/ethereum/state3/state.hpp>
 #include <category/execution/ethereum/trace/call_tracer.hpp>
@@ -61,7 +62,7 @@ template <Traits traits>
 ExecuteSystemTransaction<traits>::ExecuteSystemTransaction(
     Chain const &chain, uint64_t const i, Transaction const &tx,
     Address const &sender, BlockHeader const &header, BlockState &block_state,
-    BlockMetrics &block_metrics, boost::fibers::promise<void> &prev,
+    BlockMetrics &block_metrics, fiber::Completion &prev,
     CallTracerBase &call_tracer)
     : chain_{chain}
     , i_{i}
@@ -101,11 +102,12 @@ Result<Receipt> ExecuteSystemTransaction<traits>::operator()()
 
         call_tracer_.reset();
 
-        auto result = execute(state);
+        auto result = profiled_evm([&] { return execute(state); });
 
         {
             TRACE_TXN_EVENT(StartStall);
-            prev_.get_future().wait();
+            TxnProfileTimer const stall_timer{&TxnProfile::stall_nanos};
+            prev_.wait();
         }
 
         if (block_state_.can_merge(state)) {
@@ -120,12 +122,16 @@ Result<Receipt> ExecuteSystemTransaction<traits>::operator()()
     block_metrics_.inc_retries();
     {
         TRACE_TXN_EVENT(StartRetry);
+        TxnProfileTimer const retry_timer{&TxnProfile::retry_nanos};
+        if (auto *const profile = retry_timer.profile()) {
+            ++profile->retry_count;
+        }
 
         State state{block_state_, Incarnation{header_.number, i_ + 1}};
 
         call_tracer_.reset();
 
-        auto result = execute(state);
+        auto result = profiled_evm([&] { return execute(state); });
 
         MONAD_ASSERT(block_state_.can_merge(state));
         if (result.has_error()) {
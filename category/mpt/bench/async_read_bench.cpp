@@ -20,6 +20,7 @@
 #include <category/core/keccak.hpp>
 #include <category/core/small_prng.hpp>
 #include <category/mpt/db.hpp>
+#include <category/mpt/node_cache.hpp>
 #include <category/mpt/ondisk_db_config.hpp>
 #include <category/mpt/test/test_fixtures_base.hpp>
 #include <category/mpt/traverse.hpp>
@@ -57,8 +58,9 @@ static monad::byte_string to_key(uint64_t const key)
     return monad::byte_string{hash.bytes, sizeof(hash.bytes)};
 }
 
+template <class DbType>
 static uint64_t
-select_rand_version(Db const &db, monad::small_prng &rnd, double bias)
+select_rand_version(DbType const &db, monad::small_prng &rnd, double bias)
 {
     auto const version_range_start =
         static_cast<double>(db.get_earliest_version());
@@ -88,6 +90,8 @@ struct Stats
     std::mutex mutex;
     OpStats lookup;
     OpStats traverse;
+    OpStats looped_find; // num counts keys
+    OpStats find_many; // num counts keys
 };
 
 int main(int argc, char *const argv[])
@@ -95,6 +99,8 @@ int main(int argc, char *const argv[])
     unsigned num_async_reader_threads = 1;
     size_t num_async_reads_inflight = 100;
     unsigned num_traverse_threads = 0;
+    unsigned num_batch_reader_threads = 0;
+    size_t batch_size = 256;
     double prng_bias = 1.66;
     size_t num_nodes_per_version = 1;
     uint32_t runtime_seconds = std::numeric_limits<uint32_t>::max();
@@ -121,6 +127,13 @@ int main(int argc, char *const argv[])
             "--num-traverse-threads",
             num_traverse_threads,
             "Number of threads traversing random version tries");
+        cli.add_option(
+            "--num-batch-reader-threads",
+            num_batch_reader_threads,
+            "Number of threads reading random key batches from a RODb, "
+            "alternating between looped finds and find_many");
+        cli.add_option(
+            "--batch-size", batch_size, "Number of keys per batch read");
         cli.add_option(
             "--prng-bias",
             prng_bias,
@@ -157,6 +170,9 @@ int main(int argc, char *const argv[])
                   << std::endl;
         std::cout << "  num_traverse_threads: " << num_traverse_threads
                   << std::endl;
+        std::cout << "  num_batch_reader_threads: " << num_batch_reader_threads
+                  << std::endl;
+        std::cout << "  batch_size: " << batch_size << std::endl;
         std::cout << "  prng_bias: " << prng_bias << std::endl;
         std::cout << "  num_nodes_per_version: " << num_nodes_per_version
                   << std::endl;
@@ -495,6 +511,62 @@ int main(int argc, char *const argv[])
                 std::chrono::steady_clock::now() - start;
         };
 
+        auto random_batch_read = [&]() {
+            RODb ro_db{ReadOnlyOnDiskDbConfig{
+                .dbname_paths = {dbname_paths},
+                .node_lru_max_mem = cache_size * NodeCache::AVERAGE_NODE_SIZE}};
+
+            OpStats looped{};
+            OpStats many{};
+            uint64_t nfailed = 0;
+
+            while (ro_db.get_latest_version() == INVALID_BLOCK_NUM && !g_done) {
+            }
+
+            auto rnd = monad::thread_local_prng();
+            std::uniform_int_distribution<size_t> dist(0, keys.size() - 1);
+            std::vector<NibblesView> batch(batch_size);
+            while (!g_done) {
+                auto const version = select_rand_version(ro_db, rnd, prng_bias);
+                for (auto &key : batch) {
+                    key = keys[dist(rnd)];
+                }
+                // Alternate which goes first so that neither always runs
+                // against nodes the other has just cached
+                bool const many_first = (looped.num / batch_size) % 2 == 0;
+                for (unsigned pass = 0; pass < 2; ++pass) {
+                    auto const start = std::chrono::steady_clock::now();
+                    if ((pass == 0) == many_first) {
+                        auto const results = ro_db.find_many(batch, version);
+                        for (auto const &res : results) {
+                            nfailed += res.has_error();
+                        }
+                        many.time += std::chrono::steady_clock::now() - start;
+                        many.num += batch.size();
+                    }
+                    else {
+                        for (auto const &key : batch) {
+                            nfailed += ro_db.find(key, version).has_error();
+                        }
+                        looped.time += std::chrono::steady_clock::now() - start;
+                        looped.num += batch.size();
+                    }
+                }
+            }
+            std::ostringstream oss;
+            oss << "Batch reader thread (0x" << std::hex
+                << std::this_thread::get_id() << std::dec << ") finished"
+                << ". Did " << looped.num + many.num << " finds, "
+                << nfailed << " failed" << std::endl;
+            std::cout << oss.str();
+
+            auto lock = std::lock_guard<std::mutex>(total_stats.mutex);
+            total_stats.looped_find.num += looped.num;
+            total_stats.looped_find.time += looped.time;
+            total_stats.find_many.num += many.num;
+            total_stats.find_many.time += many.time;
+        };
+
         // construct RWDb
         StateMachineAlwaysMerkle machine{};
         auto const config = OnDiskDbConfig{
@@ -512,6 +584,10 @@ int main(int argc, char *const argv[])
             readers.emplace_back(random_traverse);
         }
 
+        for (unsigned i = 0; i < num_batch_reader_threads; ++i) {
+            readers.emplace_back(random_batch_read);
+        }
+
         alarm(runtime_seconds);
         while (!g_done) {
             ++version;
@@ -550,6 +626,22 @@ int main(int argc, char *const argv[])
                           (int64_t)total_stats.traverse.num
                     : 0)
             << std::endl;
+        auto const per_key_ns = [](OpStats const &stats) {
+            return stats.num != 0
+                       ? std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             stats.time)
+                                 .count() /
+                             (int64_t)stats.num
+                       : 0;
+        };
+        std::cout << "  Batch keys found with looped finds: "
+                  << total_stats.looped_find.num
+                  << "\n   Time per key (ns): "
+                  << per_key_ns(total_stats.looped_find)
+                  << "\n  Batch keys found with find_many: "
+                  << total_stats.find_many.num
+                  << "\n   Time per key (ns): "
+                  << per_key_ns(total_stats.find_many) << std::endl;
     }
 
     catch (const CLI::CallForHelp &e) {
@@ -0,0 +1,203 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <category/async/io.hpp>
+#include <category/async/storage_pool.hpp>
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/io/buffers.hpp>
+#include <category/core/io/ring.hpp>
+#include <category/core/keccak.hpp>
+#include <category/mpt/node.hpp>
+#include <category/mpt/node_cursor.hpp>
+#include <category/mpt/test/test_fixtures_base.hpp>
+#include <category/mpt/trie.hpp>
+#include <category/mpt/update.hpp>
+#include <category/mpt/util.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <list>
+#include <random>
+#include <vector>
+
+using namespace monad::mpt;
+using namespace monad::test;
+using namespace MONAD_ASYNC_NAMESPACE;
+
+static monad::byte_string to_key(uint64_t const key)
+{
+    auto const as_bytes = serialize_as_big_endian<sizeof(key)>(key);
+    auto const hash = monad::keccak256(as_bytes);
+    return monad::byte_string{hash.bytes, sizeof(hash.bytes)};
+}
+
+// Shaped like an account: a small nonce and balance, then the code hash and
+// storage root, which for most accounts are those of empty code and storage
+static monad::byte_string to_value(std::mt19937_64 &rng)
+{
+    static monad::byte_string const empty_hash = [] {
+        auto const hash = monad::keccak256(monad::byte_string_view{});
+        return monad::byte_string{hash.bytes, sizeof(hash.bytes)};
+    }();
+    monad::byte_string ret = serialize_as_big_endian<8>(rng() % 1000);
+    ret += monad::byte_string(24, 0);
+    ret += serialize_as_big_endian<8>(rng());
+    ret += empty_hash;
+    ret += (rng() % 8 == 0) ? to_key(rng()) : empty_hash;
+    return ret;
+}
+
+struct run_result
+{
+    UpdateAuxImpl::slow_list_compression_stats_t written;
+    std::chrono::steady_clock::duration find_elapsed{};
+};
+
+static run_result run(
+    std::vector<std::filesystem::path> const &dbname_paths,
+    int const compression_level, uint64_t const num_blocks,
+    uint64_t const updates_per_block, uint64_t const num_finds)
+{
+    auto pool = dbname_paths.empty()
+                    ? storage_pool{use_anonymous_inode_tag{}}
+                    : storage_pool{dbname_paths, storage_pool::mode::truncate};
+    monad::io::Ring read_ring{monad::io::RingConfig{512}};
+    monad::io::Ring write_ring{monad::io::RingConfig{4}};
+    auto buffers = monad::io::make_buffers_for_segregated_read_write(
+        read_ring,
+        write_ring,
+        1024,
+        4,
+        AsyncIO::MONAD_IO_BUFFERS_READ_SIZE,
+        AsyncIO::MONAD_IO_BUFFERS_WRITE_SIZE);
+    AsyncIO io{pool, buffers};
+    UpdateAux<> aux{&io};
+    aux.set_slow_list_compression_level(compression_level);
+    StateMachineAlwaysMerkle sm;
+    Node::UniquePtr root;
+
+    // Everything is written to the slow list, as historical and compacted
+    // state would be
+    std::mt19937_64 rng{42};
+    uint64_t const num_keys = num_blocks * updates_per_block;
+    for (uint64_t version = 0; version < num_blocks; ++version) {
+        UpdateList ul;
+        std::list<monad::byte_string> bytes_alloc;
+        std::list<Update> update_alloc;
+        for (uint64_t n = 0; n < updates_per_block; ++n) {
+            auto const &key = bytes_alloc.emplace_back(
+                to_key(version * updates_per_block + n));
+            auto const &value = bytes_alloc.emplace_back(to_value(rng));
+            ul.push_front(update_alloc.emplace_back(
+                make_update(key, value, false, UpdateList{}, version)));
+        }
+        root = aux.do_update(
+            std::move(root), sm, std::move(ul), version, true, false);
+    }
+
+    // Each find starts from a freshly read root, so every node on the path
+    // is read from disk and decoded
+    run_result ret{.written = aux.slow_list_compression_stats};
+    auto const version = num_blocks - 1;
+    auto const root_offset = aux.get_root_offset_at_version(version);
+    for (uint64_t n = 0; n < num_finds; ++n) {
+        auto const key = to_key(rng() % num_keys);
+        auto const begin = std::chrono::steady_clock::now();
+        auto const fresh_root = read_node_blocking(aux, root_offset, version);
+        MONAD_ASSERT(fresh_root);
+        auto const [cursor, result] =
+            find_blocking(aux, NodeCursor{*fresh_root}, key, version);
+        ret.find_elapsed += std::chrono::steady_clock::now() - begin;
+        MONAD_ASSERT(result == find_result::success);
+    }
+    return ret;
+}
+
+int main(int argc, char *const argv[])
+{
+    uint64_t num_blocks = 20;
+    uint64_t updates_per_block = 50'000;
+    uint64_t num_finds = 100'000;
+    int compression_level = 3;
+    std::vector<std::filesystem::path> dbname_paths;
+
+    CLI::App cli(
+        "Benchmark disk saved against read latency added by compressing "
+        "slow list nodes",
+        "node_compression_bench");
+    try {
+        cli.add_option("--blocks", num_blocks, "Number of blocks upserted");
+        cli.add_option(
+            "--updates-per-block",
+            updates_per_block,
+            "Number of new keys in each block");
+        cli.add_option(
+            "--finds", num_finds, "Number of random keys looked up");
+        cli.add_option(
+            "--level", compression_level, "zstd compression level");
+        cli.add_option(
+            "--db",
+            dbname_paths,
+            "A comma-separated list of database paths, which will be "
+            "overwritten. An anonymous inode is used if not set.");
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(num_blocks > 0 && updates_per_block > 0 && num_finds > 0);
+    MONAD_ASSERT(compression_level != 0);
+
+    auto const to_ns = [](auto const d) {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+    };
+    auto const uncompressed = run(
+        dbname_paths, 0, num_blocks, updates_per_block, num_finds);
+    auto const compressed = run(
+        dbname_paths,
+        compression_level,
+        num_blocks,
+        updates_per_block,
+        num_finds);
+    auto const &written = compressed.written;
+    std::cout << "Wrote " << written.nodes << " slow list nodes of "
+              << written.uncompressed_bytes << " bytes, stored in "
+              << written.stored_bytes << " bytes at zstd level "
+              << compression_level << " ("
+              << 100.0 * (1.0 - static_cast<double>(written.stored_bytes) /
+                                    static_cast<double>(std::max<uint64_t>(
+                                        written.uncompressed_bytes, 1)))
+              << "% saved)" << std::endl;
+    std::cout << "Mean find from disk: uncompressed "
+              << to_ns(uncompressed.find_elapsed) /
+                     static_cast<int64_t>(num_finds)
+              << " ns, compressed "
+              << to_ns(compressed.find_elapsed) /
+                     static_cast<int64_t>(num_finds)
+              << " ns" << std::endl;
+    return 0;
+}
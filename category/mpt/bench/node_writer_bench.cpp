@@ -0,0 +1,179 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <category/async/io.hpp>
+#include <category/async/storage_pool.hpp>
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/io/buffers.hpp>
+#include <category/core/io/ring.hpp>
+#include <category/core/keccak.hpp>
+#include <category/mpt/node.hpp>
+#include <category/mpt/test/test_fixtures_base.hpp>
+#include <category/mpt/trie.hpp>
+#include <category/mpt/update.hpp>
+#include <category/mpt/util.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace monad::mpt;
+using namespace monad::test;
+using namespace MONAD_ASYNC_NAMESPACE;
+
+static monad::byte_string to_key(uint64_t const key)
+{
+    auto const as_bytes = serialize_as_big_endian<sizeof(key)>(key);
+    auto const hash = monad::keccak256(as_bytes);
+    return monad::byte_string{hash.bytes, sizeof(hash.bytes)};
+}
+
+struct run_result
+{
+    std::chrono::steady_clock::duration total_upsert{};
+    std::chrono::steady_clock::duration max_upsert{};
+    std::chrono::steady_clock::duration write_stall{};
+    uint64_t write_stalls{0};
+};
+
+static run_result run(
+    std::vector<std::filesystem::path> const &dbname_paths,
+    unsigned const write_queue_depth, unsigned const wr_buffers,
+    uint64_t const num_blocks, uint64_t const updates_per_block)
+{
+    auto pool = dbname_paths.empty()
+                    ? storage_pool{use_anonymous_inode_tag{}}
+                    : storage_pool{dbname_paths, storage_pool::mode::truncate};
+    // as Db does, give each node writer a buffer per write in flight
+    auto const write_buffers =
+        std::max(wr_buffers, 2 * (write_queue_depth + 1));
+    monad::io::Ring read_ring{monad::io::RingConfig{512}};
+    monad::io::Ring write_ring{monad::io::RingConfig{write_buffers}};
+    auto buffers = monad::io::make_buffers_for_segregated_read_write(
+        read_ring,
+        write_ring,
+        1024,
+        write_buffers,
+        AsyncIO::MONAD_IO_BUFFERS_READ_SIZE,
+        AsyncIO::MONAD_IO_BUFFERS_WRITE_SIZE);
+    AsyncIO io{pool, buffers};
+    UpdateAux<> aux{&io};
+    aux.set_write_queue_depth(write_queue_depth);
+    StateMachineAlwaysMerkle sm;
+    Node::UniquePtr root;
+
+    // Half of each block's updates create new keys, the other half overwrite
+    // randomly chosen existing ones
+    std::mt19937_64 rng{42};
+    uint64_t next_key = 0;
+    run_result ret;
+    for (uint64_t version = 0; version < num_blocks; ++version) {
+        UpdateList ul;
+        std::list<monad::byte_string> bytes_alloc;
+        std::list<Update> update_alloc;
+        for (uint64_t n = 0; n < updates_per_block; ++n) {
+            uint64_t const k = (n % 2 == 0 || next_key == 0)
+                                   ? next_key++
+                                   : rng() % next_key;
+            auto const &key = bytes_alloc.emplace_back(to_key(k));
+            auto const &value = bytes_alloc.emplace_back(to_key(rng()));
+            ul.push_front(update_alloc.emplace_back(
+                make_update(key, value, false, UpdateList{}, version)));
+        }
+        auto const stalls_begin = io.write_stalls();
+        auto const stall_begin = io.write_stall_duration();
+        auto const begin = std::chrono::steady_clock::now();
+        root = aux.do_update(std::move(root), sm, std::move(ul), version, true);
+        auto const elapsed = std::chrono::steady_clock::now() - begin;
+        ret.total_upsert += elapsed;
+        ret.max_upsert = std::max(ret.max_upsert, elapsed);
+        ret.write_stall += io.write_stall_duration() - stall_begin;
+        ret.write_stalls += io.write_stalls() - stalls_begin;
+    }
+    return ret;
+}
+
+int main(int argc, char *const argv[])
+{
+    uint64_t num_blocks = 100;
+    uint64_t updates_per_block = 50'000;
+    unsigned write_queue_depth = 2;
+    unsigned wr_buffers = 4;
+    std::vector<std::filesystem::path> dbname_paths;
+
+    CLI::App cli(
+        "Benchmark the pipelined node writer against full buffer writes",
+        "node_writer_bench");
+    try {
+        cli.add_option("--blocks", num_blocks, "Number of blocks upserted");
+        cli.add_option(
+            "--updates-per-block",
+            updates_per_block,
+            "Number of key updates in each block");
+        cli.add_option(
+            "--write-queue-depth",
+            write_queue_depth,
+            "Write queue depth of the pipelined node writer");
+        cli.add_option(
+            "--wr-buffers", wr_buffers, "Minimum number of write buffers");
+        cli.add_option(
+            "--db",
+            dbname_paths,
+            "A comma-separated list of database paths, which will be "
+            "overwritten. An anonymous inode is used if not set.");
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(num_blocks > 0 && updates_per_block > 0);
+    MONAD_ASSERT(write_queue_depth > 0);
+
+    auto const to_us = [](auto const d) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    };
+    std::cout << "Upserting " << num_blocks << " blocks of "
+              << updates_per_block << " updates" << std::endl;
+    for (unsigned const depth : {0u, write_queue_depth}) {
+        auto const r = run(
+            dbname_paths, depth, wr_buffers, num_blocks, updates_per_block);
+        std::cout << (depth == 0 ? "  full buffer writes"
+                                 : "  pipelined writes, depth ")
+                  << (depth == 0 ? "" : std::to_string(depth))
+                  << ": mean upsert "
+                  << to_us(r.total_upsert) / static_cast<int64_t>(num_blocks)
+                  << " us, max upsert " << to_us(r.max_upsert)
+                  << " us, write stalls " << r.write_stalls << " totalling "
+                  << to_us(r.write_stall) << " us ("
+                  << to_us(r.write_stall) / static_cast<int64_t>(num_blocks)
+                  << " us per block)" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,181 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/hex_literal.hpp>
+#include <category/core/keccak.hpp>
+#include <category/mpt/db.hpp>
+#include <category/mpt/nibbles_view.hpp>
+#include <category/mpt/ondisk_db_config.hpp>
+#include <category/mpt/test/test_fixtures_base.hpp>
+#include <category/mpt/trie.hpp>
+#include <category/mpt/update.hpp>
+#include <category/mpt/util.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <list>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace monad::mpt;
+using namespace monad::test;
+
+static monad::byte_string to_key(uint64_t const key)
+{
+    auto const as_bytes = serialize_as_big_endian<sizeof(key)>(key);
+    auto const hash = monad::keccak256(as_bytes);
+    return monad::byte_string{hash.bytes, sizeof(hash.bytes)};
+}
+
+int main(int argc, char *const argv[])
+{
+    uint64_t num_keys = 1'000'000;
+    size_t keys_per_proof = 1000;
+    size_t num_proofs = 100;
+    std::vector<std::filesystem::path> dbname_paths;
+
+    CLI::App cli(
+        "Benchmark batched merkle multiproofs against one proof per key",
+        "proof_bench");
+    try {
+        cli.add_option(
+            "--num-keys", num_keys, "Number of keys written to the trie");
+        cli.add_option(
+            "--keys-per-proof",
+            keys_per_proof,
+            "Number of random keys proven by each multiproof");
+        cli.add_option(
+            "--num-proofs", num_proofs, "Number of multiproofs generated");
+        cli.add_option(
+               "--db",
+               dbname_paths,
+               "A comma-separated list of database paths, which will be "
+               "overwritten")
+            ->required();
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(num_keys > 0 && keys_per_proof > 0 && num_proofs > 0);
+
+    auto const prefix = 0x10_hex;
+    {
+        StateMachineAlwaysMerkle machine;
+        Db db{
+            machine,
+            OnDiskDbConfig{
+                .compaction = true,
+                .dbname_paths = dbname_paths}};
+        std::cout << "Writing " << num_keys << " keys..." << std::endl;
+        constexpr uint64_t keys_per_version = 100'000;
+        for (uint64_t version = 0; version * keys_per_version < num_keys;
+             ++version) {
+            UpdateList ul;
+            std::list<monad::byte_string> bytes_alloc;
+            std::list<Update> update_alloc;
+            auto const begin = version * keys_per_version;
+            auto const end = std::min(num_keys, begin + keys_per_version);
+            for (uint64_t k = begin; k < end; ++k) {
+                auto const &key = bytes_alloc.emplace_back(to_key(k));
+                ul.push_front(update_alloc.emplace_back(
+                    make_update(key, key, false, UpdateList{}, version)));
+            }
+            UpdateList ul_prefix;
+            auto u_prefix = make_update(
+                prefix,
+                monad::byte_string_view{},
+                false,
+                std::move(ul),
+                version);
+            ul_prefix.push_front(u_prefix);
+            db.upsert(std::move(ul_prefix), version);
+        }
+    }
+
+    AsyncIOContext io_ctx{ReadOnlyOnDiskDbConfig{.dbname_paths = dbname_paths}};
+    Db ro_db{io_ctx};
+    auto const version = ro_db.get_latest_version();
+
+    std::mt19937_64 rng{42};
+    std::uniform_int_distribution<uint64_t> dist{0, num_keys - 1};
+    std::vector<monad::byte_string> keys;
+    std::vector<NibblesView> key_views;
+
+    std::chrono::steady_clock::duration multi_elapsed{};
+    std::chrono::steady_clock::duration single_elapsed{};
+    size_t distinct_nodes = 0;
+    size_t single_nodes = 0;
+    for (size_t p = 0; p < num_proofs; ++p) {
+        keys.clear();
+        for (size_t k = 0; k < keys_per_proof; ++k) {
+            keys.emplace_back(to_key(dist(rng)));
+        }
+        key_views.assign(keys.begin(), keys.end());
+
+        auto begin = std::chrono::steady_clock::now();
+        auto const multi = ro_db.generate_proof(
+            prefix, key_views, &DummyComputeLeafData::compute, version);
+        multi_elapsed += std::chrono::steady_clock::now() - begin;
+        MONAD_ASSERT(multi.has_value());
+        distinct_nodes += multi.value().nodes.size();
+
+        // baseline: one proof per key, sharing nothing
+        begin = std::chrono::steady_clock::now();
+        for (auto const &key : key_views) {
+            auto const single = ro_db.generate_proof(
+                prefix,
+                std::span{&key, 1},
+                &DummyComputeLeafData::compute,
+                version);
+            MONAD_ASSERT(single.has_value());
+            MONAD_ASSERT(
+                single.value().keys[0].result == find_result::success);
+            single_nodes += single.value().nodes.size();
+        }
+        single_elapsed += std::chrono::steady_clock::now() - begin;
+    }
+
+    auto const to_us = [](auto const d) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    };
+    auto const per_second = [&](auto const d) {
+        return static_cast<double>(num_proofs * keys_per_proof) * 1'000'000 /
+               static_cast<double>(std::max<int64_t>(to_us(d), 1));
+    };
+    std::cout << "Proved " << num_proofs << " batches of " << keys_per_proof
+              << " keys out of " << num_keys << std::endl;
+    std::cout << "  multiproof: " << to_us(multi_elapsed) << " us, "
+              << per_second(multi_elapsed) << " keys/s, " << distinct_nodes
+              << " proof nodes" << std::endl;
+    std::cout << "  proof per key: " << to_us(single_elapsed) << " us, "
+              << per_second(single_elapsed) << " keys/s, " << single_nodes
+              << " proof nodes" << std::endl;
+    return 0;
+}
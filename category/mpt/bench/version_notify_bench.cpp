@@ -0,0 +1,209 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/keccak.hpp>
+#include <category/mpt/db.hpp>
+#include <category/mpt/ondisk_db_config.hpp>
+#include <category/mpt/test/test_fixtures_base.hpp>
+#include <category/mpt/trie.hpp>
+#include <category/mpt/update.hpp>
+#include <category/mpt/util.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <list>
+#include <thread>
+#include <vector>
+
+using namespace monad::mpt;
+using namespace monad::test;
+
+static monad::byte_string to_key(uint64_t const key)
+{
+    auto const as_bytes = serialize_as_big_endian<sizeof(key)>(key);
+    auto const hash = monad::keccak256(as_bytes);
+    return monad::byte_string{hash.bytes, sizeof(hash.bytes)};
+}
+
+struct run_result
+{
+    // time from the writer's upsert returning to the reader seeing the
+    // version, for every version the reader saw
+    std::vector<std::chrono::nanoseconds> head_lag;
+    uint64_t versions_skipped{0};
+};
+
+// A poll interval of zero waits on version change notifications instead
+static run_result run(
+    std::vector<std::filesystem::path> const &dbname_paths,
+    std::chrono::microseconds const poll_interval,
+    std::chrono::microseconds const block_interval, uint64_t const num_blocks,
+    uint64_t const updates_per_block)
+{
+    using clock = std::chrono::steady_clock;
+    StateMachineAlwaysMerkle machine;
+    Db db{
+        machine,
+        OnDiskDbConfig{
+            .compaction = true,
+            .dbname_paths = dbname_paths,
+            .fixed_history_length = num_blocks}};
+    AsyncIOContext io_ctx{ReadOnlyOnDiskDbConfig{.dbname_paths = dbname_paths}};
+    Db ro_db{io_ctx};
+
+    // Each side only writes its own vector, they are compared after joining
+    std::vector<clock::time_point> upserted(num_blocks);
+    std::vector<clock::time_point> seen_at(num_blocks);
+    std::vector<bool> seen(num_blocks, false);
+    std::thread reader([&] {
+        uint64_t latest = INVALID_BLOCK_NUM;
+        while (latest != num_blocks - 1) {
+            uint64_t now_latest;
+            if (poll_interval.count() == 0) {
+                now_latest = ro_db.wait_for_latest_version_change(
+                    latest, std::chrono::seconds(1));
+            }
+            else {
+                now_latest = ro_db.get_latest_version();
+                if (now_latest == latest) {
+                    std::this_thread::sleep_for(poll_interval);
+                    continue;
+                }
+            }
+            if (now_latest != latest) {
+                seen_at[now_latest] = clock::now();
+                seen[now_latest] = true;
+                latest = now_latest;
+            }
+        }
+    });
+
+    for (uint64_t version = 0; version < num_blocks; ++version) {
+        auto const begin = clock::now();
+        UpdateList ul;
+        std::list<monad::byte_string> bytes_alloc;
+        std::list<Update> update_alloc;
+        for (uint64_t n = 0; n < updates_per_block; ++n) {
+            auto const &key = bytes_alloc.emplace_back(
+                to_key(version * updates_per_block + n));
+            ul.push_front(update_alloc.emplace_back(
+                make_update(key, key, false, UpdateList{}, version)));
+        }
+        db.upsert(std::move(ul), version);
+        upserted[version] = clock::now();
+        std::this_thread::sleep_until(begin + block_interval);
+    }
+    reader.join();
+
+    run_result ret;
+    for (uint64_t version = 0; version < num_blocks; ++version) {
+        if (!seen[version]) {
+            ++ret.versions_skipped;
+            continue;
+        }
+        // the version is visible to readers shortly before upsert() returns
+        ret.head_lag.push_back(std::max(
+            std::chrono::nanoseconds{0},
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                seen_at[version] - upserted[version])));
+    }
+    std::sort(ret.head_lag.begin(), ret.head_lag.end());
+    return ret;
+}
+
+int main(int argc, char *const argv[])
+{
+    uint64_t num_blocks = 2000;
+    uint64_t updates_per_block = 100;
+    unsigned block_interval_us = 2000;
+    unsigned poll_interval_us = 100;
+    std::vector<std::filesystem::path> dbname_paths;
+
+    CLI::App cli(
+        "Benchmark how far behind the writer a read only Db sees the latest "
+        "version, when notified against when polling",
+        "version_notify_bench");
+    try {
+        cli.add_option("--blocks", num_blocks, "Number of blocks upserted");
+        cli.add_option(
+            "--updates-per-block",
+            updates_per_block,
+            "Number of new keys in each block");
+        cli.add_option(
+            "--block-interval-us",
+            block_interval_us,
+            "Time between the start of each upsert");
+        cli.add_option(
+            "--poll-interval-us",
+            poll_interval_us,
+            "Sleep between polls of the latest version");
+        cli.add_option(
+               "--db",
+               dbname_paths,
+               "A comma-separated list of database paths, which will be "
+               "overwritten")
+            ->required();
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(num_blocks > 0 && updates_per_block > 0);
+    MONAD_ASSERT(poll_interval_us > 0);
+
+    auto const to_us = [](std::chrono::nanoseconds const d) {
+        return static_cast<double>(d.count()) / 1000.0;
+    };
+    std::cout << "Upserting " << num_blocks << " blocks of "
+              << updates_per_block << " updates every " << block_interval_us
+              << " us" << std::endl;
+    for (unsigned const poll_us : {0u, poll_interval_us}) {
+        auto const r = run(
+            dbname_paths,
+            std::chrono::microseconds(poll_us),
+            std::chrono::microseconds(block_interval_us),
+            num_blocks,
+            updates_per_block);
+        MONAD_ASSERT(!r.head_lag.empty());
+        auto const percentile = [&](double const p) {
+            return r.head_lag[static_cast<size_t>(
+                p * static_cast<double>(r.head_lag.size() - 1))];
+        };
+        if (poll_us == 0) {
+            std::cout << "  notified:";
+        }
+        else {
+            std::cout << "  polling every " << poll_us << " us:";
+        }
+        std::cout << " head lag p50 " << to_us(percentile(0.5)) << " us, p99 "
+                  << to_us(percentile(0.99)) << " us, max "
+                  << to_us(r.head_lag.back()) << " us, " << r.versions_skipped
+                  << " versions never seen" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,200 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/hex_literal.hpp>
+#include <category/core/keccak.hpp>
+#include <category/mpt/db.hpp>
+#include <category/mpt/nibbles_view.hpp>
+#include <category/mpt/ondisk_db_config.hpp>
+#include <category/mpt/test/test_fixtures_base.hpp>
+#include <category/mpt/trie.hpp>
+#include <category/mpt/update.hpp>
+#include <category/mpt/util.hpp>
+
+#include <CLI/CLI.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <list>
+#include <vector>
+
+using namespace monad::mpt;
+using namespace monad::test;
+
+static monad::byte_string to_key(uint64_t const key)
+{
+    auto const as_bytes = serialize_as_big_endian<sizeof(key)>(key);
+    auto const hash = monad::keccak256(as_bytes);
+    return monad::byte_string{hash.bytes, sizeof(hash.bytes)};
+}
+
+int main(int argc, char *const argv[])
+{
+    uint64_t num_versions = 10000;
+    size_t num_keys_per_version = 100;
+    size_t num_query_keys = 16;
+    unsigned hot_key_update_interval = 8;
+    std::vector<std::filesystem::path> dbname_paths;
+
+    CLI::App cli(
+        "Benchmark a version range find against independent finds per "
+        "version",
+        "version_range_bench");
+    try {
+        cli.add_option(
+            "--num-versions",
+            num_versions,
+            "Number of versions to write and query");
+        cli.add_option(
+            "--num-keys-per-version",
+            num_keys_per_version,
+            "Number of new background keys inserted per version");
+        cli.add_option(
+            "--num-query-keys",
+            num_query_keys,
+            "Number of hot keys queried over the whole version range");
+        cli.add_option(
+            "--hot-key-update-interval",
+            hot_key_update_interval,
+            "Each hot key is rewritten once every this many versions");
+        cli.add_option(
+               "--db",
+               dbname_paths,
+               "A comma-separated list of database paths, which will be "
+               "overwritten")
+            ->required();
+        cli.parse(argc, argv);
+    }
+    catch (CLI::CallForHelp const &) {
+        std::cout << cli.help() << std::flush;
+        return 0;
+    }
+    catch (CLI::ParseError const &e) {
+        std::cerr << "FATAL: " << e.what() << "\n\n";
+        std::cerr << cli.help() << std::flush;
+        return 1;
+    }
+    MONAD_ASSERT(num_versions > 0 && num_query_keys > 0);
+    MONAD_ASSERT(hot_key_update_interval > 0);
+
+    auto const prefix = 0x10_hex;
+    std::vector<monad::byte_string> hot_keys;
+    for (size_t k = 0; k < num_query_keys; ++k) {
+        hot_keys.emplace_back(to_key(~uint64_t(k)));
+    }
+
+    {
+        StateMachineAlwaysMerkle machine;
+        Db db{
+            machine,
+            OnDiskDbConfig{
+                .compaction = true,
+                .dbname_paths = dbname_paths,
+                .fixed_history_length = num_versions}};
+        std::cout << "Writing " << num_versions << " versions..." << std::endl;
+        for (uint64_t version = 0; version < num_versions; ++version) {
+            UpdateList ul;
+            std::list<monad::byte_string> bytes_alloc;
+            std::list<Update> update_alloc;
+            auto const &version_bytes = bytes_alloc.emplace_back(
+                serialize_as_big_endian<sizeof(uint64_t)>(version));
+            for (size_t k = 0; k < num_keys_per_version; ++k) {
+                ul.push_front(update_alloc.emplace_back(make_update(
+                    bytes_alloc.emplace_back(
+                        to_key(version * num_keys_per_version + k)),
+                    version_bytes,
+                    false,
+                    UpdateList{},
+                    version)));
+            }
+            for (size_t k = 0; k < hot_keys.size(); ++k) {
+                if ((version + k) % hot_key_update_interval == 0) {
+                    ul.push_front(update_alloc.emplace_back(make_update(
+                        hot_keys[k],
+                        version_bytes,
+                        false,
+                        UpdateList{},
+                        version)));
+                }
+            }
+            UpdateList ul_prefix;
+            auto u_prefix = make_update(prefix, std::move(ul), version);
+            ul_prefix.push_front(u_prefix);
+            db.upsert(std::move(ul_prefix), version);
+        }
+    }
+
+    AsyncIOContext io_ctx{ReadOnlyOnDiskDbConfig{.dbname_paths = dbname_paths}};
+    Db ro_db{io_ctx};
+    auto const min_version = ro_db.get_earliest_version();
+    auto const max_version = ro_db.get_latest_version();
+    auto const num_queried_versions = max_version - min_version + 1;
+
+    std::vector<monad::byte_string> query_keys;
+    for (auto const &key : hot_keys) {
+        query_keys.emplace_back(prefix + key);
+    }
+    std::vector<NibblesView> query_key_views{
+        query_keys.begin(), query_keys.end()};
+
+    // baseline: one find per key per version
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::vector<monad::byte_string>> expected(query_keys.size());
+    for (size_t k = 0; k < query_keys.size(); ++k) {
+        for (uint64_t v = min_version; v <= max_version; ++v) {
+            auto const res = ro_db.get(query_keys[k], v);
+            expected[k].emplace_back(
+                res.has_value() ? monad::byte_string{res.value()}
+                                : monad::byte_string{});
+        }
+    }
+    auto const independent_elapsed = std::chrono::steady_clock::now() - begin;
+
+    begin = std::chrono::steady_clock::now();
+    auto const results =
+        ro_db.find_version_range(query_key_views, min_version, max_version);
+    auto const range_elapsed = std::chrono::steady_clock::now() - begin;
+
+    size_t total_runs = 0;
+    for (size_t k = 0; k < query_keys.size(); ++k) {
+        total_runs += results[k].size();
+        for (auto const &run : results[k]) {
+            for (uint64_t v = run.begin_version; v <= run.end_version; ++v) {
+                auto const &value = run.result == find_result::success
+                                        ? run.value
+                                        : monad::byte_string{};
+                MONAD_ASSERT(expected[k][v - min_version] == value);
+            }
+        }
+    }
+
+    auto const to_us = [](auto const d) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+    };
+    auto const num_lookups = query_keys.size() * num_queried_versions;
+    std::cout << "Queried " << query_keys.size() << " keys over "
+              << num_queried_versions << " versions (" << num_lookups
+              << " lookups, " << total_runs << " distinct runs)" << std::endl;
+    std::cout << "  independent finds: " << to_us(independent_elapsed)
+              << " us" << std::endl;
+    std::cout << "  version range find: " << to_us(range_elapsed) << " us"
+              << std::endl;
+    return 0;
+}
@@ -813,11 +813,7 @@ public:
                     auto const *old_metadata =
                         (monad::mpt::detail::db_metadata const *)
                             i.nonchunkstorage.data();
-                    if (memcmp(
-                            old_metadata->magic,
-                            monad::mpt::detail::db_metadata::MAGIC,
-                            monad::mpt::detail::db_metadata::
-                                MAGIC_STRING_LEN)) {
+                    if (!old_metadata->has_valid_magic()) {
                         std::stringstream ss;
                         ss << "DB archive was generated with version "
                            << old_metadata->magic
@@ -854,14 +850,15 @@ public:
                         f(db_metadata[1]);
                     };
                     do_([&](monad::mpt::detail::db_metadata *metadata) {
-                        MONAD_ASSERT(
-                            0 == memcmp(
-                                     metadata->magic,
-                                     monad::mpt::detail::db_metadata::MAGIC,
-                                     monad::mpt::detail::db_metadata::
-                                         MAGIC_STRING_LEN));
+                        MONAD_ASSERT(metadata->has_valid_magic());
                     });
                     do_([&](monad::mpt::detail::db_metadata *metadata) {
+                        // carries over whether slow list nodes may be
+                        // compressed
+                        memcpy(
+                            metadata->magic,
+                            old_metadata->magic,
+                            sizeof(metadata->magic));
                         metadata->db_offsets.store(old_metadata->db_offsets);
                         metadata->root_offsets.next_version_ =
                             old_metadata->root_offsets.next_version_;
@@ -31,9 +31,9 @@
 
 MONAD_MPT_NAMESPACE_BEGIN
 
-unsigned encode_two_pieces(
-    unsigned char *const dest, NibblesView const path,
-    byte_string_view const second, bool const has_value)
+byte_string encode_two_pieces_rlp(
+    NibblesView const path, byte_string_view const second,
+    bool const has_value)
 {
     constexpr size_t max_compact_encode_size = KECCAK256_SIZE + 1;
 
@@ -60,9 +60,32 @@ unsigned encode_two_pieces(
 
     byte_string rlp(rlp::list_length(concat_len), 0);
     rlp::encode_list(rlp, {concat_rlp.data(), concat_rlp.size()});
-    auto ret = to_node_reference({rlp.data(), rlp.size()}, dest);
-    // free any long array allocated on heap
-    return ret;
+    return rlp;
+}
+
+unsigned encode_two_pieces(
+    unsigned char *const dest, NibblesView const path,
+    byte_string_view const second, bool const has_value)
+{
+    auto const rlp = encode_two_pieces_rlp(path, second, has_value);
+    return to_node_reference({rlp.data(), rlp.size()}, dest);
+}
+
+byte_string encode_branch_rlp(Node *const node)
+{
+    // 16 hashed children and the empty value
+    constexpr size_t max_branch_str_size = (KECCAK256_SIZE + 1) * 16 + 1;
+
+    MONAD_ASSERT(node->number_of_children());
+    unsigned char branch_str_rlp[max_branch_str_size];
+    auto result = encode_16_children(node, {branch_str_rlp});
+    result = encode_empty_string(result);
+    auto const concat_len = static_cast<size_t>(result.data() - branch_str_rlp);
+    MONAD_ASSERT(concat_len <= max_branch_str_size);
+
+    byte_string rlp(rlp::list_length(concat_len), 0);
+    rlp::encode_list(rlp, byte_string_view{branch_str_rlp, concat_len});
+    return rlp;
 }
 
 std::span<unsigned char> encode_empty_string(std::span<unsigned char> result)
@@ -61,6 +61,15 @@ unsigned encode_two_pieces(
     unsigned char *const dest, NibblesView const path,
     byte_string_view const second, bool const has_value = false);
 
+//! rlp of the leaf or extension node whose node reference is returned by
+//! encode_two_pieces()
+byte_string encode_two_pieces_rlp(
+    NibblesView path, byte_string_view second, bool has_value = false);
+
+//! rlp of the valueless branch node formed by the children of node, whose node
+//! reference is what MerkleComputeBase::compute_branch() computes
+byte_string encode_branch_rlp(Node *node);
+
 struct Compute
 {
     virtual ~Compute() = default;
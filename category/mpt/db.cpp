@@ -36,6 +36,7 @@
 #include <category/mpt/nibbles_view.hpp>
 #include <category/mpt/node.hpp>
 #include <category/mpt/node_cache.hpp>
+#include <category/mpt/shared_node_cache.hpp>
 #include <category/mpt/ondisk_db_config.hpp>
 #include <category/mpt/traverse.hpp>
 #include <category/mpt/trie.hpp>
@@ -47,6 +48,7 @@
 
 #include <quill/Quill.h>
 
+#include <algorithm>
 #include <atomic>
 #include <cerrno>
 #include <chrono>
@@ -57,6 +59,8 @@
 #include <iterator>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <system_error>
 #include <thread>
@@ -82,6 +86,33 @@ namespace detail
         {
         }
     };
+
+    // Each of the fast and slow node writers needs one buffer to fill plus
+    // one per write it may have in flight
+    inline unsigned write_buffer_count(OnDiskDbConfig const &options)
+    {
+        return std::max(
+            options.wr_buffers, 2 * (options.write_queue_depth + 1));
+    }
+
+    // Returns the latest version once it differs from `version`, or when the
+    // timeout elapses
+    uint64_t wait_for_latest_version_change(
+        UpdateAuxImpl const &aux, uint64_t const version,
+        std::chrono::nanoseconds const timeout)
+    {
+        auto const deadline = std::chrono::steady_clock::now() + timeout;
+        for (;;) {
+            // read the sequence first so a change in between is not missed
+            auto const seen = aux.version_change_sequence();
+            auto const latest = aux.db_history_max_version();
+            auto const now = std::chrono::steady_clock::now();
+            if (latest != version || now >= deadline) {
+                return latest;
+            }
+            aux.wait_for_version_change(seen, deadline - now);
+        }
+    }
 }
 
 struct Db::Impl
@@ -98,6 +129,19 @@ struct Db::Impl
         NibblesView dest, bool blocked_by_write = true) = 0;
     virtual find_cursor_result_type find_fiber_blocking(
         NodeCursor const &root, NibblesView const &key, uint64_t version) = 0;
+
+    // Find each key below `root` into the result at the same index. By
+    // default the keys are found one at a time.
+    virtual void find_many_fiber_blocking(
+        NodeCursor const &root, std::span<NibblesView const> const keys,
+        std::span<find_cursor_result_type> const results,
+        uint64_t const version)
+    {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            results[i] = find_fiber_blocking(root, keys[i], version);
+        }
+    }
+
     virtual size_t prefetch_fiber_blocking() = 0;
     virtual NodeCursor load_root_for_version(uint64_t version) = 0;
     virtual size_t poll(bool blocking, size_t count) = 0;
@@ -106,6 +150,26 @@ struct Db::Impl
         size_t concurrency_limit) = 0;
     virtual void
     move_trie_version_fiber_blocking(uint64_t src, uint64_t dest) = 0;
+
+    // Trie operations which may still be running on return. By default they
+    // have completed.
+    virtual void copy_trie_async(
+        uint64_t const src_version, NibblesView const src,
+        uint64_t const dest_version, NibblesView const dest,
+        bool const blocked_by_write)
+    {
+        copy_trie_fiber_blocking(
+            src_version, src, dest_version, dest, blocked_by_write);
+    }
+
+    virtual void
+    move_trie_version_async(uint64_t const src, uint64_t const dest)
+    {
+        move_trie_version_fiber_blocking(src, dest);
+    }
+
+    virtual void wait_for_trie_ops() {}
+
     virtual void update_finalized_version(uint64_t) = 0;
     virtual void update_verified_version(uint64_t) = 0;
     virtual uint64_t get_latest_finalized_version() const = 0;
@@ -164,13 +228,27 @@ AsyncIOContext::AsyncIOContext(OnDiskDbConfig const &options)
                            : async::storage_pool::mode::truncate};
     }()}
     , read_ring{{options.uring_entries, options.enable_io_polling, options.sq_thread_cpu}}
-    , write_ring{io::RingConfig{options.wr_buffers}}
+    , write_ring{io::RingConfig{detail::write_buffer_count(options)}}
     , buffers{io::make_buffers_for_segregated_read_write(
-          read_ring, *write_ring, options.rd_buffers, options.wr_buffers,
+          read_ring, *write_ring, options.rd_buffers,
+          detail::write_buffer_count(options),
           async::AsyncIO::MONAD_IO_BUFFERS_READ_SIZE,
           async::AsyncIO::MONAD_IO_BUFFERS_WRITE_SIZE)}
     , io{pool, buffers}
 {
+    if (!options.low_latency_dbname_paths.empty()) {
+        for (size_t n = 0; n < options.dbname_paths.size(); n++) {
+            bool const low_latency = std::ranges::contains(
+                options.low_latency_dbname_paths, options.dbname_paths[n]);
+            pool.set_device_tier(
+                n,
+                low_latency ? async::storage_pool::device_tier::low_latency
+                            : async::storage_pool::device_tier::capacity);
+        }
+        MONAD_ASSERT(
+            pool.is_tiered(),
+            "low latency db paths must be a strict subset of the db paths");
+    }
     io.set_capture_io_latencies(options.capture_io_latencies);
     io.set_concurrent_read_io_limit(options.concurrent_read_io_limit);
     io.set_eager_completions(options.eager_completions);
@@ -402,14 +480,16 @@ struct OnDiskWithWorkerThreadImpl
         bool write_root;
     };
 
+    // A null src_root, or a null dest_root for a different version, is read
+    // by the worker. The prefixes are owned as the caller may not wait.
     struct FiberCopyTrieRequest
     {
         threadsafe_boost_fibers_promise<Node::UniquePtr> *promise;
-        std::reference_wrapper<Node> src_root;
-        NibblesView src;
+        Node *src_root;
+        Nibbles src;
         uint64_t src_version;
         Node::UniquePtr dest_root;
-        NibblesView dest;
+        Nibbles dest;
         uint64_t dest_version;
         bool blocked_by_write;
     };
@@ -452,11 +532,21 @@ struct OnDiskWithWorkerThreadImpl
         uint64_t version;
     };
 
+    struct RODbFiberFindManyOwningRequest
+    {
+        threadsafe_boost_fibers_promise<void> *promise;
+        OwningNodeCursor start;
+        std::span<NibblesView const> keys;
+        std::span<find_owning_cursor_result_type> results;
+        uint64_t version;
+    };
+
     using Comms = std::variant<
         std::monostate, fiber_find_request_t, FiberUpsertRequest,
         FiberLoadAllFromBlockRequest, FiberTraverseRequest, MoveSubtrieRequest,
         FiberLoadRootVersionRequest, FiberCopyTrieRequest,
-        RODbFiberFindOwningNodeRequest>;
+        RODbFiberFindOwningNodeRequest, fiber_find_many_request_t,
+        RODbFiberFindManyOwningRequest>;
 
     ::moodycamel::ConcurrentQueue<Comms> comms_;
     std::mutex lock_;
@@ -485,6 +575,9 @@ struct OnDiskWithWorkerThreadImpl
             , async_io(options)
             , aux{&async_io.io, options.fixed_history_length}
         {
+            aux.set_write_queue_depth(options.write_queue_depth);
+            aux.set_slow_list_compression_level(
+                options.slow_list_compression_level);
             if (options.rewind_to_latest_finalized) {
                 auto const latest_block_id = aux.get_latest_finalized_version();
                 if (latest_block_id == INVALID_BLOCK_NUM) {
@@ -496,14 +589,23 @@ struct OnDiskWithWorkerThreadImpl
             }
         }
 
-        void rodb_run(size_t const node_lru_max_mem)
+        void rodb_run(ReadOnlyOnDiskDbConfig const &options)
         {
             inflight_map_owning_t inflight;
-            NodeCache node_cache{node_lru_max_mem};
+            NodeCache node_cache{options.node_lru_max_mem};
+            std::optional<SharedNodeCache> shared_node_cache;
+            if (options.shared_node_cache_path.has_value()) {
+                shared_node_cache.emplace(
+                    *options.shared_node_cache_path,
+                    options.shared_node_cache_max_mem);
+                node_cache.set_shared_cache(&*shared_node_cache);
+            }
 
             ::boost::container::deque<
                 threadsafe_boost_fibers_promise<find_owning_cursor_result_type>>
                 find_owning_cursor_promises;
+            ::boost::container::deque<threadsafe_boost_fibers_promise<void>>
+                find_many_promises;
 
             Comms request;
             unsigned did_nothing_count = 0;
@@ -534,6 +636,21 @@ struct OnDiskWithWorkerThreadImpl
                                 req->version);
                         }
                     }
+                    else if (auto *req = std::get_if<10>(&request);
+                             req != nullptr) {
+                        find_many_promises.emplace_back(
+                            std::move(*req->promise));
+                        req->promise = &find_many_promises.back();
+                        find_many_owning_notify_fiber_future(
+                            aux,
+                            node_cache,
+                            inflight,
+                            *req->promise,
+                            req->start,
+                            req->keys,
+                            req->results,
+                            req->version);
+                    }
                     did_nothing = false;
                 }
                 async_io.io.poll_nonblocking(1);
@@ -549,7 +666,12 @@ struct OnDiskWithWorkerThreadImpl
                            .future_has_been_destroyed()) {
                     find_owning_cursor_promises.pop_front();
                 }
-                if (!find_owning_cursor_promises.empty()) {
+                while (!find_many_promises.empty() &&
+                       find_many_promises.front().future_has_been_destroyed()) {
+                    find_many_promises.pop_front();
+                }
+                if (!find_owning_cursor_promises.empty() ||
+                    !find_many_promises.empty()) {
                     did_nothing = false;
                 }
                 if (did_nothing) {
@@ -592,6 +714,8 @@ struct OnDiskWithWorkerThreadImpl
                 traverse_promises;
             ::boost::container::deque<threadsafe_boost_fibers_promise<void>>
                 move_trie_version_promises;
+            ::boost::container::deque<threadsafe_boost_fibers_promise<void>>
+                find_many_promises;
 
             Comms request;
             unsigned did_nothing_count = 0;
@@ -680,9 +804,32 @@ struct OnDiskWithWorkerThreadImpl
                         // share the same promise type as upsert
                         upsert_promises.emplace_back(std::move(*req->promise));
                         req->promise = &upsert_promises.back();
+                        Node::UniquePtr src_root;
+                        if (req->src_root == nullptr) {
+                            src_root = read_node_blocking(
+                                aux,
+                                aux.get_root_offset_at_version(
+                                    req->src_version),
+                                req->src_version);
+                            MONAD_ASSERT(src_root);
+                            req->src_root = src_root.get();
+                            if (req->src_version == req->dest_version) {
+                                req->dest_root = std::move(src_root);
+                            }
+                        }
+                        if (!req->dest_root &&
+                            req->src_version != req->dest_version) {
+                            auto const root_offset =
+                                aux.get_root_offset_at_version(
+                                    req->dest_version);
+                            if (root_offset != INVALID_OFFSET) {
+                                req->dest_root = read_node_blocking(
+                                    aux, root_offset, req->dest_version);
+                            }
+                        }
                         auto root = copy_trie_to_dest(
                             aux,
-                            req->src_root,
+                            *req->src_root,
                             req->src,
                             req->src_version,
                             std::move(req->dest_root),
@@ -691,6 +838,20 @@ struct OnDiskWithWorkerThreadImpl
                             req->blocked_by_write);
                         req->promise->set_value(std::move(root));
                     }
+                    else if (auto *req = std::get_if<9>(&request);
+                             req != nullptr) {
+                        // Ditto to above
+                        find_many_promises.emplace_back(
+                            std::move(*req->promise));
+                        req->promise = &find_many_promises.back();
+                        find_many_notify_fiber_future(
+                            aux,
+                            inflights,
+                            *req->promise,
+                            req->start,
+                            req->keys,
+                            req->results);
+                    }
                     did_nothing = false;
                 }
                 async_io.io.poll_nonblocking(1);
@@ -722,9 +883,14 @@ struct OnDiskWithWorkerThreadImpl
                            .future_has_been_destroyed()) {
                     move_trie_version_promises.pop_front();
                 }
+                while (!find_many_promises.empty() &&
+                       find_many_promises.front().future_has_been_destroyed()) {
+                    find_many_promises.pop_front();
+                }
                 if (!find_promises.empty() || !upsert_promises.empty() ||
                     !prefetch_promises.empty() || !traverse_promises.empty() ||
-                    !move_trie_version_promises.empty()) {
+                    !move_trie_version_promises.empty() ||
+                    !find_many_promises.empty()) {
                     did_nothing = false;
                 }
                 if (did_nothing) {
@@ -782,7 +948,7 @@ struct OnDiskWithWorkerThreadImpl
                 worker_ = std::make_unique<DbAsyncWorker>(this, options);
                 cond_.notify_one();
             }
-            worker_->rodb_run(options.node_lru_max_mem);
+            worker_->rodb_run(options);
             std::unique_lock const g(lock_);
             worker_.reset();
         })
@@ -817,6 +983,30 @@ class Db::RWOnDisk final
     uint64_t root_version_{INVALID_BLOCK_NUM};
     uint64_t unflushed_version_{INVALID_BLOCK_NUM};
 
+    // The copy or move started by copy_trie_async() or
+    // move_trie_version_async(), whose promise must outlive the worker
+    // taking it from the request
+    struct PendingTrieOp
+    {
+        threadsafe_boost_fibers_promise<Node::UniquePtr> copy_promise;
+        threadsafe_boost_fibers_promise<void> move_promise;
+        ::monad::detail::threadsafe_boost_fibers_future<Node::UniquePtr>
+            copy_future;
+        ::monad::detail::threadsafe_boost_fibers_future<void> move_future;
+        bool is_copy{false};
+        uint64_t dest_version{INVALID_BLOCK_NUM};
+    };
+
+    std::optional<PendingTrieOp> pending_trie_op_;
+
+    void wake_worker_()
+    {
+        if (worker_->sleeping.load(std::memory_order_acquire)) {
+            std::unique_lock const g(lock_);
+            cond_.notify_one();
+        }
+    }
+
 public:
     RWOnDisk(OnDiskDbConfig const &options, StateMachine &machine)
         : OnDiskWithWorkerThreadImpl(options)
@@ -836,6 +1026,15 @@ public:
     {
     }
 
+    virtual ~RWOnDisk()
+    {
+        wait_for_trie_ops();
+    }
+
+    // Plain accessors, they do not wait for a pending copy or move: aux() is
+    // reached from any thread, e.g. generate_proof() and
+    // find_version_range(). Owner thread paths which need the settled root or
+    // metadata call wait_for_trie_ops() themselves.
     virtual Node::UniquePtr &root() override
     {
         return root_;
@@ -870,6 +1069,26 @@ public:
         return fut.get();
     }
 
+    // threadsafe
+    virtual void find_many_fiber_blocking(
+        NodeCursor const &start, std::span<NibblesView const> const keys,
+        std::span<find_cursor_result_type> const results, uint64_t) override
+    {
+        threadsafe_boost_fibers_promise<void> promise;
+        auto fut = promise.get_future();
+        comms_.enqueue(fiber_find_many_request_t{
+            .promise = &promise,
+            .start = start,
+            .keys = keys,
+            .results = results});
+        // promise is racily emptied after this point
+        if (worker_->sleeping.load(std::memory_order_acquire)) {
+            std::unique_lock const g(lock_);
+            cond_.notify_one();
+        }
+        fut.get();
+    }
+
     // threadsafe
     virtual void upsert_fiber_blocking(
         UpdateList &&updates, uint64_t const version,
@@ -890,6 +1109,7 @@ public:
                 unflushed_version_ = INVALID_BLOCK_NUM;
             }
         }
+        wait_for_trie_ops();
         // reload root to handle out-of-order upserts
         if (version != root_version_ &&
             (version != root_version_ + 1 ||
@@ -922,22 +1142,41 @@ public:
     virtual void move_trie_version_fiber_blocking(
         uint64_t const src, uint64_t const dest) override
     {
-        threadsafe_boost_fibers_promise<void> promise;
-        auto fut = promise.get_future();
-        comms_.enqueue(
-            MoveSubtrieRequest{.promise = &promise, .src = src, .dest = dest});
+        move_trie_version_async(src, dest);
+        wait_for_trie_ops();
+    }
+
+    virtual void
+    move_trie_version_async(uint64_t const src, uint64_t const dest) override
+    {
+        wait_for_trie_ops();
+        auto &op = pending_trie_op_.emplace();
+        op.dest_version = dest;
+        op.move_future = op.move_promise.get_future();
+        comms_.enqueue(MoveSubtrieRequest{
+            .promise = &op.move_promise, .src = src, .dest = dest});
         // promise is racily emptied after this point
-        if (worker_->sleeping.load(std::memory_order_acquire)) {
-            std::unique_lock const g(lock_);
-            cond_.notify_one();
+        wake_worker_();
+    }
+
+    virtual void wait_for_trie_ops() override
+    {
+        if (!pending_trie_op_.has_value()) {
+            return;
         }
-        fut.get();
-        root_version_ = dest;
+        if (pending_trie_op_->is_copy) {
+            root_ = pending_trie_op_->copy_future.get();
+        }
+        else {
+            pending_trie_op_->move_future.get();
+        }
+        root_version_ = pending_trie_op_->dest_version;
+        pending_trie_op_.reset();
     }
 
-    // threadsafe
     virtual size_t prefetch_fiber_blocking() override
     {
+        wait_for_trie_ops();
         MONAD_ASSERT(root());
         threadsafe_boost_fibers_promise<size_t> promise;
         auto fut = promise.get_future();
@@ -980,6 +1219,7 @@ public:
 
     virtual NodeCursor load_root_for_version(uint64_t const version) override
     {
+        wait_for_trie_ops();
         if (version != root_version_) {
             if (!aux().version_is_valid_ondisk(version)) {
                 root_ = nullptr;
@@ -1006,28 +1246,33 @@ public:
         uint64_t const dest_version, NibblesView const dest,
         bool const blocked_by_write = true) override
     {
-        if (src_version != root_version_) {
-            root_ = read_node_blocking(
-                aux(),
-                aux().get_root_offset_at_version(src_version),
-                src_version);
-            root_version_ = src_version;
-        }
-        Node &src_root = *root_;
+        copy_trie_async(
+            src_version, src, dest_version, dest, blocked_by_write);
+        wait_for_trie_ops();
+    }
+
+    // The worker reads whichever roots are not already in memory, so the
+    // caller does not wait on them either
+    virtual void copy_trie_async(
+        uint64_t const src_version, NibblesView const src,
+        uint64_t const dest_version, NibblesView const dest,
+        bool const blocked_by_write) override
+    {
+        wait_for_trie_ops();
+        Node *src_root = nullptr;
         Node::UniquePtr dest_root{};
-        if (src_version == dest_version) {
-            dest_root = std::move(root_);
-        }
-        else if (auto const root_offset =
-                     aux().get_root_offset_at_version(dest_version);
-                 root_offset != INVALID_OFFSET) {
-            dest_root = read_node_blocking(aux(), root_offset, dest_version);
+        if (src_version == root_version_ && root_) {
+            src_root = root_.get();
+            if (src_version == dest_version) {
+                dest_root = std::move(root_);
+            }
         }
-
-        threadsafe_boost_fibers_promise<Node::UniquePtr> promise;
-        auto fut = promise.get_future();
+        auto &op = pending_trie_op_.emplace();
+        op.is_copy = true;
+        op.dest_version = dest_version;
+        op.copy_future = op.copy_promise.get_future();
         comms_.enqueue(FiberCopyTrieRequest{
-            .promise = &promise,
+            .promise = &op.copy_promise,
             .src_root = src_root,
             .src = src,
             .src_version = src_version,
@@ -1036,21 +1281,18 @@ public:
             .dest_version = dest_version,
             .blocked_by_write = blocked_by_write});
         // promise is racily emptied after this point
-        if (worker_->sleeping.load(std::memory_order_acquire)) {
-            std::unique_lock const g(lock_);
-            cond_.notify_one();
-        }
-        root_ = fut.get();
-        root_version_ = dest_version;
+        wake_worker_();
     }
 
     virtual void update_finalized_version(uint64_t const version) override
     {
+        wait_for_trie_ops();
         aux().set_latest_finalized_version(version);
     }
 
     virtual void update_verified_version(uint64_t const version) override
     {
+        wait_for_trie_ops();
         MONAD_ASSERT(version <= aux().db_history_max_version());
         aux().set_latest_verified_version(version);
     }
@@ -1098,6 +1340,28 @@ struct RODb::Impl final : public OnDiskWithWorkerThreadImpl
         return fut.get();
     }
 
+    void find_many_fiber_blocking(
+        OwningNodeCursor start, std::span<NibblesView const> const keys,
+        std::span<find_owning_cursor_result_type> const results,
+        uint64_t const version)
+    {
+        threadsafe_boost_fibers_promise<void> promise;
+        RODbFiberFindManyOwningRequest req{
+            .promise = &promise,
+            .start = start,
+            .keys = keys,
+            .results = results,
+            .version = version};
+        auto fut = promise.get_future();
+        comms_.enqueue(req);
+        // promise is racily emptied after this point
+        if (worker_->sleeping.load(std::memory_order_acquire)) {
+            std::unique_lock const g(lock_);
+            cond_.notify_one();
+        }
+        fut.get();
+    }
+
     OwningNodeCursor load_root_fiber_blocking(uint64_t version)
     {
         auto const root_offset = aux().get_root_offset_at_version(version);
@@ -1132,6 +1396,18 @@ uint64_t RODb::get_earliest_version() const
     return impl_->aux().db_history_min_valid_version();
 }
 
+uint64_t RODb::wait_for_latest_version_change(
+    uint64_t const block_id, std::chrono::nanoseconds const timeout) const
+{
+    MONAD_ASSERT(impl_);
+    auto const latest =
+        detail::wait_for_latest_version_change(impl_->aux(), block_id, timeout);
+    if (latest != block_id && latest != INVALID_BLOCK_NUM) {
+        impl_->load_root_fiber_blocking(latest);
+    }
+    return latest;
+}
+
 DbError find_result_to_db_error(find_result const result) noexcept
 {
     switch (result) {
@@ -1180,6 +1456,66 @@ RODb::find(NibblesView const key, uint64_t const block_id) const
     return find(cursor, key, block_id);
 }
 
+std::vector<Result<OwningNodeCursor>> RODb::find_many(
+    OwningNodeCursor &node_cursor, std::span<NibblesView const> const keys,
+    uint64_t const block_id) const
+{
+    MONAD_ASSERT(impl_);
+    std::vector<find_owning_cursor_result_type> found(keys.size());
+    if (!keys.empty()) {
+        impl_->find_many_fiber_blocking(node_cursor, keys, found, block_id);
+    }
+    std::vector<Result<OwningNodeCursor>> results;
+    results.reserve(keys.size());
+    for (auto &[cursor, result] : found) {
+        if (result != find_result::success) {
+            results.emplace_back(find_result_to_db_error(result));
+            continue;
+        }
+        MONAD_DEBUG_ASSERT(cursor.is_valid());
+        results.emplace_back(std::move(cursor));
+    }
+    return results;
+}
+
+std::vector<Result<OwningNodeCursor>> RODb::find_many(
+    std::span<NibblesView const> const keys, uint64_t const block_id) const
+{
+    MONAD_ASSERT(impl_);
+    OwningNodeCursor cursor = impl_->load_root_fiber_blocking(block_id);
+    return find_many(cursor, keys, block_id);
+}
+
+std::vector<version_range_find_results_t> RODb::find_version_range(
+    std::span<NibblesView const> const keys, uint64_t const min_block_id,
+    uint64_t const max_block_id) const
+{
+    MONAD_ASSERT(impl_);
+    return find_version_range_blocking(
+        impl_->aux(), keys, min_block_id, max_block_id);
+}
+
+version_range_find_results_t RODb::find_version_range(
+    NibblesView const key, uint64_t const min_block_id,
+    uint64_t const max_block_id) const
+{
+    return std::move(find_version_range(
+        std::span{&key, 1}, min_block_id, max_block_id)[0]);
+}
+
+Result<merkle_multiproof_t> RODb::generate_proof(
+    NibblesView const prefix, std::span<NibblesView const> const keys,
+    compute_leaf_data_fn const leaf_data, uint64_t const block_id) const
+{
+    MONAD_ASSERT(impl_);
+    auto proof = generate_proof_blocking(
+        impl_->aux(), prefix, keys, leaf_data, block_id);
+    if (proof.result != find_result::success) {
+        return find_result_to_db_error(proof.result);
+    }
+    return proof;
+}
+
 Db::Db(StateMachine &machine)
     : impl_{std::make_unique<InMemory>(machine)}
 {
@@ -1211,12 +1547,73 @@ Db::find(NodeCursor root, NibblesView const key, uint64_t const block_id) const
     return it;
 }
 
+std::vector<Result<NodeCursor>> Db::find_many(
+    NodeCursor const root, std::span<NibblesView const> const keys,
+    uint64_t const block_id) const
+{
+    MONAD_ASSERT(impl_);
+    std::vector<find_cursor_result_type> found(keys.size());
+    if (!keys.empty()) {
+        impl_->find_many_fiber_blocking(root, keys, found, block_id);
+    }
+    std::vector<Result<NodeCursor>> results;
+    results.reserve(keys.size());
+    for (auto const &[cursor, result] : found) {
+        if (result != find_result::success) {
+            results.emplace_back(find_result_to_db_error(result));
+            continue;
+        }
+        MONAD_DEBUG_ASSERT(cursor.node != nullptr);
+        results.emplace_back(cursor);
+    }
+    return results;
+}
+
+std::vector<Result<NodeCursor>> Db::find_many(
+    std::span<NibblesView const> const keys, uint64_t const block_id) const
+{
+    MONAD_ASSERT(impl_);
+    return find_many(impl_->load_root_for_version(block_id), keys, block_id);
+}
+
 NodeCursor Db::load_root_for_version(uint64_t const block_id) const
 {
     MONAD_ASSERT(impl_);
     return impl_->load_root_for_version(block_id);
 }
 
+std::vector<version_range_find_results_t> Db::find_version_range(
+    std::span<NibblesView const> const keys, uint64_t const min_block_id,
+    uint64_t const max_block_id) const
+{
+    MONAD_ASSERT(impl_);
+    MONAD_ASSERT(impl_->aux().is_on_disk());
+    return find_version_range_blocking(
+        impl_->aux(), keys, min_block_id, max_block_id);
+}
+
+version_range_find_results_t Db::find_version_range(
+    NibblesView const key, uint64_t const min_block_id,
+    uint64_t const max_block_id) const
+{
+    return std::move(find_version_range(
+        std::span{&key, 1}, min_block_id, max_block_id)[0]);
+}
+
+Result<merkle_multiproof_t> Db::generate_proof(
+    NibblesView const prefix, std::span<NibblesView const> const keys,
+    compute_leaf_data_fn const leaf_data, uint64_t const block_id) const
+{
+    MONAD_ASSERT(impl_);
+    MONAD_ASSERT(impl_->aux().is_on_disk());
+    auto proof = generate_proof_blocking(
+        impl_->aux(), prefix, keys, leaf_data, block_id);
+    if (proof.result != find_result::success) {
+        return find_result_to_db_error(proof.result);
+    }
+    return proof;
+}
+
 Result<NodeCursor>
 Db::find(NibblesView const key, uint64_t const block_id) const
 {
@@ -1290,6 +1687,29 @@ void Db::move_trie_version_forward(uint64_t const src, uint64_t const dest)
     return;
 }
 
+void Db::copy_trie_async(
+    uint64_t const src_version, NibblesView const src,
+    uint64_t const dest_version, NibblesView const dest,
+    bool const blocked_by_write)
+{
+    MONAD_ASSERT(impl_);
+    impl_->copy_trie_async(
+        src_version, src, dest_version, dest, blocked_by_write);
+}
+
+void Db::move_trie_version_forward_async(
+    uint64_t const src, uint64_t const dest)
+{
+    MONAD_ASSERT(impl_);
+    impl_->move_trie_version_async(src, dest);
+}
+
+void Db::wait_for_trie_ops()
+{
+    MONAD_ASSERT(impl_);
+    impl_->wait_for_trie_ops();
+}
+
 bool Db::traverse(
     NodeCursor const cursor, TraverseMachine &machine, uint64_t const block_id,
     size_t const concurrency_limit)
@@ -1312,6 +1732,7 @@ bool Db::traverse_blocking(
 NodeCursor Db::root() const noexcept
 {
     MONAD_ASSERT(impl_);
+    impl_->wait_for_trie_ops();
     return impl_->root() ? NodeCursor{*impl_->root()} : NodeCursor{};
 }
 
@@ -1331,6 +1752,7 @@ void Db::update_voted_metadata(
     uint64_t const version, bytes32_t const &block_id)
 {
     MONAD_ASSERT(impl_);
+    impl_->wait_for_trie_ops();
     impl_->aux().set_latest_voted(version, block_id);
 }
 
@@ -1380,6 +1802,19 @@ uint64_t Db::get_earliest_version() const
     }
 }
 
+uint64_t Db::wait_for_latest_version_change(
+    uint64_t const block_id, std::chrono::nanoseconds const timeout)
+{
+    MONAD_ASSERT(impl_);
+    MONAD_ASSERT(is_on_disk());
+    auto const latest =
+        detail::wait_for_latest_version_change(impl_->aux(), block_id, timeout);
+    if (is_read_only() && latest != block_id && latest != INVALID_BLOCK_NUM) {
+        impl_->load_root_for_version(latest);
+    }
+    return latest;
+}
+
 size_t Db::prefetch()
 {
     MONAD_ASSERT(impl_);
@@ -15,7 +15,10 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <span>
+#include <vector>
 
 #include <category/async/concepts.hpp>
 #include <category/async/config.hpp>
@@ -75,8 +78,41 @@ public:
     find(OwningNodeCursor &, NibblesView, uint64_t block_id) const;
     Result<OwningNodeCursor> find(NibblesView prefix, uint64_t block_id) const;
 
+    // Find a batch of keys in one descent, see find_many_notify_fiber_future().
+    // Returns the result of each key at the same index.
+    std::vector<Result<OwningNodeCursor>> find_many(
+        OwningNodeCursor &, std::span<NibblesView const>,
+        uint64_t block_id) const;
+    std::vector<Result<OwningNodeCursor>>
+    find_many(std::span<NibblesView const>, uint64_t block_id) const;
+
+    // Resolve keys at every version in [min_block_id, max_block_id] in one
+    // pass, see find_version_range_blocking(). Does not go through the worker
+    // thread or the node cache.
+    std::vector<version_range_find_results_t> find_version_range(
+        std::span<NibblesView const> keys, uint64_t min_block_id,
+        uint64_t max_block_id) const;
+    version_range_find_results_t find_version_range(
+        NibblesView key, uint64_t min_block_id, uint64_t max_block_id) const;
+
+    // Merkle proofs of a batch of keys below the subtrie at `prefix`, see
+    // generate_proof_blocking(). Does not go through the worker thread or the
+    // node cache.
+    Result<merkle_multiproof_t> generate_proof(
+        NibblesView prefix, std::span<NibblesView const> keys,
+        compute_leaf_data_fn, uint64_t block_id) const;
+
     uint64_t get_latest_version() const;
     uint64_t get_earliest_version() const;
+    // Sleep until the latest version is no longer `block_id`, or the timeout
+    // elapses, and return the latest version. The writer wakes waiting readers
+    // as soon as it records a new version, so this replaces polling
+    // get_latest_version(). The root of a new latest version is loaded into
+    // the node cache before returning. The wait blocks the calling thread,
+    // not just the calling fiber, so do not call this on a fiber pool worker
+    // such as those serving reads, which it would stall for the timeout.
+    uint64_t wait_for_latest_version_change(
+        uint64_t block_id, std::chrono::nanoseconds timeout) const;
 };
 
 // RW, ROBlocking, InMemory
@@ -117,12 +153,48 @@ public:
     Result<byte_string_view> get_data(NibblesView, uint64_t block_id) const;
     Result<byte_string_view>
     get_data(NodeCursor, NibblesView, uint64_t block_id) const;
+    // Find a batch of keys in one descent, see find_many_notify_fiber_future().
+    // Returns the result of each key at the same index. Only an RWDb shares
+    // reads across keys, other modes find the keys one at a time.
+    std::vector<Result<NodeCursor>> find_many(
+        NodeCursor, std::span<NibblesView const>, uint64_t block_id) const;
+    std::vector<Result<NodeCursor>>
+    find_many(std::span<NibblesView const>, uint64_t block_id) const;
 
     NodeCursor load_root_for_version(uint64_t block_id) const;
 
+    // Resolve keys at every version in [min_block_id, max_block_id] in one
+    // pass, see find_version_range_blocking(). On-disk only, never waits on a
+    // fiber future.
+    std::vector<version_range_find_results_t> find_version_range(
+        std::span<NibblesView const> keys, uint64_t min_block_id,
+        uint64_t max_block_id) const;
+    version_range_find_results_t find_version_range(
+        NibblesView key, uint64_t min_block_id, uint64_t max_block_id) const;
+
+    // Merkle proofs of a batch of keys below the subtrie at `prefix`, see
+    // generate_proof_blocking(). On-disk only, never waits on a fiber future.
+    Result<merkle_multiproof_t> generate_proof(
+        NibblesView prefix, std::span<NibblesView const> keys,
+        compute_leaf_data_fn, uint64_t block_id) const;
+
     void copy_trie(
         uint64_t src_version, NibblesView src, uint64_t dest_version,
         NibblesView dest, bool blocked_by_write = true);
+    // As copy_trie() and move_trie_version_forward(), but an on disk RW Db
+    // returns once the operation is queued to its worker thread, so the
+    // caller can overlap other work with it. Only the owner thread calls
+    // which use the root or write metadata wait for it first: root(),
+    // load_root_for_version() and the find() and get() by version, upsert(),
+    // prefetch(), the update_*() calls and the next copy or move, as does
+    // wait_for_trie_ops(). The overlap therefore ends at the next such call.
+    // Metadata getters, find_version_range() and generate_proof() never wait
+    // and see the versions as of before the operation until it completes.
+    void copy_trie_async(
+        uint64_t src_version, NibblesView src, uint64_t dest_version,
+        NibblesView dest, bool blocked_by_write = true);
+    void move_trie_version_forward_async(uint64_t src, uint64_t dest);
+    void wait_for_trie_ops();
 
     void upsert(
         UpdateList, uint64_t block_id, bool enable_compaction = true,
@@ -151,6 +223,13 @@ public:
     NodeCursor root() const noexcept;
     uint64_t get_latest_version() const;
     uint64_t get_earliest_version() const;
+    // Sleep until the latest version is no longer `block_id`, or the timeout
+    // elapses, and return the latest version. On disk only, see
+    // RODb::wait_for_latest_version_change(), which also says why this must
+    // not be called on a fiber pool worker. A read only Db also advances its
+    // root to the new latest version.
+    uint64_t wait_for_latest_version_change(
+        uint64_t block_id, std::chrono::nanoseconds timeout);
     uint64_t get_history_length() const;
     // This function moves trie from source to destination version in db
     // history. Only the RWDb can call this API for state sync purposes.
@@ -27,6 +27,7 @@
 #include "unsigned_20.hpp"
 
 #include <atomic>
+#include <cstring>
 #include <type_traits>
 
 MONAD_MPT_NAMESPACE_BEGIN
@@ -64,6 +65,10 @@ namespace detail
     struct db_metadata
     {
         static constexpr char const *MAGIC = "MONAD007";
+        // Replaces MAGIC once nodes may have been written to the slow list
+        // compressed, see compress_node_for_disk(). Code from before
+        // compression takes it for a newer DB version and refuses the DB.
+        static constexpr char const *MAGIC_SLOW_LIST_COMPRESSED = "MONAD008";
         static constexpr unsigned MAGIC_STRING_LEN = 8;
 
         friend class MONAD_MPT_NAMESPACE::UpdateAuxImpl;
@@ -73,6 +78,18 @@ namespace detail
         // Needed to please the compiler in db_copy()
         db_metadata &operator=(db_metadata const &) = default;
 
+        bool has_valid_magic() const noexcept
+        {
+            return 0 == memcmp(magic, MAGIC, MAGIC_STRING_LEN) ||
+                   slow_list_compressed();
+        }
+
+        bool slow_list_compressed() const noexcept
+        {
+            return 0 ==
+                   memcmp(magic, MAGIC_SLOW_LIST_COMPRESSED, MAGIC_STRING_LEN);
+        }
+
         char magic[MAGIC_STRING_LEN];
         uint64_t chunk_info_count : 20; // items in chunk_info below
         uint64_t using_chunks_for_root_offsets : 1;
@@ -163,13 +180,19 @@ namespace detail
         uint64_t unused0; // used to be latest_voted_round;
         int64_t auto_expire_version;
         bytes32_t latest_voted_block_id; // 32 bytes
+        // futex word, see version_change_sequence() below
+        uint32_t version_change_sequence_;
+        // see rewind_epoch() below
+        uint32_t rewind_epoch_;
+        // see version_change_waiters() below
+        uint32_t version_change_waiters_;
         // TODO: add latest_proposal info, format as follow, remember to
         // subtract those bytes from `future_variables_unused`
         // uint64_t latest_proposal_version;
         // uint8_t latest_proposal_block_id[32];
 
         // padding for adding future atomics without requiring DB reset
-        uint8_t future_variables_unused[4064];
+        uint8_t future_variables_unused[4052];
 
         // used to know if the metadata was being
         // updated when the process suddenly exited
@@ -183,6 +206,35 @@ namespace detail
                 (std::byte *)&capacity_in_free_list - 1);
         }
 
+        // Incremented by the writer after every change to the version
+        // history, which then wakes any process futex waiting on it. This
+        // lets read-only openers learn of new versions without polling.
+        std::atomic<uint32_t> &version_change_sequence() noexcept
+        {
+            static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+            return *start_lifetime_as<std::atomic<uint32_t>>(
+                &version_change_sequence_);
+        }
+
+        // Number of threads futex waiting on version_change_sequence(), in
+        // any process, so the writer can skip the wake when there are none.
+        // A reader that dies while waiting leaves it too high, which only
+        // costs the writer a needless wake.
+        std::atomic<uint32_t> &version_change_waiters() noexcept
+        {
+            return *start_lifetime_as<std::atomic<uint32_t>>(
+                &version_change_waiters_);
+        }
+
+        // Randomised when the DB is created and changed on every rewind of
+        // the chunk lists, after which virtual offsets already handed out
+        // may be written again. Anything cached by virtual offset outside
+        // this process must also be tagged with this.
+        std::atomic<uint32_t> &rewind_epoch() noexcept
+        {
+            return *start_lifetime_as<std::atomic<uint32_t>>(&rewind_epoch_);
+        }
+
         struct id_pair
         {
             uint32_t begin, end;
@@ -27,6 +27,7 @@
 #include <category/mpt/node.hpp>
 #include <category/mpt/node_cache.hpp>
 #include <category/mpt/node_cursor.hpp>
+#include <category/mpt/shared_node_cache.hpp>
 #include <category/mpt/trie.hpp>
 #include <category/mpt/util.hpp>
 
@@ -34,10 +35,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <numeric>
+#include <span>
 #include <utility>
+#include <vector>
 
 #include <unistd.h>
 
@@ -119,6 +124,10 @@ namespace
         inflight_map_owning_t &inflights;
         chunk_offset_t offset;
         virtual_chunk_offset_t virtual_offset;
+        // the version read and the rewind epoch as of before the read, for
+        // the shared node cache
+        uint64_t version;
+        uint32_t rewind_epoch;
         chunk_offset_t rd_offset; // required for sender
         unsigned bytes_to_read; // required for sender too
         uint16_t buffer_off;
@@ -126,12 +135,15 @@ namespace
         find_owning_receiver(
             UpdateAuxImpl &aux, NodeCache &node_cache,
             inflight_map_owning_t &inflights, chunk_offset_t const offset,
-            virtual_chunk_offset_t const virtual_offset)
+            virtual_chunk_offset_t const virtual_offset, uint64_t const version)
             : aux(&aux)
             , node_cache(node_cache)
             , inflights(inflights)
             , offset(offset)
             , virtual_offset(virtual_offset)
+            , version(version)
+            , rewind_epoch(
+                  node_cache.shared_cache() ? aux.rewind_epoch() : uint32_t(0))
             , rd_offset(0, 0)
         {
             auto const num_pages_to_load_node =
@@ -166,6 +178,15 @@ namespace
                     detail::deserialize_node_from_receiver_result<CacheNode>(
                         std::move(buffer_), buffer_off, io_state);
                 node_cache.insert(virtual_offset, node);
+                // Other openers trust the shared cache without checking the
+                // version themselves, so only publish a node read from a
+                // version which is still valid, under an unchanged epoch
+                auto *const shared = node_cache.shared_cache();
+                if (shared != nullptr &&
+                    aux->version_is_valid_ondisk(version) &&
+                    aux->rewind_epoch() == rewind_epoch) {
+                    shared->insert(virtual_offset, rewind_epoch, *node);
+                }
                 start_cursor = OwningNodeCursor{node};
             }
             auto it = inflights.find(virtual_offset);
@@ -178,30 +199,399 @@ namespace
         }
     };
 
-    void async_read_with_continuation(
+    // Returns false without reading if not called from the io thread
+    bool async_read_with_continuation(
         UpdateAuxImpl &aux, NodeCache &node_cache,
-        inflight_map_owning_t &inflights,
-        threadsafe_boost_fibers_promise<find_owning_cursor_result_type>
-            &promise,
-        auto &&cont, chunk_offset_t const read_offset,
-        virtual_chunk_offset_t const virtual_offset)
+        inflight_map_owning_t &inflights, auto &&cont,
+        chunk_offset_t const read_offset,
+        virtual_chunk_offset_t const virtual_offset, uint64_t const version)
     {
         if (aux.io->owning_thread_id() != get_tl_tid()) {
-            promise.set_value(
-                {OwningNodeCursor{},
-                 find_result::need_to_continue_in_io_thread});
-            return;
+            return false;
         }
         if (auto lt = inflights.find(virtual_offset); lt != inflights.end()) {
             lt->second.emplace_back(std::move(cont));
-            return;
+            return true;
+        }
+        // another opener of the database may have read it already
+        if (auto *const shared = node_cache.shared_cache()) {
+            if (auto node = shared->find(virtual_offset, aux.rewind_epoch())) {
+                node_cache.insert(virtual_offset, node);
+                OwningNodeCursor cursor{node};
+                MONAD_ASSERT(cont(cursor));
+                return true;
+            }
         }
         inflights[virtual_offset].emplace_back(cont);
         find_owning_receiver receiver(
-            aux, node_cache, inflights, read_offset, virtual_offset);
+            aux, node_cache, inflights, read_offset, virtual_offset, version);
         detail::initiate_async_read_update(
             *aux.io, std::move(receiver), receiver.bytes_to_read);
+        return true;
     }
+
+    // Outcome of walking a key along the path of a node. `result` is unknown
+    // when the key continues into the child at `key.get(prefix_index)`.
+    struct node_path_match_t
+    {
+        find_result result;
+        unsigned node_prefix_index;
+        unsigned prefix_index;
+    };
+
+    node_path_match_t match_node_path(
+        NodeBase const &node, unsigned node_prefix_index,
+        NibblesView const key, unsigned prefix_index)
+    {
+        for (; node_prefix_index < node.path_nibbles_len();
+             ++node_prefix_index, ++prefix_index) {
+            if (prefix_index >= key.nibble_size()) {
+                return {
+                    find_result::key_ends_earlier_than_node_failure,
+                    node_prefix_index,
+                    prefix_index};
+            }
+            if (key.get(prefix_index) !=
+                node.path_nibble_view().get(node_prefix_index)) {
+                return {
+                    find_result::key_mismatch_failure,
+                    node_prefix_index,
+                    prefix_index};
+            }
+        }
+        if (prefix_index == key.nibble_size()) {
+            return {find_result::success, node_prefix_index, prefix_index};
+        }
+        if (!(node.mask & (1u << key.get(prefix_index)))) {
+            return {
+                find_result::branch_not_exist_failure,
+                node_prefix_index,
+                prefix_index};
+        }
+        return {find_result::unknown, node_prefix_index, prefix_index};
+    }
+
+    // A batch of keys found in one descent. Keys are visited in sorted order
+    // so that keys sharing a path are adjacent and descend together, splitting
+    // where their paths diverge. Every node is read at most once per batch and
+    // the reads of all diverging subtries are in flight at the same time.
+    // Deletes itself once every key has been resolved.
+    template <class Cursor>
+    class find_many_base
+    {
+    protected:
+        threadsafe_boost_fibers_promise<void> &promise_;
+        std::span<NibblesView const> keys_;
+        std::span<find_result_type<Cursor>> results_;
+        std::vector<uint32_t> order_;
+        // unresolved keys, plus one for each descent in progress
+        size_t pending_;
+
+        find_many_base(
+            threadsafe_boost_fibers_promise<void> &promise,
+            std::span<NibblesView const> const keys,
+            std::span<find_result_type<Cursor>> const results)
+            : promise_(promise)
+            , keys_(keys)
+            , results_(results)
+            , order_(keys.size())
+            , pending_(keys.size() + 1)
+        {
+            MONAD_ASSERT(keys.size() == results.size());
+            MONAD_ASSERT(keys.size() <= std::numeric_limits<uint32_t>::max());
+            std::iota(order_.begin(), order_.end(), 0u);
+            std::ranges::sort(order_, [&](uint32_t const a, uint32_t const b) {
+                return keys_[a] < keys_[b];
+            });
+        }
+
+        virtual ~find_many_base() = default;
+
+        NibblesView key(size_t const i) const
+        {
+            return keys_[order_[i]];
+        }
+
+        void resolve(size_t const i, find_result_type<Cursor> result)
+        {
+            MONAD_DEBUG_ASSERT(pending_ > 1);
+            results_[order_[i]] = std::move(result);
+            --pending_;
+        }
+
+        void resolve_all(
+            size_t begin, size_t const end, Cursor cursor,
+            find_result const result)
+        {
+            for (; begin < end; ++begin) {
+                Cursor copy = cursor;
+                resolve(begin, {std::move(copy), result});
+            }
+        }
+
+        // One past the last key of [begin, end) whose first `nibbles` nibbles
+        // are those of the key at `begin`, all of which share `depth` nibbles
+        size_t group_end(
+            size_t const begin, size_t const end, unsigned const depth,
+            unsigned const nibbles) const
+        {
+            NibblesView const first = key(begin);
+            size_t i = begin + 1;
+            for (; i < end; ++i) {
+                NibblesView const other = key(i);
+                if (other.nibble_size() < nibbles ||
+                    other.substr(depth, nibbles - depth) !=
+                        first.substr(depth, nibbles - depth)) {
+                    break;
+                }
+            }
+            return i;
+        }
+
+        void acquire()
+        {
+            ++pending_;
+        }
+
+        void release()
+        {
+            if (--pending_ == 0) {
+                promise_.set_value();
+                delete this;
+            }
+        }
+    };
+
+    class find_many_t final : public find_many_base<NodeCursor>
+    {
+        UpdateAuxImpl &aux_;
+        inflight_map_t &inflights_;
+
+    public:
+        find_many_t(
+            UpdateAuxImpl &aux, inflight_map_t &inflights,
+            threadsafe_boost_fibers_promise<void> &promise,
+            std::span<NibblesView const> const keys,
+            std::span<find_cursor_result_type> const results)
+            : find_many_base(promise, keys, results)
+            , aux_(aux)
+            , inflights_(inflights)
+        {
+        }
+
+        void start(NodeCursor const root)
+        {
+            descend(root, 0, 0, order_.size());
+            release();
+        }
+
+        // Keys in [begin, end) share their first `depth` nibbles, which lead
+        // to `cursor`
+        void descend(
+            NodeCursor const cursor, unsigned const depth, size_t begin,
+            size_t const end)
+        {
+            if (!cursor.is_valid()) {
+                resolve_all(
+                    begin,
+                    end,
+                    NodeCursor{},
+                    find_result::root_node_is_null_failure);
+                return;
+            }
+            Node *const node = cursor.node;
+            while (begin < end) {
+                auto const match = match_node_path(
+                    *node, cursor.prefix_index, key(begin), depth);
+                if (match.result != find_result::unknown) {
+                    resolve(
+                        begin,
+                        {NodeCursor{*node, match.node_prefix_index},
+                         match.result});
+                    ++begin;
+                    continue;
+                }
+                size_t const next =
+                    group_end(begin, end, depth, match.prefix_index + 1);
+                descend_child(
+                    *node,
+                    key(begin).get(match.prefix_index),
+                    match.prefix_index + 1,
+                    begin,
+                    next);
+                begin = next;
+            }
+        }
+
+        void descend_child(
+            Node &node, unsigned char const branch, unsigned const depth,
+            size_t const begin, size_t const end)
+        {
+            auto const child_index = node.to_child_index(branch);
+            if (Node *const child = node.next(child_index)) {
+                descend(NodeCursor{*child}, depth, begin, end);
+                return;
+            }
+            if (aux_.io->owning_thread_id() != get_tl_tid()) {
+                resolve_all(
+                    begin,
+                    end,
+                    NodeCursor{node, node.path_nibbles_len()},
+                    find_result::need_to_continue_in_io_thread);
+                return;
+            }
+            chunk_offset_t const offset = node.fnext(child_index);
+            auto cont = [this, depth, begin, end](
+                            NodeCursor node_cursor) -> result<void> {
+                acquire();
+                descend(node_cursor, depth, begin, end);
+                release();
+                return success();
+            };
+            if (auto lt = inflights_.find(offset); lt != inflights_.end()) {
+                lt->second.emplace_back(cont);
+                return;
+            }
+            inflights_[offset].emplace_back(cont);
+            find_receiver receiver(aux_, inflights_, &node, branch);
+            detail::initiate_async_read_update(
+                *aux_.io, std::move(receiver), receiver.bytes_to_read);
+        }
+    };
+
+    class find_many_owning_t final
+        : public find_many_base<OwningNodeCursor>
+    {
+        UpdateAuxImpl &aux_;
+        NodeCache &node_cache_;
+        inflight_map_owning_t &inflights_;
+        uint64_t const version_;
+
+    public:
+        find_many_owning_t(
+            UpdateAuxImpl &aux, NodeCache &node_cache,
+            inflight_map_owning_t &inflights,
+            threadsafe_boost_fibers_promise<void> &promise,
+            std::span<NibblesView const> const keys,
+            std::span<find_owning_cursor_result_type> const results,
+            uint64_t const version)
+            : find_many_base(promise, keys, results)
+            , aux_(aux)
+            , node_cache_(node_cache)
+            , inflights_(inflights)
+            , version_(version)
+        {
+        }
+
+        void start(OwningNodeCursor &root)
+        {
+            descend(root, 0, 0, order_.size());
+            release();
+        }
+
+        void descend(
+            OwningNodeCursor &cursor, unsigned const depth, size_t begin,
+            size_t const end)
+        {
+            if (!aux_.version_is_valid_ondisk(version_)) {
+                resolve_all(
+                    begin,
+                    end,
+                    OwningNodeCursor{},
+                    find_result::version_no_longer_exist);
+                return;
+            }
+            if (!cursor.is_valid()) {
+                resolve_all(
+                    begin,
+                    end,
+                    OwningNodeCursor{},
+                    find_result::root_node_is_null_failure);
+                return;
+            }
+            while (begin < end) {
+                auto const match = match_node_path(
+                    *cursor.node, cursor.prefix_index, key(begin), depth);
+                if (match.result != find_result::unknown) {
+                    resolve(
+                        begin,
+                        {OwningNodeCursor{
+                             cursor.node, match.node_prefix_index},
+                         match.result});
+                    ++begin;
+                    continue;
+                }
+                size_t const next =
+                    group_end(begin, end, depth, match.prefix_index + 1);
+                descend_child(
+                    cursor,
+                    key(begin).get(match.prefix_index),
+                    match.prefix_index + 1,
+                    begin,
+                    next);
+                begin = next;
+            }
+        }
+
+        void descend_child(
+            OwningNodeCursor &cursor, unsigned char const branch,
+            unsigned const depth, size_t const begin, size_t const end)
+        {
+            auto const &node = *cursor.node;
+            auto const next_node_offset =
+                node.fnext(node.to_child_index(branch));
+            auto const next_virtual_offset =
+                aux_.physical_to_virtual(next_node_offset);
+            // version validity check must be after the virtual offset
+            // translation
+            if (!aux_.version_is_valid_ondisk(version_) ||
+                next_virtual_offset == INVALID_VIRTUAL_OFFSET) {
+                resolve_all(
+                    begin,
+                    end,
+                    cursor,
+                    find_result::version_no_longer_exist);
+                return;
+            }
+            NodeCache::ConstAccessor acc;
+            if (node_cache_.find(acc, next_virtual_offset)) {
+                OwningNodeCursor next_cursor{acc->second->val.first};
+                acc.release();
+                descend(next_cursor, depth, begin, end);
+                return;
+            }
+            auto cont = [this, depth, begin, end](
+                            OwningNodeCursor &node_cursor) -> result<void> {
+                acquire();
+                if (!node_cursor.is_valid()) {
+                    resolve_all(
+                        begin,
+                        end,
+                        OwningNodeCursor{},
+                        find_result::version_no_longer_exist);
+                }
+                else {
+                    descend(node_cursor, depth, begin, end);
+                }
+                release();
+                return success();
+            };
+            if (!async_read_with_continuation(
+                    aux_,
+                    node_cache_,
+                    inflights_,
+                    cont,
+                    next_node_offset,
+                    next_virtual_offset,
+                    version_)) {
+                resolve_all(
+                    begin,
+                    end,
+                    OwningNodeCursor{},
+                    find_result::need_to_continue_in_io_thread);
+            }
+        }
+    };
 }
 
 // Use a hashtable for inflight requests, it maps a file offset to a list of
@@ -373,14 +763,18 @@ void find_owning_notify_fiber_future(
                 version);
             return success();
         };
-        async_read_with_continuation(
-            aux,
-            node_cache,
-            inflights,
-            promise,
-            cont,
-            next_node_offset,
-            next_virtual_offset);
+        if (!async_read_with_continuation(
+                aux,
+                node_cache,
+                inflights,
+                cont,
+                next_node_offset,
+                next_virtual_offset,
+                version)) {
+            promise.set_value(
+                {OwningNodeCursor{},
+                 find_result::need_to_continue_in_io_thread});
+        }
     }
     else {
         promise.set_value(
@@ -420,14 +814,38 @@ void load_root_notify_fiber_future(
         }
         return success();
     };
-    async_read_with_continuation(
-        aux,
-        node_cache,
-        inflights,
-        promise,
-        cont,
-        root_offset,
-        root_virtual_offset);
+    if (!async_read_with_continuation(
+            aux,
+            node_cache,
+            inflights,
+            cont,
+            root_offset,
+            root_virtual_offset,
+            version)) {
+        promise.set_value(
+            {OwningNodeCursor{}, find_result::need_to_continue_in_io_thread});
+    }
+}
+
+void find_many_notify_fiber_future(
+    UpdateAuxImpl &aux, inflight_map_t &inflights,
+    threadsafe_boost_fibers_promise<void> &promise, NodeCursor const start,
+    std::span<NibblesView const> const keys,
+    std::span<find_cursor_result_type> const results)
+{
+    (new find_many_t(aux, inflights, promise, keys, results))->start(start);
+}
+
+void find_many_owning_notify_fiber_future(
+    UpdateAuxImpl &aux, NodeCache &node_cache, inflight_map_owning_t &inflights,
+    threadsafe_boost_fibers_promise<void> &promise, OwningNodeCursor &start,
+    std::span<NibblesView const> const keys,
+    std::span<find_owning_cursor_result_type> const results,
+    uint64_t const version)
+{
+    (new find_many_owning_t(
+         aux, node_cache, inflights, promise, keys, results, version))
+        ->start(start);
 }
 
 MONAD_MPT_NAMESPACE_END
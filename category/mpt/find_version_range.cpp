@@ -0,0 +1,241 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/async/config.hpp>
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/unordered_map.hpp>
+#include <category/mpt/config.hpp>
+#include <category/mpt/nibbles_view.hpp>
+#include <category/mpt/node.hpp>
+#include <category/mpt/trie.hpp>
+#include <category/mpt/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+MONAD_MPT_NAMESPACE_BEGIN
+
+namespace
+{
+    // Bound on the number of nodes a single query keeps in memory. The cache
+    // is only dropped between versions so node pointers stay valid while a
+    // version is being resolved.
+    constexpr size_t MAX_CACHED_NODES = 1u << 16;
+
+    // (key nibble index at which node starts, node offset) for each node
+    // visited on a key's walk from the root
+    using walk_path_t = std::vector<std::pair<unsigned, chunk_offset_t>>;
+
+    struct walk_outcome_t
+    {
+        find_result result{find_result::unknown};
+        Node const *node{nullptr};
+        bool reused{false};
+    };
+
+    class version_range_walker
+    {
+        UpdateAuxImpl const &aux_;
+        unordered_dense_map<
+            chunk_offset_t, Node::UniquePtr, chunk_offset_t_hasher>
+            nodes_;
+
+        Node const *load(chunk_offset_t const offset, uint64_t const version)
+        {
+            if (auto const it = nodes_.find(offset); it != nodes_.end()) {
+                return it->second.get();
+            }
+            Node::UniquePtr node = read_node_blocking(aux_, offset, version);
+            if (!node) {
+                return nullptr;
+            }
+            return nodes_.emplace(offset, std::move(node)).first->second.get();
+        }
+
+    public:
+        explicit version_range_walker(UpdateAuxImpl const &aux)
+            : aux_(aux)
+        {
+        }
+
+        void drop_cache_if_full()
+        {
+            if (nodes_.size() >= MAX_CACHED_NODES) {
+                nodes_.clear();
+            }
+        }
+
+        void drop_cache()
+        {
+            nodes_.clear();
+        }
+
+        // Same semantics as find_blocking(), except that the walk stops early
+        // once it reaches a node visited at the same point by `prev_path`.
+        walk_outcome_t walk(
+            NibblesView const key, chunk_offset_t const root_offset,
+            uint64_t const version, walk_path_t const &prev_path,
+            walk_path_t &path)
+        {
+            path.clear();
+            chunk_offset_t offset = root_offset;
+            unsigned prefix_index = 0;
+            while (true) {
+                auto const depth = path.size();
+                path.emplace_back(prefix_index, offset);
+                if (depth < prev_path.size() &&
+                    prev_path[depth] == path.back()) {
+                    return {.reused = true};
+                }
+                Node const *const node = load(offset, version);
+                if (!node) {
+                    return {.result = find_result::version_no_longer_exist};
+                }
+                auto const path_view = node->path_nibble_view();
+                unsigned node_prefix_index = 0;
+                while (node_prefix_index < node->path_nibbles_len() &&
+                       prefix_index < key.nibble_size()) {
+                    if (key.get(prefix_index) !=
+                        path_view.get(node_prefix_index)) {
+                        return {
+                            .result = find_result::key_mismatch_failure,
+                            .node = node};
+                    }
+                    ++node_prefix_index;
+                    ++prefix_index;
+                }
+                if (node_prefix_index != node->path_nibbles_len()) {
+                    return {
+                        .result =
+                            find_result::key_ends_earlier_than_node_failure,
+                        .node = node};
+                }
+                if (prefix_index == key.nibble_size()) {
+                    return {.result = find_result::success, .node = node};
+                }
+                unsigned char const nibble = key.get(prefix_index);
+                if (!(node->mask & (1u << nibble))) {
+                    return {
+                        .result = find_result::branch_not_exist_failure,
+                        .node = node};
+                }
+                offset = node->fnext(node->to_child_index(nibble));
+                ++prefix_index;
+            }
+        }
+    };
+
+    void append_run(
+        version_range_find_results_t &runs, uint64_t const version,
+        find_result const result, byte_string_view const value)
+    {
+        if (!runs.empty()) {
+            auto &last = runs.back();
+            if (last.end_version + 1 == version && last.result == result &&
+                byte_string_view{last.value} == value) {
+                last.end_version = version;
+                return;
+            }
+        }
+        runs.push_back(
+            {.begin_version = version,
+             .end_version = version,
+             .result = result,
+             .value = byte_string{value}});
+    }
+}
+
+std::vector<version_range_find_results_t> find_version_range_blocking(
+    UpdateAuxImpl const &aux, std::span<NibblesView const> const keys,
+    uint64_t const min_version, uint64_t const max_version)
+{
+    MONAD_ASSERT(aux.is_on_disk());
+    MONAD_ASSERT(min_version <= max_version);
+
+    std::vector<version_range_find_results_t> results(keys.size());
+    auto const max_valid_version = aux.db_history_max_version();
+    if (max_valid_version == INVALID_BLOCK_NUM) {
+        return results;
+    }
+    auto const begin =
+        std::max(min_version, aux.db_history_min_valid_version());
+    auto const end = std::min(max_version, max_valid_version);
+
+    version_range_walker walker{aux};
+    std::vector<walk_path_t> prev_paths(keys.size());
+    std::vector<walk_path_t> paths(keys.size());
+    std::vector<walk_outcome_t> outcomes(keys.size());
+    auto const mark_version_invalid = [&](uint64_t const version) {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            append_run(
+                results[i], version, find_result::version_no_longer_exist, {});
+            prev_paths[i].clear();
+        }
+        // Node offsets referenced across an invalid version may have been
+        // recycled, so nothing loaded before it can be reused after it.
+        walker.drop_cache();
+    };
+    for (uint64_t version = begin; version <= end; ++version) {
+        walker.drop_cache_if_full();
+        auto const root_offset = aux.get_root_offset_at_version(version);
+        if (root_offset == INVALID_OFFSET) {
+            mark_version_invalid(version);
+            continue;
+        }
+        for (size_t i = 0; i < keys.size(); ++i) {
+            outcomes[i] = walker.walk(
+                keys[i], root_offset, version, prev_paths[i], paths[i]);
+        }
+        // Nodes served from the cache are not checked against the version,
+        // so validate once more now that the whole batch has been resolved.
+        if (!aux.version_is_valid_ondisk(version)) {
+            mark_version_invalid(version);
+            continue;
+        }
+        for (size_t i = 0; i < keys.size(); ++i) {
+            auto const &outcome = outcomes[i];
+            auto &runs = results[i];
+            if (outcome.reused) {
+                MONAD_DEBUG_ASSERT(
+                    !runs.empty() && runs.back().end_version + 1 == version);
+                runs.back().end_version = version;
+            }
+            else {
+                append_run(
+                    runs,
+                    version,
+                    outcome.result,
+                    outcome.result == find_result::success &&
+                            outcome.node->has_value()
+                        ? outcome.node->value()
+                        : byte_string_view{});
+            }
+            if (outcome.result == find_result::version_no_longer_exist) {
+                prev_paths[i].clear();
+            }
+            else {
+                std::swap(prev_paths[i], paths[i]);
+            }
+        }
+    }
+    return results;
+}
+
+MONAD_MPT_NAMESPACE_END
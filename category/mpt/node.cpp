@@ -44,6 +44,8 @@
 #include <utility>
 #include <vector>
 
+#include <zstd.h>
+
 MONAD_MPT_NAMESPACE_BEGIN
 
 Node::Node(prevent_public_construction_tag) {}
@@ -587,6 +589,71 @@ void serialize_node_to_buffer(
     }
 }
 
+byte_string compress_node_for_disk(Node const &node, int const level)
+{
+    static thread_local std::unique_ptr<ZSTD_CCtx, decltype(&ZSTD_freeCCtx)>
+        cctx{ZSTD_createCCtx(), &ZSTD_freeCCtx};
+    MONAD_ASSERT(cctx);
+    auto const disk_size = node.get_disk_size();
+    auto const node_size = disk_size - Node::disk_size_bytes;
+    byte_string ret(Node::disk_size_bytes + ZSTD_compressBound(node_size), 0);
+    auto const written = ZSTD_compressCCtx(
+        cctx.get(),
+        ret.data() + Node::disk_size_bytes,
+        ret.size() - Node::disk_size_bytes,
+        &node,
+        node_size,
+        level);
+    MONAD_ASSERT_PRINTF(
+        !ZSTD_isError(written),
+        "zstd compression failed with %s",
+        ZSTD_getErrorName(written));
+    auto const stored_size = Node::disk_size_bytes + written;
+    if (stored_size >= disk_size) {
+        return {};
+    }
+    ret.resize(stored_size);
+    uint32_t const header =
+        static_cast<uint32_t>(stored_size) | Node::compressed_disk_size_bit;
+    memcpy(ret.data(), &header, sizeof(header));
+    return ret;
+}
+
+byte_string decompress_node_from_buffer(
+    unsigned char const *const read_pos, size_t const max_bytes)
+{
+    static thread_local std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>
+        dctx{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+    MONAD_ASSERT(dctx);
+    auto const stored_size =
+        unaligned_load<uint32_t>(read_pos) & ~Node::compressed_disk_size_bit;
+    MONAD_ASSERT_PRINTF(
+        stored_size > Node::disk_size_bytes && stored_size <= max_bytes,
+        "compressed node disk size is %u",
+        stored_size);
+    auto const *const frame = read_pos + Node::disk_size_bytes;
+    auto const frame_size = stored_size - Node::disk_size_bytes;
+    auto const node_size = ZSTD_getFrameContentSize(frame, frame_size);
+    MONAD_ASSERT(
+        node_size != ZSTD_CONTENTSIZE_UNKNOWN &&
+        node_size != ZSTD_CONTENTSIZE_ERROR &&
+        node_size + Node::disk_size_bytes <= Node::max_disk_size);
+    byte_string ret(Node::disk_size_bytes + node_size, 0);
+    auto const disk_size = static_cast<uint32_t>(ret.size());
+    memcpy(ret.data(), &disk_size, sizeof(disk_size));
+    auto const written = ZSTD_decompressDCtx(
+        dctx.get(),
+        ret.data() + Node::disk_size_bytes,
+        node_size,
+        frame,
+        frame_size);
+    MONAD_ASSERT_PRINTF(
+        !ZSTD_isError(written) && written == node_size,
+        "zstd decompression of node failed with %s",
+        ZSTD_isError(written) ? ZSTD_getErrorName(written) : "short output");
+    return ret;
+}
+
 int64_t calc_min_version(Node const &node)
 {
     int64_t min_version = node.version;
@@ -19,6 +19,7 @@
 #include <category/core/byte_string.hpp>
 #include <category/core/endian.hpp> // NOLINT
 #include <category/core/keccak.h>
+#include <category/core/likely.h>
 #include <category/core/math.hpp>
 #include <category/core/mem/allocators.hpp>
 #include <category/core/rlp/encode.hpp>
@@ -150,6 +151,9 @@ public:
     static constexpr size_t max_disk_size =
         256 * 1024 * 1024; // 256mb, same as storage chunk size
     static constexpr unsigned disk_size_bytes = sizeof(uint32_t);
+    // Set in the on-disk size of a node stored compressed, see
+    // compress_node_for_disk()
+    static constexpr uint32_t compressed_disk_size_bit = 1U << 31;
     static constexpr size_t max_size =
         max_disk_size + max_number_of_children * KECCAK256_SIZE;
 
@@ -440,6 +444,17 @@ void serialize_node_to_buffer(
     unsigned char *write_pos, unsigned bytes_to_write, Node const &,
     uint32_t disk_size, unsigned offset = 0);
 
+/* Encodes the node for disk as a zstd frame of its uncompressed encoding,
+preceded by the 32-bit on-disk size with `NodeBase::compressed_disk_size_bit`
+set. Returns an empty string if that is no smaller than the uncompressed
+encoding.
+*/
+byte_string compress_node_for_disk(Node const &, int level);
+
+// Returns the uncompressed on-disk encoding of a compressed on-disk node
+byte_string
+decompress_node_from_buffer(unsigned char const *read_pos, size_t max_bytes);
+
 template <class NodeType>
 inline NodeType::UniquePtr
 deserialize_node_from_buffer(unsigned char const *read_pos, size_t max_bytes)
@@ -449,6 +464,12 @@ deserialize_node_from_buffer(unsigned char const *read_pos, size_t max_bytes)
     }
     // Load 32-bit node on-disk size
     auto const disk_size = unaligned_load<uint32_t>(read_pos);
+    if (MONAD_UNLIKELY(disk_size & NodeBase::compressed_disk_size_bit)) {
+        auto const decompressed =
+            decompress_node_from_buffer(read_pos, max_bytes);
+        return deserialize_node_from_buffer<NodeType>(
+            decompressed.data(), decompressed.size());
+    }
     MONAD_ASSERT_PRINTF(
         disk_size <= max_bytes, "deserialized node disk size is %u", disk_size);
     MONAD_ASSERT(disk_size > 0 && disk_size <= NodeBase::max_disk_size);
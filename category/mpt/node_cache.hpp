@@ -25,6 +25,8 @@
 
 MONAD_MPT_NAMESPACE_BEGIN
 
+class SharedNodeCache;
+
 // Memory bounded node cache
 class NodeCache final
     : private static_lru_cache<
@@ -39,6 +41,8 @@ class NodeCache final
 
     size_t max_bytes_;
     size_t used_bytes_{0};
+    // consulted by readers on a miss before reading from disk, if set
+    SharedNodeCache *shared_{nullptr};
 
     void evict_until_under_limit()
     {
@@ -76,6 +80,16 @@ public:
 
     ~NodeCache() = default;
 
+    void set_shared_cache(SharedNodeCache *const shared) noexcept
+    {
+        shared_ = shared;
+    }
+
+    SharedNodeCache *shared_cache() const noexcept
+    {
+        return shared_;
+    }
+
     Map::iterator insert(
         virtual_chunk_offset_t const &virt_offset,
         std::shared_ptr<CacheNode> const &sp) noexcept
@@ -35,10 +35,23 @@ struct OnDiskDbConfig
     bool rewind_to_latest_finalized{false};
     unsigned rd_buffers{1024};
     unsigned wr_buffers{4};
+    // if non-zero, node writers pipeline partially filled write buffers
+    // while fewer than this many writes are in flight. wr_buffers is raised
+    // to at least 2 * (write_queue_depth + 1) so neither writer stalls.
+    unsigned write_queue_depth{0};
+    // if non-zero, nodes written to the slow list are stored compressed with
+    // zstd at this level wherever that saves space. Fast list nodes are never
+    // compressed. Once set, the DB can only be opened for writing with it
+    // set, and not at all by code from before compression.
+    int slow_list_compression_level{0};
     unsigned uring_entries{512};
     std::optional<unsigned> sq_thread_cpu{0};
     std::optional<uint64_t> start_block_id{std::nullopt};
     std::vector<std::filesystem::path> dbname_paths{};
+    // subset of dbname_paths which are low latency devices. If set, new fast
+    // list chunks are placed on these and new slow list chunks on the others,
+    // so compaction migrates older data onto the capacity devices over time
+    std::vector<std::filesystem::path> low_latency_dbname_paths{};
     int64_t file_size_db{512}; // truncate files to this size
     unsigned concurrent_read_io_limit{1024};
     // fixed history length if contains value, otherwise rely on db to adjust
@@ -60,6 +73,12 @@ struct ReadOnlyOnDiskDbConfig
     std::vector<std::filesystem::path> dbname_paths;
     unsigned concurrent_read_io_limit{600};
     uint64_t node_lru_max_mem{100ul << 20}; // 100MB
+    // if set, a node cache in this shared memory file (e.g. under /dev/shm)
+    // is shared with every other read only opener using the same path, see
+    // SharedNodeCache. It is created with room for shared_node_cache_max_mem
+    // of nodes if it does not already exist.
+    std::optional<std::filesystem::path> shared_node_cache_path{std::nullopt};
+    uint64_t shared_node_cache_max_mem{1ul << 30}; // 1GB
 };
 
 MONAD_MPT_NAMESPACE_END
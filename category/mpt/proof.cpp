@@ -0,0 +1,320 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/core/keccak.h>
+#include <category/mpt/compute.hpp>
+#include <category/mpt/config.hpp>
+#include <category/mpt/merkle/node_reference.hpp>
+#include <category/mpt/nibbles_view.hpp>
+#include <category/mpt/node.hpp>
+#include <category/mpt/trie.hpp>
+#include <category/mpt/util.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+MONAD_MPT_NAMESPACE_BEGIN
+
+namespace
+{
+    // Result of matching `key` from nibble `depth` against a node path
+    find_result match_path(
+        NibblesView const key, unsigned const depth, NibblesView const path)
+    {
+        for (unsigned i = 0; i < path.nibble_size(); ++i) {
+            if (depth + i == key.nibble_size()) {
+                return find_result::key_ends_earlier_than_node_failure;
+            }
+            if (key.get(depth + i) != path.get(i)) {
+                return find_result::key_mismatch_failure;
+            }
+        }
+        return find_result::success;
+    }
+
+    class proof_builder
+    {
+        UpdateAuxImpl const &aux_;
+        compute_leaf_data_fn const leaf_data_;
+        uint64_t const version_;
+        std::span<NibblesView const> const keys_;
+        merkle_multiproof_t &proof_;
+        bool version_valid_{true};
+
+        // Lists rlp as a proof node of every key in group. Nodes shorter than
+        // a hash are embedded in their parent instead, unless they are root.
+        void add_node(
+            byte_string rlp, std::span<uint32_t const> const group,
+            bool const is_root)
+        {
+            if (!is_root && rlp.size() < KECCAK256_SIZE) {
+                return;
+            }
+            auto const index = static_cast<uint32_t>(proof_.nodes.size());
+            proof_.nodes.emplace_back(std::move(rlp));
+            for (auto const k : group) {
+                proof_.keys[k].nodes.push_back(index);
+            }
+        }
+
+        void set_result(
+            std::span<uint32_t const> const group, find_result const result)
+        {
+            for (auto const k : group) {
+                proof_.keys[k].result = result;
+            }
+        }
+
+        // The rebuilt rlp must hash to the data the parent node holds for it
+        static bool matches_reference(
+            byte_string_view const rlp, byte_string_view const reference)
+        {
+            unsigned char buffer[KECCAK256_SIZE];
+            auto const len = to_node_reference(rlp, buffer);
+            return reference == byte_string_view{buffer, len};
+        }
+
+        void leaf(
+            Node &node, NibblesView const path, unsigned const depth,
+            std::span<uint32_t const> const group,
+            byte_string_view const reference)
+        {
+            auto rlp = encode_two_pieces_rlp(path, leaf_data_(node), true);
+            MONAD_DEBUG_ASSERT(
+                reference.empty() || matches_reference(rlp, reference));
+            add_node(std::move(rlp), group, reference.empty());
+            for (auto const k : group) {
+                auto const result = match_path(keys_[k], depth, path);
+                proof_.keys[k].result =
+                    (result == find_result::success &&
+                     keys_[k].nibble_size() != depth + path.nibble_size())
+                        ? find_result::key_mismatch_failure
+                        : result;
+            }
+        }
+
+        void branch(
+            Node &node, NibblesView const path, unsigned depth,
+            std::span<uint32_t const> group, byte_string_view const reference)
+        {
+            auto branch_rlp = encode_branch_rlp(&node);
+            if (path.nibble_size()) {
+                unsigned char branch_reference[KECCAK256_SIZE];
+                auto const len =
+                    to_node_reference(branch_rlp, branch_reference);
+                auto rlp = encode_two_pieces_rlp(
+                    path, {branch_reference, len}, false);
+                MONAD_DEBUG_ASSERT(
+                    reference.empty() || matches_reference(rlp, reference));
+                add_node(std::move(rlp), group, reference.empty());
+                // keys diverging from the extension path end here. As the
+                // keys are sorted, the ones that match are contiguous.
+                for (auto const k : group) {
+                    proof_.keys[k].result = match_path(keys_[k], depth, path);
+                }
+                auto const matches = [&](uint32_t const k) {
+                    return proof_.keys[k].result == find_result::success;
+                };
+                auto const begin = std::ranges::find_if(group, matches);
+                auto const end = std::find_if_not(begin, group.end(), matches);
+                group = {begin, end};
+                add_node(std::move(branch_rlp), group, false);
+                depth += path.nibble_size();
+            }
+            else {
+                MONAD_DEBUG_ASSERT(
+                    reference.empty() ||
+                    matches_reference(branch_rlp, reference));
+                add_node(std::move(branch_rlp), group, reference.empty());
+            }
+            // a key ending at a branch has no value, keys sorting before all
+            // longer ones
+            while (!group.empty() &&
+                   keys_[group.front()].nibble_size() == depth) {
+                proof_.keys[group.front()].result =
+                    find_result::key_ends_earlier_than_node_failure;
+                group = group.subspan(1);
+            }
+            while (!group.empty()) {
+                auto const nibble = keys_[group.front()].get(depth);
+                auto const run = static_cast<size_t>(
+                    std::ranges::find_if(
+                        group,
+                        [&](uint32_t const k) {
+                            return keys_[k].get(depth) != nibble;
+                        }) -
+                    group.begin());
+                if (node.mask & (1u << nibble)) {
+                    auto const index = node.to_child_index(nibble);
+                    auto const child =
+                        read_node_blocking(aux_, node.fnext(index), version_);
+                    if (!child) {
+                        version_valid_ = false;
+                        return;
+                    }
+                    walk(
+                        *child,
+                        child->path_nibble_view(),
+                        depth + 1,
+                        group.first(run),
+                        node.child_data_view(index));
+                    if (!version_valid_) {
+                        return;
+                    }
+                }
+                else {
+                    set_result(
+                        group.first(run),
+                        find_result::branch_not_exist_failure);
+                }
+                group = group.subspan(run);
+            }
+        }
+
+        void walk(
+            Node &node, NibblesView const path, unsigned const depth,
+            std::span<uint32_t const> const group,
+            byte_string_view const reference)
+        {
+            if (node.has_value()) {
+                leaf(node, path, depth, group, reference);
+            }
+            else {
+                branch(node, path, depth, group, reference);
+            }
+        }
+
+    public:
+        proof_builder(
+            UpdateAuxImpl const &aux, compute_leaf_data_fn const leaf_data,
+            uint64_t const version, std::span<NibblesView const> const keys,
+            merkle_multiproof_t &proof)
+            : aux_(aux)
+            , leaf_data_(leaf_data)
+            , version_(version)
+            , keys_(keys)
+            , proof_(proof)
+        {
+        }
+
+        // Proves every key against the merkle trie formed by the children of
+        // `root`. Returns false if the version became invalid meanwhile.
+        bool prove(Node &root, std::span<uint32_t const> const order)
+        {
+            if (root.mask == 0) {
+                unsigned char const empty_rlp = RLP_EMPTY_STRING;
+                keccak256(&empty_rlp, 1, proof_.root.bytes);
+                set_result(order, find_result::branch_not_exist_failure);
+                return true;
+            }
+            if (std::has_single_bit(root.mask)) {
+                // the root merges the only branch nibble into the path of the
+                // child below it, as MerkleComputeBase::compute_len() does
+                auto const nibble =
+                    static_cast<unsigned char>(std::countr_zero(root.mask));
+                auto const child =
+                    read_node_blocking(aux_, root.fnext(0), version_);
+                if (!child) {
+                    return false;
+                }
+                auto const path = concat(nibble, child->path_nibble_view());
+                walk(*child, path, 0, order, {});
+            }
+            else {
+                branch(root, {}, 0, order, {});
+            }
+            if (!version_valid_) {
+                return false;
+            }
+            MONAD_ASSERT(!proof_.nodes.empty());
+            keccak256(
+                proof_.nodes.front().data(),
+                proof_.nodes.front().size(),
+                proof_.root.bytes);
+            return true;
+        }
+    };
+}
+
+merkle_multiproof_t generate_proof_blocking(
+    UpdateAuxImpl const &aux, NibblesView const prefix,
+    std::span<NibblesView const> const keys,
+    compute_leaf_data_fn const leaf_data, uint64_t const version)
+{
+    MONAD_ASSERT(aux.is_on_disk());
+    MONAD_ASSERT(leaf_data != nullptr);
+
+    auto const version_gone = [&] {
+        merkle_multiproof_t proof{
+            .result = find_result::version_no_longer_exist};
+        proof.keys.resize(keys.size());
+        return proof;
+    };
+    merkle_multiproof_t proof;
+    proof.keys.resize(keys.size());
+    auto const root_offset = aux.get_root_offset_at_version(version);
+    if (root_offset == INVALID_OFFSET) {
+        return version_gone();
+    }
+    // descend to the subtrie root, which must end exactly at a node
+    Node::UniquePtr node = read_node_blocking(aux, root_offset, version);
+    unsigned prefix_index = 0;
+    while (node) {
+        auto const result =
+            match_path(prefix, prefix_index, node->path_nibble_view());
+        if (result != find_result::success) {
+            proof.result = result;
+            return proof;
+        }
+        prefix_index += node->path_nibbles_len();
+        if (prefix_index == prefix.nibble_size()) {
+            break;
+        }
+        auto const nibble = prefix.get(prefix_index);
+        if (!(node->mask & (1u << nibble))) {
+            proof.result = find_result::branch_not_exist_failure;
+            return proof;
+        }
+        node = read_node_blocking(
+            aux, node->fnext(node->to_child_index(nibble)), version);
+        ++prefix_index;
+    }
+    if (!node) {
+        return version_gone();
+    }
+
+    std::vector<uint32_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::ranges::sort(order, [&](uint32_t const a, uint32_t const b) {
+        return keys[a] < keys[b];
+    });
+    proof_builder builder{aux, leaf_data, version, keys, proof};
+    // Nodes are not checked against the version once loaded, so validate once
+    // more now that every key has been resolved.
+    if (!builder.prove(*node, order) || !aux.version_is_valid_ondisk(version)) {
+        return version_gone();
+    }
+    proof.result = find_result::success;
+    return proof;
+}
+
+MONAD_MPT_NAMESPACE_END
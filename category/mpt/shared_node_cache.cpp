@@ -0,0 +1,279 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <category/async/detail/start_lifetime_as_polyfill.hpp>
+#include <category/core/assert.h>
+#include <category/mpt/config.hpp>
+#include <category/mpt/node.hpp>
+#include <category/mpt/shared_node_cache.hpp>
+#include <category/mpt/util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MONAD_MPT_NAMESPACE_BEGIN
+
+struct SharedNodeCache::header_t
+{
+    static constexpr char MAGIC[8] = {'M', 'N', 'D', 'N', 'C', 'A', 'C', '1'};
+
+    char magic[8];
+    uint32_t slot_size;
+    uint32_t ways;
+    uint64_t sets;
+};
+
+struct alignas(64) SharedNodeCache::slot_t
+{
+    // odd while the slot is being written
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> key;
+    std::atomic<uint32_t> rewind_epoch;
+    // of the node's on-disk encoding, zero if the slot is empty
+    std::atomic<uint32_t> size;
+    std::atomic<uint8_t> referenced;
+    uint8_t unused[7];
+    unsigned char data[max_node_disk_size];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+namespace
+{
+    constexpr size_t round_up_64(size_t const v) noexcept
+    {
+        return (v + 63) & ~size_t(63);
+    }
+
+    // header, then a clock hand per set, then the slots
+    constexpr size_t clock_hands_offset = 64;
+
+    constexpr size_t slots_offset(uint64_t const sets) noexcept
+    {
+        return clock_hands_offset + round_up_64(sets * sizeof(uint32_t));
+    }
+
+    constexpr size_t map_size(uint64_t const sets) noexcept
+    {
+        return slots_offset(sets) +
+               sets * SharedNodeCache::WAYS * SharedNodeCache::SLOT_SIZE;
+    }
+}
+
+SharedNodeCache::SharedNodeCache(
+    std::filesystem::path const &path, size_t const capacity_bytes)
+{
+    static_assert(sizeof(header_t) <= clock_hands_offset);
+    static_assert(sizeof(slot_t) == SLOT_SIZE);
+    static_assert(offsetof(slot_t, data) == SLOT_HEADER_SIZE);
+    header_t header{};
+    while (true) {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        MONAD_ASSERT_PRINTF(
+            fd_ != -1,
+            "open of shared node cache %s failed due to %s",
+            path.c_str(),
+            std::strerror(errno));
+        // Serialise creation against other processes opening it concurrently
+        MONAD_ASSERT_PRINTF(
+            ::flock(fd_, LOCK_EX) == 0,
+            "failed due to %s",
+            std::strerror(errno));
+        struct stat st;
+        MONAD_ASSERT_PRINTF(
+            ::fstat(fd_, &st) == 0, "failed due to %s", std::strerror(errno));
+        // Another opener may have replaced the file while we waited
+        struct stat path_st;
+        if (::stat(path.c_str(), &path_st) != 0 ||
+            path_st.st_dev != st.st_dev || path_st.st_ino != st.st_ino) {
+            ::close(fd_);
+            continue;
+        }
+        bool const valid =
+            static_cast<size_t>(st.st_size) >= sizeof(header) &&
+            ::pread(fd_, &header, sizeof(header), 0) == sizeof(header) &&
+            0 == memcmp(header.magic, header_t::MAGIC, sizeof(header.magic)) &&
+            header.slot_size == SLOT_SIZE && header.ways == WAYS &&
+            header.sets > 0 &&
+            static_cast<size_t>(st.st_size) == map_size(header.sets);
+        if (valid) {
+            break;
+        }
+        if (st.st_size != 0) {
+            // Laid out by a different build, or left incomplete by a process
+            // which died creating it. Processes may still have it mapped, so
+            // it is replaced by a new file rather than resized under them.
+            MONAD_ASSERT_PRINTF(
+                ::unlink(path.c_str()) == 0,
+                "unlink of shared node cache %s failed due to %s",
+                path.c_str(),
+                std::strerror(errno));
+            ::close(fd_);
+            continue;
+        }
+        header = header_t{};
+        memcpy(header.magic, header_t::MAGIC, sizeof(header.magic));
+        header.slot_size = SLOT_SIZE;
+        header.ways = WAYS;
+        header.sets = std::max<uint64_t>(1, capacity_bytes / SLOT_SIZE / WAYS);
+        MONAD_ASSERT_PRINTF(
+            ::ftruncate(fd_, off_t(map_size(header.sets))) == 0,
+            "failed due to %s",
+            std::strerror(errno));
+        MONAD_ASSERT(
+            ::pwrite(fd_, &header, sizeof(header), 0) == sizeof(header));
+        break;
+    }
+    sets_ = header.sets;
+    map_size_ = map_size(sets_);
+    auto *const map = static_cast<std::byte *>(::mmap(
+        nullptr, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0));
+    MONAD_ASSERT_PRINTF(
+        map != MAP_FAILED, "mmap failed due to %s", std::strerror(errno));
+    MONAD_ASSERT(::flock(fd_, LOCK_UN) == 0);
+    header_ = start_lifetime_as<header_t>(map);
+    clock_hands_ = start_lifetime_as_array<std::atomic<uint32_t>>(
+        map + clock_hands_offset, sets_);
+    slots_ = start_lifetime_as_array<slot_t>(
+        map + slots_offset(sets_), sets_ * WAYS);
+}
+
+SharedNodeCache::~SharedNodeCache()
+{
+    if (header_ != nullptr) {
+        ::munmap(header_, map_size_);
+    }
+    if (fd_ != -1) {
+        ::close(fd_);
+    }
+}
+
+uint64_t
+SharedNodeCache::set_index(virtual_chunk_offset_t const offset) const noexcept
+{
+    return virtual_chunk_offset_t_hasher{}(offset) % sets_;
+}
+
+std::shared_ptr<CacheNode> SharedNodeCache::find(
+    virtual_chunk_offset_t const virtual_offset,
+    uint32_t const rewind_epoch) noexcept
+{
+    auto const key = virtual_offset.hasher_raw();
+    slot_t *const set = slots_ + set_index(virtual_offset) * WAYS;
+    for (unsigned i = 0; i < WAYS; ++i) {
+        slot_t &slot = set[i];
+        auto const seq = slot.seq.load(std::memory_order_acquire);
+        if ((seq & 1) != 0 ||
+            slot.key.load(std::memory_order_relaxed) != key ||
+            slot.rewind_epoch.load(std::memory_order_relaxed) != rewind_epoch) {
+            continue;
+        }
+        auto const size = slot.size.load(std::memory_order_relaxed);
+        if (size == 0 || size > max_node_disk_size) {
+            continue;
+        }
+        unsigned char buffer[max_node_disk_size];
+        memcpy(buffer, slot.data, size);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) != seq) {
+            // rewritten while we copied it out
+            continue;
+        }
+        slot.referenced.store(1, std::memory_order_relaxed);
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return deserialize_node_from_buffer<CacheNode>(buffer, size);
+    }
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    return {};
+}
+
+void SharedNodeCache::insert(
+    virtual_chunk_offset_t const virtual_offset, uint32_t const rewind_epoch,
+    NodeBase const &node) noexcept
+{
+    uint32_t const disk_size = node.get_disk_size();
+    if (disk_size > max_node_disk_size) {
+        return;
+    }
+    auto const key = virtual_offset.hasher_raw();
+    auto const index = set_index(virtual_offset);
+    slot_t *const set = slots_ + index * WAYS;
+    for (unsigned i = 0; i < WAYS; ++i) {
+        // another opener got there first
+        if ((set[i].seq.load(std::memory_order_acquire) & 1) == 0 &&
+            set[i].size.load(std::memory_order_relaxed) != 0 &&
+            set[i].key.load(std::memory_order_relaxed) == key &&
+            set[i].rewind_epoch.load(std::memory_order_relaxed) ==
+                rewind_epoch) {
+            return;
+        }
+    }
+    // Clock: skip, and clear, the referenced bit of each way until one
+    // without it is found. Two sweeps always find one unless other openers
+    // keep hitting the whole set, in which case nothing is evicted.
+    slot_t *victim = nullptr;
+    for (unsigned n = 0; n < 2 * WAYS; ++n) {
+        auto const way =
+            clock_hands_[index].fetch_add(1, std::memory_order_relaxed) % WAYS;
+        if (set[way].referenced.exchange(0, std::memory_order_relaxed) == 0) {
+            victim = &set[way];
+            break;
+        }
+    }
+    if (victim == nullptr) {
+        return;
+    }
+    auto seq = victim->seq.load(std::memory_order_relaxed);
+    // A slot left odd by a process which died writing it stays unusable
+    if ((seq & 1) != 0 ||
+        !victim->seq.compare_exchange_strong(
+            seq,
+            seq + 1,
+            std::memory_order_acquire,
+            std::memory_order_relaxed)) {
+        return;
+    }
+    victim->key.store(key, std::memory_order_relaxed);
+    victim->rewind_epoch.store(rewind_epoch, std::memory_order_relaxed);
+    victim->size.store(disk_size, std::memory_order_relaxed);
+    memcpy(victim->data, &disk_size, NodeBase::disk_size_bytes);
+    memcpy(
+        victim->data + NodeBase::disk_size_bytes,
+        &node,
+        disk_size - NodeBase::disk_size_bytes);
+    victim->seq.store(seq + 2, std::memory_order_release);
+}
+
+uint64_t SharedNodeCache::occupied() const noexcept
+{
+    uint64_t ret = 0;
+    for (uint64_t i = 0; i < sets_ * WAYS; ++i) {
+        ret += slots_[i].size.load(std::memory_order_relaxed) != 0;
+    }
+    return ret;
+}
+
+MONAD_MPT_NAMESPACE_END
@@ -0,0 +1,108 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#pragma once
+
+#include <category/mpt/config.hpp>
+#include <category/mpt/node.hpp>
+#include <category/mpt/util.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+MONAD_MPT_NAMESPACE_BEGIN
+
+/* A node cache in a shared memory file, mapped by every read only opener of
+a database on the host, so that each node is read from disk and held in
+memory once rather than once per opener. It sits below each opener's private
+`NodeCache`, and holds the on-disk encoding of nodes keyed by virtual offset
+and the database's rewind epoch, see `detail::db_metadata::rewind_epoch()`.
+
+The cache is set associative. Lookups take no locks: each slot is a seqlock
+which readers validate after copying the node out. Each set evicts with a
+clock over its ways, hits setting the referenced bit. Nodes larger than a
+slot are never cached, which in practice leaves out only leaves with large
+values, not the upper trie.
+*/
+class SharedNodeCache
+{
+public:
+    static constexpr size_t SLOT_SIZE = 2048;
+    static constexpr size_t SLOT_HEADER_SIZE = 32;
+    // Largest node on-disk encoding which fits in a slot
+    static constexpr size_t max_node_disk_size = SLOT_SIZE - SLOT_HEADER_SIZE;
+    static constexpr unsigned WAYS = 8;
+
+private:
+    struct header_t;
+    struct slot_t;
+
+    int fd_{-1};
+    size_t map_size_{0};
+    header_t *header_{nullptr};
+    std::atomic<uint32_t> *clock_hands_{nullptr};
+    slot_t *slots_{nullptr};
+    uint64_t sets_{0};
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+
+    uint64_t set_index(virtual_chunk_offset_t) const noexcept;
+
+public:
+    //! Opens the cache at `path`, creating it with room for about
+    //! `capacity_bytes` of nodes if it does not exist. An existing cache
+    //! keeps the capacity it was created with. One laid out by a different
+    //! build is replaced by a new file, leaving its current users their
+    //! mapping of the old one.
+    SharedNodeCache(std::filesystem::path const &path, size_t capacity_bytes);
+    ~SharedNodeCache();
+
+    SharedNodeCache(SharedNodeCache const &) = delete;
+    SharedNodeCache &operator=(SharedNodeCache const &) = delete;
+
+    //! Returns a copy of the node at `virtual_offset` cached under
+    //! `rewind_epoch`, or null
+    std::shared_ptr<CacheNode>
+    find(virtual_chunk_offset_t virtual_offset, uint32_t rewind_epoch) noexcept;
+
+    //! Best effort, gives up rather than wait on another writer of the slot
+    void insert(
+        virtual_chunk_offset_t virtual_offset, uint32_t rewind_epoch,
+        NodeBase const &) noexcept;
+
+    uint64_t capacity() const noexcept
+    {
+        return sets_ * WAYS;
+    }
+
+    //! Number of slots holding a node, by scanning them all
+    uint64_t occupied() const noexcept;
+
+    //! Lookups by this process
+    uint64_t hits() const noexcept
+    {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    uint64_t misses() const noexcept
+    {
+        return misses_.load(std::memory_order_relaxed);
+    }
+};
+
+MONAD_MPT_NAMESPACE_END
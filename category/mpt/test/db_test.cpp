@@ -26,6 +26,7 @@
 #include <category/core/hex_literal.hpp>
 #include <category/core/io/buffers.hpp>
 #include <category/core/io/ring.hpp>
+#include <category/core/keccak.h>
 #include <category/core/result.hpp>
 #include <category/core/small_prng.hpp>
 #include <category/core/unaligned.hpp>
@@ -33,6 +34,7 @@
 #include <category/mpt/db_error.hpp>
 #include <category/mpt/nibbles_view.hpp>
 #include <category/mpt/ondisk_db_config.hpp>
+#include <category/mpt/shared_node_cache.hpp>
 #include <category/mpt/traverse.hpp>
 #include <category/mpt/trie.hpp>
 #include <category/mpt/update.hpp>
@@ -46,12 +48,14 @@
 #include <boost/fiber/future/promise.hpp>
 #include <boost/fiber/operations.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <deque>
 #include <filesystem>
 #include <functional>
@@ -478,6 +482,238 @@ TEST_F(OnDiskDbWithFileFixture, read_only_db_single_thread)
         0x05a697d6698c55ee3e4d472c4907bca2184648bcfdd0e023e7ff7089dc984e7e_hex);
 }
 
+TEST_F(OnDiskDbWithFileFixture, find_version_range)
+{
+    auto const &kv = fixed_updates::kv;
+    auto const prefix = 0x00_hex;
+    uint64_t const num_blocks = 20;
+
+    // kv[0] changes every 5 blocks, kv[1] is written once, kv[2] appears at
+    // block 10 and kv[3] changes every block
+    for (uint64_t b = 0; b < num_blocks; ++b) {
+        std::deque<Update> updates;
+        UpdateList ul;
+        auto const push = [&](monad::byte_string const &k,
+                              monad::byte_string const &v) {
+            ul.push_front(updates.emplace_back(make_update(k, v)));
+        };
+        push(kv[3].first, kv[b % 4].second);
+        if (b % 5 == 0) {
+            push(kv[0].first, kv[(b / 5) % 4].second);
+        }
+        if (b == 0) {
+            push(kv[1].first, kv[1].second);
+        }
+        if (b == 10) {
+            push(kv[2].first, kv[2].second);
+        }
+        UpdateList ul_prefix;
+        auto u_prefix = make_update(prefix, std::move(ul), b);
+        ul_prefix.push_front(u_prefix);
+        db.upsert(std::move(ul_prefix), b);
+    }
+
+    std::vector<monad::byte_string> keys;
+    for (auto const &[k, v] : kv) {
+        keys.emplace_back(prefix + k);
+    }
+    keys.emplace_back(prefix + 0x99_hex); // never exists
+    std::vector<NibblesView> key_views{keys.begin(), keys.end()};
+
+    AsyncIOContext io_ctx{ReadOnlyOnDiskDbConfig{.dbname_paths = {dbname}}};
+    Db ro_db{io_ctx};
+
+    auto const verify = [&](Db &db) {
+        // versions past the latest one are not reported
+        auto const results =
+            db.find_version_range(key_views, 0, num_blocks + 100);
+        ASSERT_EQ(results.size(), keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            auto const &runs = results[i];
+            ASSERT_FALSE(runs.empty());
+            EXPECT_EQ(runs.front().begin_version, 0);
+            EXPECT_EQ(runs.back().end_version, num_blocks - 1);
+            for (size_t r = 0; r < runs.size(); ++r) {
+                if (r > 0) {
+                    EXPECT_EQ(
+                        runs[r].begin_version, runs[r - 1].end_version + 1);
+                    EXPECT_FALSE(
+                        runs[r].result == runs[r - 1].result &&
+                        runs[r].value == runs[r - 1].value);
+                }
+                for (uint64_t v = runs[r].begin_version;
+                     v <= runs[r].end_version;
+                     ++v) {
+                    auto const res = db.get(keys[i], v);
+                    if (runs[r].result == find_result::success) {
+                        ASSERT_TRUE(res.has_value());
+                        EXPECT_EQ(res.value(), runs[r].value);
+                    }
+                    else {
+                        EXPECT_TRUE(res.has_error());
+                    }
+                }
+            }
+        }
+        EXPECT_EQ(results[0].size(), 4);
+        ASSERT_EQ(results[1].size(), 1);
+        EXPECT_EQ(results[1][0].result, find_result::success);
+        EXPECT_EQ(results[1][0].value, kv[1].second);
+        ASSERT_EQ(results[2].size(), 2);
+        EXPECT_NE(results[2][0].result, find_result::success);
+        EXPECT_EQ(results[2][1].begin_version, 10);
+        EXPECT_EQ(results[2][1].value, kv[2].second);
+        EXPECT_EQ(results[3].size(), num_blocks);
+        ASSERT_EQ(results[4].size(), 1);
+        EXPECT_NE(results[4][0].result, find_result::success);
+
+        // single key over a sub range
+        auto const runs = db.find_version_range(keys[0], 7, 12);
+        ASSERT_EQ(runs.size(), 2);
+        EXPECT_EQ(runs[0].begin_version, 7);
+        EXPECT_EQ(runs[0].end_version, 9);
+        EXPECT_EQ(runs[0].value, kv[1].second);
+        EXPECT_EQ(runs[1].begin_version, 10);
+        EXPECT_EQ(runs[1].end_version, 12);
+        EXPECT_EQ(runs[1].value, kv[2].second);
+    };
+    verify(db);
+    verify(ro_db);
+}
+
+TEST_F(OnDiskDbWithFileFixture, generate_proof)
+{
+    auto const &kv = fixed_updates::kv;
+    auto const prefix = 0x00_hex;
+    uint64_t const block_id = 0;
+
+    upsert_updates_flat_list(
+        db,
+        prefix,
+        block_id,
+        make_update(kv[0].first, kv[0].second),
+        make_update(kv[1].first, kv[1].second),
+        make_update(kv[2].first, kv[2].second),
+        make_update(kv[3].first, kv[3].second));
+
+    std::vector<monad::byte_string> keys;
+    for (auto const &[k, v] : kv) {
+        keys.emplace_back(k);
+    }
+    // diverges inside the leaf of kv[0]
+    keys.emplace_back(
+        0x123456781234567812345678123456781234567812345678123456781234567f_hex);
+    // no branch below the shared extension
+    keys.emplace_back(
+        0x12345678f2345678123456781234567812345678123456781234567812345678_hex);
+    // diverges inside the extension at the root
+    keys.emplace_back(
+        0x9934567812345678123456781234567812345678123456781234567812345678_hex);
+    keys.emplace_back(kv[0].first); // duplicates share their proof
+    std::vector<NibblesView> key_views{keys.begin(), keys.end()};
+
+    auto const keccak = [](monad::byte_string_view const rlp) {
+        monad::bytes32_t hash;
+        keccak256(rlp.data(), rlp.size(), hash.bytes);
+        return hash;
+    };
+
+    auto const verify = [&](auto &db) {
+        auto const res = db.generate_proof(
+            prefix, key_views, &DummyComputeLeafData::compute, block_id);
+        ASSERT_TRUE(res.has_value());
+        auto const &proof = res.value();
+        auto const root = db.find(prefix, block_id).value().node->data();
+        ASSERT_EQ(root.size(), sizeof(monad::bytes32_t));
+        EXPECT_EQ(
+            monad::byte_string_view(proof.root.bytes, sizeof(proof.root)),
+            root);
+        ASSERT_EQ(proof.keys.size(), keys.size());
+
+        size_t total = 0;
+        for (size_t i = 0; i < keys.size(); ++i) {
+            auto const &key_proof = proof.keys[i];
+            ASSERT_FALSE(key_proof.nodes.empty());
+            total += key_proof.nodes.size();
+            // each proof node is referenced by hash from its parent
+            EXPECT_EQ(key_proof.nodes.front(), 0u);
+            EXPECT_EQ(keccak(proof.nodes[0]), proof.root);
+            for (size_t n = 1; n < key_proof.nodes.size(); ++n) {
+                auto const hash = keccak(proof.nodes[key_proof.nodes[n]]);
+                EXPECT_NE(
+                    proof.nodes[key_proof.nodes[n - 1]].find(
+                        monad::byte_string_view{hash.bytes, sizeof(hash)}),
+                    monad::byte_string::npos);
+            }
+            if (i < kv.size()) {
+                EXPECT_EQ(key_proof.result, find_result::success);
+                EXPECT_NE(
+                    proof.nodes[key_proof.nodes.back()].find(kv[i].second),
+                    monad::byte_string::npos);
+            }
+        }
+        EXPECT_EQ(
+            proof.keys[kv.size()].result, find_result::key_mismatch_failure);
+        EXPECT_EQ(
+            proof.keys[kv.size() + 1].result,
+            find_result::branch_not_exist_failure);
+        EXPECT_EQ(
+            proof.keys[kv.size() + 2].result,
+            find_result::key_mismatch_failure);
+        EXPECT_EQ(proof.keys[kv.size() + 2].nodes.size(), 1);
+        EXPECT_EQ(proof.keys.back().nodes, proof.keys[0].nodes);
+
+        // shared nodes are listed once
+        EXPECT_LT(proof.nodes.size(), total);
+        for (size_t n = 0; n < proof.nodes.size(); ++n) {
+            EXPECT_EQ(
+                std::count(
+                    proof.nodes.begin(), proof.nodes.end(), proof.nodes[n]),
+                1);
+        }
+
+        // a single key proof lists the same nodes
+        for (size_t i = 0; i < keys.size(); ++i) {
+            auto const single = db.generate_proof(
+                                      prefix,
+                                      std::span{&key_views[i], 1},
+                                      &DummyComputeLeafData::compute,
+                                      block_id)
+                                    .value();
+            EXPECT_EQ(single.root, proof.root);
+            EXPECT_EQ(single.keys[0].result, proof.keys[i].result);
+            ASSERT_EQ(single.keys[0].nodes.size(), proof.keys[i].nodes.size());
+            for (size_t n = 0; n < single.keys[0].nodes.size(); ++n) {
+                EXPECT_EQ(
+                    single.nodes[single.keys[0].nodes[n]],
+                    proof.nodes[proof.keys[i].nodes[n]]);
+            }
+        }
+
+        EXPECT_EQ(
+            db.generate_proof(
+                  0x01_hex,
+                  key_views,
+                  &DummyComputeLeafData::compute,
+                  block_id)
+                .error(),
+            DbError::key_not_found);
+        EXPECT_EQ(
+            db.generate_proof(
+                  prefix,
+                  key_views,
+                  &DummyComputeLeafData::compute,
+                  block_id + 1)
+                .error(),
+            DbError::version_no_longer_exist);
+    };
+    verify(db);
+
+    AsyncIOContext io_ctx{ReadOnlyOnDiskDbConfig{.dbname_paths = {dbname}}};
+    Db ro_db{io_ctx};
+    verify(ro_db);
+}
+
 TEST_F(ROOnDiskWithFileFixture, nonblocking_rodb)
 {
     std::shared_ptr<boost::fibers::promise<void>[]> promises{
@@ -526,6 +762,51 @@ TEST_F(ROOnDiskWithFileFixture, nonblocking_rodb)
     }
 }
 
+TEST_F(ROOnDiskWithFileFixture, find_many)
+{
+    uint64_t const version = num_blocks - 1;
+    // keys written in every other block, keys never written, and a repeat,
+    // in no particular order
+    std::vector<monad::byte_string> keys;
+    for (unsigned i = 0; i < 20 * keys_per_block; i += 7) {
+        keys.emplace_back(keccak_int_to_string(i * 2 % (num_blocks * 10)));
+        keys.emplace_back(keccak_int_to_string(num_blocks * 10 + i));
+    }
+    keys.emplace_back(keys.front());
+    std::vector<NibblesView> const key_views{keys.begin(), keys.end()};
+
+    auto const rw_results = db.find_many(key_views, version);
+    ASSERT_EQ(rw_results.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto const expected = db.find(key_views[i], version);
+        ASSERT_EQ(rw_results[i].has_value(), expected.has_value());
+        if (expected.has_value()) {
+            EXPECT_EQ(rw_results[i].value().node, expected.value().node);
+            EXPECT_EQ(rw_results[i].value().node->value(), keys[i]);
+        }
+    }
+    EXPECT_TRUE(db.find_many({}, version).empty());
+
+    boost::fibers::promise<void> done;
+    pool.submit(0, [&] {
+        auto ro_results = ro_db.find_many(key_views, version);
+        ASSERT_EQ(ro_results.size(), keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            auto const expected = ro_db.find(key_views[i], version);
+            ASSERT_EQ(ro_results[i].has_value(), expected.has_value());
+            if (expected.has_value()) {
+                EXPECT_EQ(ro_results[i].value().node->value(), keys[i]);
+            }
+        }
+        // a version outside the history fails every key
+        for (auto const &res : ro_db.find_many(key_views, 5000)) {
+            EXPECT_TRUE(res.has_error());
+        }
+        done.set_value();
+    });
+    done.get_future().get();
+}
+
 TEST_F(OnDiskDbWithFileAsyncFixture, read_only_db_single_thread_async)
 {
     auto const &kv = fixed_updates::kv;
@@ -627,6 +908,135 @@ TEST_F(OnDiskDbWithFileFixture, open_emtpy_rodb)
         ro_db.get({}, 0).assume_error(), DbError::version_no_longer_exist);
 }
 
+TEST_F(OnDiskDbWithFileFixture, read_only_db_woken_by_new_version)
+{
+    AsyncIOContext io_ctx{ReadOnlyOnDiskDbConfig{.dbname_paths = {dbname}}};
+    Db ro_db{io_ctx};
+    auto const prefix = 0x00_hex;
+    auto const &kv = fixed_updates::kv;
+    uint64_t const num_blocks = 20;
+
+    // nothing is written, so the wait times out
+    EXPECT_EQ(
+        ro_db.wait_for_latest_version_change(
+            INVALID_BLOCK_NUM, std::chrono::milliseconds(1)),
+        INVALID_BLOCK_NUM);
+
+    std::thread reader([&] {
+        uint64_t seen = INVALID_BLOCK_NUM;
+        while (seen != num_blocks - 1) {
+            auto const latest = ro_db.wait_for_latest_version_change(
+                seen, std::chrono::seconds(10));
+            ASSERT_NE(latest, seen);
+            ASSERT_TRUE(seen == INVALID_BLOCK_NUM || latest > seen);
+            // the root of the new version is already loaded
+            EXPECT_TRUE(ro_db.root().is_valid());
+            auto const res = ro_db.get(prefix + kv[0].first, latest);
+            ASSERT_TRUE(res.has_value());
+            EXPECT_EQ(res.value(), kv[0].second);
+            seen = latest;
+        }
+    });
+    for (uint64_t block_id = 0; block_id < num_blocks; ++block_id) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        upsert_updates_flat_list(
+            db, prefix, block_id, make_update(kv[0].first, kv[0].second));
+    }
+    reader.join();
+}
+
+TEST_F(ROOnDiskWithFileFixture, wait_for_latest_version_change)
+{
+    uint64_t const next_version = num_blocks;
+    EXPECT_EQ(
+        ro_db.wait_for_latest_version_change(
+            num_blocks - 1, std::chrono::milliseconds(1)),
+        num_blocks - 1);
+
+    // The wait blocks its thread, so it runs on a thread of its own, and
+    // the pool keeps serving reads meanwhile
+    uint64_t woken = INVALID_BLOCK_NUM;
+    std::thread waiter([&] {
+        woken = ro_db.wait_for_latest_version_change(
+            num_blocks - 1, std::chrono::seconds(10));
+    });
+    boost::fibers::promise<void> read;
+    pool.submit(0, [&] {
+        EXPECT_TRUE(ro_db.find({}, num_blocks - 1).has_value());
+        read.set_value();
+    });
+    read.get_future().get();
+
+    auto [kv_alloc, updates_alloc] =
+        prepare_random_updates(keys_per_block, next_version * keys_per_block);
+    UpdateList ls;
+    for (auto &u : updates_alloc) {
+        ls.push_front(u);
+    }
+    db.upsert(std::move(ls), next_version);
+    waiter.join();
+    EXPECT_EQ(woken, next_version);
+
+    boost::fibers::promise<void> done;
+    pool.submit(0, [&] {
+        auto const key = keccak_int_to_string(next_version * keys_per_block);
+        auto const res = ro_db.find(key, next_version);
+        ASSERT_TRUE(res.has_value());
+        EXPECT_EQ(res.value().node->value(), key);
+        done.set_value();
+    });
+    done.get_future().get();
+}
+
+TEST_F(OnDiskDbWithFileFixture, read_only_dbs_share_node_cache)
+{
+    unsigned const keys_per_block = 10;
+    uint64_t const num_blocks = 100;
+    for (unsigned b = 0; b < num_blocks; ++b) {
+        auto [kv_alloc, updates_alloc] =
+            prepare_random_updates(keys_per_block, b * keys_per_block);
+        UpdateList ls;
+        for (auto &u : updates_alloc) {
+            ls.push_front(u);
+        }
+        db.upsert(std::move(ls), b);
+    }
+    auto const shared_path = create_temp_file(0);
+    auto unshared = monad::make_scope_exit(
+        [&]() noexcept { std::filesystem::remove(shared_path); });
+    ReadOnlyOnDiskDbConfig const ro_config{
+        .dbname_paths = {dbname},
+        .node_lru_max_mem = 10 * NodeCache::AVERAGE_NODE_SIZE,
+        .shared_node_cache_path = shared_path,
+        .shared_node_cache_max_mem = 16 << 20};
+    monad::fiber::PriorityPool pool(1, 4);
+
+    auto const find_all = [&](RODb &ro_db) {
+        boost::fibers::promise<void> done;
+        pool.submit(0, [&] {
+            for (unsigned i = 0; i < num_blocks * keys_per_block; ++i) {
+                auto const kv_bytes = keccak_int_to_string(i);
+                auto const res = ro_db.find(kv_bytes, num_blocks - 1);
+                ASSERT_TRUE(res.has_value());
+                EXPECT_EQ(res.value().node->value(), kv_bytes);
+            }
+            done.set_value();
+        });
+        done.get_future().get();
+    };
+    {
+        RODb first{ro_config};
+        find_all(first);
+    }
+    SharedNodeCache const shared{shared_path, 0};
+    auto const occupied = shared.occupied();
+    EXPECT_GT(occupied, 0);
+    // the second opener finds everything through what the first cached
+    RODb second{ro_config};
+    find_all(second);
+    EXPECT_EQ(shared.occupied(), occupied);
+}
+
 TEST_F(OnDiskDbWithFileFixture, DISABLED_read_only_db_concurrent)
 {
     // Have one thread make forward progress by updating new versions and
@@ -1171,6 +1581,48 @@ TEST(DbTest, out_of_order_upserts_to_nonexist_earlier_version)
     }
 }
 
+TEST(DbTest, compressed_slow_list_nodes_read_back)
+{
+    auto const dbname = create_temp_file(2); // 2Gb db
+    auto undb = monad::make_scope_exit(
+        [&]() noexcept { std::filesystem::remove(dbname); });
+    StateMachineAlwaysMerkle machine{};
+    OnDiskDbConfig config{
+        .compaction = true,
+        .slow_list_compression_level = 3,
+        .sq_thread_cpu{std::nullopt},
+        .dbname_paths = {dbname},
+        .fixed_history_length = DBTEST_HISTORY_LENGTH};
+    Db db{machine, config};
+
+    AsyncIOContext io_ctx{ReadOnlyOnDiskDbConfig{.dbname_paths = {dbname}}};
+    Db rodb{io_ctx};
+
+    // Highly compressible values, all written to the slow list
+    constexpr unsigned total_keys = 1000;
+    std::vector<monad::byte_string> keys;
+    std::vector<monad::byte_string> values;
+    std::vector<Update> updates;
+    keys.reserve(total_keys);
+    values.reserve(total_keys);
+    updates.reserve(total_keys);
+    UpdateList ls;
+    for (unsigned i = 0; i < total_keys; ++i) {
+        auto &key = keys.emplace_back(32, 0);
+        std::memcpy(key.data(), &i, sizeof(i));
+        auto const &value =
+            values.emplace_back(256, static_cast<unsigned char>(i));
+        ls.push_front(updates.emplace_back(make_update(key, value)));
+    }
+    db.upsert(std::move(ls), 0, true, false);
+
+    for (unsigned i = 0; i < total_keys; ++i) {
+        auto const res = rodb.get(keys[i], 0);
+        ASSERT_TRUE(res.has_value());
+        EXPECT_EQ(res.value(), values[i]);
+    }
+}
+
 TEST(DbTest, out_of_order_upserts_with_compaction)
 {
     auto const dbname = create_temp_file(3); // 3Gb db
@@ -1934,6 +2386,53 @@ TEST_F(OnDiskDbWithFileFixture, copy_trie_to_different_version_modify_state)
     }
 }
 
+TEST_F(OnDiskDbWithFileFixture, copy_trie_and_move_version_async)
+{
+    std::deque<monad::byte_string> kv_alloc;
+    for (size_t i = 0; i < 3; ++i) {
+        kv_alloc.emplace_back(keccak_int_to_string(i));
+    }
+    auto const prefix = 0x0012_hex;
+    auto const dest_prefix = 0x001233_hex;
+    auto const last_prefix = 0x10_hex;
+    uint64_t const block_id = 0;
+    upsert_updates_flat_list(
+        db, prefix, block_id, make_update(kv_alloc[0], kv_alloc[0]));
+
+    // the prefixes need not outlive the call, and upsert waits for the copy
+    {
+        monad::byte_string const src{prefix};
+        monad::byte_string const dest{dest_prefix};
+        db.copy_trie_async(block_id, src, block_id + 1, dest, false);
+    }
+    upsert_updates_flat_list(
+        db, dest_prefix, block_id + 1, make_update(kv_alloc[1], kv_alloc[1]));
+    auto res = db.get(dest_prefix + kv_alloc[0], block_id + 1);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res.value(), kv_alloc[0]);
+    res = db.get(dest_prefix + kv_alloc[1], block_id + 1);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res.value(), kv_alloc[1]);
+
+    // a copy within the version, then a move, each waited for explicitly
+    db.copy_trie_async(block_id + 1, dest_prefix, block_id + 1, last_prefix);
+    db.wait_for_trie_ops();
+    res = db.get(last_prefix + kv_alloc[1], block_id + 1);
+    ASSERT_TRUE(res.has_value());
+    EXPECT_EQ(res.value(), kv_alloc[1]);
+
+    db.move_trie_version_forward_async(block_id + 1, block_id + 10);
+    db.wait_for_trie_ops();
+    EXPECT_EQ(db.get_latest_version(), block_id + 10);
+    upsert_updates_flat_list(
+        db, last_prefix, block_id + 10, make_update(kv_alloc[2], kv_alloc[2]));
+    for (auto const &key : kv_alloc) {
+        res = db.get(last_prefix + key, block_id + 10);
+        ASSERT_TRUE(res.has_value());
+        EXPECT_EQ(res.value(), key);
+    }
+}
+
 TEST_F(OnDiskDbWithFileFixture, history_ring_buffer_wrap_around)
 {
     auto const prefix = 0x0012_hex;
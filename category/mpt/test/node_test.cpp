@@ -15,6 +15,7 @@
 
 #include <category/core/byte_string.hpp>
 #include <category/core/hex_literal.hpp>
+#include <category/core/unaligned.hpp>
 #include <category/mpt/compute.hpp>
 #include <category/mpt/nibbles_view.hpp>
 #include <category/mpt/node.hpp>
@@ -26,6 +27,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <optional>
+#include <random>
 #include <span>
 
 using namespace monad::mpt;
@@ -185,3 +187,41 @@ TEST(NodeTest, super_large_node)
         node->get_disk_size(),
         value_len + sizeof(Node) + Node::disk_size_bytes);
 }
+
+TEST(NodeTest, compressed_disk_encoding_round_trips)
+{
+    auto const path = 0x1234567812345678_hex;
+    monad::byte_string const value(1000, 0xab);
+    Node::UniquePtr node{make_node(0, {}, NibblesView{path}, value, {}, 5)};
+    auto const disk_size = node->get_disk_size();
+
+    auto const encoded = compress_node_for_disk(*node, 3);
+    ASSERT_FALSE(encoded.empty());
+    EXPECT_LT(encoded.size(), disk_size);
+    auto const header = monad::unaligned_load<uint32_t>(encoded.data());
+    EXPECT_TRUE(header & Node::compressed_disk_size_bit);
+    EXPECT_EQ(header & ~Node::compressed_disk_size_bit, encoded.size());
+
+    // Trailing bytes beyond the compressed node are ignored, as they are
+    // when reading whole disk pages
+    monad::byte_string buffer = encoded;
+    buffer.resize(encoded.size() + 100, 0xff);
+    auto const decoded =
+        deserialize_node_from_buffer<Node>(buffer.data(), buffer.size());
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(decoded->get_disk_size(), disk_size);
+    EXPECT_EQ(decoded->path_nibble_view(), NibblesView{path});
+    EXPECT_EQ(decoded->value(), value);
+    EXPECT_EQ(decoded->version, 5);
+}
+
+TEST(NodeTest, incompressible_node_is_not_compressed)
+{
+    std::mt19937 rng{42};
+    monad::byte_string value(256, 0);
+    for (auto &c : value) {
+        c = static_cast<unsigned char>(rng());
+    }
+    Node::UniquePtr node{make_node(0, {}, {}, value, {}, 0)};
+    EXPECT_TRUE(compress_node_for_disk(*node, 3).empty());
+}
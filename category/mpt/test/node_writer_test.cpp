@@ -13,16 +13,29 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include "test_fixtures_base.hpp"
+
 #include <category/core/assert.h>
 
 #include <category/async/config.hpp>
+#include <category/async/io.hpp>
+#include <category/async/storage_pool.hpp>
+#include <category/core/byte_string.hpp>
+#include <category/core/small_prng.hpp>
 #include <category/core/test_util/gtest_signal_stacktrace_printer.hpp> // NOLINT
 #include <category/mpt/config.hpp>
 #include <category/mpt/node.hpp>
 #include <category/mpt/trie.hpp>
+#include <category/mpt/update.hpp>
 
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+#include <unistd.h>
 
 using namespace MONAD_MPT_NAMESPACE;
 using namespace MONAD_ASYNC_NAMESPACE;
@@ -38,6 +51,45 @@ namespace
         auto node = make_node(0, {}, {}, value, {}, 0);
         return node;
     }
+
+    void append_dummy_bytes(
+        UpdateAuxImpl &aux, node_writer_unique_ptr_type &node_writer,
+        size_t bytes)
+    {
+        while (bytes > 0) {
+            auto &sender = node_writer->sender();
+            auto const remaining_bytes = sender.remaining_buffer_bytes();
+            if (bytes <= remaining_bytes) {
+                sender.advance_buffer_append(bytes);
+                return;
+            }
+            if (remaining_bytes > 0) {
+                sender.advance_buffer_append(remaining_bytes);
+                bytes -= remaining_bytes;
+            }
+
+            auto new_node_writer = replace_node_writer(aux, node_writer);
+            MONAD_ASSERT(new_node_writer);
+            node_writer->initiate();
+            // shall be recycled by the i/o receiver
+            node_writer.release();
+            node_writer = std::move(new_node_writer);
+        }
+    }
+
+    std::filesystem::path make_temp_file(size_t const size)
+    {
+        char temppath[] = "monad_test_fixture_XXXXXX";
+        int const fd = mkstemp(temppath);
+        if (-1 == fd) {
+            abort();
+        }
+        if (-1 == ftruncate(fd, static_cast<off_t>(size))) {
+            abort();
+        }
+        ::close(fd);
+        return temppath;
+    }
 }
 
 template <
@@ -63,16 +115,8 @@ struct NodeWriterTestBase : public ::testing::Test
             if constexpr (use_anonoymous_inode) {
                 return storage_pool(use_anonymous_inode_tag{}, flags);
             }
-            char temppath[] = "monad_test_fixture_XXXXXX";
-            int const fd = mkstemp(temppath);
-            if (-1 == fd) {
-                abort();
-            }
-            if (-1 == ftruncate(fd, (3 + num_chunks) * chunk_size + 24576)) {
-                abort();
-            }
-            ::close(fd);
-            std::filesystem::path temppath2(temppath);
+            auto temppath2 =
+                make_temp_file((3 + num_chunks) * chunk_size + 24576);
             return MONAD_ASYNC_NAMESPACE::storage_pool(
                 {&temppath2, 1},
                 MONAD_ASYNC_NAMESPACE::storage_pool::mode::create_if_needed,
@@ -101,25 +145,7 @@ struct NodeWriterTestBase : public ::testing::Test
     void node_writer_append_dummy_bytes(
         node_writer_unique_ptr_type &node_writer, size_t bytes)
     {
-        while (bytes > 0) {
-            auto &sender = node_writer->sender();
-            auto const remaining_bytes = sender.remaining_buffer_bytes();
-            if (bytes <= remaining_bytes) {
-                sender.advance_buffer_append(bytes);
-                return;
-            }
-            if (remaining_bytes > 0) {
-                sender.advance_buffer_append(remaining_bytes);
-                bytes -= remaining_bytes;
-            }
-
-            auto new_node_writer = replace_node_writer(aux, node_writer);
-            MONAD_ASSERT(new_node_writer);
-            node_writer->initiate();
-            // shall be recycled by the i/o receiver
-            node_writer.release();
-            node_writer = std::move(new_node_writer);
-        }
+        append_dummy_bytes(aux, node_writer, bytes);
     }
 
     uint32_t get_writer_chunk_id(node_writer_unique_ptr_type &node_writer)
@@ -231,3 +257,246 @@ TEST_F(NodeWriterTest, write_node_at_new_chunk)
     EXPECT_EQ(
         node_offset_chunk_count, get_writer_chunk_count(aux.node_writer_fast));
 }
+
+TEST_F(NodeWriterTest, pipelined_writer_submits_aligned_partial_buffers)
+{
+    aux.set_write_queue_depth(1);
+    auto const chunk_id = get_writer_chunk_id(aux.node_writer_fast);
+    auto const alignment = io.chunk_write_alignment(chunk_id);
+    EXPECT_TRUE(std::has_single_bit(alignment));
+    EXPECT_GE(alignment, DISK_PAGE_SIZE);
+
+    // An odd node size so nodes straddle the aligned cuts, and far fewer
+    // bytes than fill a write buffer
+    unsigned const node_disk_size = 1000;
+    unsigned const num_nodes = 4096;
+    auto const value_size =
+        node_disk_size - sizeof(Node) - Node::disk_size_bytes;
+    for (unsigned i = 0; i < num_nodes; ++i) {
+        auto node = make_node(
+            0, {}, {}, monad::byte_string(value_size, uint8_t(i)), {}, 0);
+        auto const node_offset = async_write_node_set_spare(aux, *node, true);
+        EXPECT_EQ(node_offset.id, chunk_id);
+        EXPECT_EQ(node_offset.offset, i * node_disk_size);
+    }
+    // The writer only moves on from its first buffer by submitting early
+    auto const &sender = aux.node_writer_fast->sender();
+    auto const cut = sender.offset().offset;
+    EXPECT_GT(cut, 0);
+    EXPECT_EQ(cut % alignment, 0);
+    EXPECT_EQ(
+        cut + sender.written_buffer_bytes(), num_nodes * node_disk_size);
+
+    // Every node wholly before the cut is on disk
+    io.wait_until_done();
+    auto chunk = pool.activate_chunk(pool.seq, chunk_id);
+    auto const fd = chunk->read_fd();
+    auto *buffer = (unsigned char *)aligned_alloc(DISK_PAGE_SIZE, cut);
+    ASSERT_NE(buffer, nullptr);
+    ASSERT_EQ(
+        ::pread(fd.first, buffer, cut, static_cast<off_t>(fd.second)),
+        static_cast<ssize_t>(cut));
+    for (unsigned i = 0; (i + 1) * node_disk_size <= cut; ++i) {
+        auto const node = deserialize_node_from_buffer<Node>(
+            buffer + i * node_disk_size, node_disk_size);
+        ASSERT_EQ(node->value().size(), value_size);
+        EXPECT_EQ(node->value()[0], uint8_t(i));
+    }
+    ::free(buffer);
+}
+
+// A low latency device and a capacity device, the fast list kept on the
+// former and the slow list on the latter as writers move to new chunks
+struct TieredNodeWriterTest : public ::testing::Test
+{
+    static constexpr size_t chunk_size = 1 << 24;
+    static constexpr size_t chunks_per_device = 8;
+    static constexpr uint64_t history_len = 32;
+    static constexpr size_t device_size =
+        (3 + chunks_per_device) * chunk_size + 24576;
+
+    std::filesystem::path paths[2];
+    storage_pool pool;
+    monad::io::Ring ring1;
+    monad::io::Ring ring2;
+    monad::io::Buffers rwbuf;
+    AsyncIO io;
+    UpdateAux<> aux;
+
+    TieredNodeWriterTest()
+        : paths{make_temp_file(device_size), make_temp_file(device_size)}
+        , pool{[&] {
+            storage_pool::creation_flags flags;
+            flags.chunk_capacity = std::countr_zero(chunk_size);
+            storage_pool ret(
+                paths, storage_pool::mode::create_if_needed, flags);
+            ret.set_device_tier(0, storage_pool::device_tier::low_latency);
+            ret.set_device_tier(1, storage_pool::device_tier::capacity);
+            return ret;
+        }()}
+        , ring1{monad::io::RingConfig{2}}
+        , ring2{monad::io::RingConfig{4}}
+        , rwbuf{monad::io::make_buffers_for_segregated_read_write(
+              ring1, ring2, 2, 4, AsyncIO::MONAD_IO_BUFFERS_READ_SIZE,
+              AsyncIO::MONAD_IO_BUFFERS_WRITE_SIZE)}
+        , io{pool, rwbuf}
+        , aux{&io, history_len}
+    {
+    }
+
+    ~TieredNodeWriterTest()
+    {
+        for (auto const &path : paths) {
+            std::filesystem::remove(path);
+        }
+    }
+
+    storage_pool::device_tier
+    writer_tier(node_writer_unique_ptr_type &node_writer)
+    {
+        return pool.chunk_tier(
+            storage_pool::seq, node_writer->sender().offset().id);
+    }
+
+    bool is_low_latency(
+        MONAD_MPT_NAMESPACE::detail::db_metadata::chunk_info_t const *ci) const
+    {
+        return pool.chunk_tier(
+                   storage_pool::seq, ci->index(aux.db_metadata())) ==
+               storage_pool::device_tier::low_latency;
+    }
+
+    bool fast_list_is_low_latency() const
+    {
+        for (auto const *ci = aux.db_metadata()->fast_list_begin();
+             ci != nullptr;
+             ci = ci->next(aux.db_metadata())) {
+            if (!is_low_latency(ci)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Every other chunk on the free list precedes every low latency one
+    bool free_list_is_partitioned() const
+    {
+        bool seen_low_latency = false;
+        for (auto const *ci = aux.db_metadata()->free_list_begin();
+             ci != nullptr;
+             ci = ci->next(aux.db_metadata())) {
+            if (is_low_latency(ci)) {
+                seen_low_latency = true;
+            }
+            else if (seen_low_latency) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+TEST_F(TieredNodeWriterTest, writers_roll_over_to_chunks_of_their_tier)
+{
+    ASSERT_TRUE(pool.is_tiered());
+    EXPECT_EQ(
+        writer_tier(aux.node_writer_fast),
+        storage_pool::device_tier::low_latency);
+    EXPECT_EQ(
+        writer_tier(aux.node_writer_slow), storage_pool::device_tier::capacity);
+
+    // Starting mid chunk, each append moves a writer on by exactly one chunk,
+    // until its tier has one free chunk left. The slow list takes its chunks
+    // from the beginning of the free list, the fast list from the end.
+    append_dummy_bytes(aux, aux.node_writer_fast, 1024);
+    append_dummy_bytes(aux, aux.node_writer_slow, 1024);
+    for (size_t i = 0; i < chunks_per_device - 2; ++i) {
+        append_dummy_bytes(aux, aux.node_writer_fast, chunk_size);
+        EXPECT_EQ(
+            writer_tier(aux.node_writer_fast),
+            storage_pool::device_tier::low_latency)
+            << i;
+        append_dummy_bytes(aux, aux.node_writer_slow, chunk_size);
+        EXPECT_EQ(
+            writer_tier(aux.node_writer_slow),
+            storage_pool::device_tier::capacity)
+            << i;
+    }
+    EXPECT_EQ(aux.num_chunks(UpdateAuxImpl::chunk_list::free), 2);
+    io.wait_until_done();
+}
+
+TEST_F(
+    TieredNodeWriterTest,
+    compaction_and_rewind_keep_fast_list_on_low_latency_device)
+{
+    // Rewriting the same keys every version keeps the live data small, so
+    // compaction soon frees the chunk the fast list started on
+    monad::small_prng rand;
+    std::vector<monad::byte_string> keys(1000, monad::byte_string(32, 0));
+    for (auto &key : keys) {
+        for (size_t n = 0; n < key.size(); n += 4) {
+            *(uint32_t *)(key.data() + n) = rand();
+        }
+    }
+    monad::test::StateMachineAlwaysMerkle sm;
+    Node::UniquePtr root;
+    uint64_t version = 0;
+    auto const first_fast_chunk = aux.db_metadata()->fast_list.begin;
+    while (aux.db_metadata()->fast_list.begin == first_fast_chunk) {
+        ASSERT_LT(version, 2000u);
+        monad::byte_string const value(32, uint8_t(version));
+        std::vector<Update> updates;
+        updates.reserve(keys.size());
+        UpdateList update_ls;
+        for (auto const &key : keys) {
+            update_ls.push_front(updates.emplace_back(make_update(key, value)));
+        }
+        root = aux.do_update(
+            std::move(root), sm, std::move(update_ls), version++, true);
+        ASSERT_TRUE(fast_list_is_low_latency()) << version;
+        ASSERT_TRUE(free_list_is_partitioned()) << version;
+    }
+
+    // Slow list writes past the offsets in the metadata, as a crash leaves
+    // them, are discarded by a rewind which frees their capacity chunks
+    root.reset();
+    append_dummy_bytes(aux, aux.node_writer_slow, 2 * chunk_size);
+    io.wait_until_done();
+    aux.rewind_to_version(version - 2);
+    EXPECT_TRUE(free_list_is_partitioned());
+
+    for (size_t i = 0; i < 2; ++i) {
+        append_dummy_bytes(aux, aux.node_writer_fast, chunk_size);
+        EXPECT_EQ(
+            writer_tier(aux.node_writer_fast),
+            storage_pool::device_tier::low_latency)
+            << i;
+        append_dummy_bytes(aux, aux.node_writer_slow, chunk_size);
+        EXPECT_EQ(
+            writer_tier(aux.node_writer_slow),
+            storage_pool::device_tier::capacity)
+            << i;
+    }
+    EXPECT_TRUE(fast_list_is_low_latency());
+    io.wait_until_done();
+}
+
+TEST_F(TieredNodeWriterTest, reopening_with_other_tiers_partitions_free_list)
+{
+    // As if the pool had been created untiered or tiered the other way round
+    aux.unset_io();
+    pool.set_device_tier(0, storage_pool::device_tier::capacity);
+    pool.set_device_tier(1, storage_pool::device_tier::low_latency);
+    aux.set_io(&io, history_len);
+    EXPECT_TRUE(free_list_is_partitioned());
+
+    append_dummy_bytes(aux, aux.node_writer_fast, chunk_size);
+    EXPECT_EQ(
+        writer_tier(aux.node_writer_fast),
+        storage_pool::device_tier::low_latency);
+    append_dummy_bytes(aux, aux.node_writer_slow, chunk_size);
+    EXPECT_EQ(
+        writer_tier(aux.node_writer_slow), storage_pool::device_tier::capacity);
+    io.wait_until_done();
+}
@@ -0,0 +1,163 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+#include <category/async/util.hpp>
+#include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
+#include <category/mpt/node.hpp>
+#include <category/mpt/shared_node_cache.hpp>
+#include <category/mpt/util.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace monad::mpt;
+
+namespace
+{
+    struct SharedNodeCacheTest : public ::testing::Test
+    {
+        std::filesystem::path const path{[] {
+            std::filesystem::path const filename{
+                MONAD_ASYNC_NAMESPACE::working_temporary_directory() /
+                "monad_shared_node_cache_test_XXXXXX"};
+            int const fd = ::mkstemp((char *)filename.native().data());
+            MONAD_ASSERT(fd != -1);
+            ::close(fd);
+            return filename;
+        }()};
+
+        ~SharedNodeCacheTest()
+        {
+            std::filesystem::remove(path);
+        }
+    };
+
+    Node::UniquePtr make_leaf(uint32_t const v, size_t const value_size = 84)
+    {
+        monad::byte_string value(value_size, 0);
+        memcpy(value.data(), &v, sizeof(v));
+        return make_node(0, {}, {}, std::move(value), 0, 0);
+    }
+
+    uint32_t leaf_value(CacheNode const &node)
+    {
+        uint32_t v;
+        memcpy(&v, node.value().data(), sizeof(v));
+        return v;
+    }
+}
+
+TEST_F(SharedNodeCacheTest, shared_between_openers)
+{
+    SharedNodeCache cache{path, 1 << 20};
+    EXPECT_EQ(cache.occupied(), 0);
+    virtual_chunk_offset_t const offset{1, 4096, 1};
+    EXPECT_EQ(cache.find(offset, 7), nullptr);
+    auto const leaf = make_leaf(0xbeef);
+    cache.insert(offset, 7, *leaf);
+    EXPECT_EQ(cache.occupied(), 1);
+
+    auto const found = cache.find(offset, 7);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->get_mem_size(), leaf->get_mem_size());
+    EXPECT_EQ(leaf_value(*found), 0xbeef);
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 1);
+
+    // a rewind of the database hides everything cached before it
+    EXPECT_EQ(cache.find(offset, 8), nullptr);
+    // as does the same offset in another list or chunk
+    EXPECT_EQ(cache.find(virtual_chunk_offset_t{1, 4096, 0}, 7), nullptr);
+    EXPECT_EQ(cache.find(virtual_chunk_offset_t{2, 4096, 1}, 7), nullptr);
+
+    // another opener, which keeps the capacity it was created with
+    SharedNodeCache other{path, 64 << 20};
+    EXPECT_EQ(other.capacity(), cache.capacity());
+    auto const found_by_other = other.find(offset, 7);
+    ASSERT_NE(found_by_other, nullptr);
+    EXPECT_EQ(leaf_value(*found_by_other), 0xbeef);
+}
+
+TEST_F(SharedNodeCacheTest, clock_eviction_keeps_referenced_nodes)
+{
+    // a single set
+    SharedNodeCache cache{
+        path, SharedNodeCache::SLOT_SIZE * SharedNodeCache::WAYS};
+    ASSERT_EQ(cache.capacity(), SharedNodeCache::WAYS);
+    for (uint32_t i = 0; i < SharedNodeCache::WAYS; ++i) {
+        cache.insert(virtual_chunk_offset_t{1, i * 64, 1}, 0, *make_leaf(i));
+    }
+    EXPECT_EQ(cache.occupied(), SharedNodeCache::WAYS);
+    // only the first node is hit, so it must survive filling the set again
+    ASSERT_NE(cache.find(virtual_chunk_offset_t{1, 0, 1}, 0), nullptr);
+    for (uint32_t i = SharedNodeCache::WAYS; i < 2 * SharedNodeCache::WAYS - 1;
+         ++i) {
+        cache.insert(virtual_chunk_offset_t{1, i * 64, 1}, 0, *make_leaf(i));
+    }
+    EXPECT_EQ(cache.occupied(), SharedNodeCache::WAYS);
+    auto const first = cache.find(virtual_chunk_offset_t{1, 0, 1}, 0);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(leaf_value(*first), 0);
+    for (uint32_t i = 1; i < SharedNodeCache::WAYS; ++i) {
+        EXPECT_EQ(cache.find(virtual_chunk_offset_t{1, i * 64, 1}, 0), nullptr);
+    }
+}
+
+TEST_F(SharedNodeCacheTest, node_larger_than_a_slot_is_not_cached)
+{
+    SharedNodeCache cache{path, 1 << 20};
+    auto const leaf = make_leaf(1, SharedNodeCache::max_node_disk_size);
+    ASSERT_GT(leaf->get_disk_size(), SharedNodeCache::max_node_disk_size);
+    cache.insert(virtual_chunk_offset_t{1, 0, 1}, 0, *leaf);
+    EXPECT_EQ(cache.occupied(), 0);
+    EXPECT_EQ(cache.find(virtual_chunk_offset_t{1, 0, 1}, 0), nullptr);
+}
+
+TEST_F(SharedNodeCacheTest, incompatible_file_is_replaced_not_resized)
+{
+    SharedNodeCache cache{path, 1 << 20};
+    virtual_chunk_offset_t const offset{1, 4096, 1};
+    cache.insert(offset, 0, *make_leaf(0xbeef));
+
+    // as if laid out by a different build
+    {
+        int const fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        ASSERT_NE(fd, -1);
+        char const magic[8] = {};
+        ASSERT_EQ(
+            ::pwrite(fd, magic, sizeof(magic), 0), ssize_t(sizeof(magic)));
+        ::close(fd);
+    }
+    struct stat before;
+    ASSERT_EQ(::stat(path.c_str(), &before), 0);
+    SharedNodeCache other{path, 1 << 20};
+    struct stat after;
+    ASSERT_EQ(::stat(path.c_str(), &after), 0);
+    EXPECT_NE(after.st_ino, before.st_ino);
+    EXPECT_EQ(other.find(offset, 0), nullptr);
+
+    // the existing mapping is untouched
+    auto const found = cache.find(offset, 0);
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(leaf_value(*found), 0xbeef);
+}
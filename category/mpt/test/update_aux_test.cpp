@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 
 #include <chrono>
+#include <cstring>
 #include <thread>
 
 #include <category/async/config.hpp>
@@ -197,3 +198,52 @@ TEST(update_aux_test, root_offsets_fast_slow)
             "Detected corruption");
     }
 }
+
+TEST(update_aux_test, slow_list_compression_marks_db)
+{
+    testing::FLAGS_gtest_death_test_style = "threadsafe";
+
+    monad::async::storage_pool pool(monad::async::use_anonymous_inode_tag{});
+    monad::io::Ring ring1;
+    monad::io::Ring ring2;
+    monad::io::Buffers testbuf =
+        monad::io::make_buffers_for_segregated_read_write(
+            ring1,
+            ring2,
+            2,
+            4,
+            monad::async::AsyncIO::MONAD_IO_BUFFERS_READ_SIZE,
+            monad::async::AsyncIO::MONAD_IO_BUFFERS_WRITE_SIZE);
+    monad::async::AsyncIO testio(pool, testbuf);
+    {
+        monad::mpt::UpdateAux aux_writer{};
+        aux_writer.set_io(&testio, AUX_TEST_HISTORY_LENGTH);
+        aux_writer.set_slow_list_compression_level(0);
+        EXPECT_FALSE(aux_writer.db_metadata()->slow_list_compressed());
+
+        // Code from before compression only accepts MAGIC
+        aux_writer.set_slow_list_compression_level(3);
+        EXPECT_TRUE(aux_writer.db_metadata()->slow_list_compressed());
+        EXPECT_NE(
+            0,
+            memcmp(
+                aux_writer.db_metadata()->magic,
+                monad::mpt::detail::db_metadata::MAGIC,
+                monad::mpt::detail::db_metadata::MAGIC_STRING_LEN));
+    }
+    {
+        // reopens with compression enabled
+        monad::mpt::UpdateAux aux_writer{};
+        aux_writer.set_io(&testio, AUX_TEST_HISTORY_LENGTH);
+        EXPECT_TRUE(aux_writer.db_metadata()->slow_list_compressed());
+        aux_writer.set_slow_list_compression_level(1);
+    }
+    {
+        // but not with it disabled
+        monad::mpt::UpdateAux aux_writer{};
+        aux_writer.set_io(&testio, AUX_TEST_HISTORY_LENGTH);
+        EXPECT_DEATH(
+            aux_writer.set_slow_list_compression_level(0),
+            "must be opened with slow list compression enabled");
+    }
+}
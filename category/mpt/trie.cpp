@@ -1581,7 +1581,9 @@ node_writer_unique_ptr_type replace_node_writer_to_start_at_new_chunk(
     auto *sender = &node_writer->sender();
     bool const in_fast_list =
         aux.db_metadata()->at(sender->offset().id)->in_fast_list;
-    auto const *ci_ = aux.db_metadata()->free_list_end();
+    auto const *ci_ = aux.next_free_chunk_for(
+        in_fast_list ? UpdateAuxImpl::chunk_list::fast
+                     : UpdateAuxImpl::chunk_list::slow);
     MONAD_ASSERT(ci_ != nullptr); // we are out of free blocks!
     auto idx = ci_->index(aux.db_metadata());
     chunk_offset_t const offset_of_new_writer{idx, 0};
@@ -1653,6 +1655,14 @@ node_writer_unique_ptr_type replace_node_writer_to_start_at_new_chunk(
 
 node_writer_unique_ptr_type replace_node_writer(
     UpdateAuxImpl &aux, node_writer_unique_ptr_type const &node_writer)
+{
+    return replace_node_writer(
+        aux, node_writer, node_writer->sender().written_buffer_bytes());
+}
+
+node_writer_unique_ptr_type replace_node_writer(
+    UpdateAuxImpl &aux, node_writer_unique_ptr_type const &node_writer,
+    size_t const bytes_written)
 {
     // Can't use add_to_offset(), because it asserts if we go past the
     // capacity
@@ -1660,7 +1670,7 @@ node_writer_unique_ptr_type replace_node_writer(
     bool const in_fast_list =
         aux.db_metadata()->at(offset_of_next_writer.id)->in_fast_list;
     file_offset_t offset = offset_of_next_writer.offset;
-    offset += node_writer->sender().written_buffer_bytes();
+    offset += bytes_written;
     offset_of_next_writer.offset = offset & chunk_offset_t::max_offset;
     auto const chunk_capacity =
         aux.io->chunk_capacity(offset_of_next_writer.id);
@@ -1670,7 +1680,9 @@ node_writer_unique_ptr_type replace_node_writer(
     if (offset == chunk_capacity) {
         // If after the current write buffer we're hitting chunk capacity, we
         // replace writer to the start of next chunk.
-        ci_ = aux.db_metadata()->free_list_end();
+        ci_ = aux.next_free_chunk_for(
+            in_fast_list ? UpdateAuxImpl::chunk_list::fast
+                         : UpdateAuxImpl::chunk_list::slow);
         MONAD_ASSERT(ci_ != nullptr); // we are out of free blocks!
         idx = ci_->index(aux.db_metadata());
         offset_of_next_writer.id = idx & 0xfffffU;
@@ -1689,7 +1701,7 @@ node_writer_unique_ptr_type replace_node_writer(
         return {};
     }
     if (ci_ != nullptr) {
-        MONAD_DEBUG_ASSERT(ci_ == aux.db_metadata()->free_list_end());
+        MONAD_DEBUG_ASSERT(!ci_->in_fast_list && !ci_->in_slow_list);
         aux.remove(idx);
         aux.append(
             in_fast_list ? UpdateAuxImpl::chunk_list::fast
@@ -1699,15 +1711,69 @@ node_writer_unique_ptr_type replace_node_writer(
     return ret;
 }
 
-// return physical offset the node is written at
-async_write_node_result async_write_node(
+// Smallest write the pipelined node writer will submit before its buffer is
+// full
+static constexpr size_t EARLY_WRITE_MIN_BYTES = 1024 * 1024;
+
+/* When pipelining is enabled and fewer writes than the write queue depth are
+in flight, submit what the node writer has buffered so far instead of waiting
+for its buffer to fill. Writes are thus small while the device keeps up and
+grow towards the full buffer size as it falls behind. The write is cut at the
+device's preferred alignment, and the bytes beyond the cut are carried over
+into the replacement writer.
+*/
+static void submit_node_writer_early_if_device_idle(
+    UpdateAuxImpl &aux, node_writer_unique_ptr_type &node_writer)
+{
+    if (aux.io->writes_in_flight() >= aux.write_queue_depth()) {
+        return;
+    }
+    auto *sender = &node_writer->sender();
+    if (sender->remaining_buffer_bytes() == 0) {
+        // About to be submitted in full anyway
+        return;
+    }
+    auto const offset = sender->offset();
+    auto const alignment =
+        file_offset_t(aux.io->chunk_write_alignment(offset.id));
+    auto const end =
+        (offset.offset + sender->written_buffer_bytes()) & ~(alignment - 1);
+    if (end < offset.offset + EARLY_WRITE_MIN_BYTES) {
+        return;
+    }
+    size_t const cut = end - offset.offset;
+    auto new_node_writer = replace_node_writer(aux, node_writer, cut);
+    if (!new_node_writer) {
+        // We reentered, try again on the next node written
+        return;
+    }
+    // Completions reaped while replacing may have appended more nodes
+    sender = &node_writer->sender();
+    auto const carried = sender->written_buffer_bytes() - cut;
+    auto const *from = sender->rewind_buffer_append(carried);
+    auto *to = new_node_writer->sender().advance_buffer_append(carried);
+    MONAD_ASSERT(from != nullptr && to != nullptr);
+    memcpy(to, from, carried);
+    node_writer->receiver().reset(cut);
+    node_writer->initiate();
+    // shall be recycled by the i/o receiver
+    node_writer.release();
+    node_writer = std::move(new_node_writer);
+}
+
+// Appends `size` bytes of on-disk node encoding, produced by `serialize(where,
+// bytes, offset)` in as many pieces as the write buffers require
+template <class Serialize>
+static async_write_node_result async_write_node_(
     UpdateAuxImpl &aux, node_writer_unique_ptr_type &node_writer,
-    Node const &node)
+    uint32_t const size, Serialize &&serialize)
 {
 retry:
     aux.io->poll_nonblocking_if_not_within_completions(1);
+    if (aux.write_queue_depth() > 0) {
+        submit_node_writer_early_if_device_idle(aux, node_writer);
+    }
     auto *sender = &node_writer->sender();
-    auto const size = node.get_disk_size();
     auto const remaining_bytes = sender->remaining_buffer_bytes();
     async_write_node_result ret{
         .offset_written_to = INVALID_OFFSET,
@@ -1719,8 +1785,7 @@ retry:
             sender->offset().add_to_offset(sender->written_buffer_bytes());
         auto *where_to_serialize = sender->advance_buffer_append(size);
         MONAD_DEBUG_ASSERT(where_to_serialize != nullptr);
-        serialize_node_to_buffer(
-            (unsigned char *)where_to_serialize, size, node, size);
+        serialize((unsigned char *)where_to_serialize, size, 0u);
     }
     else {
         auto const chunk_remaining_bytes =
@@ -1748,12 +1813,8 @@ retry:
                 (unsigned char *)node_writer->sender().advance_buffer_append(
                     bytes_to_append);
             MONAD_DEBUG_ASSERT(where_to_serialize != nullptr);
-            serialize_node_to_buffer(
-                where_to_serialize,
-                bytes_to_append,
-                node,
-                size,
-                offset_in_on_disk_node);
+            serialize(
+                where_to_serialize, bytes_to_append, offset_in_on_disk_node);
             offset_in_on_disk_node += bytes_to_append;
             new_node_writer = replace_node_writer(aux, node_writer);
             if (!new_node_writer) {
@@ -1785,12 +1846,8 @@ retry:
             auto bytes_to_append = std::min(
                 (unsigned)node_writer->sender().remaining_buffer_bytes(),
                 size - offset_in_on_disk_node);
-            serialize_node_to_buffer(
-                where_to_serialize,
-                bytes_to_append,
-                node,
-                size,
-                offset_in_on_disk_node);
+            serialize(
+                where_to_serialize, bytes_to_append, offset_in_on_disk_node);
             offset_in_on_disk_node += bytes_to_append;
             MONAD_ASSERT(offset_in_on_disk_node <= size);
             MONAD_ASSERT(
@@ -1816,6 +1873,41 @@ retry:
     return ret;
 }
 
+// return physical offset the node is written at
+async_write_node_result async_write_node(
+    UpdateAuxImpl &aux, node_writer_unique_ptr_type &node_writer,
+    Node const &node)
+{
+    auto const size = node.get_disk_size();
+    return async_write_node_(
+        aux,
+        node_writer,
+        size,
+        [&](unsigned char *const where,
+            unsigned const bytes,
+            unsigned const offset) {
+            serialize_node_to_buffer(where, bytes, node, size, offset);
+        });
+}
+
+// Writes a node already encoded for disk, e.g. by compress_node_for_disk()
+async_write_node_result async_write_encoded_node(
+    UpdateAuxImpl &aux, node_writer_unique_ptr_type &node_writer,
+    byte_string_view const encoded)
+{
+    MONAD_ASSERT(encoded.size() <= Node::max_disk_size);
+    return async_write_node_(
+        aux,
+        node_writer,
+        static_cast<uint32_t>(encoded.size()),
+        [&](unsigned char *const where,
+            unsigned const bytes,
+            unsigned const offset) {
+            MONAD_ASSERT(offset + bytes <= encoded.size());
+            memcpy(where, encoded.data() + offset, bytes);
+        });
+}
+
 // Return node's physical offset the node is written at, triedb should not
 // depend on any metadata to walk the data structure.
 chunk_offset_t
@@ -1827,15 +1919,31 @@ async_write_node_set_spare(UpdateAuxImpl &aux, Node &node, bool write_to_fast)
         aux.set_can_write_to_fast(!aux.can_write_to_fast());
     }
 
-    auto off = async_write_node(
-                   aux,
-                   write_to_fast ? aux.node_writer_fast : aux.node_writer_slow,
-                   node)
-                   .offset_written_to;
+    async_write_node_result written;
+    if (!write_to_fast && aux.slow_list_compression_level() != 0) {
+        // Slow list nodes are rarely read, so trade read latency for space
+        auto const encoded =
+            compress_node_for_disk(node, aux.slow_list_compression_level());
+        written = encoded.empty()
+                      ? async_write_node(aux, aux.node_writer_slow, node)
+                      : async_write_encoded_node(
+                            aux, aux.node_writer_slow, encoded);
+        auto &compression_stats = aux.slow_list_compression_stats;
+        ++compression_stats.nodes;
+        compression_stats.uncompressed_bytes += node.get_disk_size();
+        compression_stats.stored_bytes += written.bytes_appended;
+    }
+    else {
+        written = async_write_node(
+            aux,
+            write_to_fast ? aux.node_writer_fast : aux.node_writer_slow,
+            node);
+    }
+    auto off = written.offset_written_to;
     MONAD_ASSERT(
         (write_to_fast && aux.db_metadata()->at(off.id)->in_fast_list) ||
         (!write_to_fast && aux.db_metadata()->at(off.id)->in_slow_list));
-    unsigned const pages = num_pages(off.offset, node.get_disk_size());
+    unsigned const pages = num_pages(off.offset, written.bytes_appended);
     off.set_spare(static_cast<uint16_t>(node_disk_pages_spare_15{pages}));
     return off;
 }
@@ -1847,6 +1955,18 @@ void flush_buffered_writes(UpdateAuxImpl &aux)
         auto *sender = &node_writer->sender();
         auto written = sender->written_buffer_bytes();
         auto paddedup = round_up_align<DISK_PAGE_BITS>(written);
+        if (aux.write_queue_depth() > 0) {
+            // The pipelined writer also pads to the device's preferred
+            // alignment, space in the buffer permitting
+            auto const offset = sender->offset();
+            auto const alignment =
+                file_offset_t(aux.io->chunk_write_alignment(offset.id));
+            auto const end =
+                (offset.offset + written + alignment - 1) & ~(alignment - 1);
+            paddedup = std::min(
+                size_t(end - offset.offset),
+                written + sender->remaining_buffer_bytes());
+        }
         auto const tozerobytes = paddedup - written;
         auto *tozero = sender->advance_buffer_append(tozerobytes);
         MONAD_DEBUG_ASSERT(tozero != nullptr);
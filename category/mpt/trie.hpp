@@ -16,6 +16,7 @@
 #pragma once
 
 #include <category/async/config.hpp>
+#include <category/core/byte_string.hpp>
 #include <category/core/bytes.hpp>
 #include <category/core/lru/static_lru_cache.hpp>
 #include <category/mpt/compute.hpp>
@@ -46,9 +47,11 @@
 
 #include <atomic>
 #include <bit>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <optional>
+#include <span>
 #include <vector>
 
 // temporary
@@ -175,6 +178,12 @@ write_new_root_node(UpdateAuxImpl &, Node &root, uint64_t version);
 node_writer_unique_ptr_type
 replace_node_writer(UpdateAuxImpl &, node_writer_unique_ptr_type const &);
 
+// Replace the node writer with one starting `bytes_written` bytes into the
+// current writer's buffer
+node_writer_unique_ptr_type replace_node_writer(
+    UpdateAuxImpl &, node_writer_unique_ptr_type const &,
+    size_t bytes_written);
+
 // \class Auxiliaries for triedb update
 class UpdateAuxImpl
 {
@@ -195,6 +204,15 @@ class UpdateAuxImpl
 
     void free_compacted_chunks();
 
+    // Destroy the contents of a fast or slow list chunk and return it to the
+    // free list. On a tiered pool a low latency chunk goes to the end of the
+    // free list and any other to its beginning, so that the free list stays
+    // partitioned by tier for next_free_chunk_for().
+    void release_chunk_(uint32_t idx);
+    // Partition the free list of a tiered pool by tier if it is not already,
+    // e.g. when the pool was created untiered or with another tiering
+    void partition_free_list_by_tier_();
+
     // clear root offsets of versions <= version
     void clear_root_offsets_up_to_and_including(uint64_t version);
     void release_unreferenced_chunks();
@@ -217,6 +235,9 @@ class UpdateAuxImpl
 
     void update_disk_growth_data();
 
+    // bump the version change sequence and wake its waiters
+    void notify_version_change_() noexcept;
+
     /******** Compaction ********/
     uint32_t chunks_to_remove_before_count_fast_{0};
     uint32_t chunks_to_remove_before_count_slow_{0};
@@ -239,6 +260,10 @@ class UpdateAuxImpl
                                               // currently upserting
     bool alternate_slow_fast_writer_{false};
     bool can_write_to_fast_{true};
+    // zero disables the pipelined node writer
+    unsigned write_queue_depth_{0};
+    // zstd level slow list nodes are compressed at, zero disables
+    int slow_list_compression_level_{0};
 
     virtual void lock_unique_() const = 0;
 
@@ -401,6 +426,15 @@ public:
 
     detail::TrieUpdateCollectedStats stats;
 
+    // Slow list nodes written while compression was enabled, and their
+    // sizes before and after compression, since the db was opened
+    struct slow_list_compression_stats_t
+    {
+        uint64_t nodes{0};
+        uint64_t uncompressed_bytes{0};
+        uint64_t stored_bytes{0};
+    } slow_list_compression_stats;
+
     UpdateAuxImpl(
         MONAD_ASYNC_NAMESPACE::AsyncIO *io_ = nullptr,
         std::optional<uint64_t> const history_len = {})
@@ -714,6 +748,16 @@ public:
     void append(chunk_list list, uint32_t idx) noexcept;
     void remove(uint32_t idx) noexcept;
 
+    // Returns the free chunk which should next be appended to the fast or
+    // slow list, always one end of the free list. If the storage pool is
+    // tiered, the free list holds its low latency chunks at the end and the
+    // others at the beginning, so the fast list takes from the end and the
+    // slow list from the beginning, falling back to the end of the free list
+    // if the preferred tier has no free chunks. Returns null if we are out of
+    // free chunks.
+    detail::db_metadata::chunk_info_t const *
+    next_free_chunk_for(chunk_list list) const noexcept;
+
     template <typename Func, typename... Args>
         requires std::invocable<
             std::function<void(detail::db_metadata *, Args...)>,
@@ -743,6 +787,17 @@ public:
 
     int64_t get_auto_expire_version_metadata() const noexcept;
 
+    //! See `detail::db_metadata::rewind_epoch()`
+    uint32_t rewind_epoch() const noexcept;
+    //! Changes whenever the version history or the latest finalized,
+    //! verified or voted versions change, in this or another process.
+    uint32_t version_change_sequence() const noexcept;
+    //! Sleeps until the version change sequence is no longer `seen`, or the
+    //! timeout elapses. Returns whether it changed. This blocks the calling
+    //! thread in the kernel, so must not be called on a fiber pool worker.
+    bool wait_for_version_change(
+        uint32_t seen, std::chrono::nanoseconds timeout) const noexcept;
+
     // WARNING: These are destructive, they discard immediately any extraneous
     // data.
     void rewind_to_match_offsets();
@@ -771,6 +826,32 @@ public:
         return can_write_to_fast_;
     }
 
+    //! When non-zero, node writers submit partially filled buffers, aligned
+    //! to the device's preferred i/o size, whenever fewer than this many
+    //! writes are in flight. There must be at least `2 * (depth + 1)` write
+    //! buffers for this to never stall.
+    void set_write_queue_depth(unsigned depth) noexcept
+    {
+        write_queue_depth_ = depth;
+    }
+
+    unsigned write_queue_depth() const noexcept
+    {
+        return write_queue_depth_;
+    }
+
+    //! When non-zero, nodes written to the slow list are stored compressed
+    //! with zstd at this level if that makes them smaller. Reads detect
+    //! compressed nodes. Enabling it marks the DB metadata, after which code
+    //! from before compression refuses the DB, and so must this with a
+    //! level of zero.
+    void set_slow_list_compression_level(int level);
+
+    int slow_list_compression_level() const noexcept
+    {
+        return slow_list_compression_level_;
+    }
+
     void set_can_write_to_fast(bool v) noexcept
     {
         can_write_to_fast_ = v;
@@ -1083,6 +1164,18 @@ static_assert(sizeof(fiber_find_request_t) == 40);
 static_assert(alignof(fiber_find_request_t) == 8);
 static_assert(std::is_trivially_copyable_v<fiber_find_request_t> == true);
 
+// The request type for the triedb thread to find a batch of keys, `results`
+// receives the result of each key at the same index
+struct fiber_find_many_request_t
+{
+    threadsafe_boost_fibers_promise<void> *promise;
+    NodeCursor start{};
+    std::span<NibblesView const> keys{};
+    std::span<find_cursor_result_type> results{};
+};
+
+static_assert(std::is_trivially_copyable_v<fiber_find_many_request_t> == true);
+
 class NodeCache;
 
 //! \warning this is not threadsafe, should only be called from triedb thread
@@ -1099,6 +1192,26 @@ void find_owning_notify_fiber_future(
     threadsafe_boost_fibers_promise<find_owning_cursor_result_type> &promise,
     OwningNodeCursor &start, NibblesView, uint64_t version);
 
+/*! \brief find a batch of keys below `start` in one descent, then fulfil
+`promise`. Keys may be in any order and may repeat. Keys sharing a path walk
+it together and split where their paths diverge, so a node on the shared path
+is read once per batch instead of once per key, and the reads of every
+diverging subtrie are issued before waiting on any of them.
+
+\warning as find_notify_fiber_future(), call only from the triedb thread
+*/
+void find_many_notify_fiber_future(
+    UpdateAuxImpl &, inflight_map_t &, threadsafe_boost_fibers_promise<void> &,
+    NodeCursor start, std::span<NibblesView const> keys,
+    std::span<find_cursor_result_type> results);
+
+// rodb
+void find_many_owning_notify_fiber_future(
+    UpdateAuxImpl &, NodeCache &, inflight_map_owning_t &,
+    threadsafe_boost_fibers_promise<void> &, OwningNodeCursor &start,
+    std::span<NibblesView const> keys,
+    std::span<find_owning_cursor_result_type> results, uint64_t version);
+
 // rodb load root
 void load_root_notify_fiber_future(
     UpdateAuxImpl &, NodeCache &, inflight_map_owning_t &,
@@ -1124,6 +1237,84 @@ becomes invalid.
 Node::UniquePtr read_node_blocking(
     UpdateAuxImpl const &, chunk_offset_t node_offset, uint64_t version);
 
+//! A run of consecutive versions over which a key resolved to the same find
+//! result and value
+struct version_range_find_result_t
+{
+    uint64_t begin_version{0}; // inclusive
+    uint64_t end_version{0}; // inclusive
+    find_result result{find_result::unknown};
+    byte_string value{};
+};
+
+using version_range_find_results_t = std::vector<version_range_find_result_t>;
+
+/*! \brief blocking find of a batch of keys at every version in
+[min_version, max_version] in one pass, returning per key the runs of
+consecutive versions resolving to the same result and value. Only versions
+within the db history window at the time of the call are reported.
+
+Versions are walked in ascending order. Nodes read from disk are cached for
+reuse by later keys and versions. Between versions, the cache is dropped once
+it holds 65536 nodes or more (it may grow past that while one version is
+being resolved), and whenever a version is found to be outside the history
+window. A node is read from disk at most once per cache lifetime, so a long
+query may read it again after a drop. When a key's walk reaches the same node
+offset it reached in the previous version, the previous result is reused
+without descending any further. This makes a query over many nearby versions
+cost roughly one find plus one read per changed node on the key's path.
+
+On-disk only. Nodes are loaded into memory owned by the call and never
+attached to the trie, so it is safe to invoke from any thread.
+*/
+std::vector<version_range_find_results_t> find_version_range_blocking(
+    UpdateAuxImpl const &, std::span<NibblesView const> keys,
+    uint64_t min_version, uint64_t max_version);
+
+//! Computes the merkle leaf data of a node with a value, e.g. the static
+//! `compute()` of the leaf data type a MerkleComputeBase is instantiated with
+using compute_leaf_data_fn = byte_string (*)(Node const &);
+
+//! Merkle proof of a batch of keys against the root of one merkle subtrie
+struct merkle_multiproof_t
+{
+    struct key_proof_t
+    {
+        //! success proves inclusion, any other result proves the key is absent
+        find_result result{find_result::unknown};
+        //! indices into `nodes` of the proof of the key, from the root down
+        std::vector<uint32_t> nodes{};
+    };
+
+    //! success, or why the subtrie could not be read
+    find_result result{find_result::unknown};
+    //! merkle root of the subtrie, keccak of the rlp of the root node
+    bytes32_t root{};
+    //! rlp of each distinct proof node. Nodes of less than 32 bytes are
+    //! embedded in their parent and not listed, except for the root
+    std::vector<byte_string> nodes{};
+    //! proof of each key, at the same index as the key
+    std::vector<key_proof_t> keys{};
+};
+
+/*! \brief blocking generation of an Ethereum merkle proof for each of a batch
+of keys, relative to the subtrie whose root is the node at `prefix` at
+`version`, e.g. the state trie or the storage trie below an account node.
+
+Keys are resolved in sorted order in a single descent, so a node shared by the
+paths of several keys is read from disk and rlp encoded once, and listed once
+in the result. Proof nodes are rebuilt from the child data stored in each
+node, which is what MerkleComputeBase hashes, with `leaf_data` supplying the
+leaf encoding.
+
+On-disk only. Nodes are loaded into memory owned by the call and never
+attached to the trie, so it is safe to invoke from any thread.
+*/
+merkle_multiproof_t generate_proof_blocking(
+    UpdateAuxImpl const &, NibblesView prefix,
+    std::span<NibblesView const> keys, compute_leaf_data_fn leaf_data,
+    uint64_t version);
+
 //////////////////////////////////////////////////////////////////////////////
 // helpers
 inline constexpr unsigned num_pages(file_offset_t const offset, unsigned bytes)
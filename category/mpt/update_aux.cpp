@@ -39,7 +39,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <climits>
 #include <cstring>
+#include <ctime>
 #include <format>
 #include <random>
 #include <span>
@@ -48,8 +50,10 @@
 #include <utility>
 #include <vector>
 
+#include <linux/futex.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
 MONAD_MPT_NAMESPACE_BEGIN
@@ -177,6 +181,89 @@ void UpdateAuxImpl::remove(uint32_t const idx) noexcept
     }
 }
 
+detail::db_metadata::chunk_info_t const *
+UpdateAuxImpl::next_free_chunk_for(chunk_list const list) const noexcept
+{
+    MONAD_ASSERT(is_on_disk());
+    MONAD_DEBUG_ASSERT(list != chunk_list::free);
+    auto const *const end = db_metadata()->free_list_end();
+    auto const &pool = io->storage_pool();
+    if (end == nullptr || !pool.is_tiered()) {
+        return end;
+    }
+    auto const is_preferred = [&](detail::db_metadata::chunk_info_t const *ci) {
+        bool const low_latency =
+            pool.chunk_tier(storage_pool::seq, ci->index(db_metadata())) ==
+            storage_pool::device_tier::low_latency;
+        return low_latency == (list == chunk_list::fast);
+    };
+    // Removing from the middle of a list would break the contiguous insertion
+    // counts it relies on, so only its ends are candidates. Pool creation,
+    // release_chunk_() and partition_free_list_by_tier_() keep the low
+    // latency chunks at the end and the others at the beginning.
+    if (is_preferred(end)) {
+        return end;
+    }
+    auto const *const begin = db_metadata()->free_list_begin();
+    if (is_preferred(begin)) {
+        return begin;
+    }
+    return end;
+}
+
+void UpdateAuxImpl::release_chunk_(uint32_t const idx)
+{
+    MONAD_ASSERT(is_on_disk());
+    remove(idx);
+    auto &pool = io->storage_pool();
+    auto chunk = pool.chunk(storage_pool::seq, idx);
+    chunk->destroy_contents();
+    if (!pool.is_tiered() ||
+        pool.chunk_tier(storage_pool::seq, idx) ==
+            storage_pool::device_tier::low_latency) {
+        append(chunk_list::free, idx);
+        return;
+    }
+    auto const capacity = chunk->capacity();
+    for (auto const i : {0, 1}) {
+        auto *const m = db_metadata_[i].main;
+        m->prepend_(m->free_list, m->at_(idx));
+        m->free_capacity_add_(capacity);
+    }
+}
+
+void UpdateAuxImpl::partition_free_list_by_tier_()
+{
+    MONAD_ASSERT(is_on_disk());
+    auto const &pool = io->storage_pool();
+    if (!pool.is_tiered()) {
+        return;
+    }
+    auto const is_capacity = [&](uint32_t const idx) {
+        return pool.chunk_tier(storage_pool::seq, idx) !=
+               storage_pool::device_tier::low_latency;
+    };
+    std::vector<uint32_t> chunks;
+    for (auto const *ci = db_metadata()->free_list_begin(); ci != nullptr;
+         ci = ci->next(db_metadata())) {
+        chunks.push_back(ci->index(db_metadata()));
+    }
+    if (std::ranges::is_partitioned(chunks, is_capacity)) {
+        return;
+    }
+    LOG_INFO_CFORMAT(
+        "Partitioning %zu free chunks by device tier.", chunks.size());
+    // Free chunks hold no data, so they can be removed from the beginning of
+    // the free list and appended again in tier order
+    for (uint32_t const idx : chunks) {
+        remove(idx);
+    }
+    std::ranges::stable_partition(chunks, is_capacity);
+    for (uint32_t const idx : chunks) {
+        append(chunk_list::free, idx);
+    }
+}
+
 void UpdateAuxImpl::advance_db_offsets_to(
     chunk_offset_t const fast_offset, chunk_offset_t const slow_offset) noexcept
 {
@@ -203,6 +290,7 @@ void UpdateAuxImpl::append_root_offset(
     };
     do_(db_metadata_[0].main);
     do_(db_metadata_[1].main);
+    notify_version_change_();
 }
 
 void UpdateAuxImpl::update_root_offset(
@@ -215,6 +303,7 @@ void UpdateAuxImpl::update_root_offset(
     };
     do_(db_metadata_[0].main);
     do_(db_metadata_[1].main);
+    notify_version_change_();
 }
 
 void UpdateAuxImpl::fast_forward_next_version(
@@ -241,6 +330,7 @@ void UpdateAuxImpl::fast_forward_next_version(
     };
     do_(db_metadata_[0].main);
     do_(db_metadata_[1].main);
+    notify_version_change_();
 }
 
 void UpdateAuxImpl::update_history_length_metadata(
@@ -299,6 +389,7 @@ void UpdateAuxImpl::set_latest_finalized_version(
     };
     do_(db_metadata_[0].main);
     do_(db_metadata_[1].main);
+    notify_version_change_();
 }
 
 void UpdateAuxImpl::set_latest_verified_version(uint64_t const version) noexcept
@@ -311,6 +402,7 @@ void UpdateAuxImpl::set_latest_verified_version(uint64_t const version) noexcept
     };
     do_(db_metadata_[0].main);
     do_(db_metadata_[1].main);
+    notify_version_change_();
 }
 
 void UpdateAuxImpl::set_latest_voted(
@@ -324,6 +416,88 @@ void UpdateAuxImpl::set_latest_voted(
             ->store(version, std::memory_order_release);
         m->latest_voted_block_id = block_id;
     }
+    notify_version_change_();
+}
+
+void UpdateAuxImpl::set_slow_list_compression_level(int const level)
+{
+    if (is_on_disk()) {
+        MONAD_ASSERT(
+            level != 0 || !db_metadata()->slow_list_compressed(),
+            "DB has compressed nodes on its slow list, so it must be opened "
+            "with slow list compression enabled");
+        if (level != 0 && !db_metadata()->slow_list_compressed()) {
+            MONAD_ASSERT(!io->is_read_only());
+            for (auto const i : {0, 1}) {
+                auto *const m = db_metadata_[i].main;
+                auto g = m->hold_dirty();
+                memcpy(
+                    m->magic,
+                    detail::db_metadata::MAGIC_SLOW_LIST_COMPRESSED,
+                    detail::db_metadata::MAGIC_STRING_LEN);
+            }
+        }
+    }
+    slow_list_compression_level_ = level;
+}
+
+void UpdateAuxImpl::notify_version_change_() noexcept
+{
+    // Readers in other processes wait on the shared mapping, so this must not
+    // be a private futex. Both the increment and the waiter count load are
+    // sequentially consistent, pairing with wait_for_version_change(), so
+    // either the waiter sees the new sequence or this sees the waiter.
+    for (auto const i : {0, 1}) {
+        auto *const m = db_metadata_[i].main;
+        auto &seq = m->version_change_sequence();
+        seq.fetch_add(1, std::memory_order_seq_cst);
+        if (m->version_change_waiters().load(std::memory_order_seq_cst) != 0) {
+            syscall(SYS_futex, &seq, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+        }
+    }
+}
+
+uint32_t UpdateAuxImpl::rewind_epoch() const noexcept
+{
+    MONAD_ASSERT(is_on_disk());
+    return const_cast<detail::db_metadata *>(db_metadata())
+        ->rewind_epoch()
+        .load(std::memory_order_acquire);
+}
+
+uint32_t UpdateAuxImpl::version_change_sequence() const noexcept
+{
+    MONAD_ASSERT(is_on_disk());
+    return const_cast<detail::db_metadata *>(db_metadata())
+        ->version_change_sequence()
+        .load(std::memory_order_acquire);
+}
+
+bool UpdateAuxImpl::wait_for_version_change(
+    uint32_t const seen, std::chrono::nanoseconds const timeout) const noexcept
+{
+    MONAD_ASSERT(is_on_disk());
+    auto *const m = const_cast<detail::db_metadata *>(db_metadata());
+    auto &seq = m->version_change_sequence();
+    if (seq.load(std::memory_order_acquire) != seen) {
+        return true;
+    }
+    if (timeout.count() > 0) {
+        auto &waiters = m->version_change_waiters();
+        waiters.fetch_add(1, std::memory_order_seq_cst);
+        if (seq.load(std::memory_order_seq_cst) == seen) {
+            auto const secs =
+                std::chrono::duration_cast<std::chrono::seconds>(timeout);
+            struct timespec const ts{
+                .tv_sec = static_cast<time_t>(secs.count()),
+                .tv_nsec = static_cast<long>((timeout - secs).count())};
+            // Returns early with EAGAIN if the sequence has already moved
+            // on, and spurious wakeups are caught by the reload below
+            syscall(SYS_futex, &seq, FUTEX_WAIT, seen, &ts, nullptr, 0);
+        }
+        waiters.fetch_sub(1, std::memory_order_release);
+    }
+    return seq.load(std::memory_order_acquire) != seen;
 }
 
 int64_t UpdateAuxImpl::get_auto_expire_version_metadata() const noexcept
@@ -367,6 +541,13 @@ int64_t UpdateAuxImpl::calc_auto_expire_version() noexcept
 void UpdateAuxImpl::rewind_to_match_offsets()
 {
     MONAD_ASSERT(is_on_disk());
+    // Invalidate what other processes cached by virtual offset before any
+    // storage past the offsets can be written again
+    for (auto const i : {0, 1}) {
+        auto *const m = db_metadata_[i].main;
+        auto g = m->hold_dirty();
+        m->rewind_epoch().fetch_add(1, std::memory_order_acq_rel);
+    }
 
     auto const fast_offset = db_metadata()->db_offsets.start_of_wip_offset_fast;
     MONAD_ASSERT(db_metadata()->at(fast_offset.id)->in_fast_list);
@@ -420,10 +601,7 @@ void UpdateAuxImpl::rewind_to_match_offsets()
     // Free all chunks after fast_offset.id
     auto const *ci = db_metadata()->at(fast_offset.id);
     while (ci != db_metadata()->fast_list_end()) {
-        auto const idx = db_metadata()->fast_list.end;
-        remove(idx);
-        io->storage_pool().chunk(storage_pool::seq, idx)->destroy_contents();
-        append(chunk_list::free, idx);
+        release_chunk_(db_metadata()->fast_list.end);
     }
     auto fast_offset_chunk =
         io->storage_pool().chunk(storage_pool::seq, fast_offset.id);
@@ -432,10 +610,7 @@ void UpdateAuxImpl::rewind_to_match_offsets()
     // Same for slow list
     auto const *slow_ci = db_metadata()->at(slow_offset.id);
     while (slow_ci != db_metadata()->slow_list_end()) {
-        auto const idx = db_metadata()->slow_list.end;
-        remove(idx);
-        io->storage_pool().chunk(storage_pool::seq, idx)->destroy_contents();
-        append(chunk_list::free, idx);
+        release_chunk_(db_metadata()->slow_list.end);
     }
     auto slow_offset_chunk =
         io->storage_pool().chunk(storage_pool::seq, slow_offset.id);
@@ -614,14 +789,8 @@ void UpdateAuxImpl::set_io(
     /* If the front copy vanished for some reason ... this can happen
     if something or someone zaps the front bytes of the partition.
     */
-    if (0 != memcmp(
-                 db_metadata_[0].main->magic,
-                 detail::db_metadata::MAGIC,
-                 detail::db_metadata::MAGIC_STRING_LEN)) {
-        if (0 == memcmp(
-                     db_metadata_[1].main->magic,
-                     detail::db_metadata::MAGIC,
-                     detail::db_metadata::MAGIC_STRING_LEN)) {
+    if (!db_metadata_[0].main->has_valid_magic()) {
+        if (db_metadata_[1].main->has_valid_magic()) {
             // Can't make forward progress if we don't have writable maps
             MONAD_ASSERT(
                 can_write_to_map,
@@ -637,10 +806,7 @@ void UpdateAuxImpl::set_io(
                  db_metadata_[0].main->magic,
                  detail::db_metadata::MAGIC,
                  magic_prefix_len) &&
-        memcmp(
-            db_metadata_[0].main->magic + magic_prefix_len,
-            detail::db_metadata::MAGIC + magic_prefix_len,
-            magic_version_len)) {
+        !db_metadata_[0].main->has_valid_magic()) {
         MONAD_ABORT_PRINTF(
             "DB was generated with version %s. The current code base is on "
             "version %s. Please regenerate with the new DB version.",
@@ -648,14 +814,8 @@ void UpdateAuxImpl::set_io(
             detail::db_metadata::MAGIC + magic_prefix_len);
     }
     // Replace any dirty copy with the non-dirty copy
-    if (0 == memcmp(
-                 db_metadata_[0].main->magic,
-                 detail::db_metadata::MAGIC,
-                 detail::db_metadata::MAGIC_STRING_LEN) &&
-        0 == memcmp(
-                 db_metadata_[1].main->magic,
-                 detail::db_metadata::MAGIC,
-                 detail::db_metadata::MAGIC_STRING_LEN)) {
+    if (db_metadata_[0].main->has_valid_magic() &&
+        db_metadata_[1].main->has_valid_magic()) {
         if (can_write_to_map) {
             // Replace the dirty copy with the non-dirty copy
             if (db_metadata_[0].main->is_dirty().load(
@@ -761,10 +921,7 @@ void UpdateAuxImpl::set_io(
                 db_version_history_storage_bytes / sizeof(chunk_offset_t)};
         }
     };
-    if (0 != memcmp(
-                 db_metadata_[0].main->magic,
-                 detail::db_metadata::MAGIC,
-                 detail::db_metadata::MAGIC_STRING_LEN)) {
+    if (!db_metadata_[0].main->has_valid_magic()) {
         // Can't make forward progress if We don't have writable maps
         MONAD_ASSERT(
             can_write_to_map,
@@ -874,6 +1031,32 @@ void UpdateAuxImpl::set_io(
             "Initialize db pool with %zu chunks in increasing order.",
             chunk_count);
 #endif
+        if (io->storage_pool().is_tiered()) {
+            // Start the fast list on a low latency device and the slow list
+            // elsewhere, the remainder go to the free list
+            auto const is_low_latency = [&](uint32_t const id) {
+                return io->storage_pool().chunk_tier(storage_pool::seq, id) ==
+                       storage_pool::device_tier::low_latency;
+            };
+            auto it =
+                std::find_if(chunks.begin(), chunks.end(), is_low_latency);
+            if (it != chunks.end()) {
+                std::rotate(chunks.begin(), it, std::next(it));
+            }
+            it = std::find_if_not(
+                std::next(chunks.begin()), chunks.end(), is_low_latency);
+            if (it != chunks.end()) {
+                std::rotate(std::next(chunks.begin()), it, std::next(it));
+            }
+            // Free list ends are all next_free_chunk_for() can take from, so
+            // keep the low latency chunks at its end for the fast list
+            if (chunks.size() > 2) {
+                std::stable_partition(
+                    std::next(chunks.begin(), 2),
+                    chunks.end(),
+                    [&](uint32_t const id) { return !is_low_latency(id); });
+            }
+        }
         auto append_with_insertion_count_override = [&](chunk_list list,
                                                         uint32_t id) {
             append(list, id);
@@ -934,6 +1117,14 @@ void UpdateAuxImpl::set_io(
                 0xff,
                 sizeof(m->future_variables_unused));
         }
+        // so that caches of a previous database on the same storage, which
+        // reused virtual offsets, are not mistaken for this one
+        auto const rewind_epoch = std::random_device{}();
+        for (auto const i : {0, 1}) {
+            auto *const m = db_metadata_[i].main;
+            auto g = m->hold_dirty();
+            m->rewind_epoch().store(rewind_epoch, std::memory_order_release);
+        }
 
         // Set history length
         if (history_len.has_value()) {
@@ -967,6 +1158,7 @@ void UpdateAuxImpl::set_io(
             // Reset/init node writer's offsets, destroy contents after
             // fast_offset.id chunck
             rewind_to_match_offsets();
+            partition_free_list_by_tier_();
             if (history_len.has_value()) {
                 // reset history length
                 if (history_len < version_history_length() &&
@@ -1118,6 +1310,8 @@ Node::UniquePtr UpdateAuxImpl::do_update(
         {}, compact_offsets_bytes, false, std::move(updates), version);
     root_updates.push_front(root_update);
 
+    auto const write_stalls_begin = io->write_stalls();
+    auto const write_stall_begin = io->write_stall_duration();
     auto upsert_begin = std::chrono::steady_clock::now();
     auto root = upsert(
         *this,
@@ -1130,6 +1324,9 @@ Node::UniquePtr UpdateAuxImpl::do_update(
 
     auto const duration = std::chrono::duration_cast<std::chrono::microseconds>(
         std::chrono::steady_clock::now() - upsert_begin);
+    auto const write_stall =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            io->write_stall_duration() - write_stall_begin);
     if (compaction) {
         update_disk_growth_data();
         // log stats
@@ -1141,12 +1338,14 @@ Node::UniquePtr UpdateAuxImpl::do_update(
         physical_to_virtual(node_writer_slow->sender().offset());
     LOG_INFO_CFORMAT(
         "Finish upserting version %lu. Min valid version %lu. Time elapsed: "
-        "%ld us. Disk usage: %.4f. Chunks: %u fast, %u slow, %u free. Writer "
-        "offsets: fast={%u,%u}, slow={%u,%u}. Compaction head offset fast=%u, "
-        "slow=%u",
+        "%ld us (%lu write stalls, %ld us). Disk usage: %.4f. Chunks: %u fast, "
+        "%u slow, %u free. Writer offsets: fast={%u,%u}, slow={%u,%u}. "
+        "Compaction head offset fast=%u, slow=%u",
         version,
         db_history_min_valid_version(),
         duration.count(),
+        io->write_stalls() - write_stalls_begin,
+        write_stall.count(),
         disk_usage(),
         num_chunks(chunk_list::fast),
         num_chunks(chunk_list::slow),
@@ -1423,13 +1622,7 @@ void UpdateAuxImpl::free_compacted_chunks()
                  idx = ci->index(db_metadata()),
                  count = (uint32_t)db_metadata()->at(idx)->insertion_count()) {
                 ci = ci->next(db_metadata()); // must be in this order
-                remove(idx);
-                io->storage_pool()
-                    .chunk(monad::async::storage_pool::seq, idx)
-                    ->destroy_contents();
-                append(
-                    UpdateAuxImpl::chunk_list::free,
-                    idx); // append not prepend
+                release_chunk_(idx);
             }
         };
     MONAD_ASSERT(
@@ -1617,6 +1810,30 @@ void UpdateAuxImpl::print_update_stats(uint64_t const version)
                 (double)stats.bytes_read_after_compact_offset[1] / 1024);
         }
     }
+    if (is_on_disk() && io->capture_io_latencies()) {
+        std::format_to(std::back_inserter(buf), "[Device Latencies]\n");
+        auto const latencies = io->device_latencies();
+        for (size_t n = 0; n < latencies.size(); n++) {
+            using std::chrono::duration_cast;
+            using std::chrono::microseconds;
+            auto const &dev = latencies[n];
+            std::format_to(
+                std::back_inserter(buf),
+                "   Device {} ({}): reads {} avg {} max {}, writes {} avg {} "
+                "max {}\n",
+                n,
+                io->storage_pool().devices()[n].tier() ==
+                        storage_pool::device_tier::low_latency
+                    ? "low latency"
+                    : "capacity",
+                dev.nreads,
+                duration_cast<microseconds>(dev.average_read_latency()),
+                duration_cast<microseconds>(dev.max_read_latency),
+                dev.nwrites,
+                duration_cast<microseconds>(dev.average_write_latency()),
+                duration_cast<microseconds>(dev.max_write_latency));
+        }
+    }
     LOG_INFO("{}", buf);
 #else
     (void)version;
@@ -47,6 +47,7 @@
 #include <category/mpt/ondisk_db_config.hpp>
 #include <category/mpt/util.hpp>
 #include <category/rpc/eth_call.h>
+#include <category/vm/intercode_cache.hpp>
 #include <category/vm/evm/switch_traits.hpp>
 #include <category/vm/evm/traits.hpp>
 
@@ -92,6 +93,9 @@ namespace
         "failure to execute eth_call: queuing time exceeded timeout threshold";
     using StateOverrideObj = monad_state_override::monad_state_override_object;
 
+    constexpr uint32_t eth_call_intercode_cache_kb =
+        uint32_t{1} << 18; // 256MB
+
     template <Traits traits>
     Result<evmc::Result> eth_call_impl(
         Chain const &chain, Transaction const &txn, BlockHeader const &header,
@@ -852,6 +856,14 @@ monad_eth_call_executor *monad_eth_call_executor_create(
     MONAD_ASSERT(dbpath);
     std::string const triedb_path{dbpath};
 
+    // All executors in the process analyse code through one cache. It is
+    // never destroyed, as executors may outlive static destruction.
+    static vm::IntercodeCache *const intercode_cache =
+        new vm::IntercodeCache{eth_call_intercode_cache_kb};
+    if (!vm::get_intercode_cache()) {
+        vm::set_intercode_cache(intercode_cache);
+    }
+
     monad_eth_call_executor *const e = new monad_eth_call_executor(
         num_threads,
         num_fibers,
@@ -292,7 +292,7 @@ void monad_statesync_server_context::commit(
     StateDeltas const &state_deltas, Code const &code,
     bytes32_t const &block_id, BlockHeader const &header,
     std::vector<Receipt> const &receipts,
-    std::vector<std::vector<CallFrame>> const &call_frames,
+    std::vector<byte_string> const &call_frames,
     std::vector<Address> const &senders,
     std::vector<Transaction> const &transactions,
     std::vector<BlockHeader> const &ommers,
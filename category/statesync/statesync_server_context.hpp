@@ -84,7 +84,6 @@ struct ProposedDeletions
 static_assert(sizeof(ProposedDeletions) == 64);
 static_assert(alignof(ProposedDeletions) == 8);
 
-struct CallFrame;
 class TrieDb;
 
 MONAD_NAMESPACE_END
@@ -131,7 +130,7 @@ struct monad_statesync_server_context final : public monad::Db
         monad::StateDeltas const &state_deltas, monad::Code const &code,
         monad::bytes32_t const &block_id, monad::BlockHeader const &,
         std::vector<monad::Receipt> const &receipts = {},
-        std::vector<std::vector<monad::CallFrame>> const & = {},
+        std::vector<monad::byte_string> const & = {},
         std::vector<monad::Address> const & = {},
         std::vector<monad::Transaction> const &transactions = {},
         std::vector<monad::BlockHeader> const &ommers = {},
@@ -20,6 +20,7 @@
 #include <category/vm/compiler/types.hpp>
 #include <category/vm/core/assert.h>
 #include <category/vm/interpreter/intercode.hpp>
+#include <category/vm/runtime/arithmetic_kernels.hpp>
 #include <category/vm/runtime/math.hpp>
 #include <category/vm/runtime/storage.hpp>
 #include <category/vm/runtime/transmute.hpp>
@@ -7598,7 +7599,7 @@ namespace monad::vm::compiler::native
         else {
             call_runtime_mul(
                 Runtime<uint256_t *, uint256_t const *, uint256_t const *>(
-                    this, false, runtime::mul));
+                    this, false, runtime::arithmetic_kernels().mul));
         }
 
         MONAD_VM_DEBUG_ASSERT(stack_.top()->stack_offset().has_value());
@@ -21,6 +21,7 @@
 #include <category/vm/evm/opcodes.hpp>
 #include <category/vm/evm/traits.hpp>
 #include <category/vm/interpreter/intercode.hpp>
+#include <category/vm/runtime/arithmetic_kernels.hpp>
 #include <category/vm/runtime/detail.hpp>
 #include <category/vm/runtime/types.hpp>
 
@@ -346,7 +347,8 @@ namespace monad::vm::compiler::native
             if (mul_optimized()) {
                 return;
             }
-            call_runtime(remaining_base_gas, false, runtime::mul);
+            call_runtime(
+                remaining_base_gas, false, runtime::arithmetic_kernels().mul);
         }
 
         template <Traits traits>
@@ -404,7 +406,8 @@ namespace monad::vm::compiler::native
             if (mulmod_opt()) {
                 return;
             }
-            call_runtime(remaining_base_gas, true, runtime::mulmod);
+            call_runtime(
+                remaining_base_gas, true, runtime::arithmetic_kernels().mulmod);
         }
 
         template <typename T, size_t N>
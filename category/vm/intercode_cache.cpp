@@ -0,0 +1,120 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/vm/code.hpp>
+#include <category/vm/core/assert.h>
+#include <category/vm/intercode_cache.hpp>
+#include <category/vm/varcode_cache.hpp>
+
+#include <evmc/evmc.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <string>
+
+namespace monad::vm
+{
+    namespace
+    {
+        std::atomic<IntercodeCache *> intercode_cache{nullptr};
+    }
+
+    IntercodeCache::IntercodeCache(std::uint32_t const max_cache_kb)
+        : weight_cache_{max_cache_kb}
+    {
+    }
+
+    SharedIntercode IntercodeCache::find(evmc::bytes32 const &code_hash)
+    {
+        WeightCache::ConstAccessor acc;
+        if (!weight_cache_.find(acc, code_hash)) {
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        Entry const &entry = acc->second.value_;
+        saved_ns_.fetch_add(entry.analysis_ns, std::memory_order_relaxed);
+        return entry.icode;
+    }
+
+    SharedIntercode IntercodeCache::analyse(
+        evmc::bytes32 const &code_hash, std::span<uint8_t const> const code)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        auto icode = make_shared_intercode(code);
+        auto const analysis_ns = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+        analysis_ns_.fetch_add(analysis_ns, std::memory_order_relaxed);
+
+        Entry entry{.icode = icode, .analysis_ns = analysis_ns};
+        (void)weight_cache_.try_insert(
+            code_hash,
+            entry,
+            VarcodeCache::code_size_to_cache_weight(*icode->code_size()));
+        return entry.icode;
+    }
+
+    void IntercodeCache::insert(
+        evmc::bytes32 const &code_hash, SharedIntercode const &icode)
+    {
+        MONAD_VM_ASSERT(icode != nullptr);
+        Entry entry{.icode = icode, .analysis_ns = 0};
+        (void)weight_cache_.try_insert(
+            code_hash,
+            entry,
+            VarcodeCache::code_size_to_cache_weight(*icode->code_size()));
+    }
+
+    IntercodeCache::Stats IntercodeCache::stats() const
+    {
+        return Stats{
+            .hits = hits_.load(std::memory_order_relaxed),
+            .misses = misses_.load(std::memory_order_relaxed),
+            .entries = weight_cache_.size(),
+            .weight_kb = weight_cache_.approx_weight(),
+            .analysis_ns = analysis_ns_.load(std::memory_order_relaxed),
+            .saved_ns = saved_ns_.load(std::memory_order_relaxed)};
+    }
+
+    std::string IntercodeCache::print_stats() const
+    {
+        auto const s = stats();
+        return std::format(
+            ",intercode_cache_hits={},intercode_cache_misses={}"
+            ",intercode_cache_size={},intercode_cache_weight={}kB"
+            ",intercode_analysis_time={}µs,intercode_analysis_saved={}µs",
+            s.hits,
+            s.misses,
+            s.entries,
+            s.weight_kb,
+            s.analysis_ns / 1000,
+            s.saved_ns / 1000);
+    }
+
+    void set_intercode_cache(IntercodeCache *const cache)
+    {
+        intercode_cache.store(cache, std::memory_order_release);
+    }
+
+    IntercodeCache *get_intercode_cache()
+    {
+        return intercode_cache.load(std::memory_order_acquire);
+    }
+}
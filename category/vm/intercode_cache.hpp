@@ -0,0 +1,103 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/vm/code.hpp>
+#include <category/vm/utils/evmc_utils.hpp>
+#include <category/vm/utils/lru_weight_cache.hpp>
+
+#include <evmc/evmc.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace monad::vm
+{
+    /// Process wide cache of analysed intercode, keyed by code hash and
+    /// bounded by code size. Every `VarcodeCache` miss in the process goes
+    /// to the database for the code, so sharing the analysis here means
+    /// each code hash is analysed once rather than once per VM, block or
+    /// eth_call executor. Cached intercode is shared with the varcode that
+    /// wraps it, so an entry present in both costs its bytes once.
+    class IntercodeCache
+    {
+    public:
+        static constexpr std::uint32_t default_max_cache_kb =
+            std::uint32_t{1} << 20; // 1MB * 1kB = 1GB
+
+    private:
+        struct Entry
+        {
+            SharedIntercode icode;
+            std::uint64_t analysis_ns;
+        };
+
+        using WeightCache =
+            utils::LruWeightCache<evmc::bytes32, Entry, utils::Hash32Compare>;
+
+    public:
+        struct Stats
+        {
+            std::uint64_t hits;
+            std::uint64_t misses;
+            std::size_t entries;
+            std::uint64_t weight_kb;
+            /// Time spent analysing code on misses.
+            std::uint64_t analysis_ns;
+            /// Analysis time the hits would have cost without the cache.
+            std::uint64_t saved_ns;
+        };
+
+        explicit IntercodeCache(
+            std::uint32_t max_cache_kb = default_max_cache_kb);
+
+        IntercodeCache(IntercodeCache const &) = delete;
+        IntercodeCache &operator=(IntercodeCache const &) = delete;
+
+        /// Get intercode for given code hash, or nullptr.
+        SharedIntercode find(evmc::bytes32 const &code_hash);
+
+        /// Analyse `code` and insert it under `code_hash`. If another
+        /// thread inserted the same code hash first, its intercode is
+        /// returned instead.
+        SharedIntercode
+        analyse(evmc::bytes32 const &code_hash, std::span<uint8_t const> code);
+
+        /// Insert intercode analysed elsewhere, such as code created during
+        /// execution that is about to be committed.
+        void insert(evmc::bytes32 const &code_hash, SharedIntercode const &);
+
+        Stats stats() const;
+
+        std::string print_stats() const;
+
+    private:
+        WeightCache weight_cache_;
+        std::atomic<std::uint64_t> hits_{0};
+        std::atomic<std::uint64_t> misses_{0};
+        std::atomic<std::uint64_t> analysis_ns_{0};
+        std::atomic<std::uint64_t> saved_ns_{0};
+    };
+
+    /// Install the process wide intercode cache consulted when code is read
+    /// from the database. Passing nullptr disables it, which is the default.
+    /// The cache must outlive all database reads using it.
+    void set_intercode_cache(IntercodeCache *);
+
+    IntercodeCache *get_intercode_cache();
+}
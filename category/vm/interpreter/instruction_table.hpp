@@ -23,6 +23,7 @@
 #include <category/vm/interpreter/push.hpp>
 #include <category/vm/interpreter/stack.hpp>
 #include <category/vm/interpreter/types.hpp>
+#include <category/vm/runtime/arithmetic_kernels.hpp>
 #include <category/vm/runtime/runtime.hpp>
 #include <category/vm/runtime/types.hpp>
 #include <category/vm/runtime/uint256.hpp>
@@ -434,7 +435,7 @@ namespace monad::vm::interpreter
         std::int64_t gas_remaining, std::uint8_t const *instr_ptr)
     {
         checked_runtime_call<MUL, traits>(
-            monad_vm_runtime_mul,
+            runtime::arithmetic_kernels().mul,
             ctx,
             analysis,
             stack_bottom,
@@ -556,7 +557,7 @@ namespace monad::vm::interpreter
         std::int64_t gas_remaining, std::uint8_t const *instr_ptr)
     {
         checked_runtime_call<MULMOD, traits>(
-            runtime::mulmod,
+            runtime::arithmetic_kernels().mulmod,
             ctx,
             analysis,
             stack_bottom,
@@ -80,6 +80,7 @@ namespace monad::vm::llvm
     {
         auto ctx = runtime::Context::from(
             memory_allocator_,
+            runtime::MemoryBacking::Heap,
             chain_params,
             host,
             context,
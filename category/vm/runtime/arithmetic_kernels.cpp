@@ -0,0 +1,159 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/vm/runtime/arithmetic_kernels.hpp>
+#include <category/vm/runtime/math.hpp>
+#include <category/vm/runtime/uint256.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include <cpuid.h>
+
+namespace monad::vm::runtime
+{
+    namespace
+    {
+        using MulFn = void (*)(
+            uint256_t *, uint256_t const *, uint256_t const *) noexcept;
+
+        // Same square-and-multiply as `runtime::exp`, with the multiply
+        // routed through the given kernel.
+        template <MulFn Mul>
+        void exp_kernel(
+            uint256_t *result_ptr, uint256_t const *base_ptr,
+            uint256_t const *exponent_ptr) noexcept
+        {
+            uint256_t const &exponent = *exponent_ptr;
+            uint256_t base = *base_ptr;
+            uint256_t result{1};
+            if (base == 2) {
+                *result_ptr = result << exponent;
+                return;
+            }
+
+            size_t const sig_words =
+                count_significant_words(exponent.as_words());
+            for (size_t w = 0; w < sig_words; w++) {
+                uint64_t word_exp = exponent[w];
+                int32_t significant_bits =
+                    w + 1 == sig_words ? 64 - std::countl_zero(word_exp) : 64;
+                while (significant_bits) {
+                    if (word_exp & 1) {
+                        Mul(&result, &result, &base);
+                    }
+                    Mul(&base, &base, &base);
+                    word_exp >>= 1;
+                    significant_bits -= 1;
+                }
+            }
+            *result_ptr = result;
+        }
+
+        void mulmod_adx(
+            uint256_t *result_ptr, uint256_t const *a_ptr,
+            uint256_t const *b_ptr, uint256_t const *n_ptr) noexcept
+        {
+            if (*n_ptr == 0) {
+                *result_ptr = 0;
+                return;
+            }
+
+            words_t<2 * uint256_t::num_words> prod;
+            monad_vm_runtime_mul_512_adx(prod.data(), a_ptr, b_ptr);
+            *result_ptr = uint256_t{udivrem(prod, n_ptr->as_words()).rem};
+        }
+
+        constexpr ArithmeticKernels bmi2_kernels{
+            .isa = KernelIsa::Bmi2,
+            .mul = monad_vm_runtime_mul,
+            .mulmod = mulmod,
+            .exp = exp_kernel<monad_vm_runtime_mul>,
+        };
+
+        constexpr ArithmeticKernels adx_kernels{
+            .isa = KernelIsa::Adx,
+            .mul = monad_vm_runtime_mul_adx,
+            .mulmod = mulmod_adx,
+            .exp = exp_kernel<monad_vm_runtime_mul_adx>,
+        };
+
+        std::atomic<ArithmeticKernels const *> &active_kernels() noexcept
+        {
+            static std::atomic<ArithmeticKernels const *> active{
+                &arithmetic_kernels(detect_kernel_isa())};
+            return active;
+        }
+    }
+
+    std::string_view kernel_isa_name(KernelIsa const isa) noexcept
+    {
+        switch (isa) {
+        case KernelIsa::Bmi2:
+            return "bmi2";
+        case KernelIsa::Adx:
+            return "adx";
+        }
+        std::unreachable();
+    }
+
+    KernelIsa detect_kernel_isa() noexcept
+    {
+        unsigned eax = 0;
+        unsigned ebx = 0;
+        unsigned ecx = 0;
+        unsigned edx = 0;
+        if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) &&
+            (ebx & bit_BMI2) && (ebx & bit_ADX)) {
+            return KernelIsa::Adx;
+        }
+        return KernelIsa::Bmi2;
+    }
+
+    bool is_kernel_isa_supported(KernelIsa const isa) noexcept
+    {
+        return isa <= detect_kernel_isa();
+    }
+
+    ArithmeticKernels const &arithmetic_kernels(KernelIsa const isa) noexcept
+    {
+        switch (isa) {
+        case KernelIsa::Bmi2:
+            return bmi2_kernels;
+        case KernelIsa::Adx:
+            return adx_kernels;
+        }
+        std::unreachable();
+    }
+
+    ArithmeticKernels const &arithmetic_kernels() noexcept
+    {
+        return *active_kernels().load(std::memory_order_acquire);
+    }
+
+    bool select_arithmetic_kernels(KernelIsa const isa) noexcept
+    {
+        if (!is_kernel_isa_supported(isa)) {
+            return false;
+        }
+        active_kernels().store(
+            &arithmetic_kernels(isa), std::memory_order_release);
+        return true;
+    }
+}
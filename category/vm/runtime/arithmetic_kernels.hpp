@@ -0,0 +1,82 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/vm/runtime/uint256.hpp>
+
+#include <cstdint>
+#include <string_view>
+
+// Same contract as `monad_vm_runtime_mul`. Requires BMI2 and ADX.
+extern "C" void monad_vm_runtime_mul_adx(
+    monad::vm::runtime::uint256_t *result,
+    monad::vm::runtime::uint256_t const *left,
+    monad::vm::runtime::uint256_t const *right) noexcept;
+
+// Full 512-bit product into `result[0..8)`, which must not overlap `left` or
+// `right`. Requires BMI2 and ADX.
+extern "C" void monad_vm_runtime_mul_512_adx(
+    uint64_t *result, monad::vm::runtime::uint256_t const *left,
+    monad::vm::runtime::uint256_t const *right) noexcept;
+
+namespace monad::vm::runtime
+{
+    /// Instruction set extensions an arithmetic kernel table is tuned for.
+    /// `Bmi2` is the build baseline and always available.
+    enum class KernelIsa : uint8_t
+    {
+        Bmi2,
+        Adx,
+    };
+
+    std::string_view kernel_isa_name(KernelIsa) noexcept;
+
+    /// Runtime entry points for the arithmetic opcodes that have ISA
+    /// specific implementations. Every table computes exactly the same
+    /// results, and the signatures match the generic runtime functions in
+    /// `math.hpp`, so both the interpreter and the x86 emitter can call them
+    /// in place of those.
+    struct ArithmeticKernels
+    {
+        KernelIsa isa;
+        void (*mul)(
+            uint256_t *, uint256_t const *, uint256_t const *) noexcept;
+        void (*mulmod)(
+            uint256_t *, uint256_t const *, uint256_t const *,
+            uint256_t const *) noexcept;
+        void (*exp)(
+            uint256_t *result, uint256_t const *base,
+            uint256_t const *exponent) noexcept;
+    };
+
+    /// The best kernel ISA supported by the host CPU, from CPUID.
+    KernelIsa detect_kernel_isa() noexcept;
+
+    bool is_kernel_isa_supported(KernelIsa) noexcept;
+
+    /// The kernel table for a given ISA, whether or not the host supports it.
+    ArithmeticKernels const &arithmetic_kernels(KernelIsa) noexcept;
+
+    /// The active kernel table. It is selected once, on first use, from
+    /// `detect_kernel_isa`.
+    ArithmeticKernels const &arithmetic_kernels() noexcept;
+
+    /// Override the active kernel table, for tests and benchmarks. Native
+    /// code embeds the kernel addresses, so this must be called before any
+    /// contract is compiled. Returns false, leaving the active table
+    /// unchanged, if the host does not support `isa`.
+    bool select_arithmetic_kernels(KernelIsa isa) noexcept;
+}
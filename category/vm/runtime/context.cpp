@@ -47,7 +47,7 @@ extern "C" void monad_vm_runtime_increase_capacity(
     std::uint8_t *new_data = static_cast<uint8_t *>(std::malloc(new_capacity));
     std::memcpy(new_data, ctx->memory.data, old_size);
     std::memset(new_data + old_size, 0, new_capacity - old_size);
-    ctx->memory.dealloc(ctx->memory.data);
+    ctx->memory.dealloc(ctx->memory.data, old_size);
     ctx->memory.capacity = new_capacity;
     ctx->memory.data = new_data;
 }
@@ -64,9 +64,10 @@ namespace monad::vm::runtime
     }
 
     Context Context::from(
-        EvmMemoryAllocator alloc, ChainParams const &chain_params,
-        evmc_host_interface const *host, evmc_host_context *context,
-        evmc_message const *msg, std::span<std::uint8_t const> code) noexcept
+        EvmMemoryAllocator alloc, MemoryBacking const mem_backing,
+        ChainParams const &chain_params, evmc_host_interface const *host,
+        evmc_host_context *context, evmc_message const *msg,
+        std::span<std::uint8_t const> code) noexcept
     {
         return Context{
             .chain_params = chain_params,
@@ -92,7 +93,7 @@ namespace monad::vm::runtime
                     .tx_context = host->get_tx_context(context),
                 },
             .result = {},
-            .memory = Memory(alloc),
+            .memory = Memory(alloc, mem_backing),
         };
     }
 
@@ -17,6 +17,7 @@
 
 #include <category/vm/core/assert.h>
 #include <category/vm/evm/traits.hpp>
+#include <category/vm/runtime/arithmetic_kernels.hpp>
 #include <category/vm/runtime/types.hpp>
 #include <category/vm/runtime/uint256.hpp>
 
@@ -130,6 +131,6 @@ namespace monad::vm::runtime
 
         ctx->deduct_gas(exponent_byte_size * exponent_cost);
 
-        *result_ptr = exp(*a_ptr, *exponent_ptr);
+        arithmetic_kernels().exp(result_ptr, a_ptr, exponent_ptr);
     }
 }
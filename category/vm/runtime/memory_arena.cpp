@@ -0,0 +1,137 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/vm/core/assert.h>
+#include <category/vm/runtime/memory_arena.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace monad::vm::runtime
+{
+    namespace
+    {
+        std::atomic<size_t> reserved_region_count{0};
+
+        void unmap_region(uint8_t *const region) noexcept
+        {
+            MONAD_VM_ASSERT(munmap(region, EvmMemoryArena::region_size) == 0);
+            reserved_region_count.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        struct RegionCache
+        {
+            std::vector<uint8_t *> regions;
+
+            ~RegionCache()
+            {
+                for (uint8_t *const region : regions) {
+                    unmap_region(region);
+                }
+            }
+        };
+
+        thread_local RegionCache region_cache;
+
+        uint8_t *reserve_region() noexcept
+        {
+            if (reserved_region_count.fetch_add(
+                    1, std::memory_order_relaxed) >=
+                EvmMemoryArena::max_reserved_regions) {
+                reserved_region_count.fetch_sub(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            void *const p = mmap(
+                nullptr,
+                EvmMemoryArena::region_size,
+                PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+                -1,
+                0);
+            if (p == MAP_FAILED) {
+                reserved_region_count.fetch_sub(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            auto *const region = static_cast<uint8_t *>(p);
+            // Best effort, THP may be disabled on the host
+            (void)madvise(
+                region + EvmMemoryArena::small_page_prefix,
+                EvmMemoryArena::region_size -
+                    EvmMemoryArena::small_page_prefix,
+                MADV_HUGEPAGE);
+            return region;
+        }
+    }
+
+    uint8_t *EvmMemoryArena::acquire() noexcept
+    {
+        auto &regions = region_cache.regions;
+        if (!regions.empty()) {
+            uint8_t *const region = regions.back();
+            regions.pop_back();
+            return region;
+        }
+        return reserve_region();
+    }
+
+    void EvmMemoryArena::release(
+        uint8_t *const region, uint32_t const dirty_size) noexcept
+    {
+        MONAD_VM_DEBUG_ASSERT(dirty_size <= region_size);
+        if (dirty_size <= memset_limit) {
+            std::memset(region, 0, dirty_size);
+        }
+        else {
+            static size_t const page_size =
+                static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            size_t const dirty_end =
+                (dirty_size + page_size - 1) & ~(page_size - 1);
+            std::memset(region, 0, memset_limit);
+            MONAD_VM_ASSERT(
+                madvise(
+                    region + memset_limit,
+                    dirty_end - memset_limit,
+                    MADV_DONTNEED) == 0);
+        }
+
+        auto &regions = region_cache.regions;
+        if (regions.size() < max_cached_regions_per_thread) {
+            regions.push_back(region);
+        }
+        else {
+            unmap_region(region);
+        }
+    }
+
+    size_t EvmMemoryArena::reserved_regions() noexcept
+    {
+        return reserved_region_count.load(std::memory_order_relaxed);
+    }
+
+    void EvmMemoryArena::debug_clear_cache() noexcept
+    {
+        auto &regions = region_cache.regions;
+        for (uint8_t *const region : regions) {
+            unmap_region(region);
+        }
+        regions.clear();
+    }
+}
@@ -0,0 +1,78 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace monad::vm::runtime
+{
+    /// Backing store for EVM memory.
+    enum class MemoryBacking : uint8_t
+    {
+        /// A cached 4 kB chunk, reallocated and copied on expansion.
+        Heap,
+        /// A region from `EvmMemoryArena`, expanded in place.
+        Arena,
+    };
+
+    /// Thread local pool of large, lazily committed virtual regions used as
+    /// EVM memory. A region is reserved once with `MAP_NORESERVE`, so memory
+    /// expansion within it never copies and only touches the pages the
+    /// contract actually writes. Beyond its first 2 MB a region is advised
+    /// for transparent huge pages, so contracts that grow memory to megabytes
+    /// take one fault per 2 MB rather than per 4 kB.
+    ///
+    /// Released regions are zeroed before they are cached: a small dirty
+    /// prefix with `memset`, and the rest by dropping the pages, which the
+    /// kernel zero fills on the next touch.
+    class EvmMemoryArena
+    {
+    public:
+        static constexpr uint32_t region_size = uint32_t{1} << 25;
+
+        /// Capacity reported by arena backed memory. It is never a multiple
+        /// of 64, so it cannot collide with a heap capacity, which is always
+        /// twice a word aligned size.
+        static constexpr uint32_t capacity = region_size - 32;
+
+        static constexpr size_t small_page_prefix = size_t{1} << 21;
+
+        /// Dirty bytes up to this size are zeroed with `memset` on release,
+        /// anything beyond is returned to the kernel.
+        static constexpr size_t memset_limit = size_t{1} << 16;
+
+        static constexpr size_t max_cached_regions_per_thread = 64;
+
+        /// Upper bound on regions reserved across all threads, cached or in
+        /// use. Deep call stacks beyond this fall back to heap memory.
+        static constexpr size_t max_reserved_regions = 4096;
+
+        /// Returns a zeroed region of `region_size` bytes, or nullptr if the
+        /// reservation limit is reached or the mapping fails.
+        static uint8_t *acquire() noexcept;
+
+        /// Return a region obtained from `acquire`. Only its first
+        /// `dirty_size` bytes may have been written.
+        static void release(uint8_t *region, uint32_t dirty_size) noexcept;
+
+        /// Number of regions reserved across all threads.
+        static size_t reserved_regions() noexcept;
+
+        /// Unmap the regions cached by the calling thread, for testing.
+        static void debug_clear_cache() noexcept;
+    };
+}
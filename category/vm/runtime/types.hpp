@@ -18,6 +18,7 @@
 #include <category/vm/core/assert.h>
 #include <category/vm/runtime/allocator.hpp>
 #include <category/vm/runtime/bin.hpp>
+#include <category/vm/runtime/memory_arena.hpp>
 #include <category/vm/runtime/transmute.hpp>
 #include <category/vm/runtime/uint256.hpp>
 
@@ -104,13 +105,24 @@ namespace monad::vm::runtime
 
         Memory() = delete;
 
-        explicit Memory(EvmMemoryAllocator allocator)
+        explicit Memory(
+            EvmMemoryAllocator allocator,
+            MemoryBacking backing = MemoryBacking::Heap)
             : allocator_{allocator}
             , size{}
-            , capacity{initial_capacity}
-            , data{allocator_.aligned_alloc_cached()}
+            , capacity{}
+            , data{}
             , cost{}
         {
+            if (backing == MemoryBacking::Arena) {
+                data = EvmMemoryArena::acquire();
+                if (data) {
+                    capacity = EvmMemoryArena::capacity;
+                    return;
+                }
+            }
+            capacity = initial_capacity;
+            data = allocator_.aligned_alloc_cached();
             memset(data, 0, capacity);
         }
 
@@ -126,7 +138,7 @@ namespace monad::vm::runtime
 
         Memory &operator=(Memory &&m) noexcept
         {
-            dealloc(data);
+            dealloc(data, size);
 
             size = m.size;
             capacity = m.capacity;
@@ -143,7 +155,7 @@ namespace monad::vm::runtime
 
         ~Memory()
         {
-            dealloc(data);
+            dealloc(data, size);
         }
 
         [[gnu::always_inline]]
@@ -155,12 +167,17 @@ namespace monad::vm::runtime
             cost = 0;
         }
 
+        /// Free `d`, of which only the first `dirty_size` bytes may have
+        /// been written, according to the current `capacity`.
         [[gnu::always_inline]]
-        void dealloc(uint8_t *d)
+        void dealloc(uint8_t *d, uint32_t dirty_size)
         {
             if (capacity == initial_capacity) {
                 allocator_.free_cached(d);
             }
+            else if (capacity == EvmMemoryArena::capacity) {
+                EvmMemoryArena::release(d, dirty_size);
+            }
             else {
                 std::free(d);
             }
@@ -175,9 +192,9 @@ namespace monad::vm::runtime
     struct Context
     {
         static Context from(
-            EvmMemoryAllocator mem_alloc, ChainParams const &chain_params,
-            evmc_host_interface const *host, evmc_host_context *context,
-            evmc_message const *msg,
+            EvmMemoryAllocator mem_alloc, MemoryBacking mem_backing,
+            ChainParams const &chain_params, evmc_host_interface const *host,
+            evmc_host_context *context, evmc_message const *msg,
             std::span<std::uint8_t const> code) noexcept;
 
         static Context empty() noexcept;
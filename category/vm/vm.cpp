@@ -38,10 +38,11 @@ namespace monad::vm
 
     VM::VM(
         bool enable_async, std::size_t max_stack_cache,
-        std::size_t max_memory_cache)
+        std::size_t max_memory_cache, runtime::MemoryBacking memory_backing)
         : compiler_{enable_async}
         , stack_allocator_{max_stack_cache}
         , memory_allocator_{max_memory_cache}
+        , memory_backing_{memory_backing}
     {
     }
 
@@ -55,6 +56,7 @@ namespace monad::vm
         auto const &icode = vcode->intercode();
         auto rt_ctx = runtime::Context::from(
             memory_allocator_,
+            memory_backing_,
             params,
             host_itf,
             host_ctx,
@@ -84,7 +86,13 @@ namespace monad::vm
         auto const *const host_itf = &host.get_interface();
         auto *const host_ctx = host.to_context();
         auto rt_ctx = runtime::Context::from(
-            memory_allocator_, params, host_itf, host_ctx, msg, code);
+            memory_allocator_,
+            memory_backing_,
+            params,
+            host_itf,
+            host_ctx,
+            msg,
+            code);
 
         // Install new runtime context:
         auto *const prev_rt_ctx = host.set_runtime_context(&rt_ctx);
@@ -109,7 +117,13 @@ namespace monad::vm
     {
         auto const &icode = vcode->intercode();
         auto rt_ctx = runtime::Context::from(
-            memory_allocator_, params, host, host_ctx, msg, icode->code_span());
+            memory_allocator_,
+            memory_backing_,
+            params,
+            host,
+            host_ctx,
+            msg,
+            icode->code_span());
         return execute_impl<traits>(rt_ctx, code_hash, vcode);
     }
 
@@ -122,7 +136,13 @@ namespace monad::vm
         std::span<uint8_t const> code)
     {
         auto rt_ctx = runtime::Context::from(
-            memory_allocator_, params, host, host_ctx, msg, code);
+            memory_allocator_,
+            memory_backing_,
+            params,
+            host,
+            host_ctx,
+            msg,
+            code);
         return execute_bytecode_impl<traits>(rt_ctx, code);
     }
 
@@ -135,7 +155,13 @@ namespace monad::vm
         SharedIntercode const &icode)
     {
         auto rt_ctx = runtime::Context::from(
-            memory_allocator_, params, host, host_ctx, msg, icode->code_span());
+            memory_allocator_,
+            memory_backing_,
+            params,
+            host,
+            host_ctx,
+            msg,
+            icode->code_span());
         return execute_intercode_impl<traits>(rt_ctx, icode);
     }
 
@@ -229,7 +255,13 @@ namespace monad::vm
         SharedIntercode const &icode, compiler::native::entrypoint_t entry)
     {
         auto rt_ctx = runtime::Context::from(
-            memory_allocator_, params, host, host_ctx, msg, icode->code_span());
+            memory_allocator_,
+            memory_backing_,
+            params,
+            host,
+            host_ctx,
+            msg,
+            icode->code_span());
         return execute_native_entrypoint_impl(rt_ctx, entry);
     }
 
@@ -22,6 +22,7 @@
 #include <category/vm/host.hpp>
 #include <category/vm/interpreter/execute.hpp>
 #include <category/vm/runtime/allocator.hpp>
+#include <category/vm/runtime/memory_arena.hpp>
 #include <category/vm/utils/debug.hpp>
 
 namespace monad::vm
@@ -124,6 +125,7 @@ namespace monad::vm
         CompilerConfig compiler_config_;
         runtime::EvmStackAllocator stack_allocator_;
         runtime::EvmMemoryAllocator memory_allocator_;
+        runtime::MemoryBacking memory_backing_;
 
     public:
         explicit VM(
@@ -131,7 +133,9 @@ namespace monad::vm
             std::size_t max_stack_cache_byte_size =
                 runtime::EvmStackAllocator::DEFAULT_MAX_CACHE_BYTE_SIZE,
             std::size_t max_memory_cache_byte_size =
-                runtime::EvmMemoryAllocator::DEFAULT_MAX_CACHE_BYTE_SIZE);
+                runtime::EvmMemoryAllocator::DEFAULT_MAX_CACHE_BYTE_SIZE,
+            runtime::MemoryBacking memory_backing =
+                runtime::MemoryBacking::Arena);
 
         std::optional<SharedVarcode>
         find_varcode(evmc::bytes32 const &code_hash)
@@ -14,12 +14,15 @@
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "event.hpp"
+#include "replay_ethereum.hpp"
 #include "runloop_ethereum.hpp"
 #include "runloop_monad.hpp"
 
 #include <category/core/assert.h>
 #include <category/core/basic_formatter.hpp>
+#include <category/core/byte_string.hpp>
 #include <category/core/config.hpp>
+#include <category/core/cpuset.h>
 #include <category/core/fiber/priority_pool.hpp>
 #include <category/core/likely.h>
 #include <category/core/monad_exception.hpp>
@@ -33,8 +36,11 @@
 #include <category/execution/ethereum/core/rlp/block_rlp.hpp>
 #include <category/execution/ethereum/db/block_db.hpp>
 #include <category/execution/ethereum/db/db_cache.hpp>
+#include <category/execution/ethereum/db/flat_state_index.hpp>
+#include <category/execution/ethereum/db/storage_filter_index.hpp>
 #include <category/execution/ethereum/db/trie_db.hpp>
 #include <category/execution/ethereum/event/exec_event_ctypes.h>
+#include <category/execution/ethereum/precompile_cache.hpp>
 #include <category/execution/ethereum/precompiles.hpp>
 #include <category/execution/ethereum/state2/block_state.hpp>
 #include <category/execution/ethereum/trace/call_tracer.hpp>
@@ -47,6 +53,7 @@
 #include <category/statesync/statesync_server.h>
 #include <category/statesync/statesync_server_context.hpp>
 #include <category/statesync/statesync_server_network.hpp>
+#include <category/vm/intercode_cache.hpp>
 #include <category/vm/vm.hpp>
 
 #include <CLI/CLI.hpp>
@@ -63,8 +70,11 @@
 #include <cstdlib>
 #include <exception>
 #include <filesystem>
+#include <fstream>
 #include <limits>
 #include <optional>
+#include <ranges>
+#include <sched.h>
 #include <signal.h>
 #include <stdexcept>
 #include <string>
@@ -128,12 +138,21 @@ try {
     unsigned nfibers = 256;
     bool no_compaction = false;
     bool trace_calls = false;
+    unsigned precompile_cache_mb = 0;
+    unsigned intercode_cache_mb = 1024;
+    size_t flat_index_entries = 0;
+    size_t storage_filter_accounts = 0;
+    size_t storage_filter_max_slots = 1ul << 22;
     std::string exec_event_ring_config;
+    std::string worker_cpus;
     unsigned sq_thread_cpu = static_cast<unsigned>(get_nprocs() - 1);
     unsigned ro_sq_thread_cpu = static_cast<unsigned>(get_nprocs() - 2);
     std::vector<fs::path> dbname_paths;
+    std::vector<fs::path> low_latency_dbname_paths;
     fs::path snapshot;
     fs::path dump_snapshot;
+    bool dump_snapshot_ndjson = false;
+    std::vector<fs::path> replay_checkpoints;
     std::string statesync;
     auto log_level = quill::LogLevel::Info;
 
@@ -154,6 +173,13 @@ try {
         ->transform(CLI::CheckedTransformer(log_level_map, CLI::ignore_case));
     cli.add_option("--nthreads", nthreads, "number of threads");
     cli.add_option("--nfibers", nfibers, "number of fibers");
+    cli.add_option(
+        "--worker_cpus",
+        worker_cpus,
+        "cpus to pin worker threads to, e.g. 0-47. Worker i is pinned to "
+        "the i-th lowest numbered cpu, wrapping around. Worker threads "
+        "steal from neighbouring workers first, which share a NUMA node "
+        "when its cpus are numbered contiguously");
     cli.add_flag("--no-compaction", no_compaction, "disable compaction");
     cli.add_option(
         "--sq_thread_cpu",
@@ -164,35 +190,96 @@ try {
         "--ro_sq_thread_cpu",
         ro_sq_thread_cpu,
         "sq_thread_cpu for the read only db");
-    cli.add_option(
+    auto const check_snapshot = [](std::string const &s) -> std::string {
+        fs::path const path{s};
+        if (!fs::is_regular_file(path / "accounts")) {
+            return "missing accounts";
+        }
+        if (!fs::is_regular_file(path / "code")) {
+            return "missing code";
+        }
+        return "";
+    };
+    auto const check_replay_checkpoint =
+        [&](std::string const &s) -> std::string {
+        if (!replay_checkpoint_block_num(s).has_value()) {
+            return "checkpoint directory name is not a block number";
+        }
+        return check_snapshot(s);
+    };
+    auto *const db_option = cli.add_option(
         "--db",
         dbname_paths,
         "A comma-separated list of previously created database paths. You can "
         "configure the storage pool with one or more files/devices. If no "
         "value is passed, the replay will run with an in-memory triedb");
+    cli.add_option(
+        "--low_latency_db",
+        low_latency_dbname_paths,
+        "A comma-separated subset of the --db paths which are low latency "
+        "devices. Recent trie data is placed on these, and compaction "
+        "migrates older data onto the remaining devices");
     cli.add_option(
         "--dump_snapshot",
         dump_snapshot,
         "directory to dump state to at the end of run");
+    cli.add_flag(
+        "--dump_snapshot_ndjson",
+        dump_snapshot_ndjson,
+        "stream the dumped state as newline-delimited JSON to state.ndjson, "
+        "on up to --nthreads threads, instead of building state.json in "
+        "memory");
     cli.add_flag("--trace_calls", trace_calls, "enable call tracing");
+    cli.add_option(
+           "--precompile_cache_mb",
+           precompile_cache_mb,
+           "size in MiB of the cache of expensive precompile results, keyed "
+           "by input hash. 0 disables the cache")
+        ->check(CLI::Range(0u, 4095u));
+    cli.add_option(
+           "--intercode_cache_mb",
+           intercode_cache_mb,
+           "size in MiB of the process wide cache of analysed contract code, "
+           "keyed by code hash. 0 disables the cache")
+        ->check(CLI::Range(0u, 65535u));
+    cli.add_option(
+        "--flat_index_entries",
+        flat_index_entries,
+        "maximum number of accounts, and of storage slots, in the flat index "
+        "of the latest state consulted before the trie. Only used with an "
+        "on disk db. 0 disables the index");
+    cli.add_option(
+        "--storage_filter_accounts",
+        storage_filter_accounts,
+        "maximum number of accounts with a filter over the slots of their "
+        "storage, used to skip trie reads of absent slots. Only used with an "
+        "on disk db. 0 disables the filters");
+    cli.add_option(
+        "--storage_filter_max_slots",
+        storage_filter_max_slots,
+        "accounts with more storage slots than this are not filtered");
     auto *const group =
         cli.add_option_group("load", "methods to initialize the db");
-    group
-        ->add_option(
-            "--snapshot", snapshot, "snapshot file path to load db from")
-        ->check([](std::string const &s) -> std::string {
-            fs::path const path{s};
-            if (!fs::is_regular_file(path / "accounts")) {
-                return "missing accounts";
-            }
-            if (!fs::is_regular_file(path / "code")) {
-                return "missing code";
-            }
-            return "";
-        });
-    group->add_option(
+    auto *const snapshot_option =
+        group
+            ->add_option(
+                "--snapshot", snapshot, "snapshot file path to load db from")
+            ->check(check_snapshot);
+    auto *const statesync_option = group->add_option(
         "--statesync", statesync, "socket for statesync communication");
     group->require_option(0, 1);
+    cli.add_option(
+           "--replay_checkpoints",
+           replay_checkpoints,
+           "A comma-separated list of snapshot directories to replay "
+           "historical ethereum blocks from in parallel. The block range is "
+           "split at the checkpoints and each segment runs on its own "
+           "in-memory db with --nthreads threads, then segment boundaries "
+           "are verified to chain")
+        ->check(check_replay_checkpoint)
+        ->excludes(db_option)
+        ->excludes(snapshot_option)
+        ->excludes(statesync_option);
     CLI::Option const *const exec_event_ring_option =
         cli.add_option(
                "--exec-event-ring",
@@ -261,6 +348,63 @@ try {
 
     MONAD_ASSERT(init_trusted_setup());
 
+    if (!replay_checkpoints.empty()) {
+        if (chain_config != CHAIN_CONFIG_ETHEREUM_MAINNET) {
+            LOG_ERROR("--replay_checkpoints requires ethereum_mainnet");
+            return EXIT_FAILURE;
+        }
+        uint64_t const begin_block_num =
+            std::ranges::min(
+                replay_checkpoints | std::views::transform([](auto const &p) {
+                    return replay_checkpoint_block_num(p).value();
+                })) +
+            1;
+        uint64_t const end_block_num =
+            (std::numeric_limits<uint64_t>::max() - begin_block_num + 1) <=
+                    nblocks
+                ? std::numeric_limits<uint64_t>::max()
+                : begin_block_num + nblocks - 1;
+        if (isatty(STDIN_FILENO)) {
+            signal(SIGINT, signal_handler);
+        }
+        signal(SIGTERM, signal_handler);
+        stop = 0;
+        EthereumMainnet const chain;
+        auto const result = replay_ethereum_parallel(
+            chain,
+            block_db_path,
+            replay_checkpoints,
+            end_block_num,
+            nthreads,
+            nfibers,
+            stop);
+        if (MONAD_UNLIKELY(result.has_error())) {
+            LOG_ERROR(
+                "replay failed with: {}",
+                result.assume_error().message().c_str());
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    std::optional<cpu_set_t> worker_cpuset;
+    if (!worker_cpus.empty()) {
+        worker_cpuset = monad_parse_cpuset(worker_cpus.data());
+        cpu_set_t allowed;
+        MONAD_ASSERT(sched_getaffinity(0, sizeof(allowed), &allowed) == 0);
+        cpu_set_t unavailable;
+        CPU_XOR(&unavailable, &*worker_cpuset, &allowed);
+        CPU_AND(&unavailable, &unavailable, &*worker_cpuset);
+        if (MONAD_UNLIKELY(
+                CPU_COUNT(&*worker_cpuset) == 0 ||
+                CPU_COUNT(&unavailable) != 0)) {
+            LOG_ERROR(
+                "--worker_cpus must name at least one cpu, all of which this "
+                "process may run on");
+            return EXIT_FAILURE;
+        }
+    }
+
     auto const db_in_memory = dbname_paths.empty();
     [[maybe_unused]] auto const load_start_time =
         std::chrono::steady_clock::now();
@@ -283,7 +427,8 @@ try {
                     .wr_buffers = 32,
                     .uring_entries = 128,
                     .sq_thread_cpu = sq_thread_cpu,
-                    .dbname_paths = dbname_paths}};
+                    .dbname_paths = dbname_paths,
+                    .low_latency_dbname_paths = low_latency_dbname_paths}};
         }
         machine = std::make_unique<InMemoryMachine>();
         return mpt::Db{*machine};
@@ -305,7 +450,20 @@ try {
         MONAD_ASSERT(false);
     }();
 
-    TrieDb triedb{db}; // init block number to latest finalized block
+    std::optional<FlatStateIndex> flat_index;
+    if (flat_index_entries > 0 && db.is_on_disk()) {
+        flat_index.emplace(flat_index_entries);
+    }
+    std::optional<StorageFilterIndex> storage_filters;
+    if (storage_filter_accounts > 0 && db.is_on_disk()) {
+        storage_filters.emplace(
+            storage_filter_accounts, storage_filter_max_slots);
+    }
+    // init block number to latest finalized block
+    TrieDb triedb{
+        db,
+        flat_index ? &*flat_index : nullptr,
+        storage_filters ? &*storage_filters : nullptr};
     // Note: in memory db block number is always zero
     uint64_t const init_block_num = [&] {
         if (!snapshot.empty()) {
@@ -321,10 +479,12 @@ try {
 
             // load the eth header for snapshot
             BlockDb block_db{block_db_path};
-            Block block;
+            BlockHeader header;
             MONAD_ASSERT_PRINTF(
-                block_db.get(n, block), "FATAL: Could not load block %lu", n);
-            load_header(db, block.header);
+                block_db.get_header(n, header),
+                "FATAL: Could not load block %lu",
+                n);
+            load_header(db, header);
             return n;
         }
         else if (!db.root().is_valid()) {
@@ -381,7 +541,11 @@ try {
         start_block_num,
         nblocks);
 
-    fiber::PriorityPool priority_pool{nthreads, nfibers};
+    fiber::PriorityPool priority_pool{
+        nthreads,
+        nfibers,
+        false,
+        worker_cpuset ? &*worker_cpuset : nullptr};
 
     auto const start_time = std::chrono::steady_clock::now();
 
@@ -416,6 +580,16 @@ try {
             : block_num + nblocks - 1;
 
     vm::VM vm;
+    std::optional<PrecompileCache> precompile_cache;
+    if (precompile_cache_mb > 0) {
+        precompile_cache.emplace(uint32_t{precompile_cache_mb} << 20);
+        set_precompile_cache(&*precompile_cache);
+    }
+    std::optional<vm::IntercodeCache> intercode_cache;
+    if (intercode_cache_mb > 0) {
+        intercode_cache.emplace(uint32_t{intercode_cache_mb} << 10);
+        vm::set_intercode_cache(&*intercode_cache);
+    }
     DbCache db_cache = ctx ? DbCache{*ctx} : DbCache{triedb};
     auto const result = [&] {
         switch (chain_config) {
@@ -466,7 +640,7 @@ try {
             "number of blocks run = {}, time_elapsed = {}, num transactions = "
             "{}, "
             "tps = {}, gps = {} M"
-            "{}{}",
+            "{}{}{}{}",
             block_num,
             nblocks,
             elapsed,
@@ -477,8 +651,12 @@ try {
                 (1'000'000 *
                  std::max(1UL, static_cast<uint64_t>(elapsed.count()))),
             vm.print_compiler_stats(),
-            vm.print_total_counts());
+            vm.print_total_counts(),
+            precompile_cache ? precompile_cache->print_stats() : "",
+            intercode_cache ? intercode_cache->print_stats() : "");
     }
+    set_precompile_cache(nullptr);
+    vm::set_intercode_cache(nullptr);
 
     if (sync != nullptr) {
         sync_thread.request_stop();
@@ -494,7 +672,43 @@ try {
             .concurrent_read_io_limit = 128});
         mpt::Db db{io_ctx};
         TrieDb ro_db{db};
-        write_to_file(ro_db.to_json(), dump_snapshot, block_num);
+        if (dump_snapshot_ndjson) {
+            auto const dir = dump_snapshot / std::to_string(block_num);
+            fs::create_directory(dir);
+            MONAD_ASSERT(fs::is_directory(dir));
+            auto const file = dir / "state.ndjson";
+            MONAD_ASSERT(!fs::exists(file));
+            std::ofstream ofile(file, std::ios::binary);
+            auto const stats = ro_db.export_state(
+                StateExportFormat::ndjson,
+                [&](byte_string_view const chunk) {
+                    ofile.write(
+                        reinterpret_cast<char const *>(chunk.data()),
+                        static_cast<std::streamsize>(chunk.size()));
+                },
+                std::clamp(nthreads, 1u, 16u));
+            ofile.flush();
+            MONAD_ASSERT(ofile.good());
+            auto const elapsed =
+                std::chrono::duration_cast<std::chrono::milliseconds>(
+                    stats.elapsed);
+            LOG_INFO(
+                "Finished streaming state at block = {}: {} accounts, {} "
+                "storage slots, {} bytes, time elapsed = {}, {:.1f} MB/s",
+                block_num,
+                stats.accounts,
+                stats.storage_slots,
+                stats.bytes,
+                elapsed,
+                static_cast<double>(stats.bytes) /
+                    std::max<double>(
+                        std::chrono::duration<double>(stats.elapsed).count(),
+                        1e-9) /
+                    1e6);
+        }
+        else {
+            write_to_file(ro_db.to_json(), dump_snapshot, block_num);
+        }
     }
     return result.has_error() ? EXIT_FAILURE : EXIT_SUCCESS;
 }
@@ -0,0 +1,269 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include "replay_ethereum.hpp"
+#include "runloop_ethereum.hpp"
+
+#include <category/core/assert.h>
+#include <category/core/bytes.hpp>
+#include <category/core/config.hpp>
+#include <category/core/fiber/priority_pool.hpp>
+#include <category/execution/ethereum/block_hash_buffer.hpp>
+#include <category/execution/ethereum/chain/chain.hpp>
+#include <category/execution/ethereum/core/block.hpp>
+#include <category/execution/ethereum/core/fmt/bytes_fmt.hpp>
+#include <category/execution/ethereum/db/block_db.hpp>
+#include <category/execution/ethereum/db/db_cache.hpp>
+#include <category/execution/ethereum/db/trie_db.hpp>
+#include <category/execution/ethereum/db/util.hpp>
+#include <category/execution/ethereum/validate_block.hpp>
+#include <category/mpt/db.hpp>
+#include <category/vm/vm.hpp>
+
+#include <quill/Quill.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+
+MONAD_ANONYMOUS_NAMESPACE_BEGIN
+
+struct ReplaySegment
+{
+    std::filesystem::path checkpoint;
+    uint64_t checkpoint_block_num;
+    uint64_t end_block_num; // inclusive
+    uint64_t block_num; // next block to execute
+    bytes32_t initial_state_root{};
+    bytes32_t final_state_root{};
+    std::optional<Result<std::pair<uint64_t, uint64_t>>> result{};
+};
+
+void run_segment(
+    Chain const &chain, std::filesystem::path const &ledger_dir,
+    ReplaySegment &segment, unsigned const nthreads, unsigned const nfibers,
+    sig_atomic_t volatile &stop)
+{
+    auto const n = segment.checkpoint_block_num;
+    InMemoryMachine machine;
+    mpt::Db db{machine};
+    {
+        std::ifstream accounts(segment.checkpoint / "accounts");
+        std::ifstream code(segment.checkpoint / "code");
+        load_from_binary(db, accounts, code, n);
+    }
+    BlockDb block_db{ledger_dir};
+    BlockHeader header;
+    MONAD_ASSERT_PRINTF(
+        block_db.get_header(n, header), "FATAL: Could not load block %lu", n);
+    load_header(db, header);
+
+    TrieDb triedb{db};
+    segment.initial_state_root = triedb.state_root();
+    BlockHashBufferFinalized block_hash_buffer;
+    MONAD_ASSERT(init_block_hash_buffer_from_blockdb(
+        block_db, n + 1, block_hash_buffer));
+
+    LOG_INFO(
+        "Replay segment from checkpoint {} (state root = {}) to block {}",
+        n,
+        segment.initial_state_root,
+        segment.end_block_num);
+
+    fiber::PriorityPool priority_pool{nthreads, nfibers};
+    vm::VM vm;
+    DbCache db_cache{triedb};
+    segment.block_num = n + 1;
+    segment.result = runloop_ethereum(
+        chain,
+        ledger_dir,
+        db_cache,
+        vm,
+        block_hash_buffer,
+        priority_pool,
+        segment.block_num,
+        segment.end_block_num,
+        stop,
+        false);
+    segment.final_state_root = triedb.state_root();
+    if (segment.result->has_error()) {
+        // the other segments cannot chain through this one
+        stop = 1;
+    }
+}
+
+MONAD_ANONYMOUS_NAMESPACE_END
+
+MONAD_NAMESPACE_BEGIN
+
+Result<std::pair<uint64_t, uint64_t>> replay_ethereum_parallel(
+    Chain const &chain, std::filesystem::path const &ledger_dir,
+    std::vector<std::filesystem::path> const &checkpoints,
+    uint64_t const end_block_num, unsigned const nthreads,
+    unsigned const nfibers, sig_atomic_t volatile &stop)
+{
+    MONAD_ASSERT(!checkpoints.empty());
+    std::vector<ReplaySegment> segments;
+    for (auto const &checkpoint : checkpoints) {
+        auto const checkpoint_block_num =
+            replay_checkpoint_block_num(checkpoint);
+        MONAD_ASSERT_PRINTF(
+            checkpoint_block_num.has_value(),
+            "replay checkpoint %s is not named by a block number",
+            checkpoint.c_str());
+        segments.push_back(
+            {.checkpoint = checkpoint,
+             .checkpoint_block_num = *checkpoint_block_num,
+             .end_block_num = end_block_num,
+             .block_num = 0});
+    }
+    std::ranges::sort(segments, {}, &ReplaySegment::checkpoint_block_num);
+    for (size_t i = 0; i + 1 < segments.size(); ++i) {
+        MONAD_ASSERT_PRINTF(
+            segments[i].checkpoint_block_num <
+                segments[i + 1].checkpoint_block_num,
+            "duplicate replay checkpoint for block %lu",
+            segments[i].checkpoint_block_num);
+        segments[i].end_block_num = segments[i + 1].checkpoint_block_num;
+    }
+    MONAD_ASSERT_PRINTF(
+        segments.back().checkpoint_block_num < end_block_num,
+        "last replay checkpoint %lu is not before end block %lu",
+        segments.back().checkpoint_block_num,
+        end_block_num);
+
+    LOG_INFO(
+        "Replaying blocks {} to {} in {} segments, {} threads each",
+        segments.front().checkpoint_block_num + 1,
+        end_block_num,
+        segments.size(),
+        nthreads);
+
+    auto const start_time = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (size_t i = 0; i < segments.size(); ++i) {
+            threads.emplace_back([&, i] {
+                std::string const name = "replay " + std::to_string(i);
+                pthread_setname_np(pthread_self(), name.c_str());
+                run_segment(
+                    chain, ledger_dir, segments[i], nthreads, nfibers, stop);
+            });
+        }
+    }
+    auto const elapsed = std::chrono::steady_clock::now() - start_time;
+
+    // a failing segment stops the others early, so report its error first
+    for (auto const &segment : segments) {
+        MONAD_ASSERT(segment.result.has_value());
+        if (segment.result->has_error()) {
+            LOG_ERROR(
+                "replay segment from checkpoint {} failed at block {}",
+                segment.checkpoint_block_num,
+                segment.block_num);
+            return segment.result->assume_error();
+        }
+    }
+    // with no segment failed, only the user can have set stop
+    bool const interrupted = stop != 0;
+
+    uint64_t nblocks = 0;
+    uint64_t ntxs = 0;
+    uint64_t gas = 0;
+    size_t unverified = 0;
+    for (size_t i = 0; i < segments.size(); ++i) {
+        auto const &segment = segments[i];
+        nblocks += segment.block_num - segment.checkpoint_block_num - 1;
+        ntxs += segment.result->assume_value().first;
+        gas += segment.result->assume_value().second;
+        if (i + 1 == segments.size()) {
+            continue;
+        }
+        // a segment stopped early cannot be chained to the next one
+        if (segment.block_num != segment.end_block_num + 1) {
+            if (!interrupted) {
+                LOG_ERROR(
+                    "replay segment from checkpoint {} stopped at block {} "
+                    "before reaching checkpoint {}",
+                    segment.checkpoint_block_num,
+                    segment.block_num,
+                    segment.end_block_num);
+                return outcome_e::errc::operation_canceled;
+            }
+            ++unverified;
+            continue;
+        }
+        auto const &next = segments[i + 1];
+        if (segment.final_state_root != next.initial_state_root) {
+            LOG_ERROR(
+                "replay segment from checkpoint {} ends with state root {} but "
+                "checkpoint {} has state root {}",
+                segment.checkpoint_block_num,
+                segment.final_state_root,
+                next.checkpoint_block_num,
+                next.initial_state_root);
+            return BlockError::WrongMerkleRoot;
+        }
+    }
+
+    if (interrupted) {
+        LOG_WARNING(
+            "Replay stopped after {} blocks, {} of {} segment boundaries were "
+            "not verified",
+            nblocks,
+            unverified,
+            segments.size() - 1);
+        return std::pair{ntxs, gas};
+    }
+
+    auto const elapsed_us = std::max(
+        static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed)
+                .count()),
+        1UL);
+    LOG_INFO(
+        "Replayed {} blocks in {} segments, time elapsed = {}, "
+        "blocks/s = {}, tps = {}, gps = {} M",
+        nblocks,
+        segments.size(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed),
+        nblocks * 1'000'000 / elapsed_us,
+        ntxs * 1'000'000 / elapsed_us,
+        gas / elapsed_us);
+    return std::pair{ntxs, gas};
+}
+
+std::optional<uint64_t>
+replay_checkpoint_block_num(std::filesystem::path const &checkpoint)
+{
+    auto const name = checkpoint.stem().string();
+    uint64_t block_num = 0;
+    auto const *const end = name.data() + name.size();
+    auto const [ptr, ec] = std::from_chars(name.data(), end, block_num);
+    if (name.empty() || ec != std::errc{} || ptr != end) {
+        return std::nullopt;
+    }
+    return block_num;
+}
+
+MONAD_NAMESPACE_END
@@ -0,0 +1,56 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#pragma once
+
+#include <category/core/config.hpp>
+#include <category/core/result.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <signal.h>
+
+MONAD_NAMESPACE_BEGIN
+
+struct Chain;
+
+// Replay historical Ethereum blocks in parallel. The range is split at the
+// given binary checkpoints (directories named by their block number, as for
+// --snapshot). Each segment loads its checkpoint into its own in-memory trie
+// and runs on its own thread and priority pool, up to the next checkpoint's
+// block or `end_block_num` for the last one. On completion the state root
+// each segment finishes at is checked against the next segment's starting
+// state root. A segment which fails sets `stop`, so the others finish early,
+// and its error is returned, as is an error for a segment which stops short
+// of the next checkpoint other than by a user requested stop. Otherwise
+// returns the total number of transactions and gas, logging the boundaries
+// left unverified if the user stopped the replay. Every checkpoint must be
+// named by its block number, see replay_checkpoint_block_num().
+Result<std::pair<uint64_t, uint64_t>> replay_ethereum_parallel(
+    Chain const &, std::filesystem::path const &ledger_dir,
+    std::vector<std::filesystem::path> const &checkpoints,
+    uint64_t end_block_num, unsigned nthreads, unsigned nfibers,
+    sig_atomic_t volatile &stop);
+
+// The block number a checkpoint directory is named by, or nullopt if its
+// name is not a decimal block number
+std::optional<uint64_t>
+replay_checkpoint_block_num(std::filesystem::path const &checkpoint);
+
+MONAD_NAMESPACE_END
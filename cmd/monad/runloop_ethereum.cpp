@@ -16,6 +16,7 @@
 #include "runloop_ethereum.hpp"
 
 #include <category/core/assert.h>
+#include <category/core/byte_string.hpp>
 #include <category/core/bytes.hpp>
 #include <category/core/config.hpp>
 #include <category/core/fiber/priority_pool.hpp>
@@ -111,17 +112,19 @@ Result<void> process_ethereum_block(
         }
     }
 
-    // Call tracer initialization
-    std::vector<std::vector<CallFrame>> call_frames{block.transactions.size()};
+    // Call tracer initialization: each tracer writes the encoded call frames
+    // of its transaction once the transaction has finished
+    std::vector<byte_string> call_frames(block.transactions.size());
     std::vector<std::unique_ptr<CallTracerBase>> call_tracers{
         block.transactions.size()};
     for (unsigned i = 0; i < block.transactions.size(); ++i) {
-        call_tracers[i] =
-            enable_tracing
-                ? std::unique_ptr<CallTracerBase>{std::make_unique<CallTracer>(
-                      block.transactions[i], call_frames[i])}
-                : std::unique_ptr<CallTracerBase>{
-                      std::make_unique<NoopCallTracer>()};
+        if (enable_tracing) {
+            call_tracers[i] = std::make_unique<ArenaCallTracer>(
+                block.transactions[i], call_frames[i]);
+        }
+        else {
+            call_tracers[i] = std::make_unique<NoopCallTracer>();
+        }
     }
 
     // Core execution: transaction-level EVM execution that tracks state
@@ -178,7 +181,8 @@ Result<void> process_ethereum_block(
     LOG_INFO(
         "__exec_block,bl={:8},ts={}"
         ",tx={:5},rt={:4},rtp={:5.2f}%"
-        ",sr={:>7},txe={:>8},cmt={:>8},tot={:>8},tpse={:5},tps={:5}"
+        ",sr={:>7},txs={:>6},txe={:>8},cmt={:>8},tot={:>8},tpse={:5}"
+        ",tps={:5},stl={:>8},rd={:6}/{:>8},pc={:>8}"
         ",gas={:9},gpse={:4},gps={:3}{}{}{}",
         block.header.number,
         std::chrono::duration_cast<std::chrono::milliseconds>(
@@ -189,6 +193,7 @@ Result<void> process_ethereum_block(
         100.0 * (double)block_metrics.num_retries() /
             std::max(1.0, (double)block.transactions.size()),
         sender_recovery_time,
+        block_metrics.tx_submit_time(),
         block_metrics.tx_exec_time(),
         commit_time,
         block_time,
@@ -196,6 +201,10 @@ Result<void> process_ethereum_block(
             (uint64_t)std::max(1L, block_metrics.tx_exec_time().count()),
         block.transactions.size() * 1'000'000 /
             (uint64_t)std::max(1L, block_time.count()),
+        block_metrics.tx_stall_time(),
+        block_metrics.txn_profile().db_read_count,
+        block_metrics.db_read_time(),
+        block_metrics.precompile_time(),
         output_header.gas_used,
         output_header.gas_used /
             (uint64_t)std::max(1L, block_metrics.tx_exec_time().count()),
@@ -119,6 +119,7 @@ public:
 
         auto ctx = vm::runtime::Context::from(
             memory_allocator,
+            vm::runtime::MemoryBacking::Heap,
             {.max_initcode_size = 0xC000},
             interface,
             context,
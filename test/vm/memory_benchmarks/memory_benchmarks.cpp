@@ -0,0 +1,66 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/vm/runtime/allocator.hpp>
+#include <category/vm/runtime/bin.hpp>
+#include <category/vm/runtime/memory_arena.hpp>
+#include <category/vm/runtime/types.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <limits>
+
+using namespace monad::vm::runtime;
+
+namespace
+{
+    // Grow memory to `state.range(1)` bytes in `state.range(2)` byte steps,
+    // writing the last word after each step, as a contract filling memory
+    // with MSTORE would.
+    void expand_memory(benchmark::State &state)
+    {
+        auto const backing = static_cast<MemoryBacking>(state.range(0));
+        auto const target_size = static_cast<uint32_t>(state.range(1));
+        auto const step = static_cast<uint32_t>(state.range(2));
+
+        for (auto _ : state) {
+            auto ctx = Context::empty();
+            ctx.memory = Memory(EvmMemoryAllocator{}, backing);
+            ctx.gas_remaining = std::numeric_limits<std::int64_t>::max();
+
+            for (uint32_t size = step; size <= target_size; size += step) {
+                ctx.expand_memory(Bin<30>::unsafe_from(size));
+                ctx.memory.data[size - 1] = 0xFF;
+            }
+            benchmark::DoNotOptimize(ctx.memory.data);
+        }
+
+        state.SetBytesProcessed(
+            static_cast<int64_t>(state.iterations()) * target_size);
+        state.counters["reserved_regions"] =
+            static_cast<double>(EvmMemoryArena::reserved_regions());
+    }
+
+    BENCHMARK(expand_memory)
+        ->ArgNames({"backing", "size", "step"})
+        ->ArgsProduct(
+            {{static_cast<int64_t>(MemoryBacking::Heap),
+              static_cast<int64_t>(MemoryBacking::Arena)},
+             benchmark::CreateRange(1 << 12, 1 << 24, 16),
+             {32, 1 << 12}});
+}
+
+BENCHMARK_MAIN();
@@ -13,6 +13,7 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <category/vm/runtime/arithmetic_kernels.hpp>
 #include <category/vm/utils/evm-as/kernel-builder.hpp>
 
 #include <test/vm/utils/evm-as_utils.hpp>
@@ -24,6 +25,8 @@
 
 #include <algorithm>
 #include <cctype>
+#include <iostream>
+#include <map>
 #include <random>
 #include <regex>
 
@@ -39,6 +42,7 @@ struct CommandArguments
     std::vector<std::string> title_filters;
     std::vector<std::string> impl_filters;
     std::vector<std::string> seq_filters;
+    KernelIsa kernel_isa = detect_kernel_isa();
 };
 
 static CommandArguments parse_command_arguments(int argc, char **argv)
@@ -52,6 +56,14 @@ static CommandArguments parse_command_arguments(int argc, char **argv)
         "--impl-filter", args.impl_filters, "VM implementation regex");
     app.add_option(
         "--seq-filter", args.seq_filters, "Instruction sequence regex");
+    app.add_option(
+           "--kernel-isa",
+           args.kernel_isa,
+           "Arithmetic kernels used by MUL, MULMOD and EXP runtime calls")
+        ->transform(CLI::CheckedTransformer(
+            std::map<std::string, KernelIsa>{
+                {"bmi2", KernelIsa::Bmi2}, {"adx", KernelIsa::Adx}},
+            CLI::ignore_case));
 
     try {
         app.parse(argc, argv);
@@ -495,6 +507,14 @@ int main(int argc, char **argv)
 {
     auto const args = parse_command_arguments(argc, argv);
 
+    if (!select_arithmetic_kernels(args.kernel_isa)) {
+        std::cerr << "Kernel ISA " << kernel_isa_name(args.kernel_isa)
+                  << " is not supported by this CPU\n";
+        return 1;
+    }
+    std::cout << "Arithmetic kernels: "
+              << kernel_isa_name(arithmetic_kernels().isa) << "\n\n";
+
     init_llvm();
 
     BenchmarkBuilder(
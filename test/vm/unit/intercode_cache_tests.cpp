@@ -0,0 +1,74 @@
+// Copyright (C) 2025 Category Labs, Inc.
+//
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <category/vm/code.hpp>
+#include <category/vm/intercode_cache.hpp>
+
+#include <evmc/evmc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace monad::vm;
+
+TEST(IntercodeCache, AnalyseOnce)
+{
+    IntercodeCache cache;
+    evmc::bytes32 const hash{1};
+    std::vector<uint8_t> const code{0x60, 0x01, 0x5b, 0x00};
+
+    ASSERT_EQ(cache.find(hash), nullptr);
+    auto const icode = cache.analyse(hash, code);
+    ASSERT_NE(icode, nullptr);
+    ASSERT_EQ(icode->size(), code.size());
+    ASSERT_TRUE(icode->is_jumpdest(2));
+
+    ASSERT_EQ(cache.find(hash), icode);
+
+    // A racing analysis of the same code hash keeps the first intercode
+    ASSERT_EQ(cache.analyse(hash, code), icode);
+
+    auto const stats = cache.stats();
+    ASSERT_EQ(stats.hits, 1);
+    ASSERT_EQ(stats.misses, 1);
+    ASSERT_EQ(stats.entries, 1);
+}
+
+TEST(IntercodeCache, Insert)
+{
+    IntercodeCache cache;
+    evmc::bytes32 const hash{2};
+    auto const icode = make_shared_intercode({0x5b, 0x00});
+
+    cache.insert(hash, icode);
+    ASSERT_EQ(cache.find(hash), icode);
+    ASSERT_EQ(cache.stats().analysis_ns, 0);
+}
+
+TEST(IntercodeCache, Eviction)
+{
+    // Each entry weighs at least 3 kB
+    IntercodeCache cache{6};
+    std::vector<uint8_t> const code{0x00};
+
+    for (uint8_t i = 1; i <= 8; ++i) {
+        (void)cache.analyse(evmc::bytes32{i}, code);
+    }
+    ASSERT_LE(cache.stats().weight_kb, 6);
+    ASSERT_NE(cache.find(evmc::bytes32{8}), nullptr);
+    ASSERT_EQ(cache.find(evmc::bytes32{1}), nullptr);
+}
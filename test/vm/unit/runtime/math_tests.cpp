@@ -16,6 +16,7 @@
 #include "fixture.hpp"
 
 #include <category/vm/evm/traits.hpp>
+#include <category/vm/runtime/arithmetic_kernels.hpp>
 #include <category/vm/runtime/math.hpp>
 #include <category/vm/runtime/uint256.hpp>
 
@@ -23,7 +24,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <random>
 #include <utility>
 #include <vector>
 
@@ -239,3 +242,65 @@ TEST_F(RuntimeTest, ExpNew)
         0x6170C9D4CF040C5B5B784780A1BD33BA7B6BB3803AA626C24C21067A267C0001_u256);
     ASSERT_EQ(ctx_.gas_remaining, 0);
 }
+
+TEST(ArithmeticKernels, MatchGeneric)
+{
+    std::mt19937_64 rng{42};
+    auto const random_word = [&] {
+        // Mix in sparse and saturated limbs to exercise the carry chains
+        uint256_t x;
+        for (size_t i = 0; i < 4; ++i) {
+            switch (rng() % 4) {
+            case 0:
+                x[i] = 0;
+                break;
+            case 1:
+                x[i] = ~uint64_t{0};
+                break;
+            default:
+                x[i] = rng();
+            }
+        }
+        return x;
+    };
+
+    for (auto const isa : {KernelIsa::Bmi2, KernelIsa::Adx}) {
+        if (!is_kernel_isa_supported(isa)) {
+            continue;
+        }
+        auto const &k = arithmetic_kernels(isa);
+        ASSERT_EQ(k.isa, isa);
+        for (size_t i = 0; i < 10'000; ++i) {
+            auto const a = random_word();
+            auto const b = random_word();
+            auto const n = i % 8 == 0 ? uint256_t{0} : random_word();
+            auto const e = uint256_t{rng() % 512};
+
+            uint256_t r;
+            k.mul(&r, &a, &b);
+            ASSERT_EQ(r, a * b) << kernel_isa_name(isa);
+
+            r = a;
+            k.mul(&r, &r, &b);
+            ASSERT_EQ(r, a * b) << kernel_isa_name(isa);
+
+            k.mulmod(&r, &a, &b, &n);
+            ASSERT_EQ(r, n == 0 ? uint256_t{0} : mulmod(a, b, n))
+                << kernel_isa_name(isa);
+
+            k.exp(&r, &a, &e);
+            ASSERT_EQ(r, exp(a, e)) << kernel_isa_name(isa);
+        }
+    }
+}
+
+TEST(ArithmeticKernels, Selection)
+{
+    auto const detected = detect_kernel_isa();
+    EXPECT_TRUE(is_kernel_isa_supported(KernelIsa::Bmi2));
+    EXPECT_EQ(arithmetic_kernels().isa, detected);
+    EXPECT_TRUE(select_arithmetic_kernels(KernelIsa::Bmi2));
+    EXPECT_EQ(arithmetic_kernels().isa, KernelIsa::Bmi2);
+    EXPECT_TRUE(select_arithmetic_kernels(detected));
+    EXPECT_EQ(arithmetic_kernels().isa, detected);
+}
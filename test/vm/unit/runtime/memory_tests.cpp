@@ -17,11 +17,15 @@
 
 #include <category/vm/runtime/allocator.hpp>
 #include <category/vm/runtime/memory.hpp>
+#include <category/vm/runtime/memory_arena.hpp>
 #include <category/vm/runtime/types.hpp>
 #include <category/vm/runtime/uint256.hpp>
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
 
 using namespace monad::vm::runtime;
 using namespace monad::vm::compiler::test;
@@ -233,3 +237,67 @@ TEST_F(RuntimeTest, RuntimeIncreaseMemory)
             return b == 0;
         }));
 }
+
+TEST_F(RuntimeTest, ArenaMemoryExpandsInPlace)
+{
+    ctx_.memory = Memory(EvmMemoryAllocator{}, MemoryBacking::Arena);
+    ASSERT_EQ(ctx_.memory.capacity, EvmMemoryArena::capacity);
+
+    auto *const data = ctx_.memory.data;
+    ctx_.gas_remaining = std::numeric_limits<std::int64_t>::max();
+
+    ctx_.expand_memory(Bin<30>::unsafe_from(32));
+    ctx_.memory.data[31] = 0xFF;
+
+    ctx_.expand_memory(Bin<30>::unsafe_from(uint32_t{1} << 22));
+    ASSERT_EQ(ctx_.memory.size, uint32_t{1} << 22);
+    ASSERT_EQ(ctx_.memory.capacity, EvmMemoryArena::capacity);
+    ASSERT_EQ(ctx_.memory.data, data);
+    ASSERT_EQ(ctx_.memory.data[31], 0xFF);
+    ASSERT_TRUE(std::all_of(
+        ctx_.memory.data + 32,
+        ctx_.memory.data + ctx_.memory.size,
+        [](auto b) { return b == 0; }));
+}
+
+TEST_F(RuntimeTest, ArenaMemoryIsZeroedOnReuse)
+{
+    EvmMemoryArena::debug_clear_cache();
+
+    for (uint32_t const dirty_size : {uint32_t{64}, uint32_t{1} << 22}) {
+        uint8_t *data;
+        {
+            auto memory = Memory(EvmMemoryAllocator{}, MemoryBacking::Arena);
+            ASSERT_EQ(memory.capacity, EvmMemoryArena::capacity);
+            data = memory.data;
+            memory.size = dirty_size;
+            std::memset(memory.data, 0xAB, dirty_size);
+        }
+        auto memory = Memory(EvmMemoryAllocator{}, MemoryBacking::Arena);
+        ASSERT_EQ(memory.data, data);
+        ASSERT_TRUE(std::all_of(
+            memory.data, memory.data + dirty_size, [](auto b) {
+                return b == 0;
+            }));
+    }
+}
+
+TEST_F(RuntimeTest, ArenaMemoryFallsBackToHeap)
+{
+    ctx_.memory = Memory(EvmMemoryAllocator{}, MemoryBacking::Arena);
+    ASSERT_EQ(ctx_.memory.capacity, EvmMemoryArena::capacity);
+    ctx_.gas_remaining = std::numeric_limits<std::int64_t>::max();
+
+    ctx_.expand_memory(Bin<30>::unsafe_from(32));
+    ctx_.memory.data[0] = 0xFF;
+
+    uint32_t const new_size = EvmMemoryArena::region_size;
+    ctx_.expand_memory(Bin<30>::unsafe_from(new_size));
+    ASSERT_EQ(ctx_.memory.size, new_size);
+    ASSERT_EQ(ctx_.memory.capacity, new_size * 2);
+    ASSERT_EQ(ctx_.memory.data[0], 0xFF);
+    ASSERT_TRUE(std::all_of(
+        ctx_.memory.data + 1,
+        ctx_.memory.data + ctx_.memory.size,
+        [](auto b) { return b == 0; }));
+}